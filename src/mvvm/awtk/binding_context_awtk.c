@@ -29,16 +29,21 @@
 #include "base/widget.h"
 #include "widgets/window.h"
 #include "base/window_manager.h"
+#include "mvvm/base/navigator.h"
+#include "mvvm/base/navigator_trace.h"
 #include "mvvm/base/data_binding.h"
+#include "mvvm/base/numeric_series.h"
 #include "mvvm/base/view_model_dummy.h"
 #include "mvvm/base/view_model_array.h"
 #include "mvvm/base/view_model_factory.h"
 #include "mvvm/base/binding_context.h"
 #include "mvvm/base/command_binding.h"
+#include "mvvm/base/value_converter.h"
 #include "mvvm/base/binding_rule_parser.h"
 #include "mvvm/awtk/binding_context_awtk.h"
 
 static ret_t binding_context_bind_for_widget(widget_t* widget, navigator_request_t* req);
+static ret_t on_view_model_item_changed(void* ctx, event_t* e);
 
 static const char* widget_get_prop_vmodel(widget_t* widget) {
   value_t v;
@@ -123,6 +128,7 @@ static ret_t binding_context_bind_data(binding_context_t* ctx, const char* name,
     BINDING_RULE(rule)->cursor = cursor;
   }
 
+  data_binding_resolve_prop_id(rule);
   goto_error_if_fail(darray_push(&(ctx->data_bindings), rule) == RET_OK);
 
   if (rule->trigger != UPDATE_WHEN_EXPLICIT) {
@@ -194,6 +200,25 @@ static bool_t command_binding_filter(command_binding_t* rule, event_t* e) {
   return FALSE;
 }
 
+static ret_t binding_context_awtk_close_window(binding_context_t* ctx, widget_t* win) {
+  ret_t ret = RET_NOT_IMPL;
+  navigator_request_t* req = ctx->navigator_request;
+
+  /*交给导航处理器，它可以缓存窗口。需要参数或者返回结果的窗口每次重新创建*/
+  if (navigator() != NULL && req != NULL && win->name != NULL &&
+      navigator_request_is_plain(req)) {
+    navigator_request_t* close_req = navigator_request_create(win->name, NULL);
+
+    if (close_req != NULL) {
+      object_set_prop_pointer(OBJECT(close_req), NAVIGATOR_ARG_VIEW, win);
+      ret = navigator_handle_close(navigator(), close_req);
+      object_unref(OBJECT(close_req));
+    }
+  }
+
+  return ret == RET_OK ? RET_OK : window_close(win);
+}
+
 static ret_t command_binding_exec_command(command_binding_t* rule) {
   if (command_binding_can_exec(rule)) {
     if (rule->update_model) {
@@ -204,7 +229,7 @@ static ret_t command_binding_exec_command(command_binding_t* rule) {
 
     if (rule->close_window) {
       widget_t* win = widget_get_window(BINDING_RULE(rule)->widget);
-      window_close(win);
+      binding_context_awtk_close_window(BINDING_RULE(rule)->binding_context, win);
     }
 
     if (rule->quit_app) {
@@ -251,6 +276,11 @@ static ret_t binding_context_bind_command(binding_context_t* ctx, const char* na
     widget_on(widget, event, on_widget_event, rule);
   }
 
+  if (rule->prefetch && rule->args != NULL && navigator() != NULL &&
+      tk_str_ieq(rule->command, COMMAND_BINDING_CMD_NAVIGATE)) {
+    navigator_prefetch(rule->args);
+  }
+
   return RET_OK;
 error:
   object_unref(OBJECT(rule));
@@ -271,8 +301,31 @@ static ret_t visit_bind_one_prop(void* ctx, const void* data) {
   return RET_OK;
 }
 
+static ret_t on_view_model_props_dirty(void* ctx, event_t* e) {
+  binding_context_t* bctx = (binding_context_t*)ctx;
+  view_model_props_dirty_event_t* evt = (view_model_props_dirty_event_t*)e;
+
+  bctx->dirty_props_received = TRUE;
+  if (evt->all) {
+    binding_context_update_to_view(bctx);
+  } else {
+    binding_context_update_dirty_to_view(bctx, evt->dirty, evt->size);
+  }
+
+  return RET_OK;
+}
+
 static ret_t on_view_model_prop_change(void* ctx, event_t* e) {
-  binding_context_update_to_view((binding_context_t*)ctx);
+  binding_context_t* bctx = (binding_context_t*)ctx;
+
+  /*紧跟在EVT_VIEW_MODEL_PROPS_DIRTY之后的通知已经按脏属性处理过了*/
+  if (e->type == EVT_PROP_CHANGED && bctx->dirty_props_received) {
+    bctx->dirty_props_received = FALSE;
+    return RET_OK;
+  }
+
+  bctx->dirty_props_received = FALSE;
+  binding_context_update_to_view(bctx);
 
   return RET_OK;
 }
@@ -345,6 +398,7 @@ static ret_t binding_context_awtk_bind_widget(binding_context_t* ctx, widget_t*
     view_model_on_mount(view_model);
     emitter_on(EMITTER(view_model), EVT_PROP_CHANGED, on_view_model_prop_change, ctx);
     emitter_on(EMITTER(view_model), EVT_PROPS_CHANGED, on_view_model_prop_change, ctx);
+    emitter_on(EMITTER(view_model), EVT_VIEW_MODEL_PROPS_DIRTY, on_view_model_props_dirty, ctx);
   }
 
   return RET_OK;
@@ -480,19 +534,30 @@ static ret_t binding_context_on_rebind(void* c, event_t* e) {
 
 static ret_t binding_context_awtk_bind(binding_context_t* ctx, void* widget) {
   ret_t ret = RET_OK;
+  uint64_t start = 0;
 
   if (object_is_collection(OBJECT(ctx->view_model))) {
     ret = binding_context_awtk_bind_widget_array(ctx, WIDGET(widget));
 
     emitter_on(EMITTER(ctx->view_model), EVT_PROP_CHANGED, on_view_model_prop_change, ctx);
     emitter_on(EMITTER(ctx->view_model), EVT_PROPS_CHANGED, on_view_model_prop_change, ctx);
+    emitter_on(EMITTER(ctx->view_model), EVT_VIEW_MODEL_PROPS_DIRTY, on_view_model_props_dirty,
+               ctx);
     emitter_on(EMITTER(ctx->view_model), EVT_ITEMS_CHANGED, binding_context_on_rebind, ctx);
+    emitter_on(EMITTER(ctx->view_model), EVT_VIEW_MODEL_ITEM_INSERTED, binding_context_on_rebind,
+               ctx);
+    emitter_on(EMITTER(ctx->view_model), EVT_VIEW_MODEL_ITEM_REMOVED, binding_context_on_rebind,
+               ctx);
+    emitter_on(EMITTER(ctx->view_model), EVT_VIEW_MODEL_ITEM_CHANGED, on_view_model_item_changed,
+               ctx);
   } else {
     ret = binding_context_awtk_bind_widget(ctx, WIDGET(widget));
   }
 
   return_value_if_fail(ret == RET_OK, RET_FAIL);
+  start = navigator_trace_now();
   return_value_if_fail(binding_context_update_to_view(ctx) == RET_OK, RET_FAIL);
+  navigator_trace_add(NAVIGATOR_TRACE_UPDATE_TO_VIEW, start);
   ctx->bound = TRUE;
 
   return RET_OK;
@@ -511,29 +576,291 @@ static ret_t widget_set_prop_if_diff(widget_t* widget, const char* name, const v
   return widget_set_prop(widget, name, v);
 }
 
-static ret_t visit_data_binding_update_to_view(void* ctx, const void* data) {
-  value_t v;
-  data_binding_t* rule = DATA_BINDING(data);
-  widget_t* widget = WIDGET(BINDING_RULE(rule)->widget);
+/*数值序列是同一个对象，有变化时总是传给控件，本次更新结束后再清除变化的区间*/
+static numeric_series_t* data_binding_dirty_series(const value_t* v, darray_t* dirty_series) {
+  numeric_series_t* series = NULL;
+
+  if (v->type == VALUE_TYPE_OBJECT && value_object(v) != NULL) {
+    series = numeric_series_cast(value_object(v));
+  }
+
+  if (series == NULL || !numeric_series_is_dirty(series)) {
+    return NULL;
+  }
+
+  if (darray_find(dirty_series, series) == NULL) {
+    darray_push(dirty_series, object_ref(OBJECT(series)));
+  }
+
+  return series;
+}
+
+static ret_t visit_dirty_series_clear(void* ctx, const void* data) {
+  numeric_series_clear_dirty(NUMERIC_SERIES(data));
+  object_unref(OBJECT(data));
+
+  return RET_OK;
+}
+
+static bool_t data_binding_need_update_to_view(data_binding_t* rule) {
   binding_context_t* bctx = BINDING_RULE(rule)->binding_context;
 
   if (tk_str_start_with(rule->path, DATA_BINDING_ERROR_OF)) {
+    return FALSE;
+  }
+
+  if (bctx->bound && !binding_context_is_prop_dirty(bctx, rule->prop_id)) {
+    return FALSE;
+  }
+
+  return (rule->mode == BINDING_ONCE && !(bctx->bound)) || rule->mode == BINDING_ONE_WAY ||
+         rule->mode == BINDING_TWO_WAY;
+}
+
+static ret_t data_binding_set_widget_prop(data_binding_t* rule, const value_t* v,
+                                          darray_t* dirty_series) {
+  numeric_series_t* series = data_binding_dirty_series(v, dirty_series);
+  widget_t* widget = WIDGET(BINDING_RULE(rule)->widget);
+  binding_context_t* bctx = BINDING_RULE(rule)->binding_context;
+
+  if (bctx->bound && series == NULL) {
+    return widget_set_prop_if_diff(widget, rule->prop, v);
+  } else {
+    return widget_set_prop(widget, rule->prop, v);
+  }
+}
+
+static ret_t data_binding_update_to_view(data_binding_t* rule, darray_t* dirty_series) {
+  value_t v;
+
+  return_value_if_fail(data_binding_get_prop(rule, &v) == RET_OK, RET_OK);
+  data_binding_set_widget_prop(rule, &v, dirty_series);
+  value_reset(&v);
+
+  return RET_OK;
+}
+
+static ret_t visit_data_binding_update_to_view(void* ctx, const void* data) {
+  data_binding_t* rule = DATA_BINDING(data);
+
+  if (data_binding_need_update_to_view(rule)) {
+    data_binding_update_to_view(rule, (darray_t*)ctx);
+  }
+
+  return RET_OK;
+}
+
+/*集合中的一项变化时只刷新这一行的绑定*/
+static ret_t on_view_model_item_changed(void* ctx, event_t* e) {
+  uint32_t i = 0;
+  darray_t dirty_series;
+  binding_context_t* bctx = (binding_context_t*)ctx;
+  view_model_item_event_t* evt = (view_model_item_event_t*)e;
+
+  /*整体刷新已经在等待中，这一行会一起刷新*/
+  if (!bctx->bound || bctx->request_update_view > 0 || bctx->request_rebind > 0) {
     return RET_OK;
   }
 
-  if ((rule->mode == BINDING_ONCE && !(bctx->bound)) || rule->mode == BINDING_ONE_WAY ||
-      rule->mode == BINDING_TWO_WAY) {
-    return_value_if_fail(data_binding_get_prop(rule, &v) == RET_OK, RET_OK);
-    if (bctx->bound) {
-      return_value_if_fail(widget_set_prop_if_diff(widget, rule->prop, &v) == RET_OK, RET_OK);
+  darray_init(&dirty_series, 0, NULL, NULL);
+  view_model_begin_update(bctx->view_model);
+  for (i = 0; i < bctx->data_bindings.size; i++) {
+    data_binding_t* rule = DATA_BINDING(bctx->data_bindings.elms[i]);
+
+    if (BINDING_RULE(rule)->cursor == evt->index && data_binding_need_update_to_view(rule)) {
+      data_binding_update_to_view(rule, &dirty_series);
+    }
+  }
+  view_model_end_update(bctx->view_model);
+  darray_foreach(&dirty_series, visit_dirty_series_clear, NULL);
+  darray_deinit(&dirty_series);
+
+  widget_invalidate_force(WIDGET(bctx->widget), NULL);
+
+  return RET_OK;
+}
+
+/*列表中需要刷新的一个绑定，以及预先读取的原始值*/
+typedef struct _item_binding_t {
+  data_binding_t* rule;
+  const char* field;
+  value_t raw;
+} item_binding_t;
+
+/*列表中的简单字段(item.name)可以按行一次读取，返回字段名，否则返回NULL*/
+static const char* data_binding_get_item_field(data_binding_t* rule) {
+  const char* field = NULL;
+
+  if (rule->prop_id != VIEW_MODEL_PROP_ID_INVALID || !tk_str_start_with(rule->path, "item.")) {
+    return NULL;
+  }
+  field = rule->path + 5;
+
+  return tk_is_valid_name(field) ? field : NULL;
+}
+
+static ret_t item_binding_fetch_one(item_binding_t* item) {
+  value_t v;
+
+  /*取下一行的值时可能覆盖模型内部的缓冲区，字符串需要复制一份*/
+  if (data_binding_get_raw_prop(item->rule, &v) == RET_OK) {
+    value_converter_hold_result(&(item->raw), &v);
+  }
+
+  return RET_OK;
+}
+
+/*读取原始值：同一行的简单字段用view_model_get_row_props一次读取，其它的逐个读取*/
+static ret_t binding_context_awtk_fetch_items(view_model_t* view_model, item_binding_t* items,
+                                              const char** names, value_t* values, uint32_t nr) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t k = 0;
+  uint32_t cursor = 0;
+
+  for (i = 0; i < nr; i = j) {
+    cursor = BINDING_RULE(items[i].rule)->cursor;
+    for (j = i; j < nr && items[j].field != NULL; j++) {
+      if (BINDING_RULE(items[j].rule)->cursor != cursor) {
+        break;
+      }
+      names[j - i] = items[j].field;
+    }
+
+    if (j == i) {
+      item_binding_fetch_one(items + j);
+      j++;
+    } else if (view_model_get_row_props(view_model, cursor, names, values, j - i) == RET_OK) {
+      for (k = i; k < j; k++) {
+        items[k].raw = values[k - i];
+      }
+    } else {
+      for (k = i; k < j; k++) {
+        item_binding_fetch_one(items + k);
+      }
+    }
+  }
+
+  return RET_OK;
+}
+
+/*列表中相邻的同一个转换器的绑定一起批量转换*/
+static ret_t data_binding_update_to_view_batch(item_binding_t* items, uint32_t nr,
+                                               darray_t* dirty_series) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+  item_binding_t item;
+  value_t* from = NULL;
+  value_t* to = NULL;
+  value_converter_t* c = value_converter_create(items[0].rule->converter);
+
+  if (c != NULL) {
+    from = TKMEM_ZALLOCN(value_t, nr * 2);
+  }
+
+  if (from != NULL) {
+    to = from + nr;
+    for (i = 0; i < nr; i++) {
+      /*跳过读取失败的绑定(交换位置，原始值仍然由items持有)*/
+      if (items[i].raw.type != VALUE_TYPE_INVALID) {
+        item = items[n];
+        items[n] = items[i];
+        items[i] = item;
+        from[n] = items[n].raw;
+        n++;
+      }
+    }
+
+    if (value_converter_to_view_batch(c, from, to, n) == RET_OK) {
+      for (i = 0; i < n; i++) {
+        data_binding_set_widget_prop(items[i].rule, to + i, dirty_series);
+        value_reset(to + i);
+      }
+      nr = 0;
     } else {
-      return_value_if_fail(widget_set_prop(widget, rule->prop, &v) == RET_OK, RET_OK);
+      nr = n;
     }
+
+    TKMEM_FREE(from);
+  }
+
+  if (c != NULL) {
+    object_unref(OBJECT(c));
+  }
+
+  /*批量转换失败时逐个转换*/
+  for (i = 0; i < nr; i++) {
+    data_binding_update_to_view(items[i].rule, dirty_series);
   }
 
   return RET_OK;
 }
 
+static ret_t binding_context_awtk_update_items_to_view(binding_context_t* ctx,
+                                                       darray_t* dirty_series) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t nr = 0;
+  uint32_t size = ctx->data_bindings.size;
+  value_t* values = NULL;
+  const char** names = NULL;
+  data_binding_t* rule = NULL;
+  const char* converter = NULL;
+  item_binding_t* items = TKMEM_ZALLOCN(item_binding_t, size + 1);
+
+  if (items != NULL) {
+    values = TKMEM_ZALLOCN(value_t, size + 1);
+    names = TKMEM_ZALLOCN(const char*, size + 1);
+  }
+
+  if (items == NULL || values == NULL || names == NULL) {
+    TKMEM_FREE(items);
+    TKMEM_FREE(values);
+    TKMEM_FREE(names);
+
+    return darray_foreach(&(ctx->data_bindings), visit_data_binding_update_to_view, dirty_series);
+  }
+
+  for (i = 0; i < size; i++) {
+    rule = DATA_BINDING(ctx->data_bindings.elms[i]);
+
+    if (data_binding_need_update_to_view(rule)) {
+      items[nr].rule = rule;
+      items[nr].field = data_binding_get_item_field(rule);
+      nr++;
+    }
+  }
+
+  binding_context_awtk_fetch_items(ctx->view_model, items, names, values, nr);
+
+  /*按声明的顺序更新(如slider的max要在value之前设置)，只有相邻的同一个转换器的绑定一起转换*/
+  for (i = 0; i < nr; i = j) {
+    rule = items[i].rule;
+    converter = data_binding_is_cursor(rule) ? NULL : rule->converter;
+
+    for (j = i + 1; converter != NULL && j < nr; j++) {
+      if (data_binding_is_cursor(items[j].rule) || !tk_str_eq(items[j].rule->converter, converter)) {
+        break;
+      }
+    }
+
+    if (converter != NULL) {
+      data_binding_update_to_view_batch(items + i, j - i, dirty_series);
+    } else if (items[i].raw.type != VALUE_TYPE_INVALID) {
+      data_binding_set_widget_prop(rule, &(items[i].raw), dirty_series);
+    }
+  }
+
+  for (i = 0; i < nr; i++) {
+    value_reset(&(items[i].raw));
+  }
+  TKMEM_FREE(items);
+  TKMEM_FREE(values);
+  TKMEM_FREE(names);
+
+  return RET_OK;
+}
+
 static ret_t visit_command_binding(void* ctx, const void* data) {
   command_binding_t* rule = COMMAND_BINDING(data);
   widget_t* widget = WIDGET(BINDING_RULE(rule)->widget);
@@ -548,7 +875,20 @@ static ret_t visit_command_binding(void* ctx, const void* data) {
 
 static ret_t binding_context_awtk_update_to_view_sync(binding_context_t* ctx) {
   if (ctx->request_update_view > 0) {
-    darray_foreach(&(ctx->data_bindings), visit_data_binding_update_to_view, ctx);
+    darray_t dirty_series;
+
+    darray_init(&dirty_series, 0, NULL, NULL);
+    if (object_is_collection(OBJECT(ctx->view_model))) {
+      view_model_begin_update(ctx->view_model);
+      binding_context_awtk_update_items_to_view(ctx, &dirty_series);
+      view_model_end_update(ctx->view_model);
+    } else {
+      darray_foreach(&(ctx->data_bindings), visit_data_binding_update_to_view, &dirty_series);
+    }
+    darray_foreach(&dirty_series, visit_dirty_series_clear, NULL);
+    darray_deinit(&dirty_series);
+    binding_context_clear_dirty_props(ctx);
+
     darray_foreach(&(ctx->command_bindings), visit_command_binding, ctx);
 
     ctx->request_update_view = 0;
@@ -699,13 +1039,16 @@ static ret_t binding_context_on_widget_destroy(void* ctx, event_t* e) {
 }
 
 static ret_t binding_context_bind_for_widget(widget_t* widget, navigator_request_t* req) {
+  uint64_t start = 0;
   binding_context_t* ctx = NULL;
   return_value_if_fail(widget != NULL && req != NULL, RET_BAD_PARAMS);
 
   ctx = binding_context_awtk_create(widget, req);
   return_value_if_fail(ctx != NULL, RET_BAD_PARAMS);
 
+  start = navigator_trace_now();
   goto_error_if_fail(binding_context_awtk_bind(ctx, widget) == RET_OK);
+  navigator_trace_add(NAVIGATOR_TRACE_BIND, start);
   widget_on(widget, EVT_DESTROY, binding_context_on_widget_destroy, ctx);
 
   return RET_OK;
@@ -721,10 +1064,12 @@ ret_t binding_context_bind_for_window(widget_t* widget, navigator_request_t* req
 
 ret_t awtk_open_window(navigator_request_t* req) {
   widget_t* win = NULL;
+  uint64_t start = navigator_trace_now();
   return_value_if_fail(req != NULL && req->target != NULL, RET_BAD_PARAMS);
 
   win = window_open(req->target);
   return_value_if_fail(win != NULL, RET_NOT_FOUND);
+  navigator_trace_add(NAVIGATOR_TRACE_WINDOW_OPEN, start);
 
   return binding_context_bind_for_window(win, req);
 }
@@ -21,12 +21,30 @@
 
 #include "mvvm/awtk/mvvm_awtk.h"
 
+static navigator_handler_t* s_navigator_handler;
+
 ret_t mvvm_awtk_init(void) {
-  navigator_register_handler(navigator(), NAVIGATOR_DEFAULT_HANDLER,
-                             navigator_handler_awtk_create());
+  s_navigator_handler = navigator_handler_awtk_create();
+  return_value_if_fail(s_navigator_handler != NULL, RET_OOM);
+
+  object_ref(OBJECT(s_navigator_handler));
+  navigator_register_handler(navigator(), NAVIGATOR_DEFAULT_HANDLER, s_navigator_handler);
   return RET_OK;
 }
 
+ret_t mvvm_awtk_set_window_cache_budget(uint32_t budget) {
+  return_value_if_fail(s_navigator_handler != NULL, RET_BAD_PARAMS);
+
+  return navigator_handler_awtk_set_cache_budget(s_navigator_handler, budget);
+}
+
 ret_t mvvm_awtk_deinit(void) {
+  if (s_navigator_handler != NULL) {
+    /*缓存的窗口中可能有脚本实现的view model，要在脚本引擎之前销毁*/
+    navigator_handler_awtk_clear_cache(s_navigator_handler);
+    object_unref(OBJECT(s_navigator_handler));
+    s_navigator_handler = NULL;
+  }
+
   return RET_OK;
 }
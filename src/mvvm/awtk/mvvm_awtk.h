@@ -36,6 +36,17 @@ BEGIN_C_DECLS
  */
 ret_t mvvm_awtk_init(void);
 
+/**
+ * @method mvvm_awtk_set_window_cache_budget
+ * 设置缺省导航处理器的窗口缓存可以使用的内存(估算值，0表示不缓存)。
+ * 经常来回切换的窗口(如列表和详情)关闭后保留在缓存中，再次打开时不必重新创建。
+ *
+ * @param {uint32_t} budget 内存的字节数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t mvvm_awtk_set_window_cache_budget(uint32_t budget);
+
 /**
  * @method mvvm_awtk_deinit
  * ~初始化MVVM awtk
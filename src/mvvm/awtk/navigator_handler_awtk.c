@@ -19,21 +19,391 @@
  *
  */
 
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "base/idle.h"
+#include "base/widget.h"
+#include "base/window_manager.h"
+#include "base/assets_manager.h"
 #include "mvvm/base/binding_context.h"
+#include "mvvm/base/navigator_trace.h"
 #include "mvvm/awtk/navigator_handler_awtk.h"
 
+#ifndef NAVIGATOR_HANDLER_AWTK_PREFETCH_MAX
+#define NAVIGATOR_HANDLER_AWTK_PREFETCH_MAX 8
+#endif /*NAVIGATOR_HANDLER_AWTK_PREFETCH_MAX*/
+
+#ifndef NAVIGATOR_HANDLER_AWTK_WIDGET_COST
+#define NAVIGATOR_HANDLER_AWTK_WIDGET_COST 512
+#endif /*NAVIGATOR_HANDLER_AWTK_WIDGET_COST*/
+
 extern ret_t awtk_open_window(navigator_request_t* req);
 
+typedef struct _prefetch_item_t {
+  char target[TK_NAME_LEN + 1];
+  char vmodel[TK_NAME_LEN + 1];
+  const asset_info_t* ui;
+  const asset_info_t* script;
+  bool_t loaded;
+} prefetch_item_t;
+
+static ret_t prefetch_item_destroy(prefetch_item_t* item) {
+  assets_manager_t* am = assets_manager();
+
+  if (item->ui != NULL) {
+    assets_manager_unref(am, item->ui);
+  }
+
+  if (item->script != NULL) {
+    assets_manager_unref(am, item->script);
+  }
+
+  TKMEM_FREE(item);
+
+  return RET_OK;
+}
+
+static int prefetch_item_compare(const void* a, const void* b) {
+  const prefetch_item_t* item = (const prefetch_item_t*)a;
+
+  return strcmp(item->target, (const char*)b);
+}
+
+static ret_t prefetch_item_load(prefetch_item_t* item) {
+  char* p = NULL;
+  char name[TK_NAME_LEN + 1];
+  assets_manager_t* am = assets_manager();
+
+  item->loaded = TRUE;
+  item->ui = assets_manager_ref(am, ASSET_TYPE_UI, item->target);
+  if (item->ui == NULL) {
+    log_debug("prefetch: not found ui %s\n", item->target);
+  }
+
+  /*有扩展名的view model(如temperature.js)由脚本实现，一起加载脚本*/
+  tk_strncpy(name, item->vmodel, TK_NAME_LEN);
+  p = strrchr(name, '.');
+  if (p != NULL) {
+    *p = '\0';
+    item->script = assets_manager_ref(am, ASSET_TYPE_SCRIPT, name);
+  }
+
+  return RET_OK;
+}
+
+typedef struct _cached_window_t {
+  char target[TK_NAME_LEN + 1];
+  widget_t* win;
+  uint32_t cost;
+  uint32_t destroy_id;
+} cached_window_t;
+
+static ret_t cached_window_destroy(cached_window_t* item) {
+  if (item->win != NULL) {
+    widget_off(item->win, item->destroy_id);
+
+    /*和正常关闭窗口一样，先通知view model即将卸载*/
+    event_t e = event_init(EVT_WINDOW_CLOSE, item->win);
+    widget_dispatch(item->win, &e);
+    widget_destroy(item->win);
+  }
+
+  TKMEM_FREE(item);
+
+  return RET_OK;
+}
+
+static int cached_window_compare(const void* a, const void* b) {
+  const cached_window_t* item = (const cached_window_t*)a;
+
+  return strcmp(item->target, (const char*)b);
+}
+
+static uint32_t widget_count_tree(widget_t* widget) {
+  uint32_t nr = 1;
+
+  WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+  nr += widget_count_tree(iter);
+  WIDGET_FOR_EACH_CHILD_END();
+
+  return nr;
+}
+
+/*从缓存中移除第index个窗口。restore为TRUE时返回该窗口，否则销毁它*/
+static widget_t* navigator_handler_awtk_uncache(navigator_handler_awtk_t* awtk, uint32_t index,
+                                                bool_t restore) {
+  widget_t* win = NULL;
+  cached_window_t* item = (cached_window_t*)darray_get(&(awtk->cached), index);
+  return_value_if_fail(item != NULL, NULL);
+
+  awtk->cache_size -= item->cost;
+  if (restore) {
+    win = item->win;
+    widget_off(win, item->destroy_id);
+    item->win = NULL;
+  }
+  darray_remove_index(&(awtk->cached), index);
+
+  return win;
+}
+
+static ret_t navigator_handler_awtk_shrink_cache(navigator_handler_awtk_t* awtk, uint32_t size) {
+  /*最近关闭的窗口在最后，从前面开始淘汰*/
+  while (awtk->cached.size > 0 && awtk->cache_size > size) {
+    navigator_handler_awtk_uncache(awtk, 0, FALSE);
+  }
+
+  return RET_OK;
+}
+
+/*缓存的窗口仍然在窗口管理器中，窗口管理器销毁时从缓存中移除*/
+static ret_t navigator_handler_awtk_on_cached_window_destroy(void* ctx, event_t* e) {
+  uint32_t i = 0;
+  navigator_handler_awtk_t* awtk = NAVIGATOR_HANDLER_AWTK(ctx);
+
+  for (i = 0; i < awtk->cached.size; i++) {
+    cached_window_t* item = (cached_window_t*)(awtk->cached.elms[i]);
+
+    if (item->win == WIDGET(e->target)) {
+      navigator_handler_awtk_uncache(awtk, i, TRUE);
+      break;
+    }
+  }
+
+  return RET_OK;
+}
+
+static widget_t* navigator_handler_awtk_get_top_visible(widget_t* wm) {
+  WIDGET_FOR_EACH_CHILD_BEGIN_R(wm, iter, i)
+  if (iter->visible) {
+    return iter;
+  }
+  WIDGET_FOR_EACH_CHILD_END();
+
+  return NULL;
+}
+
+/*隐藏窗口但保留在窗口管理器中，像关闭窗口一样切换前台窗口*/
+static ret_t navigator_handler_awtk_hide_window(widget_t* win) {
+  event_t e;
+  widget_t* top = NULL;
+  widget_t* wm = win->parent;
+
+  if (wm->grab_widget == win) {
+    widget_ungrab(wm, win);
+  }
+
+  if (wm->target == win) {
+    wm->target = NULL;
+  }
+
+  if (wm->key_target == win) {
+    wm->key_target = NULL;
+  }
+
+  widget_set_visible(win, FALSE, FALSE);
+  e = event_init(EVT_WINDOW_TO_BACKGROUND, win);
+  widget_dispatch(win, &e);
+
+  top = navigator_handler_awtk_get_top_visible(wm);
+  if (top != NULL) {
+    e = event_init(EVT_WINDOW_TO_FOREGROUND, top);
+    widget_dispatch(top, &e);
+  }
+
+  return widget_invalidate_force(wm, NULL);
+}
+
+/*隐藏的窗口先从窗口管理器中取出，再由窗口管理器重新打开(动画、前后台切换和grab)*/
+static ret_t navigator_handler_awtk_restore_window(widget_t* win) {
+  widget_t* wm = win->parent;
+
+  if (wm != NULL) {
+    widget_remove_child(wm, win);
+  } else {
+    wm = window_manager();
+  }
+  widget_set_visible(win, TRUE, FALSE);
+
+  return window_manager_open_window(wm, win);
+}
+
+static ret_t navigator_handler_awtk_on_idle(const idle_info_t* info) {
+  uint32_t i = 0;
+  navigator_handler_awtk_t* handler = NAVIGATOR_HANDLER_AWTK(info->ctx);
+
+  /*每次只加载一个窗口的资源，避免一次占用太长的时间*/
+  for (i = 0; i < handler->prefetched.size; i++) {
+    prefetch_item_t* item = (prefetch_item_t*)(handler->prefetched.elms[i]);
+
+    if (!item->loaded) {
+      prefetch_item_load(item);
+
+      return RET_REPEAT;
+    }
+  }
+
+  handler->idle_id = TK_INVALID_ID;
+
+  return RET_REMOVE;
+}
+
+static ret_t navigator_handler_awtk_on_destroy(object_t* obj) {
+  navigator_handler_awtk_t* handler = NAVIGATOR_HANDLER_AWTK(obj);
+
+  if (handler->idle_id != TK_INVALID_ID) {
+    idle_remove(handler->idle_id);
+    handler->idle_id = TK_INVALID_ID;
+  }
+  darray_deinit(&(handler->prefetched));
+  darray_deinit(&(handler->cached));
+
+  return RET_OK;
+}
+
 static const object_vtable_t s_navigator_handler_awtk_vtable = {
     .type = "navigator_handler_awtk",
     .desc = "navigator_handler_awtk",
     .size = sizeof(navigator_handler_awtk_t),
     .is_collection = FALSE,
+    .on_destroy = navigator_handler_awtk_on_destroy,
 };
 
+static ret_t navigator_handler_awtk_on_destroy_before_paint(void* ctx, event_t* e) {
+  navigator_trace_cancel_deferred(e->target);
+
+  return RET_REMOVE;
+}
+
+static ret_t navigator_handler_awtk_on_first_paint(void* ctx, event_t* e) {
+  navigator_trace_end_deferred(e->target);
+  widget_off_by_func(WIDGET(e->target), EVT_DESTROY,
+                     navigator_handler_awtk_on_destroy_before_paint, NULL);
+
+  return RET_REMOVE;
+}
+
+static ret_t navigator_handler_awtk_trace_paint(widget_t* win) {
+  if (win != NULL && navigator_trace_is_active()) {
+    navigator_trace_defer_end(win);
+    widget_on(win, EVT_AFTER_PAINT, navigator_handler_awtk_on_first_paint, NULL);
+    widget_on(win, EVT_DESTROY, navigator_handler_awtk_on_destroy_before_paint, NULL);
+  }
+
+  return RET_OK;
+}
+
 static ret_t navigator_handler_awtk_on_request(navigator_handler_t* handler,
                                                navigator_request_t* req) {
-  return awtk_open_window(req);
+  widget_t* win = NULL;
+  ret_t ret = RET_NOT_FOUND;
+  navigator_handler_awtk_t* awtk = NAVIGATOR_HANDLER_AWTK(handler);
+
+  /*只有不带参数的请求才能使用缓存的窗口，否则窗口的内容可能和请求不一致*/
+  if (awtk->cached.size > 0 && navigator_request_is_plain(req)) {
+    int32_t index = darray_find_index(&(awtk->cached), req->target);
+
+    if (index >= 0) {
+      win = navigator_handler_awtk_uncache(awtk, index, TRUE);
+      ret = navigator_handler_awtk_restore_window(win);
+      if (ret != RET_OK) {
+        widget_destroy(win);
+        win = NULL;
+      }
+    }
+  }
+
+  if (ret != RET_OK) {
+    ret = awtk_open_window(req);
+    if (ret == RET_OK) {
+      win = window_manager_get_top_window(window_manager());
+    }
+  }
+
+  navigator_handler_awtk_trace_paint(win);
+
+  /*窗口已经创建，不再需要预取的资源*/
+  darray_remove(&(awtk->prefetched), req->target);
+
+  return ret;
+}
+
+static ret_t navigator_handler_awtk_on_close(navigator_handler_t* handler,
+                                             navigator_request_t* req) {
+  int32_t index = 0;
+  uint32_t cost = 0;
+  cached_window_t* item = NULL;
+  navigator_handler_awtk_t* awtk = NAVIGATOR_HANDLER_AWTK(handler);
+  widget_t* win = WIDGET(object_get_prop_pointer(OBJECT(req), NAVIGATOR_ARG_VIEW));
+  return_value_if_fail(win != NULL && win->parent != NULL, RET_BAD_PARAMS);
+
+  if (awtk->cache_budget == 0) {
+    return RET_NOT_IMPL;
+  }
+
+  cost = widget_count_tree(win) * NAVIGATOR_HANDLER_AWTK_WIDGET_COST;
+  if (cost > awtk->cache_budget) {
+    return RET_NOT_IMPL;
+  }
+
+  /*同名的窗口只保留最近关闭的一个*/
+  index = darray_find_index(&(awtk->cached), req->target);
+  if (index >= 0) {
+    navigator_handler_awtk_uncache(awtk, index, FALSE);
+  }
+  navigator_handler_awtk_shrink_cache(awtk, awtk->cache_budget - cost);
+
+  item = TKMEM_ZALLOC(cached_window_t);
+  return_value_if_fail(item != NULL, RET_OOM);
+
+  item->cost = cost;
+  tk_strncpy(item->target, req->target, TK_NAME_LEN);
+  if (darray_push(&(awtk->cached), item) != RET_OK) {
+    cached_window_destroy(item);
+    return RET_OOM;
+  }
+
+  /*控件、绑定规则和view model都保留，窗口只是隐藏起来*/
+  item->win = win;
+  item->destroy_id = widget_on(win, EVT_DESTROY, navigator_handler_awtk_on_cached_window_destroy,
+                               awtk);
+  awtk->cache_size += cost;
+
+  return navigator_handler_awtk_hide_window(win);
+}
+
+static ret_t navigator_handler_awtk_on_prefetch(navigator_handler_t* handler,
+                                                navigator_request_t* req) {
+  prefetch_item_t* item = NULL;
+  navigator_handler_awtk_t* awtk = NAVIGATOR_HANDLER_AWTK(handler);
+  const char* vmodel = object_get_prop_str(OBJECT(req), NAVIGATOR_ARG_VMODEL);
+
+  if (darray_find(&(awtk->prefetched), req->target) != NULL) {
+    return RET_OK;
+  }
+
+  if (awtk->prefetched.size >= NAVIGATOR_HANDLER_AWTK_PREFETCH_MAX) {
+    darray_remove_index(&(awtk->prefetched), 0);
+  }
+
+  item = TKMEM_ZALLOC(prefetch_item_t);
+  return_value_if_fail(item != NULL, RET_OOM);
+
+  tk_strncpy(item->target, req->target, TK_NAME_LEN);
+  if (vmodel != NULL) {
+    tk_strncpy(item->vmodel, vmodel, TK_NAME_LEN);
+  }
+
+  if (darray_push(&(awtk->prefetched), item) != RET_OK) {
+    prefetch_item_destroy(item);
+    return RET_OOM;
+  }
+
+  if (awtk->idle_id == TK_INVALID_ID) {
+    awtk->idle_id = idle_add(navigator_handler_awtk_on_idle, awtk);
+  }
+
+  return RET_OK;
 }
 
 navigator_handler_t* navigator_handler_awtk_create(void) {
@@ -45,6 +415,37 @@ navigator_handler_t* navigator_handler_awtk_create(void) {
   return_value_if_fail(handler != NULL, NULL);
 
   handler->on_request = navigator_handler_awtk_on_request;
+  handler->on_prefetch = navigator_handler_awtk_on_prefetch;
+  handler->on_close = navigator_handler_awtk_on_close;
+
+  NAVIGATOR_HANDLER_AWTK(handler)->idle_id = TK_INVALID_ID;
+  darray_init(&(NAVIGATOR_HANDLER_AWTK(handler)->prefetched), NAVIGATOR_HANDLER_AWTK_PREFETCH_MAX,
+              (tk_destroy_t)prefetch_item_destroy, prefetch_item_compare);
+  darray_init(&(NAVIGATOR_HANDLER_AWTK(handler)->cached), 4, (tk_destroy_t)cached_window_destroy,
+              cached_window_compare);
 
   return handler;
 }
+
+static navigator_handler_awtk_t* navigator_handler_awtk_cast(navigator_handler_t* handler) {
+  return_value_if_fail(handler != NULL && OBJECT(handler)->vt == &s_navigator_handler_awtk_vtable,
+                       NULL);
+
+  return NAVIGATOR_HANDLER_AWTK(handler);
+}
+
+ret_t navigator_handler_awtk_set_cache_budget(navigator_handler_t* handler, uint32_t budget) {
+  navigator_handler_awtk_t* awtk = navigator_handler_awtk_cast(handler);
+  return_value_if_fail(awtk != NULL, RET_BAD_PARAMS);
+
+  awtk->cache_budget = budget;
+
+  return navigator_handler_awtk_shrink_cache(awtk, budget);
+}
+
+ret_t navigator_handler_awtk_clear_cache(navigator_handler_t* handler) {
+  navigator_handler_awtk_t* awtk = navigator_handler_awtk_cast(handler);
+  return_value_if_fail(awtk != NULL, RET_BAD_PARAMS);
+
+  return navigator_handler_awtk_shrink_cache(awtk, 0);
+}
@@ -22,6 +22,7 @@
 #ifndef TK_NAVIGATOR_HANDLER_AWTK_H
 #define TK_NAVIGATOR_HANDLER_AWTK_H
 
+#include "tkc/darray.h"
 #include "mvvm/base/view_model.h"
 #include "mvvm/base/navigator.h"
 
@@ -33,9 +34,24 @@ BEGIN_C_DECLS
  *
  * 基于AWTK实现的导航处理器，负责打开指定的窗口。
  *
+ * 预取窗口时，在空闲时加载窗口的UI资源(以及指定的view model脚本)并保持引用，
+ * 打开窗口时直接使用内存中的资源，窗口打开之后释放。
+ *
+ * 启用窗口缓存之后，通过命令绑定(CloseWindow)关闭的窗口不会被销毁，而是连同绑定规则和view model
+ * 一起隐藏起来(下面的窗口切换到前台)，再次打开同名的窗口(不带参数)时由窗口管理器重新打开。
+ * 缓存按估算的内存(控件个数 x NAVIGATOR_HANDLER_AWTK_WIDGET_COST)限制大小，超出时淘汰最早关闭的窗口。
+ *
  */
 typedef struct _navigator_handler_awtk_t {
   navigator_handler_t navigator_handler;
+
+  /*private*/
+  darray_t prefetched;
+  uint32_t idle_id;
+
+  darray_t cached;
+  uint32_t cache_size;
+  uint32_t cache_budget;
 } navigator_handler_awtk_t;
 
 /**
@@ -46,6 +62,27 @@ typedef struct _navigator_handler_awtk_t {
  */
 navigator_handler_t* navigator_handler_awtk_create(void);
 
+/**
+ * @method navigator_handler_awtk_set_cache_budget
+ * 设置窗口缓存可以使用的内存(估算值)。缺省为0，表示不缓存窗口。
+ *
+ * @param {navigator_handler_t*} handler navigator_handler对象。
+ * @param {uint32_t} budget 内存的字节数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t navigator_handler_awtk_set_cache_budget(navigator_handler_t* handler, uint32_t budget);
+
+/**
+ * @method navigator_handler_awtk_clear_cache
+ * 销毁全部缓存的窗口。
+ *
+ * @param {navigator_handler_t*} handler navigator_handler对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t navigator_handler_awtk_clear_cache(navigator_handler_t* handler);
+
 #define NAVIGATOR_HANDLER_AWTK(h) ((navigator_handler_awtk_t*)h)
 
 END_C_DECLS
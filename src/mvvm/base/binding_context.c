@@ -40,13 +40,13 @@ ret_t binding_context_init(binding_context_t* ctx, navigator_request_t* req, vie
     ctx->view_model = vm;
   }
 
+  ctx->update_all = TRUE;
+
   return RET_OK;
 }
 
-ret_t binding_context_update_to_view(binding_context_t* ctx) {
+static ret_t binding_context_request_update_to_view(binding_context_t* ctx) {
   ret_t ret = RET_OK;
-  return_value_if_fail(ctx != NULL && ctx->vt != NULL && ctx->vt->update_to_view != NULL,
-                       RET_BAD_PARAMS);
 
   if (ctx->updating_view) {
     return RET_BUSY;
@@ -59,6 +59,65 @@ ret_t binding_context_update_to_view(binding_context_t* ctx) {
   return ret;
 }
 
+ret_t binding_context_update_to_view(binding_context_t* ctx) {
+  return_value_if_fail(ctx != NULL && ctx->vt != NULL && ctx->vt->update_to_view != NULL,
+                       RET_BAD_PARAMS);
+
+  ctx->update_all = TRUE;
+
+  return binding_context_request_update_to_view(ctx);
+}
+
+ret_t binding_context_update_dirty_to_view(binding_context_t* ctx, const uint32_t* dirty,
+                                           uint32_t size) {
+  uint32_t i = 0;
+  return_value_if_fail(ctx != NULL && ctx->vt != NULL && ctx->vt->update_to_view != NULL,
+                       RET_BAD_PARAMS);
+  return_value_if_fail(dirty != NULL || size == 0, RET_BAD_PARAMS);
+
+  if (size > ctx->dirty_props_size) {
+    uint32_t* props = (uint32_t*)TKMEM_REALLOC(ctx->dirty_props, size * sizeof(uint32_t));
+    return_value_if_fail(props != NULL, RET_OOM);
+
+    memset(props + ctx->dirty_props_size, 0x00, (size - ctx->dirty_props_size) * sizeof(uint32_t));
+    ctx->dirty_props = props;
+    ctx->dirty_props_size = size;
+  }
+
+  for (i = 0; i < size; i++) {
+    ctx->dirty_props[i] |= dirty[i];
+  }
+
+  return binding_context_request_update_to_view(ctx);
+}
+
+bool_t binding_context_is_prop_dirty(binding_context_t* ctx, int32_t prop_id) {
+  uint32_t index = 0;
+  return_value_if_fail(ctx != NULL, TRUE);
+
+  if (ctx->update_all || prop_id < 0) {
+    return TRUE;
+  }
+
+  index = (uint32_t)prop_id / 32;
+  if (index >= ctx->dirty_props_size) {
+    return FALSE;
+  }
+
+  return (ctx->dirty_props[index] & (1u << (prop_id % 32))) != 0;
+}
+
+ret_t binding_context_clear_dirty_props(binding_context_t* ctx) {
+  return_value_if_fail(ctx != NULL, RET_BAD_PARAMS);
+
+  ctx->update_all = FALSE;
+  if (ctx->dirty_props != NULL) {
+    memset(ctx->dirty_props, 0x00, ctx->dirty_props_size * sizeof(uint32_t));
+  }
+
+  return RET_OK;
+}
+
 ret_t binding_context_update_to_model(binding_context_t* ctx) {
   ret_t ret = RET_OK;
   return_value_if_fail(ctx != NULL && ctx->vt != NULL && ctx->vt->update_to_model != NULL,
@@ -80,6 +139,8 @@ ret_t binding_context_destroy(binding_context_t* ctx) {
 
   darray_deinit(&(ctx->data_bindings));
   darray_deinit(&(ctx->command_bindings));
+  TKMEM_FREE(ctx->dirty_props);
+  ctx->dirty_props_size = 0;
 
   if (ctx->navigator_request != NULL) {
     object_unref(OBJECT(ctx->navigator_request));
@@ -128,6 +128,12 @@ struct _binding_context_t {
   /*列表绑定的模板*/
   void* template_widget;
 
+  /*等待刷新的属性ID集合，update_all为TRUE时刷新全部数据绑定*/
+  uint32_t* dirty_props;
+  uint32_t dirty_props_size;
+  bool_t update_all;
+  bool_t dirty_props_received;
+
   const binding_context_vtable_t* vt;
 };
 
@@ -155,6 +161,41 @@ ret_t binding_context_init(binding_context_t* ctx, navigator_request_t* req, vie
  */
 ret_t binding_context_update_to_view(binding_context_t* ctx);
 
+/**
+ * @method binding_context_update_dirty_to_view
+ * 只把指定的属性更新到视图。
+ * 脏属性集合会累积到下次更新完成，之后由binding_context_clear_dirty_props清除。
+ *
+ * @param {binding_context_t*} ctx binding_context对象。
+ * @param {const uint32_t*} dirty 按属性ID索引的位集合。
+ * @param {uint32_t} size 位集合的长度(uint32_t的个数)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t binding_context_update_dirty_to_view(binding_context_t* ctx, const uint32_t* dirty,
+                                           uint32_t size);
+
+/**
+ * @method binding_context_is_prop_dirty
+ * 检查指定属性的数据绑定是否需要刷新。
+ *
+ * @param {binding_context_t*} ctx binding_context对象。
+ * @param {int32_t} prop_id 属性ID(VIEW_MODEL_PROP_ID_INVALID表示未知，总是需要刷新)。
+ *
+ * @return {bool_t} 返回TRUE表示需要刷新，否则表示不需要。
+ */
+bool_t binding_context_is_prop_dirty(binding_context_t* ctx, int32_t prop_id);
+
+/**
+ * @method binding_context_clear_dirty_props
+ * 更新视图完成后，清除等待刷新的属性集合。
+ *
+ * @param {binding_context_t*} ctx binding_context对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t binding_context_clear_dirty_props(binding_context_t* ctx);
+
 /**
  * @method binding_context_exec
  * 执行内置命令。
@@ -23,6 +23,7 @@
 #include "tkc/tokenizer.h"
 #include "mvvm/base/data_binding.h"
 #include "mvvm/base/command_binding.h"
+#include "mvvm/base/navigator_trace.h"
 #include "mvvm/base/binding_rule_parser.h"
 
 /*
@@ -98,6 +99,7 @@ binding_rule_t* binding_rule_parse(const char* name, const char* value, bool_t i
   const char* v = NULL;
   char key[TK_NAME_LEN + 1];
   binding_rule_t* rule = NULL;
+  uint64_t start = navigator_trace_now();
   return_value_if_fail(name != NULL && value != NULL, NULL);
 
   rule = binding_rule_create(name, inputable);
@@ -129,6 +131,7 @@ binding_rule_t* binding_rule_parse(const char* name, const char* value, bool_t i
   }
 
   tokenizer_deinit(&t);
+  navigator_trace_accumulate(NAVIGATOR_TRACE_RULE_PARSE, start);
 
   return rule;
 }
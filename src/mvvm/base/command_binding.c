@@ -69,6 +69,8 @@ static ret_t command_binding_set_prop(object_t* obj, const char* name, const val
     rule->quit_app = value != NULL ? tk_atob(value) : TRUE;
   } else if (equal(COMMAND_BINDING_UPDATE_VIEW_MODEL, name)) {
     rule->update_model = value != NULL ? tk_atob(value) : TRUE;
+  } else if (equal(COMMAND_BINDING_PREFETCH, name)) {
+    rule->prefetch = value != NULL ? tk_atob(value) : TRUE;
   } else {
     if (rule->props == NULL) {
       rule->props = object_default_create();
@@ -96,6 +98,8 @@ static ret_t command_binding_get_prop(object_t* obj, const char* name, value_t*
     value_set_bool(v, rule->quit_app);
   } else if (equal(COMMAND_BINDING_UPDATE_VIEW_MODEL, name)) {
     value_set_bool(v, rule->update_model);
+  } else if (equal(COMMAND_BINDING_PREFETCH, name)) {
+    value_set_bool(v, rule->prefetch);
   } else {
     ret = object_get_prop(rule->props, name, v);
   }
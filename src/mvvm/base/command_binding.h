@@ -93,6 +93,13 @@ typedef struct _command_binding_t {
    */
   bool_t auto_disable;
 
+  /**
+   * @property {bool_t} prefetch
+   * @annotation ["readable"]
+   * 对于navigate命令，是否在绑定之后空闲时预取目标窗口。
+   */
+  bool_t prefetch;
+
   /*private*/
   shortcut_t filter;
 } command_binding_t;
@@ -137,6 +144,7 @@ ret_t command_binding_exec(command_binding_t* rule);
 #define COMMAND_BINDING_QUIT_APP "QuitApp"
 #define COMMAND_BINDING_AUTO_DISABLE "AutoDisable"
 #define COMMAND_BINDING_CLOSE_WINDOW "CloseWindow"
+#define COMMAND_BINDING_PREFETCH "Prefetch"
 #define COMMAND_BINDING_UPDATE_VIEW_MODEL "UpdateModel"
 
 #define COMMAND_BINDING_EVENT "Event"
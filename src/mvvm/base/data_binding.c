@@ -148,6 +148,7 @@ data_binding_t* data_binding_create(void) {
   return_value_if_fail(obj != NULL, NULL);
 
   rule->mode = BINDING_ONE_WAY;
+  rule->prop_id = VIEW_MODEL_PROP_ID_INVALID;
   rule->props = object_default_create();
 
   if (rule->props == NULL) {
@@ -244,8 +245,32 @@ static ret_t value_fix(view_model_t* view_model, const char* name, value_t* valu
   return ret;
 }
 
-ret_t data_binding_get_prop(data_binding_t* rule, value_t* v) {
-  value_t raw;
+ret_t data_binding_resolve_prop_id(data_binding_t* rule) {
+  view_model_t* view_model = NULL;
+  return_value_if_fail(rule != NULL, RET_BAD_PARAMS);
+
+  view_model = BINDING_RULE_VIEW_MODEL(rule);
+  return_value_if_fail(view_model != NULL, RET_BAD_PARAMS);
+
+  rule->prop_id = VIEW_MODEL_PROP_ID_INVALID;
+  if (rule->path != NULL && tk_is_valid_prop_name(rule->path)) {
+    rule->prop_id = view_model_get_prop_id(view_model, rule->path);
+  }
+
+  return RET_OK;
+}
+
+bool_t data_binding_is_cursor(data_binding_t* rule) {
+  view_model_t* view_model = NULL;
+  return_value_if_fail(rule != NULL, FALSE);
+
+  view_model = BINDING_RULE_VIEW_MODEL(rule);
+  return_value_if_fail(view_model != NULL, FALSE);
+
+  return object_is_collection(OBJECT(view_model)) && tk_str_eq(rule->path, VIEW_MODEL_PROP_CURSOR);
+}
+
+ret_t data_binding_get_raw_prop(data_binding_t* rule, value_t* v) {
   view_model_t* view_model = NULL;
   return_value_if_fail(rule != NULL && v != NULL, RET_BAD_PARAMS);
 
@@ -263,19 +288,45 @@ ret_t data_binding_get_prop(data_binding_t* rule, value_t* v) {
     }
   }
 
-  return_value_if_fail(view_model_eval(view_model, rule->path, &raw) == RET_OK, RET_FAIL);
+  if (rule->prop_id != VIEW_MODEL_PROP_ID_INVALID) {
+    return_value_if_fail(view_model_get_prop_by_id(view_model, rule->prop_id, v) == RET_OK,
+                         RET_FAIL);
+  } else {
+    return_value_if_fail(view_model_eval(view_model, rule->path, v) == RET_OK, RET_FAIL);
+  }
+
+  return RET_OK;
+}
+
+ret_t data_binding_get_prop(data_binding_t* rule, value_t* v) {
+  value_t raw;
+  return_value_if_fail(rule != NULL && v != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(data_binding_get_raw_prop(rule, &raw) == RET_OK, RET_FAIL);
+
+  if (data_binding_is_cursor(rule)) {
+    *v = raw;
+
+    return RET_OK;
+  }
 
   return value_to_view(rule->converter, &raw, v);
 }
 
-static ret_t vm_set_prop(view_model_t* vm, const char* converter, const char* path,
-                         const value_t* raw) {
-  if (converter == NULL) {
-    return view_model_set_prop(vm, path, raw);
+static ret_t vm_set_prop_value(view_model_t* vm, data_binding_t* rule, const value_t* v) {
+  if (rule->prop_id != VIEW_MODEL_PROP_ID_INVALID) {
+    return view_model_set_prop_by_id(vm, rule->prop_id, v);
+  } else {
+    return view_model_set_prop(vm, rule->path, v);
+  }
+}
+
+static ret_t vm_set_prop(view_model_t* vm, data_binding_t* rule, const value_t* raw) {
+  if (rule->converter == NULL) {
+    return vm_set_prop_value(vm, rule, raw);
   } else {
     value_t v;
-    if (value_to_model(converter, raw, &v) == RET_OK) {
-      return view_model_set_prop(vm, path, &v);
+    if (value_to_model(rule->converter, raw, &v) == RET_OK) {
+      return vm_set_prop_value(vm, rule, &v);
     } else {
       return RET_FAIL;
     }
@@ -301,7 +352,7 @@ ret_t data_binding_set_prop(data_binding_t* rule, const value_t* raw) {
     value_deep_copy(&fix_value, raw);
 
     if (value_fix(view_model, rule->validator, &fix_value) == RET_OK) {
-      ret_t ret = vm_set_prop(view_model, rule->converter, rule->path, &fix_value);
+      ret_t ret = vm_set_prop(view_model, rule, &fix_value);
       value_reset(&fix_value);
 
       return ret;
@@ -311,5 +362,5 @@ ret_t data_binding_set_prop(data_binding_t* rule, const value_t* raw) {
     return RET_BAD_PARAMS;
   }
 
-  return vm_set_prop(view_model, rule->converter, rule->path, raw);
+  return vm_set_prop(view_model, rule, raw);
 }
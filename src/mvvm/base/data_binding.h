@@ -138,6 +138,9 @@ typedef struct _data_binding_t {
    * 触发更新模型的时机。
    */
   update_model_trigger_t trigger;
+
+  /*private*/
+  int32_t prop_id;
 } data_binding_t;
 
 /**
@@ -149,6 +152,38 @@ typedef struct _data_binding_t {
  */
 data_binding_t* data_binding_create(void);
 
+/**
+ * @method data_binding_resolve_prop_id
+ * 绑定时把path解析为模型的属性ID。
+ * 模型支持属性ID时，之后读写属性不再比较字符串，否则仍然按名称访问。
+ *
+ * @param {data_binding_t*} rule 绑定规则对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t data_binding_resolve_prop_id(data_binding_t* rule);
+
+/**
+ * @method data_binding_is_cursor
+ * 检查是否绑定到集合模型的当前行号(行号不需要转换)。
+ *
+ * @param {data_binding_t*} rule 绑定规则对象。
+ *
+ * @return {bool_t} 返回TRUE表示绑定到当前行号，否则表示不是。
+ */
+bool_t data_binding_is_cursor(data_binding_t* rule);
+
+/**
+ * @method data_binding_get_raw_prop
+ * 从模型中获取属性值，不经过转换器转换(用于批量转换)。
+ *
+ * @param {data_binding_t*} rule 绑定规则对象。
+ * @param {value_t*} v 值对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t data_binding_get_raw_prop(data_binding_t* rule, value_t* v);
+
 /**
  * @method data_binding_get_prop
  * 从模型中获取属性值。
@@ -24,6 +24,7 @@
 ret_t mvvm_base_init(void) {
   return_value_if_fail(view_model_factory_init() == RET_OK, RET_FAIL);
   return_value_if_fail(value_converter_init() == RET_OK, RET_FAIL);
+  return_value_if_fail(value_converter_native_init() == RET_OK, RET_FAIL);
   return_value_if_fail(value_validator_init() == RET_OK, RET_FAIL);
   navigator_set(navigator_create());
   return_value_if_fail(navigator() != NULL, RET_FAIL);
@@ -37,6 +38,7 @@ ret_t mvvm_base_deinit(void) {
   value_validator_deinit();
   object_unref(OBJECT(navigator()));
   navigator_set(NULL);
+  navigator_trace_deinit();
 
   return RET_OK;
 }
@@ -21,13 +21,13 @@
 
 #include "tkc/value.h"
 #include "tkc/utils.h"
-#include "tkc/object_default.h"
 #include "mvvm/base/navigator.h"
+#include "mvvm/base/navigator_trace.h"
 
 static ret_t navigator_on_destroy(object_t* obj) {
   navigator_t* nav = NAVIGATOR(obj);
 
-  object_unref(OBJECT(nav->handlers));
+  registry_deinit(&(nav->handlers));
 
   return RET_OK;
 }
@@ -46,11 +46,7 @@ navigator_t* navigator_create(void) {
   nav = NAVIGATOR(obj);
   return_value_if_fail(obj != NULL, NULL);
 
-  nav->handlers = object_default_create();
-  if (nav->handlers == NULL) {
-    object_unref(obj);
-    obj = NULL;
-  }
+  registry_init(&(nav->handlers), (tk_destroy_t)object_unref);
 
   return nav;
 }
@@ -58,16 +54,17 @@ navigator_t* navigator_create(void) {
 static navigator_handler_t* navigator_find_handler(navigator_t* nav, const char* target) {
   navigator_handler_t* handler = NULL;
   return_value_if_fail(nav != NULL && target != NULL, NULL);
-  handler = (navigator_handler_t*)object_get_prop_object(nav->handlers, target);
+  handler = (navigator_handler_t*)registry_get(&(nav->handlers), target);
   if (handler == NULL) {
-    handler =
-        (navigator_handler_t*)object_get_prop_object(nav->handlers, NAVIGATOR_DEFAULT_HANDLER);
+    handler = (navigator_handler_t*)registry_get(&(nav->handlers), NAVIGATOR_DEFAULT_HANDLER);
   }
 
   return handler;
 }
 
 ret_t navigator_handle_request(navigator_t* nav, navigator_request_t* req) {
+  ret_t ret = RET_OK;
+  uint64_t start = 0;
   navigator_handler_t* handler = NULL;
   return_value_if_fail(nav != NULL && req != NULL, RET_BAD_PARAMS);
 
@@ -81,16 +78,50 @@ ret_t navigator_handle_request(navigator_t* nav, navigator_request_t* req) {
   }
   return_value_if_fail(handler != NULL, RET_NOT_FOUND);
 
-  return navigator_handler_on_request(handler, req);
+  /*只跟踪打开窗口的请求，toast和对话框不覆盖最近一次的记录*/
+  if (!navigator_request_is_dialog(req)) {
+    start = navigator_trace_begin(req->target);
+  }
+
+  ret = navigator_handler_on_request(handler, req);
+
+  if (start != 0) {
+    navigator_trace_add(NAVIGATOR_TRACE_HANDLE_REQUEST, start);
+    navigator_trace_end();
+  }
+
+  return ret;
+}
+
+ret_t navigator_handle_prefetch(navigator_t* nav, navigator_request_t* req) {
+  navigator_handler_t* handler = NULL;
+  return_value_if_fail(nav != NULL && req != NULL, RET_BAD_PARAMS);
+
+  handler = navigator_find_handler(nav, req->target);
+  return_value_if_fail(handler != NULL, RET_NOT_FOUND);
+
+  return navigator_handler_on_prefetch(handler, req);
+}
+
+ret_t navigator_handle_close(navigator_t* nav, navigator_request_t* req) {
+  navigator_handler_t* handler = NULL;
+  return_value_if_fail(nav != NULL && req != NULL, RET_BAD_PARAMS);
+
+  handler = navigator_find_handler(nav, req->target);
+  return_value_if_fail(handler != NULL, RET_NOT_FOUND);
+
+  return navigator_handler_on_close(handler, req);
 }
 
 ret_t navigator_register_handler(navigator_t* nav, const char* name, navigator_handler_t* handler) {
   ret_t ret = RET_OK;
   return_value_if_fail(nav != NULL && name != NULL && handler != NULL, RET_BAD_PARAMS);
 
-  ret = object_set_prop_object(nav->handlers, name, OBJECT(handler));
-  assert(OBJECT(handler)->ref_count > 1);
-  object_unref(OBJECT(handler));
+  /*注册表接管handler的引用*/
+  ret = registry_set(&(nav->handlers), name, handler);
+  if (ret != RET_OK) {
+    object_unref(OBJECT(handler));
+  }
 
   log_debug("navigator_register_handler ret=%d : %s\n", ret, name);
 
@@ -100,13 +131,13 @@ ret_t navigator_register_handler(navigator_t* nav, const char* name, navigator_h
 bool_t navigator_has_handler(navigator_t* nav, const char* name) {
   return_value_if_fail(nav != NULL && name != NULL, RET_BAD_PARAMS);
 
-  return object_get_prop_object(nav->handlers, name) != NULL;
+  return registry_has(&(nav->handlers), name);
 }
 
 ret_t navigator_unregister_handler(navigator_t* nav, const char* name) {
   return_value_if_fail(nav != NULL && name != NULL, RET_BAD_PARAMS);
 
-  object_remove_prop(OBJECT(nav->handlers), name);
+  registry_remove(&(nav->handlers), name);
 
   return RET_OK;
 }
@@ -140,6 +171,24 @@ ret_t navigator_to_ex(navigator_request_t* req) {
   return navigator_handle_request(navigator(), req);
 }
 
+ret_t navigator_prefetch(const char* target) {
+  ret_t ret = RET_OK;
+  navigator_request_t* req = NULL;
+  return_value_if_fail(target != NULL && navigator() != NULL, RET_BAD_PARAMS);
+
+  req = navigator_request_create(target, NULL);
+  return_value_if_fail(req != NULL, RET_OOM);
+
+  ret = navigator_handle_prefetch(navigator(), req);
+  object_unref(OBJECT(req));
+
+  return ret;
+}
+
+ret_t navigator_prefetch_ex(navigator_request_t* req) {
+  return navigator_handle_prefetch(navigator(), req);
+}
+
 ret_t navigator_toast(const char* content, uint32_t timeout) {
   ret_t ret = RET_OK;
   navigator_request_t* req = NULL;
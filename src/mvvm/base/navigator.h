@@ -23,6 +23,7 @@
 #define TK_NAVIGATOR_H
 
 #include "tkc/str.h"
+#include "mvvm/base/registry.h"
 #include "mvvm/base/navigator_request.h"
 #include "mvvm/base/navigator_handler.h"
 
@@ -44,7 +45,7 @@ struct _navigator_t {
   object_t object;
 
   /*private*/
-  object_t* handlers;
+  registry_t handlers;
 };
 
 /**
@@ -88,6 +89,29 @@ ret_t navigator_set(navigator_t* nav);
  */
 ret_t navigator_handle_request(navigator_t* nav, navigator_request_t* req);
 
+/**
+ * @method navigator_handle_prefetch
+ * 处理预取窗口的请求。
+ *
+ * @param {navigator_t*} nav navigator对象。
+ * @param {navigator_request_t*} req request对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t navigator_handle_prefetch(navigator_t* nav, navigator_request_t* req);
+
+/**
+ * @method navigator_handle_close
+ * 处理关闭窗口的请求(窗口由参数NAVIGATOR_ARG_VIEW指定)。
+ * 请求处理器可以缓存窗口，再次打开时直接显示。
+ *
+ * @param {navigator_t*} nav navigator对象。
+ * @param {navigator_request_t*} req request对象。
+ *
+ * @return {ret_t} 返回RET_OK表示已经处理，返回RET_NOT_IMPL时由调用者直接关闭窗口。
+ */
+ret_t navigator_handle_close(navigator_t* nav, navigator_request_t* req);
+
 /**
  * @method navigator_register_handler
  * 注册请求处理器。
@@ -147,6 +171,33 @@ ret_t navigator_to(const char* target);
  */
 ret_t navigator_to_ex(navigator_request_t* req);
 
+/**
+ * @method navigator_prefetch
+ * 请求在空闲时预取指定的窗口，之后打开该窗口时不必再从存储中加载资源。
+ *
+ *> 预取是一个提示，请求处理器不支持预取或者预取失败时，打开窗口的行为不变。
+ *
+ * @annotation ["static"]
+ *
+ * @param {const char*} target 目标窗口的名称。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t navigator_prefetch(const char* target);
+
+/**
+ * @method navigator_prefetch_ex
+ * 请求在空闲时预取指定的窗口。
+ * 可以用参数NAVIGATOR_ARG_VMODEL指定窗口的view model(如"temperature.js")，一起预取它的脚本。
+ *
+ * @annotation ["static"]
+ *
+ * @param {navigator_request_t*} req request对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t navigator_prefetch_ex(navigator_request_t* req);
+
 /**
  * @method navigator_toast
  * 显示toast信息。
@@ -49,3 +49,23 @@ ret_t navigator_handler_on_request(navigator_handler_t* handler, navigator_reque
 
   return handler->on_request(handler, req);
 }
+
+ret_t navigator_handler_on_prefetch(navigator_handler_t* handler, navigator_request_t* req) {
+  return_value_if_fail(handler != NULL && req != NULL, RET_BAD_PARAMS);
+
+  if (handler->on_prefetch == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  return handler->on_prefetch(handler, req);
+}
+
+ret_t navigator_handler_on_close(navigator_handler_t* handler, navigator_request_t* req) {
+  return_value_if_fail(handler != NULL && req != NULL, RET_BAD_PARAMS);
+
+  if (handler->on_close == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  return handler->on_close(handler, req);
+}
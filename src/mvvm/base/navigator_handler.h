@@ -44,6 +44,8 @@ struct _navigator_handler_t {
 
   /*private*/
   navigator_handler_on_request_t on_request;
+  navigator_handler_on_request_t on_prefetch;
+  navigator_handler_on_request_t on_close;
 };
 
 /**
@@ -70,6 +72,28 @@ navigator_handler_t* navigator_handler_create(navigator_handler_on_request_t on_
  */
 ret_t navigator_handler_on_request(navigator_handler_t* handler, navigator_request_t* req);
 
+/**
+ * @method navigator_handler_on_prefetch
+ * 调用本函数预取请求的目标窗口(不打开窗口)。
+ *
+ * @param {navigator_handler_t*} handler handler对象。
+ * @param {navigator_request_t*} req 预取请求。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，不支持预取时返回RET_NOT_IMPL。
+ */
+ret_t navigator_handler_on_prefetch(navigator_handler_t* handler, navigator_request_t* req);
+
+/**
+ * @method navigator_handler_on_close
+ * 调用本函数关闭请求中NAVIGATOR_ARG_VIEW指定的窗口。
+ *
+ * @param {navigator_handler_t*} handler handler对象。
+ * @param {navigator_request_t*} req 关闭请求。
+ *
+ * @return {ret_t} 返回RET_OK表示已经处理，返回RET_NOT_IMPL时由调用者直接关闭窗口。
+ */
+ret_t navigator_handler_on_close(navigator_handler_t* handler, navigator_request_t* req);
+
 #define NAVIGATOR_HANDLER(handler) ((navigator_handler_t*)(handler))
 
 #define NAVIGATOR_DEFAULT_HANDLER "default_handler"
@@ -100,3 +100,45 @@ ret_t navigator_request_on_result(navigator_request_t* req, const value_t* resul
 
   return RET_OK;
 }
+
+static ret_t visit_count_arg(void* ctx, const void* data) {
+  const named_value_t* nv = (const named_value_t*)data;
+
+  if (!tk_str_eq(nv->name, NAVIGATOR_ARG_VIEW)) {
+    *(uint32_t*)ctx += 1;
+  }
+
+  return RET_OK;
+}
+
+bool_t navigator_request_is_plain(navigator_request_t* req) {
+  uint32_t nr = 0;
+  return_value_if_fail(req != NULL, FALSE);
+
+  if (req->on_result != NULL) {
+    return FALSE;
+  }
+
+  object_foreach_prop(req->args, visit_count_arg, &nr);
+
+  return nr == 0;
+}
+
+static const char* s_dialog_requests[] = {
+    NAVIGATOR_REQ_TOAST,     NAVIGATOR_REQ_INFO,       NAVIGATOR_REQ_WARN,
+    NAVIGATOR_REQ_CONFIRM,   NAVIGATOR_REQ_INPUT_TEXT, NAVIGATOR_REQ_INPUT_FLOAT,
+    NAVIGATOR_REQ_INPUT_INT, NAVIGATOR_REQ_PICK_COLOR, NAVIGATOR_REQ_PICK_FILE,
+    NAVIGATOR_REQ_PICK_DIR};
+
+bool_t navigator_request_is_dialog(navigator_request_t* req) {
+  uint32_t i = 0;
+  return_value_if_fail(req != NULL && req->target != NULL, FALSE);
+
+  for (i = 0; i < ARRAY_SIZE(s_dialog_requests); i++) {
+    if (tk_str_eq(req->target, s_dialog_requests[i])) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
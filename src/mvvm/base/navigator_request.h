@@ -96,6 +96,28 @@ navigator_request_t* navigator_request_create(const char* target,
  */
 ret_t navigator_request_on_result(navigator_request_t* req, const value_t* result);
 
+/**
+ * @method navigator_request_is_plain
+ * 检查请求是否既没有参数(NAVIGATOR_ARG_VIEW除外)，也不需要返回结果。
+ * 这样的请求打开的窗口只取决于窗口的名称(如navigate命令)。
+ *
+ * @param {navigator_request_t*} req request对象。
+ *
+ * @return {bool_t} 返回TRUE表示是，否则表示不是。
+ */
+bool_t navigator_request_is_plain(navigator_request_t* req);
+
+/**
+ * @method navigator_request_is_dialog
+ * 检查请求是否是内置的提示或对话框(toast/info/warn/confirm/input_xxx/pick_xxx)，
+ * 而不是打开一个普通的窗口。
+ *
+ * @param {navigator_request_t*} req request对象。
+ *
+ * @return {bool_t} 返回TRUE表示是，否则表示不是。
+ */
+bool_t navigator_request_is_dialog(navigator_request_t* req);
+
 #define NAVIGATOR_REQUEST(req) ((navigator_request_t*)(req))
 
 #define NAVIGATOR_REQ_TOAST "toast"
@@ -121,6 +143,7 @@ ret_t navigator_request_on_result(navigator_request_t* req, const value_t* resul
 #define NAVIGATOR_ARG_FOR_SAVE "for_save"
 #define NAVIGATOR_ARG_MINE_TYPES "mime_types"
 #define NAVIGATOR_ARG_VIEW "__view__"
+#define NAVIGATOR_ARG_VMODEL "vmodel"
 
 END_C_DECLS
 
@@ -0,0 +1,295 @@
+﻿/**
+ * File:   navigator_trace.c
+ * Author: AWTK Develop Team
+ * Brief:  navigation latency trace
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#include "tkc/fs.h"
+#include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "mvvm/base/navigator_trace.h"
+
+#define NAVIGATOR_TRACE_PID 1
+#define NAVIGATOR_TRACE_TID 1
+/*累计的阶段不是连续的区间，放在单独的一行显示*/
+#define NAVIGATOR_TRACE_TID_ACCUMULATED 2
+
+typedef struct _navigator_tracer_t {
+  bool_t enabled;
+  bool_t active;
+  bool_t has_last;
+  uint32_t depth;
+  void* deferred_view;
+  uint64_t deferred_at;
+  navigator_trace_t current;
+  navigator_trace_t last;
+
+  fs_file_t* file;
+  uint32_t events;
+} navigator_tracer_t;
+
+static navigator_tracer_t s_tracer;
+
+/*JSON字符串中的引号、反斜杠和控制字符需要转义(每个字符最多6个字节)*/
+static const char* navigator_trace_escape(const char* str, char* buff, uint32_t size) {
+  char* d = buff;
+  const char* s = str;
+
+  while (*s != '\0' && d + 7 <= buff + size) {
+    if (*s == '"' || *s == '\\') {
+      *d++ = '\\';
+      *d++ = *s;
+    } else if ((uint8_t)(*s) < 0x20) {
+      tk_snprintf(d, 7, "\\u%04x", (uint8_t)(*s));
+      d += 6;
+    } else {
+      *d++ = *s;
+    }
+    s++;
+  }
+  *d = '\0';
+
+  return buff;
+}
+
+static ret_t navigator_trace_write_event(const char* name, const char* cat, uint32_t tid,
+                                         uint64_t start, uint64_t duration, uint32_t count) {
+  int32_t len = 0;
+  char buff[512];
+  char escaped[6 * TK_NAME_LEN + 1];
+
+  len = tk_snprintf(buff, sizeof(buff),
+                    "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%u,"
+                    "\"ts\":%.0f,\"dur\":%u,\"args\":{\"count\":%u}}",
+                    s_tracer.events > 0 ? ",\n" : "",
+                    navigator_trace_escape(name, escaped, sizeof(escaped)), cat,
+                    NAVIGATOR_TRACE_PID, tid, (double)start, (uint32_t)duration, count);
+  return_value_if_fail(len > 0 && len < (int32_t)sizeof(buff), RET_FAIL);
+  return_value_if_fail(fs_file_write(s_tracer.file, buff, len) == len, RET_IO);
+  s_tracer.events++;
+
+  return RET_OK;
+}
+
+static ret_t navigator_trace_write(const navigator_trace_t* trace) {
+  uint32_t i = 0;
+  const navigator_trace_point_t* point = NULL;
+
+  navigator_trace_write_event(trace->target, "navigate", NAVIGATOR_TRACE_TID, trace->start,
+                              trace->duration, 1);
+
+  for (i = 0; i < trace->points_nr; i++) {
+    point = trace->points + i;
+    navigator_trace_write_event(
+        point->name, "mvvm", point->count > 1 ? NAVIGATOR_TRACE_TID_ACCUMULATED : NAVIGATOR_TRACE_TID,
+        point->start, point->duration, point->count);
+  }
+
+  return RET_OK;
+}
+
+static ret_t navigator_trace_finish(void) {
+  navigator_trace_t* trace = &(s_tracer.current);
+
+  trace->duration = time_now_us() - trace->start;
+  memcpy(&(s_tracer.last), trace, sizeof(navigator_trace_t));
+  s_tracer.has_last = TRUE;
+  s_tracer.active = FALSE;
+  s_tracer.deferred_view = NULL;
+  s_tracer.depth = 0;
+
+  if (s_tracer.file != NULL) {
+    navigator_trace_write(trace);
+  }
+
+  return RET_OK;
+}
+
+static navigator_trace_point_t* navigator_trace_find(const char* name) {
+  uint32_t i = 0;
+  navigator_trace_t* trace = &(s_tracer.current);
+
+  for (i = 0; i < trace->points_nr; i++) {
+    if (tk_str_eq(trace->points[i].name, name)) {
+      return trace->points + i;
+    }
+  }
+
+  return NULL;
+}
+
+ret_t navigator_trace_enable(bool_t enable) {
+  if (!enable && s_tracer.active) {
+    s_tracer.active = FALSE;
+  }
+  s_tracer.enabled = enable;
+
+  return RET_OK;
+}
+
+ret_t navigator_trace_set_file(const char* filename) {
+  if (s_tracer.file != NULL) {
+    fs_file_write(s_tracer.file, "\n]\n", 3);
+    fs_file_close(s_tracer.file);
+    s_tracer.file = NULL;
+  }
+
+  if (filename != NULL) {
+    s_tracer.file = fs_open_file(os_fs(), filename, "wb");
+    return_value_if_fail(s_tracer.file != NULL, RET_IO);
+
+    s_tracer.events = 0;
+    fs_file_write(s_tracer.file, "[\n", 2);
+    s_tracer.enabled = TRUE;
+  }
+
+  return RET_OK;
+}
+
+const navigator_trace_t* navigator_trace_get_last(void) {
+  return s_tracer.has_last ? &(s_tracer.last) : NULL;
+}
+
+uint64_t navigator_trace_begin(const char* target) {
+  navigator_trace_t* trace = &(s_tracer.current);
+
+  if (!s_tracer.enabled || target == NULL) {
+    return 0;
+  }
+
+  if (s_tracer.active) {
+    if (s_tracer.deferred_view == NULL) {
+      s_tracer.depth++;
+
+      return time_now_us();
+    }
+
+    /*上一个窗口一直没有绘制(比如很快就被关闭了)，记录到此为止*/
+    navigator_trace_finish();
+  }
+
+  memset(trace, 0x00, sizeof(navigator_trace_t));
+  tk_strncpy(trace->target, target, TK_NAME_LEN);
+  trace->start = time_now_us();
+  s_tracer.active = TRUE;
+  s_tracer.deferred_view = NULL;
+  s_tracer.depth = 1;
+
+  return trace->start;
+}
+
+uint64_t navigator_trace_now(void) {
+  return s_tracer.active ? time_now_us() : 0;
+}
+
+ret_t navigator_trace_add(const char* name, uint64_t start) {
+  navigator_trace_point_t* point = NULL;
+  navigator_trace_t* trace = &(s_tracer.current);
+  return_value_if_fail(name != NULL, RET_BAD_PARAMS);
+
+  if (!s_tracer.active || start == 0 || trace->points_nr >= NAVIGATOR_TRACE_MAX_POINTS) {
+    return RET_OK;
+  }
+
+  point = trace->points + trace->points_nr++;
+  point->name = name;
+  point->start = start;
+  point->duration = time_now_us() - start;
+  point->count = 1;
+
+  return RET_OK;
+}
+
+ret_t navigator_trace_accumulate(const char* name, uint64_t start) {
+  navigator_trace_point_t* point = NULL;
+  return_value_if_fail(name != NULL, RET_BAD_PARAMS);
+
+  if (!s_tracer.active || start == 0) {
+    return RET_OK;
+  }
+
+  point = navigator_trace_find(name);
+  if (point == NULL) {
+    return navigator_trace_add(name, start);
+  }
+
+  point->duration += time_now_us() - start;
+  point->count++;
+
+  return RET_OK;
+}
+
+bool_t navigator_trace_is_active(void) {
+  return s_tracer.active;
+}
+
+ret_t navigator_trace_end(void) {
+  if (!s_tracer.active) {
+    return RET_OK;
+  }
+
+  if (s_tracer.depth > 0) {
+    s_tracer.depth--;
+  }
+
+  if (s_tracer.depth == 0 && s_tracer.deferred_view == NULL) {
+    navigator_trace_finish();
+  }
+
+  return RET_OK;
+}
+
+ret_t navigator_trace_defer_end(void* view) {
+  return_value_if_fail(view != NULL, RET_BAD_PARAMS);
+
+  if (s_tracer.active) {
+    s_tracer.deferred_view = view;
+    s_tracer.deferred_at = time_now_us();
+  }
+
+  return RET_OK;
+}
+
+ret_t navigator_trace_end_deferred(void* view) {
+  if (!s_tracer.active || s_tracer.deferred_view == NULL || s_tracer.deferred_view != view) {
+    return RET_OK;
+  }
+
+  navigator_trace_add(NAVIGATOR_TRACE_FIRST_PAINT, s_tracer.deferred_at);
+
+  return navigator_trace_finish();
+}
+
+ret_t navigator_trace_cancel_deferred(void* view) {
+  if (!s_tracer.active || s_tracer.deferred_view == NULL || s_tracer.deferred_view != view) {
+    return RET_OK;
+  }
+
+  /*视图没有绘制就销毁了，记录到此为止，不再引用它*/
+  return navigator_trace_finish();
+}
+
+ret_t navigator_trace_deinit(void) {
+  if (s_tracer.active) {
+    navigator_trace_finish();
+  }
+  navigator_trace_set_file(NULL);
+  memset(&s_tracer, 0x00, sizeof(s_tracer));
+
+  return RET_OK;
+}
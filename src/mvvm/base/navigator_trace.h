@@ -0,0 +1,242 @@
+﻿/**
+ * File:   navigator_trace.h
+ * Author: AWTK Develop Team
+ * Brief:  navigation latency trace
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#ifndef TK_NAVIGATOR_TRACE_H
+#define TK_NAVIGATOR_TRACE_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+#define NAVIGATOR_TRACE_MAX_POINTS 32
+
+/**
+ * @class navigator_trace_point_t
+ * 一次导航中的一个阶段。
+ */
+typedef struct _navigator_trace_point_t {
+  /**
+   * @property {const char*} name
+   * @annotation ["readable"]
+   * 阶段的名称(NAVIGATOR_TRACE_XXX)。
+   */
+  const char* name;
+  /**
+   * @property {uint64_t} start
+   * @annotation ["readable"]
+   * 开始的时间(us)。
+   */
+  uint64_t start;
+  /**
+   * @property {uint64_t} duration
+   * @annotation ["readable"]
+   * 持续的时间(us)。
+   */
+  uint64_t duration;
+  /**
+   * @property {uint32_t} count
+   * @annotation ["readable"]
+   * 累计的次数。分散在多处的阶段(如解析绑定规则)只记录一项，duration为累计的时间。
+   */
+  uint32_t count;
+} navigator_trace_point_t;
+
+/**
+ * @class navigator_trace_t
+ *
+ * 导航的耗时跟踪。
+ *
+ * 启用之后，每次导航请求都生成一条记录，包含从navigator_handle_request开始，
+ * 到打开窗口、创建view model、解析绑定规则、绑定、第一次更新视图和第一次绘制完成的各个阶段。
+ *
+ * 最近一次的记录可以用navigator_trace_get_last获取，也可以写入文件
+ * (Chrome trace event格式，可以用chrome://tracing查看)。
+ *
+ * 没有启用时，各个跟踪点只检查一个标志，没有其它开销。
+ *
+ */
+typedef struct _navigator_trace_t {
+  /**
+   * @property {char*} target
+   * @annotation ["readable"]
+   * 目标窗口的名称。
+   */
+  char target[TK_NAME_LEN + 1];
+  /**
+   * @property {uint64_t} start
+   * @annotation ["readable"]
+   * 开始的时间(us)。
+   */
+  uint64_t start;
+  /**
+   * @property {uint64_t} duration
+   * @annotation ["readable"]
+   * 总的时间(us)。
+   */
+  uint64_t duration;
+  /**
+   * @property {uint32_t} points_nr
+   * @annotation ["readable"]
+   * 阶段的个数。
+   */
+  uint32_t points_nr;
+  /**
+   * @property {navigator_trace_point_t*} points
+   * @annotation ["readable"]
+   * 各个阶段(按结束的顺序)。
+   */
+  navigator_trace_point_t points[NAVIGATOR_TRACE_MAX_POINTS];
+} navigator_trace_t;
+
+/**
+ * @method navigator_trace_enable
+ * 启用或禁用导航跟踪。
+ *
+ * @param {bool_t} enable 是否启用。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t navigator_trace_enable(bool_t enable);
+
+/**
+ * @method navigator_trace_set_file
+ * 把每次导航的记录追加到指定的文件(Chrome trace event格式)，同时启用导航跟踪。
+ *
+ * @param {const char*} filename 文件名。为NULL时关闭之前的文件。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t navigator_trace_set_file(const char* filename);
+
+/**
+ * @method navigator_trace_get_last
+ * 获取最近一次完成的导航记录。
+ *
+ * @return {const navigator_trace_t*} 返回导航记录，没有时返回NULL。
+ */
+const navigator_trace_t* navigator_trace_get_last(void);
+
+/**
+ * @method navigator_trace_begin
+ * 导航请求开始。嵌套的请求(如创建view model时打开另一个窗口)并入外层的记录。
+ *
+ * @param {const char*} target 目标窗口的名称。
+ *
+ * @return {uint64_t} 返回当前时间(us)，没有启用时返回0。
+ */
+uint64_t navigator_trace_begin(const char* target);
+
+/**
+ * @method navigator_trace_now
+ * 获取当前时间，作为navigator_trace_add的参数。
+ *
+ * @return {uint64_t} 返回当前时间(us)，没有进行中的记录时返回0。
+ */
+uint64_t navigator_trace_now(void);
+
+/**
+ * @method navigator_trace_add
+ * 在进行中的记录中增加一个从start到现在的阶段。
+ *
+ * @param {const char*} name 阶段的名称(必须是常量字符串)。
+ * @param {uint64_t} start navigator_trace_now返回的时间，为0时忽略。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t navigator_trace_add(const char* name, uint64_t start);
+
+/**
+ * @method navigator_trace_accumulate
+ * 把从start到现在的时间累加到进行中的记录的同名阶段。
+ *
+ * @param {const char*} name 阶段的名称(必须是常量字符串)。
+ * @param {uint64_t} start navigator_trace_now返回的时间，为0时忽略。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t navigator_trace_accumulate(const char* name, uint64_t start);
+
+/**
+ * @method navigator_trace_is_active
+ * 检查是否有进行中的记录。
+ *
+ * @return {bool_t} 返回TRUE表示有进行中的记录。
+ */
+bool_t navigator_trace_is_active(void);
+
+/**
+ * @method navigator_trace_end
+ * 导航请求处理完成。嵌套的请求全部完成时结束进行中的记录，除非调用过navigator_trace_defer_end。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t navigator_trace_end(void);
+
+/**
+ * @method navigator_trace_defer_end
+ * 请求处理完成后不结束记录，等到指定的视图第一次绘制完成时再结束。
+ *
+ * @param {void*} view 视图(窗口)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t navigator_trace_defer_end(void* view);
+
+/**
+ * @method navigator_trace_end_deferred
+ * 视图第一次绘制完成，增加NAVIGATOR_TRACE_FIRST_PAINT阶段并结束记录。
+ *
+ * @param {void*} view 视图(窗口)。与navigator_trace_defer_end的参数不同时(记录已经结束)忽略。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t navigator_trace_end_deferred(void* view);
+
+/**
+ * @method navigator_trace_cancel_deferred
+ * 视图在第一次绘制之前就销毁了，结束记录(没有NAVIGATOR_TRACE_FIRST_PAINT阶段)。
+ *
+ * @param {void*} view 视图(窗口)。与navigator_trace_defer_end的参数不同时(记录已经结束)忽略。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t navigator_trace_cancel_deferred(void* view);
+
+/**
+ * @method navigator_trace_deinit
+ * 结束进行中的记录，并关闭跟踪文件。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t navigator_trace_deinit(void);
+
+#define NAVIGATOR_TRACE_HANDLE_REQUEST "handle_request"
+#define NAVIGATOR_TRACE_WINDOW_OPEN "window_open"
+#define NAVIGATOR_TRACE_VIEW_MODEL_CREATE "view_model_create"
+#define NAVIGATOR_TRACE_JS_LOAD "js_load"
+#define NAVIGATOR_TRACE_RULE_PARSE "rule_parse"
+#define NAVIGATOR_TRACE_BIND "bind"
+#define NAVIGATOR_TRACE_UPDATE_TO_VIEW "update_to_view"
+#define NAVIGATOR_TRACE_FIRST_PAINT "first_paint"
+
+END_C_DECLS
+
+#endif /*TK_NAVIGATOR_TRACE_H*/
@@ -0,0 +1,184 @@
+﻿/**
+ * File:   numeric_series.c
+ * Author: AWTK Develop Team
+ * Brief:  numeric series
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "mvvm/base/numeric_series.h"
+
+static ret_t numeric_series_on_destroy(object_t* obj) {
+  numeric_series_t* series = NUMERIC_SERIES(obj);
+
+  TKMEM_FREE(series->data);
+  series->size = 0;
+  series->capacity = 0;
+
+  return RET_OK;
+}
+
+static ret_t numeric_series_get_prop(object_t* obj, const char* name, value_t* v) {
+  numeric_series_t* series = NUMERIC_SERIES(obj);
+
+  if (tk_str_eq(name, NUMERIC_SERIES_PROP_SIZE)) {
+    value_set_uint32(v, series->size);
+  } else if (tk_str_eq(name, NUMERIC_SERIES_PROP_CAPACITY)) {
+    value_set_uint32(v, series->capacity);
+  } else if (tk_str_eq(name, NUMERIC_SERIES_PROP_DIRTY_START)) {
+    value_set_uint32(v, series->dirty_start);
+  } else if (tk_str_eq(name, NUMERIC_SERIES_PROP_DIRTY_END)) {
+    value_set_uint32(v, series->dirty_end);
+  } else {
+    return RET_NOT_FOUND;
+  }
+
+  return RET_OK;
+}
+
+static const object_vtable_t s_numeric_series_vtable = {.type = "numeric_series",
+                                                        .desc = "numeric_series",
+                                                        .size = sizeof(numeric_series_t),
+                                                        .is_collection = FALSE,
+                                                        .on_destroy = numeric_series_on_destroy,
+                                                        .get_prop = numeric_series_get_prop};
+
+numeric_series_t* numeric_series_create(uint32_t capacity) {
+  object_t* obj = object_create(&s_numeric_series_vtable);
+  numeric_series_t* series = NUMERIC_SERIES(obj);
+  return_value_if_fail(series != NULL, NULL);
+
+  if (capacity > 0 && numeric_series_extend(series, capacity) != RET_OK) {
+    object_unref(obj);
+    return NULL;
+  }
+
+  return series;
+}
+
+numeric_series_t* numeric_series_cast(object_t* obj) {
+  return_value_if_fail(obj != NULL && obj->vt == &s_numeric_series_vtable, NULL);
+
+  return NUMERIC_SERIES(obj);
+}
+
+ret_t numeric_series_extend(numeric_series_t* series, uint32_t capacity) {
+  float_t* data = NULL;
+  return_value_if_fail(series != NULL, RET_BAD_PARAMS);
+
+  if (capacity <= series->capacity) {
+    return RET_OK;
+  }
+
+  if (capacity < series->capacity + (series->capacity >> 1)) {
+    capacity = series->capacity + (series->capacity >> 1);
+  }
+
+  data = (float_t*)TKMEM_REALLOC(series->data, capacity * sizeof(float_t));
+  return_value_if_fail(data != NULL, RET_OOM);
+
+  series->data = data;
+  series->capacity = capacity;
+
+  return RET_OK;
+}
+
+ret_t numeric_series_mark_dirty(numeric_series_t* series, uint32_t start, uint32_t end) {
+  return_value_if_fail(series != NULL && start <= end, RET_BAD_PARAMS);
+
+  if (start == end) {
+    return RET_OK;
+  }
+
+  if (series->dirty_start == series->dirty_end) {
+    series->dirty_start = start;
+    series->dirty_end = end;
+  } else {
+    series->dirty_start = tk_min(series->dirty_start, start);
+    series->dirty_end = tk_max(series->dirty_end, end);
+  }
+
+  return RET_OK;
+}
+
+bool_t numeric_series_is_dirty(numeric_series_t* series) {
+  return_value_if_fail(series != NULL, FALSE);
+
+  return series->dirty_end > series->dirty_start;
+}
+
+ret_t numeric_series_clear_dirty(numeric_series_t* series) {
+  return_value_if_fail(series != NULL, RET_BAD_PARAMS);
+
+  series->dirty_start = 0;
+  series->dirty_end = 0;
+
+  return RET_OK;
+}
+
+ret_t numeric_series_resize(numeric_series_t* series, uint32_t size) {
+  uint32_t old_size = 0;
+  return_value_if_fail(series != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(numeric_series_extend(series, size) == RET_OK, RET_OOM);
+
+  old_size = series->size;
+  series->size = size;
+
+  return numeric_series_mark_dirty(series, tk_min(old_size, size), tk_max(old_size, size));
+}
+
+ret_t numeric_series_set_n(numeric_series_t* series, uint32_t index, const float_t* values,
+                           uint32_t nr) {
+  return_value_if_fail(series != NULL && index <= series->size, RET_BAD_PARAMS);
+  return_value_if_fail(values != NULL || nr == 0, RET_BAD_PARAMS);
+
+  if (index + nr > series->size) {
+    return_value_if_fail(numeric_series_extend(series, index + nr) == RET_OK, RET_OOM);
+    series->size = index + nr;
+  }
+
+  memcpy(series->data + index, values, nr * sizeof(float_t));
+
+  return numeric_series_mark_dirty(series, index, index + nr);
+}
+
+ret_t numeric_series_push_n(numeric_series_t* series, const float_t* values, uint32_t nr) {
+  return_value_if_fail(series != NULL, RET_BAD_PARAMS);
+
+  return numeric_series_set_n(series, series->size, values, nr);
+}
+
+ret_t numeric_series_push(numeric_series_t* series, float_t value) {
+  return numeric_series_push_n(series, &value, 1);
+}
+
+ret_t numeric_series_set(numeric_series_t* series, uint32_t index, float_t value) {
+  return_value_if_fail(series != NULL && index < series->size, RET_BAD_PARAMS);
+
+  return numeric_series_set_n(series, index, &value, 1);
+}
+
+float_t numeric_series_get(numeric_series_t* series, uint32_t index, float_t defval) {
+  return_value_if_fail(series != NULL && index < series->size, defval);
+
+  return series->data[index];
+}
+
+ret_t numeric_series_clear(numeric_series_t* series) {
+  return numeric_series_resize(series, 0);
+}
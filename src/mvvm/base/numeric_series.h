@@ -0,0 +1,237 @@
+﻿/**
+ * File:   numeric_series.h
+ * Author: AWTK Develop Team
+ * Brief:  numeric series
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#ifndef TK_NUMERIC_SERIES_H
+#define TK_NUMERIC_SERIES_H
+
+#include "tkc/object.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class numeric_series_t
+ * @parent object_t
+ *
+ * 连续存放的数值序列，用于向图表等控件批量传递数据。
+ *
+ * 模型用value_set_object把它作为属性值返回，绑定时直接把对象传给控件，不需要逐个转换数据。
+ * 序列记录了自上次同步以来发生变化的区间(dirty_start到dirty_end)，控件只需要读取这个区间的数据。
+ * 每次更新View之后，binding context会清除变化的区间。
+ *
+ */
+typedef struct _numeric_series_t {
+  object_t object;
+
+  /**
+   * @property {uint32_t} size
+   * @annotation ["readable"]
+   * 数据的个数。
+   */
+  uint32_t size;
+
+  /**
+   * @property {uint32_t} capacity
+   * @annotation ["readable"]
+   * 数据的容量。
+   */
+  uint32_t capacity;
+
+  /**
+   * @property {float_t*} data
+   * @annotation ["readable"]
+   * 数据。
+   */
+  float_t* data;
+
+  /**
+   * @property {uint32_t} dirty_start
+   * @annotation ["readable"]
+   * 变化区间的起始位置。
+   */
+  uint32_t dirty_start;
+
+  /**
+   * @property {uint32_t} dirty_end
+   * @annotation ["readable"]
+   * 变化区间的结束位置(不包括)。数据被删除时，dirty_end可能大于size。
+   */
+  uint32_t dirty_end;
+} numeric_series_t;
+
+/**
+ * @method numeric_series_create
+ * 创建numeric_series对象。
+ *
+ * @annotation ["constructor"]
+ *
+ * @param {uint32_t} capacity 初始容量。
+ *
+ * @return {numeric_series_t*} 返回numeric_series对象。
+ */
+numeric_series_t* numeric_series_create(uint32_t capacity);
+
+/**
+ * @method numeric_series_cast
+ * 转换为numeric_series对象。
+ *
+ * @annotation ["cast"]
+ *
+ * @param {object_t*} obj 对象。
+ *
+ * @return {numeric_series_t*} 对象是numeric_series时返回它，否则返回NULL。
+ */
+numeric_series_t* numeric_series_cast(object_t* obj);
+
+/**
+ * @method numeric_series_extend
+ * 确保容量不小于指定的值。
+ *
+ * @param {numeric_series_t*} series numeric_series对象。
+ * @param {uint32_t} capacity 容量。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t numeric_series_extend(numeric_series_t* series, uint32_t capacity);
+
+/**
+ * @method numeric_series_push
+ * 追加一个数据。
+ *
+ * @param {numeric_series_t*} series numeric_series对象。
+ * @param {float_t} value 数据。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t numeric_series_push(numeric_series_t* series, float_t value);
+
+/**
+ * @method numeric_series_push_n
+ * 追加多个数据。
+ *
+ * @param {numeric_series_t*} series numeric_series对象。
+ * @param {const float_t*} values 数据。
+ * @param {uint32_t} nr 数据的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t numeric_series_push_n(numeric_series_t* series, const float_t* values, uint32_t nr);
+
+/**
+ * @method numeric_series_set_n
+ * 从指定位置开始修改多个数据，超出size的部分会追加到后面。
+ *
+ * @param {numeric_series_t*} series numeric_series对象。
+ * @param {uint32_t} index 起始位置(不能大于size)。
+ * @param {const float_t*} values 数据。
+ * @param {uint32_t} nr 数据的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t numeric_series_set_n(numeric_series_t* series, uint32_t index, const float_t* values,
+                           uint32_t nr);
+
+/**
+ * @method numeric_series_set
+ * 修改指定位置的数据。
+ *
+ * @param {numeric_series_t*} series numeric_series对象。
+ * @param {uint32_t} index 位置。
+ * @param {float_t} value 数据。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t numeric_series_set(numeric_series_t* series, uint32_t index, float_t value);
+
+/**
+ * @method numeric_series_get
+ * 获取指定位置的数据。
+ *
+ * @param {numeric_series_t*} series numeric_series对象。
+ * @param {uint32_t} index 位置。
+ * @param {float_t} defval 缺省值。
+ *
+ * @return {float_t} 返回数据，位置无效时返回缺省值。
+ */
+float_t numeric_series_get(numeric_series_t* series, uint32_t index, float_t defval);
+
+/**
+ * @method numeric_series_resize
+ * 修改数据的个数，新增的数据由调用者直接写入data，并标记为变化的区间。
+ *
+ * @param {numeric_series_t*} series numeric_series对象。
+ * @param {uint32_t} size 数据的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t numeric_series_resize(numeric_series_t* series, uint32_t size);
+
+/**
+ * @method numeric_series_clear
+ * 清除全部数据。
+ *
+ * @param {numeric_series_t*} series numeric_series对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t numeric_series_clear(numeric_series_t* series);
+
+/**
+ * @method numeric_series_mark_dirty
+ * 把指定的区间合并到变化的区间。直接修改data之后调用。
+ *
+ * @param {numeric_series_t*} series numeric_series对象。
+ * @param {uint32_t} start 起始位置。
+ * @param {uint32_t} end 结束位置(不包括)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t numeric_series_mark_dirty(numeric_series_t* series, uint32_t start, uint32_t end);
+
+/**
+ * @method numeric_series_is_dirty
+ * 检查自上次同步以来是否有变化。
+ *
+ * @param {numeric_series_t*} series numeric_series对象。
+ *
+ * @return {bool_t} 返回TRUE表示有变化，否则表示没有。
+ */
+bool_t numeric_series_is_dirty(numeric_series_t* series);
+
+/**
+ * @method numeric_series_clear_dirty
+ * 清除变化的区间(数据已经同步到View)。
+ *
+ * @param {numeric_series_t*} series numeric_series对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t numeric_series_clear_dirty(numeric_series_t* series);
+
+#define NUMERIC_SERIES(obj) ((numeric_series_t*)(obj))
+
+#define NUMERIC_SERIES_PROP_SIZE "size"
+#define NUMERIC_SERIES_PROP_CAPACITY "capacity"
+#define NUMERIC_SERIES_PROP_DIRTY_START "dirty_start"
+#define NUMERIC_SERIES_PROP_DIRTY_END "dirty_end"
+
+END_C_DECLS
+
+#endif /*TK_NUMERIC_SERIES_H*/
@@ -0,0 +1,305 @@
+﻿/**
+ * File:   registry.c
+ * Author: AWTK Develop Team
+ * Brief:  hashed registry with interned names
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "mvvm/base/registry.h"
+
+#define REGISTRY_MIN_CAPACITY 16
+
+/*字符串池中的名字，data指向它*/
+typedef struct _registry_name_t {
+  uint32_t refs;
+  char str[1];
+} registry_name_t;
+
+static registry_t s_names;
+
+static uint32_t registry_hash(const char* name) {
+  uint32_t hash = 2166136261u;
+
+  while (*name) {
+    hash ^= (uint8_t)(*name++);
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+static registry_entry_t* registry_find(registry_t* registry, const char* name, uint32_t hash,
+                                       uint32_t* probes) {
+  uint32_t i = 0;
+  uint32_t mask = 0;
+  registry_entry_t* iter = NULL;
+
+  if (registry->capacity == 0) {
+    return NULL;
+  }
+
+  mask = registry->capacity - 1;
+  for (i = hash & mask;; i = (i + 1) & mask) {
+    iter = registry->entries + i;
+
+    if (iter->name == NULL) {
+      return iter;
+    } else if (iter->hash == hash && (iter->name == name || tk_str_eq(iter->name, name))) {
+      return iter;
+    }
+
+    if (probes != NULL) {
+      (*probes)++;
+    }
+  }
+
+  return NULL;
+}
+
+static registry_entry_t* registry_lookup(registry_t* registry, const char* name) {
+  registry_entry_t* entry = registry_find(registry, name, registry_hash(name), &(registry->probes));
+
+  registry->lookups++;
+  if (entry == NULL || entry->name == NULL) {
+    registry->misses++;
+    return NULL;
+  }
+
+  return entry;
+}
+
+static ret_t registry_grow(registry_t* registry) {
+  uint32_t i = 0;
+  uint32_t capacity = registry->capacity;
+  registry_entry_t* entries = registry->entries;
+  uint32_t new_capacity = capacity > 0 ? capacity * 2 : REGISTRY_MIN_CAPACITY;
+
+  registry->entries = TKMEM_ZALLOCN(registry_entry_t, new_capacity);
+  if (registry->entries == NULL) {
+    registry->entries = entries;
+    return RET_OOM;
+  }
+
+  registry->capacity = new_capacity;
+  for (i = 0; i < capacity; i++) {
+    registry_entry_t* iter = entries + i;
+
+    if (iter->name != NULL) {
+      *registry_find(registry, iter->name, iter->hash, NULL) = *iter;
+    }
+  }
+  TKMEM_FREE(entries);
+
+  return RET_OK;
+}
+
+/*线性探测的删除：把后面不在原位的项前移，不需要墓碑*/
+static ret_t registry_erase(registry_t* registry, registry_entry_t* entry) {
+  uint32_t home = 0;
+  uint32_t mask = registry->capacity - 1;
+  uint32_t i = entry - registry->entries;
+  uint32_t j = i;
+
+  memset(entry, 0x00, sizeof(registry_entry_t));
+  registry->size--;
+
+  for (j = (j + 1) & mask; registry->entries[j].name != NULL; j = (j + 1) & mask) {
+    home = registry->entries[j].hash & mask;
+
+    if (i <= j ? (home <= i || home > j) : (home <= i && home > j)) {
+      registry->entries[i] = registry->entries[j];
+      memset(registry->entries + j, 0x00, sizeof(registry_entry_t));
+      i = j;
+    }
+  }
+
+  return RET_OK;
+}
+
+static registry_entry_t* registry_insert(registry_t* registry, const char* name, uint32_t hash) {
+  registry_entry_t* entry = NULL;
+
+  if ((registry->size + 1) * 2 > registry->capacity) {
+    return_value_if_fail(registry_grow(registry) == RET_OK, NULL);
+  }
+
+  entry = registry_find(registry, name, hash, NULL);
+  if (entry->name == NULL) {
+    entry->hash = hash;
+    registry->size++;
+  }
+
+  return entry;
+}
+
+const char* registry_intern(const char* name) {
+  uint32_t hash = 0;
+  uint32_t size = 0;
+  registry_entry_t* entry = NULL;
+  registry_name_t* interned = NULL;
+  return_value_if_fail(name != NULL, NULL);
+
+  hash = registry_hash(name);
+  entry = registry_insert(&s_names, name, hash);
+  return_value_if_fail(entry != NULL, NULL);
+
+  if (entry->name == NULL) {
+    size = strlen(name);
+    interned = (registry_name_t*)TKMEM_ALLOC(sizeof(registry_name_t) + size);
+    if (interned == NULL) {
+      registry_erase(&s_names, entry);
+      return NULL;
+    }
+
+    interned->refs = 0;
+    memcpy(interned->str, name, size + 1);
+    entry->name = interned->str;
+    entry->data = interned;
+  }
+
+  interned = (registry_name_t*)(entry->data);
+  interned->refs++;
+
+  return interned->str;
+}
+
+ret_t registry_unintern(const char* name) {
+  registry_entry_t* entry = NULL;
+  registry_name_t* interned = NULL;
+  return_value_if_fail(name != NULL, RET_BAD_PARAMS);
+
+  entry = registry_find(&s_names, name, registry_hash(name), NULL);
+  return_value_if_fail(entry != NULL && entry->name != NULL, RET_NOT_FOUND);
+
+  interned = (registry_name_t*)(entry->data);
+  interned->refs--;
+  if (interned->refs == 0) {
+    registry_erase(&s_names, entry);
+    TKMEM_FREE(interned);
+
+    if (s_names.size == 0) {
+      registry_deinit(&s_names);
+    }
+  }
+
+  return RET_OK;
+}
+
+uint32_t registry_interned_size(void) {
+  return s_names.size;
+}
+
+registry_t* registry_init(registry_t* registry, tk_destroy_t destroy) {
+  return_value_if_fail(registry != NULL, NULL);
+
+  memset(registry, 0x00, sizeof(registry_t));
+  registry->destroy = destroy;
+
+  return registry;
+}
+
+ret_t registry_set(registry_t* registry, const char* name, void* data) {
+  void* old = NULL;
+  uint32_t hash = 0;
+  registry_entry_t* entry = NULL;
+  return_value_if_fail(registry != NULL && name != NULL, RET_BAD_PARAMS);
+
+  hash = registry_hash(name);
+  entry = registry_insert(registry, name, hash);
+  return_value_if_fail(entry != NULL, RET_OOM);
+
+  if (entry->name == NULL) {
+    entry->name = registry_intern(name);
+    if (entry->name == NULL) {
+      registry_erase(registry, entry);
+      return RET_OOM;
+    }
+  } else {
+    old = entry->data;
+  }
+
+  entry->data = data;
+  if (old != NULL && registry->destroy != NULL) {
+    registry->destroy(old);
+  }
+
+  return RET_OK;
+}
+
+void* registry_get(registry_t* registry, const char* name) {
+  registry_entry_t* entry = NULL;
+  return_value_if_fail(registry != NULL && name != NULL, NULL);
+
+  entry = registry_lookup(registry, name);
+
+  return entry != NULL ? entry->data : NULL;
+}
+
+bool_t registry_has(registry_t* registry, const char* name) {
+  return_value_if_fail(registry != NULL && name != NULL, FALSE);
+
+  return registry_lookup(registry, name) != NULL;
+}
+
+ret_t registry_remove(registry_t* registry, const char* name) {
+  void* data = NULL;
+  const char* interned = NULL;
+  registry_entry_t* entry = NULL;
+  return_value_if_fail(registry != NULL && name != NULL, RET_BAD_PARAMS);
+
+  entry = registry_lookup(registry, name);
+  if (entry == NULL) {
+    return RET_NOT_FOUND;
+  }
+
+  data = entry->data;
+  interned = entry->name;
+  registry_erase(registry, entry);
+
+  if (data != NULL && registry->destroy != NULL) {
+    registry->destroy(data);
+  }
+  registry_unintern(interned);
+
+  return RET_OK;
+}
+
+ret_t registry_deinit(registry_t* registry) {
+  uint32_t i = 0;
+  registry_entry_t* iter = NULL;
+  return_value_if_fail(registry != NULL, RET_BAD_PARAMS);
+
+  for (i = 0; i < registry->capacity && registry != &s_names; i++) {
+    iter = registry->entries + i;
+
+    if (iter->name != NULL) {
+      if (iter->data != NULL && registry->destroy != NULL) {
+        registry->destroy(iter->data);
+      }
+      registry_unintern(iter->name);
+    }
+  }
+
+  TKMEM_FREE(registry->entries);
+  registry->entries = NULL;
+  registry->capacity = 0;
+  registry->size = 0;
+
+  return RET_OK;
+}
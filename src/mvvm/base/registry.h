@@ -0,0 +1,183 @@
+﻿/**
+ * File:   registry.h
+ * Author: AWTK Develop Team
+ * Brief:  hashed registry with interned names
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#ifndef TK_REGISTRY_H
+#define TK_REGISTRY_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+/*private*/
+typedef struct _registry_entry_t {
+  const char* name;
+  uint32_t hash;
+  void* data;
+} registry_entry_t;
+
+/**
+ * @class registry_t
+ *
+ * 名字到指针的注册表(散列表)，用于各个工厂保存创建函数和导航器保存处理器。
+ *
+ * 名字在全局的字符串池中共享，不同的注册表登记同一个名字(如".js")时只保存一份。
+ *
+ */
+typedef struct _registry_t {
+  /**
+   * @property {uint32_t} size
+   * @annotation ["readable"]
+   * 登记的个数。
+   */
+  uint32_t size;
+
+  /**
+   * @property {uint32_t} lookups
+   * @annotation ["readable"]
+   * 查找的次数。
+   */
+  uint32_t lookups;
+
+  /**
+   * @property {uint32_t} misses
+   * @annotation ["readable"]
+   * 没有找到的次数。
+   */
+  uint32_t misses;
+
+  /**
+   * @property {uint32_t} probes
+   * @annotation ["readable"]
+   * 查找时因为冲突而额外比较的次数。
+   */
+  uint32_t probes;
+
+  /*private*/
+  uint32_t capacity;
+  registry_entry_t* entries;
+  tk_destroy_t destroy;
+} registry_t;
+
+/**
+ * @method registry_init
+ * 初始化注册表。
+ *
+ * @annotation ["constructor"]
+ *
+ * @param {registry_t*} registry 注册表对象。
+ * @param {tk_destroy_t} destroy 数据的销毁函数(可以为NULL)。
+ *
+ * @return {registry_t*} 返回注册表对象。
+ */
+registry_t* registry_init(registry_t* registry, tk_destroy_t destroy);
+
+/**
+ * @method registry_set
+ * 登记指定名字的数据。名字已经登记时，替换(并销毁)原来的数据。
+ *
+ * @param {registry_t*} registry 注册表对象。
+ * @param {const char*} name 名字。
+ * @param {void*} data 数据。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t registry_set(registry_t* registry, const char* name, void* data);
+
+/**
+ * @method registry_get
+ * 查找指定名字的数据。
+ *
+ * @param {registry_t*} registry 注册表对象。
+ * @param {const char*} name 名字。
+ *
+ * @return {void*} 返回数据，没有登记时返回NULL。
+ */
+void* registry_get(registry_t* registry, const char* name);
+
+/**
+ * @method registry_has
+ * 检查指定的名字是否已经登记。
+ *
+ * @param {registry_t*} registry 注册表对象。
+ * @param {const char*} name 名字。
+ *
+ * @return {bool_t} 返回TRUE表示已经登记，否则表示没有登记。
+ */
+bool_t registry_has(registry_t* registry, const char* name);
+
+/**
+ * @method registry_remove
+ * 注销指定的名字(并销毁数据)。
+ *
+ * @param {registry_t*} registry 注册表对象。
+ * @param {const char*} name 名字。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，RET_NOT_FOUND表示没有登记。
+ */
+ret_t registry_remove(registry_t* registry, const char* name);
+
+/**
+ * @method registry_deinit
+ * 注销全部的名字(并销毁数据)，释放注册表的内存。
+ *
+ * @param {registry_t*} registry 注册表对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t registry_deinit(registry_t* registry);
+
+/**
+ * @method registry_intern
+ * 在全局的字符串池中登记名字(引用计数加1)。
+ *
+ * @annotation ["static"]
+ *
+ * @param {const char*} name 名字。
+ *
+ * @return {const char*} 返回共享的字符串，在调用同样次数的registry_unintern之前有效。
+ */
+const char* registry_intern(const char* name);
+
+/**
+ * @method registry_unintern
+ * 释放registry_intern返回的字符串(引用计数减1)。
+ *
+ * @annotation ["static"]
+ *
+ * @param {const char*} name registry_intern返回的字符串。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t registry_unintern(const char* name);
+
+/**
+ * @method registry_interned_size
+ * 获取全局的字符串池中名字的个数。
+ *
+ * @annotation ["static"]
+ *
+ * @return {uint32_t} 返回名字的个数。
+ */
+uint32_t registry_interned_size(void);
+
+END_C_DECLS
+
+#endif /*TK_REGISTRY_H*/
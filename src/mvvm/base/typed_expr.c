@@ -0,0 +1,1164 @@
+﻿/**
+ * File:   typed_expr.c
+ * Author: AWTK Develop Team
+ * Brief:  typed expression evaluator
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#include <math.h>
+#include <errno.h>
+#include <stdlib.h>
+#include "tkc/utils.h"
+#include "tkc/expr_eval.h"
+#include "mvvm/base/typed_expr.h"
+
+#define TYPED_EXPR_MAX_ARGS 8
+#define TYPED_EXPR_MAX_DEPTH 64
+#define TYPED_EXPR_MAX_NAME 127
+
+typedef enum _texpr_type_t {
+  TEXPR_NULL = 0,
+  TEXPR_BOOL,
+  TEXPR_INT64,
+  TEXPR_UINT64,
+  TEXPR_DOUBLE,
+  TEXPR_STR
+} texpr_type_t;
+
+typedef struct _texpr_value_t {
+  texpr_type_t type;
+  /*字符串在buff中时用offset(buff可能重新分配)，否则用str*/
+  bool_t in_buff;
+  union {
+    bool_t b;
+    int64_t i64;
+    uint64_t u64;
+    double f64;
+    struct {
+      const char* str;
+      uint32_t offset;
+      uint32_t size;
+    } s;
+  } v;
+} texpr_value_t;
+
+typedef struct _texpr_t {
+  const char* p;
+  str_t* buff;
+  void* ctx;
+  typed_expr_get_variable_t get_variable;
+
+  /*大于0时只做语法分析，不求值(&&、||和?:中不需要计算的分支)*/
+  uint32_t skip;
+  uint32_t depth;
+} texpr_t;
+
+static ret_t texpr_ternary(texpr_t* e, texpr_value_t* out);
+
+static void texpr_set_bool(texpr_value_t* out, bool_t b) {
+  memset(out, 0x00, sizeof(*out));
+  out->type = TEXPR_BOOL;
+  out->v.b = b;
+}
+
+static void texpr_set_int64(texpr_value_t* out, int64_t i64) {
+  memset(out, 0x00, sizeof(*out));
+  out->type = TEXPR_INT64;
+  out->v.i64 = i64;
+}
+
+static void texpr_set_uint64(texpr_value_t* out, uint64_t u64) {
+  memset(out, 0x00, sizeof(*out));
+  if (u64 <= INT64_MAX) {
+    out->type = TEXPR_INT64;
+    out->v.i64 = (int64_t)u64;
+  } else {
+    out->type = TEXPR_UINT64;
+    out->v.u64 = u64;
+  }
+}
+
+static void texpr_set_double(texpr_value_t* out, double f64) {
+  memset(out, 0x00, sizeof(*out));
+  out->type = TEXPR_DOUBLE;
+  out->v.f64 = f64;
+}
+
+static void texpr_set_str(texpr_value_t* out, const char* str, uint32_t size) {
+  memset(out, 0x00, sizeof(*out));
+  out->type = TEXPR_STR;
+  out->v.s.str = str;
+  out->v.s.size = size;
+}
+
+static void texpr_set_buff_str(texpr_value_t* out, uint32_t offset, uint32_t size) {
+  memset(out, 0x00, sizeof(*out));
+  out->type = TEXPR_STR;
+  out->in_buff = TRUE;
+  out->v.s.offset = offset;
+  out->v.s.size = size;
+}
+
+static const char* texpr_str(texpr_t* e, const texpr_value_t* v) {
+  return v->in_buff ? e->buff->str + v->v.s.offset : v->v.s.str;
+}
+
+static void texpr_skip_space(texpr_t* e) {
+  while (*(e->p) == ' ' || *(e->p) == '\t' || *(e->p) == '\r' || *(e->p) == '\n') {
+    e->p++;
+  }
+}
+
+static bool_t texpr_match(texpr_t* e, const char* token) {
+  uint32_t len = strlen(token);
+
+  texpr_skip_space(e);
+  if (strncmp(e->p, token, len) == 0) {
+    e->p += len;
+    return TRUE;
+  }
+
+  return FALSE;
+}
+
+/*匹配单字符的运算符，但不匹配以它开头的双字符运算符(如&和&&)*/
+static bool_t texpr_match_single(texpr_t* e, char c, const char* not_followed) {
+  texpr_skip_space(e);
+  if (*(e->p) == c && (e->p[1] == '\0' || strchr(not_followed, e->p[1]) == NULL)) {
+    e->p++;
+    return TRUE;
+  }
+
+  return FALSE;
+}
+
+static bool_t texpr_is_name_start(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static bool_t texpr_is_name_char(char c) {
+  return texpr_is_name_start(c) || (c >= '0' && c <= '9');
+}
+
+/*把字符串追加到buff中。from可能就在buff中，所以先扩展容量再取地址*/
+static ret_t texpr_append(texpr_t* e, const texpr_value_t* from) {
+  char num[64];
+  const char* str = num;
+  uint32_t size = 0;
+  str_t* buff = e->buff;
+
+  switch (from->type) {
+    case TEXPR_STR: {
+      size = from->v.s.size;
+      break;
+    }
+    case TEXPR_BOOL: {
+      str = from->v.b ? "true" : "false";
+      break;
+    }
+    case TEXPR_INT64: {
+      tk_snprintf(num, sizeof(num), "%lld", (long long)(from->v.i64));
+      break;
+    }
+    case TEXPR_UINT64: {
+      tk_snprintf(num, sizeof(num), "%llu", (unsigned long long)(from->v.u64));
+      break;
+    }
+    case TEXPR_DOUBLE: {
+      tk_snprintf(num, sizeof(num), "%.15g", from->v.f64);
+      break;
+    }
+    default: {
+      num[0] = '\0';
+      break;
+    }
+  }
+
+  if (from->type != TEXPR_STR) {
+    size = strlen(str);
+  }
+
+  return_value_if_fail(str_extend(buff, buff->size + size + 1) == RET_OK, RET_OOM);
+  if (from->type == TEXPR_STR) {
+    str = texpr_str(e, from);
+  }
+
+  memmove(buff->str + buff->size, str, size);
+  buff->size += size;
+  buff->str[buff->size] = '\0';
+
+  return RET_OK;
+}
+
+static ret_t texpr_to_buff(texpr_t* e, const char* str, uint32_t size, texpr_value_t* out) {
+  texpr_value_t v;
+  uint32_t offset = e->buff->size;
+
+  texpr_set_str(&v, str, size);
+  return_value_if_fail(texpr_append(e, &v) == RET_OK, RET_OOM);
+  texpr_set_buff_str(out, offset, size);
+
+  return RET_OK;
+}
+
+/*数值字面量，也用于把字符串转换成数值*/
+static const char* texpr_parse_number(const char* str, texpr_value_t* out) {
+  char* end = NULL;
+  uint64_t u64 = 0;
+  const char* p = str;
+
+  if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+    errno = 0;
+    u64 = strtoull(p + 2, &end, 16);
+    if (end == p + 2 || errno == ERANGE) {
+      return NULL;
+    }
+    texpr_set_uint64(out, u64);
+
+    return end;
+  }
+
+  while (*p >= '0' && *p <= '9') {
+    p++;
+  }
+
+  if (p == str && *p != '.') {
+    return NULL;
+  }
+
+  if (*p == '.' || *p == 'e' || *p == 'E') {
+    texpr_set_double(out, strtod(str, &end));
+    return end > str ? end : NULL;
+  }
+
+  errno = 0;
+  u64 = strtoull(str, &end, 10);
+  if (errno == ERANGE) {
+    texpr_set_double(out, strtod(str, &end));
+  } else {
+    texpr_set_uint64(out, u64);
+  }
+
+  return end;
+}
+
+static ret_t texpr_to_number(texpr_t* e, const texpr_value_t* v, texpr_value_t* out) {
+  switch (v->type) {
+    case TEXPR_INT64:
+    case TEXPR_UINT64:
+    case TEXPR_DOUBLE: {
+      *out = *v;
+      return RET_OK;
+    }
+    case TEXPR_BOOL: {
+      texpr_set_int64(out, v->v.b ? 1 : 0);
+      return RET_OK;
+    }
+    case TEXPR_STR: {
+      char num[64];
+      const char* end = NULL;
+      bool_t negative = FALSE;
+      const char* p = num;
+      uint32_t size = tk_min(v->v.s.size, sizeof(num) - 1);
+
+      memcpy(num, texpr_str(e, v), size);
+      num[size] = '\0';
+      while (*p == ' ') {
+        p++;
+      }
+      if (*p == '-' || *p == '+') {
+        negative = *p == '-';
+        p++;
+      }
+
+      end = texpr_parse_number(p, out);
+      if (end == NULL || *end != '\0') {
+        texpr_set_double(out, tk_atof(num));
+      } else if (negative) {
+        if (out->type == TEXPR_DOUBLE) {
+          out->v.f64 = -out->v.f64;
+        } else if (out->type == TEXPR_INT64) {
+          out->v.i64 = -out->v.i64;
+        } else {
+          texpr_set_double(out, -(double)(out->v.u64));
+        }
+      }
+      return RET_OK;
+    }
+    default: {
+      texpr_set_int64(out, 0);
+      return RET_OK;
+    }
+  }
+}
+
+static double texpr_double(const texpr_value_t* v) {
+  switch (v->type) {
+    case TEXPR_INT64: {
+      return (double)(v->v.i64);
+    }
+    case TEXPR_UINT64: {
+      return (double)(v->v.u64);
+    }
+    case TEXPR_DOUBLE: {
+      return v->v.f64;
+    }
+    default: {
+      return 0;
+    }
+  }
+}
+
+static bool_t texpr_truthy(const texpr_value_t* v) {
+  switch (v->type) {
+    case TEXPR_BOOL: {
+      return v->v.b;
+    }
+    case TEXPR_INT64: {
+      return v->v.i64 != 0;
+    }
+    case TEXPR_UINT64: {
+      return v->v.u64 != 0;
+    }
+    case TEXPR_DOUBLE: {
+      return v->v.f64 != 0;
+    }
+    case TEXPR_STR: {
+      return v->v.s.size > 0;
+    }
+    default: {
+      return FALSE;
+    }
+  }
+}
+
+/*两个操作数都能表示为uint64时返回TRUE(至少一个是uint64)*/
+static bool_t texpr_as_uint64(const texpr_value_t* a, const texpr_value_t* b, uint64_t* ua,
+                              uint64_t* ub) {
+  if (a->type == TEXPR_DOUBLE || b->type == TEXPR_DOUBLE) {
+    return FALSE;
+  }
+
+  if (a->type != TEXPR_UINT64 && b->type != TEXPR_UINT64) {
+    return FALSE;
+  }
+
+  if ((a->type == TEXPR_INT64 && a->v.i64 < 0) || (b->type == TEXPR_INT64 && b->v.i64 < 0)) {
+    return FALSE;
+  }
+
+  *ua = a->type == TEXPR_UINT64 ? a->v.u64 : (uint64_t)(a->v.i64);
+  *ub = b->type == TEXPR_UINT64 ? b->v.u64 : (uint64_t)(b->v.i64);
+
+  return TRUE;
+}
+
+static ret_t texpr_arith_uint64(char op, uint64_t a, uint64_t b, texpr_value_t* out) {
+  switch (op) {
+    case '+': {
+      if (a > UINT64_MAX - b) {
+        texpr_set_double(out, (double)a + (double)b);
+      } else {
+        texpr_set_uint64(out, a + b);
+      }
+      break;
+    }
+    case '-': {
+      if (a >= b) {
+        texpr_set_uint64(out, a - b);
+      } else if (b - a <= INT64_MAX) {
+        texpr_set_int64(out, -(int64_t)(b - a));
+      } else {
+        texpr_set_double(out, (double)a - (double)b);
+      }
+      break;
+    }
+    case '*': {
+      if (a != 0 && b > UINT64_MAX / a) {
+        texpr_set_double(out, (double)a * (double)b);
+      } else {
+        texpr_set_uint64(out, a * b);
+      }
+      break;
+    }
+    case '/': {
+      return_value_if_fail(b != 0, RET_BAD_PARAMS);
+      if (a % b == 0) {
+        texpr_set_uint64(out, a / b);
+      } else {
+        texpr_set_double(out, (double)a / (double)b);
+      }
+      break;
+    }
+    default: {
+      return_value_if_fail(b != 0, RET_BAD_PARAMS);
+      texpr_set_uint64(out, a % b);
+      break;
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t texpr_arith_int64(char op, int64_t a, int64_t b, texpr_value_t* out) {
+  switch (op) {
+    case '+': {
+      if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b)) {
+        texpr_set_double(out, (double)a + (double)b);
+      } else {
+        texpr_set_int64(out, a + b);
+      }
+      break;
+    }
+    case '-': {
+      if ((b < 0 && a > INT64_MAX + b) || (b > 0 && a < INT64_MIN + b)) {
+        texpr_set_double(out, (double)a - (double)b);
+      } else {
+        texpr_set_int64(out, a - b);
+      }
+      break;
+    }
+    case '*': {
+      double d = (double)a * (double)b;
+      if (d >= 9.2e18 || d <= -9.2e18) {
+        texpr_set_double(out, d);
+      } else {
+        texpr_set_int64(out, a * b);
+      }
+      break;
+    }
+    case '/': {
+      return_value_if_fail(b != 0, RET_BAD_PARAMS);
+      if (b != -1 && a % b == 0) {
+        texpr_set_int64(out, a / b);
+      } else {
+        texpr_set_double(out, (double)a / (double)b);
+      }
+      break;
+    }
+    default: {
+      return_value_if_fail(b != 0, RET_BAD_PARAMS);
+      texpr_set_int64(out, b == -1 ? 0 : a % b);
+      break;
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t texpr_arith(texpr_t* e, char op, const texpr_value_t* l, const texpr_value_t* r,
+                         texpr_value_t* out) {
+  uint64_t ua = 0;
+  uint64_t ub = 0;
+  texpr_value_t a;
+  texpr_value_t b;
+
+  if (op == '+' && (l->type == TEXPR_STR || r->type == TEXPR_STR)) {
+    uint32_t offset = 0;
+
+    if (l->in_buff && l->v.s.offset + l->v.s.size == e->buff->size) {
+      /*左边的字符串在buff的末尾时直接在后面追加*/
+      offset = l->v.s.offset;
+    } else {
+      offset = e->buff->size;
+      return_value_if_fail(texpr_append(e, l) == RET_OK, RET_OOM);
+    }
+    return_value_if_fail(texpr_append(e, r) == RET_OK, RET_OOM);
+    texpr_set_buff_str(out, offset, e->buff->size - offset);
+
+    return RET_OK;
+  }
+
+  texpr_to_number(e, l, &a);
+  texpr_to_number(e, r, &b);
+
+  if (a.type == TEXPR_DOUBLE || b.type == TEXPR_DOUBLE) {
+    double da = texpr_double(&a);
+    double db = texpr_double(&b);
+
+    switch (op) {
+      case '+': {
+        texpr_set_double(out, da + db);
+        break;
+      }
+      case '-': {
+        texpr_set_double(out, da - db);
+        break;
+      }
+      case '*': {
+        texpr_set_double(out, da * db);
+        break;
+      }
+      case '/': {
+        return_value_if_fail(db != 0, RET_BAD_PARAMS);
+        texpr_set_double(out, da / db);
+        break;
+      }
+      default: {
+        return_value_if_fail(db != 0, RET_BAD_PARAMS);
+        texpr_set_double(out, fmod(da, db));
+        break;
+      }
+    }
+
+    return RET_OK;
+  }
+
+  if (texpr_as_uint64(&a, &b, &ua, &ub)) {
+    return texpr_arith_uint64(op, ua, ub, out);
+  } else if (a.type == TEXPR_UINT64 || b.type == TEXPR_UINT64) {
+    /*一个是负数，另一个超出了int64的范围*/
+    texpr_value_t d;
+    texpr_set_double(&d, texpr_double(&b));
+    return texpr_arith(e, op, &a, &d, out);
+  }
+
+  return texpr_arith_int64(op, a.v.i64, b.v.i64, out);
+}
+
+/*比较两个值，返回负数、0或正数*/
+static int32_t texpr_compare(texpr_t* e, const texpr_value_t* l, const texpr_value_t* r) {
+  texpr_value_t a;
+  texpr_value_t b;
+
+  if (l->type == TEXPR_STR && r->type == TEXPR_STR) {
+    uint32_t size = tk_min(l->v.s.size, r->v.s.size);
+    int32_t ret = memcmp(texpr_str(e, l), texpr_str(e, r), size);
+
+    if (ret == 0) {
+      ret = (int32_t)(l->v.s.size) - (int32_t)(r->v.s.size);
+    }
+
+    return ret;
+  }
+
+  texpr_to_number(e, l, &a);
+  texpr_to_number(e, r, &b);
+
+  if (a.type == TEXPR_DOUBLE || b.type == TEXPR_DOUBLE) {
+    double da = texpr_double(&a);
+    double db = texpr_double(&b);
+
+    return da < db ? -1 : (da > db ? 1 : 0);
+  } else if (a.type == TEXPR_UINT64 || b.type == TEXPR_UINT64) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+
+    if (!texpr_as_uint64(&a, &b, &ua, &ub)) {
+      /*有一个是负数*/
+      return a.type == TEXPR_INT64 ? -1 : 1;
+    }
+
+    return ua < ub ? -1 : (ua > ub ? 1 : 0);
+  }
+
+  return a.v.i64 < b.v.i64 ? -1 : (a.v.i64 > b.v.i64 ? 1 : 0);
+}
+
+static int64_t texpr_int64(texpr_t* e, const texpr_value_t* v) {
+  texpr_value_t n;
+
+  texpr_to_number(e, v, &n);
+  if (n.type == TEXPR_DOUBLE) {
+    return (int64_t)(n.v.f64);
+  } else {
+    return n.v.i64;
+  }
+}
+
+static ret_t texpr_parse_string(texpr_t* e, texpr_value_t* out) {
+  const char* p = NULL;
+  char quote = *(e->p);
+  const char* start = e->p + 1;
+  uint32_t offset = e->buff->size;
+  bool_t escaped = FALSE;
+
+  for (p = start; *p != quote; p++) {
+    return_value_if_fail(*p != '\0', RET_BAD_PARAMS);
+    if (*p == '\\') {
+      escaped = TRUE;
+      p++;
+      return_value_if_fail(*p != '\0', RET_BAD_PARAMS);
+    }
+  }
+  e->p = p + 1;
+
+  if (!escaped) {
+    texpr_set_str(out, start, p - start);
+    return RET_OK;
+  }
+
+  for (p = start; *p != quote; p++) {
+    char c = *p;
+    if (c == '\\') {
+      c = *(++p);
+      if (c == 'n') {
+        c = '\n';
+      } else if (c == 't') {
+        c = '\t';
+      } else if (c == 'r') {
+        c = '\r';
+      }
+    }
+    return_value_if_fail(str_append_char(e->buff, c) == RET_OK, RET_OOM);
+  }
+  texpr_set_buff_str(out, offset, e->buff->size - offset);
+
+  return RET_OK;
+}
+
+static ret_t texpr_from_value(texpr_t* e, const value_t* v, texpr_value_t* out) {
+  switch (v->type) {
+    case VALUE_TYPE_BOOL: {
+      texpr_set_bool(out, value_bool(v));
+      break;
+    }
+    case VALUE_TYPE_INT8:
+    case VALUE_TYPE_UINT8:
+    case VALUE_TYPE_INT16:
+    case VALUE_TYPE_UINT16:
+    case VALUE_TYPE_INT32:
+    case VALUE_TYPE_UINT32:
+    case VALUE_TYPE_INT64: {
+      texpr_set_int64(out, value_int64(v));
+      break;
+    }
+    case VALUE_TYPE_UINT64: {
+      texpr_set_uint64(out, value_uint64(v));
+      break;
+    }
+    case VALUE_TYPE_STRING: {
+      /*模型返回的字符串可能在下一次读取属性时被覆盖(如JS模型的临时缓冲区)，所以放到buff中*/
+      const char* str = value_str(v);
+      return texpr_to_buff(e, str, str != NULL ? strlen(str) : 0, out);
+    }
+    case VALUE_TYPE_WSTRING: {
+      str_t str;
+      ret_t ret = RET_OOM;
+
+      str_init(&str, 0);
+      if (str_from_value(&str, v) == RET_OK) {
+        ret = texpr_to_buff(e, str.str, str.size, out);
+      }
+      str_reset(&str);
+
+      return ret;
+    }
+    default: {
+      texpr_set_double(out, value_double(v));
+      break;
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t texpr_parse_variable(texpr_t* e, texpr_value_t* out) {
+  value_t v;
+  uint32_t len = 0;
+  ret_t ret = RET_OK;
+  char name[TYPED_EXPR_MAX_NAME + 1];
+  const char* start = ++(e->p);
+
+  while (texpr_is_name_char(*(e->p)) || *(e->p) == '.' || *(e->p) == '[' || *(e->p) == ']') {
+    e->p++;
+  }
+
+  len = e->p - start;
+  return_value_if_fail(len > 0 && len <= TYPED_EXPR_MAX_NAME, RET_BAD_PARAMS);
+
+  if (e->skip > 0) {
+    memset(out, 0x00, sizeof(*out));
+    return RET_OK;
+  }
+
+  memcpy(name, start, len);
+  name[len] = '\0';
+
+  value_set_int(&v, 0);
+  ret = e->get_variable(e->ctx, name, &v);
+  if (ret == RET_OK) {
+    ret = texpr_from_value(e, &v, out);
+    value_reset(&v);
+  }
+
+  return ret;
+}
+
+/*函数调用交给eval_default_hooks，参数和返回值在调用时转换成ExprValue*/
+static ret_t texpr_call(texpr_t* e, const char* name, texpr_value_t* args, uint32_t nr,
+                        texpr_value_t* out) {
+  uint32_t i = 0;
+  ret_t ret = RET_OK;
+  ExprValue result;
+  ExprValue input[TYPED_EXPR_MAX_ARGS];
+  EvalFunc func = eval_default_hooks()->get_func(name, e->ctx);
+  return_value_if_fail(func != NULL, RET_NOT_FOUND);
+
+  memset(input, 0x00, sizeof(input));
+  memset(&result, 0x00, sizeof(result));
+  for (i = 0; i < nr; i++) {
+    texpr_value_t n;
+    if (args[i].type == TEXPR_STR) {
+      expr_value_set_string(input + i, texpr_str(e, args + i), args[i].v.s.size);
+    } else {
+      texpr_to_number(e, args + i, &n);
+      expr_value_set_number(input + i, texpr_double(&n));
+    }
+  }
+
+  if (func(input, nr, &result) != EVAL_RESULT_OK) {
+    ret = RET_FAIL;
+  }
+  for (i = 0; i < nr; i++) {
+    expr_value_clear(input + i);
+  }
+
+  if (ret == RET_OK) {
+    if (result.type == EXPR_VALUE_TYPE_STRING) {
+      const char* str = result.v.str.str;
+      ret = texpr_to_buff(e, str, str != NULL ? strlen(str) : 0, out);
+    } else if (result.v.val == floor(result.v.val) && fabs(result.v.val) < 9.2e18) {
+      texpr_set_int64(out, (int64_t)(result.v.val));
+    } else {
+      texpr_set_double(out, result.v.val);
+    }
+  }
+  expr_value_clear(&result);
+
+  return ret;
+}
+
+static ret_t texpr_parse_call(texpr_t* e, texpr_value_t* out) {
+  uint32_t nr = 0;
+  uint32_t len = 0;
+  char name[TK_NAME_LEN + 1];
+  const char* start = e->p;
+  texpr_value_t args[TYPED_EXPR_MAX_ARGS];
+
+  while (texpr_is_name_char(*(e->p))) {
+    e->p++;
+  }
+  len = e->p - start;
+
+  if (!texpr_match(e, "(")) {
+    if (len == 4 && strncmp(start, "true", len) == 0) {
+      texpr_set_bool(out, TRUE);
+      return RET_OK;
+    } else if (len == 5 && strncmp(start, "false", len) == 0) {
+      texpr_set_bool(out, FALSE);
+      return RET_OK;
+    }
+
+    return RET_BAD_PARAMS;
+  }
+  return_value_if_fail(len <= TK_NAME_LEN, RET_BAD_PARAMS);
+
+  if (!texpr_match(e, ")")) {
+    do {
+      return_value_if_fail(nr < TYPED_EXPR_MAX_ARGS, RET_BAD_PARAMS);
+      return_value_if_fail(texpr_ternary(e, args + nr) == RET_OK, RET_BAD_PARAMS);
+      nr++;
+    } while (texpr_match(e, ","));
+    return_value_if_fail(texpr_match(e, ")"), RET_BAD_PARAMS);
+  }
+
+  if (e->skip > 0) {
+    memset(out, 0x00, sizeof(*out));
+    return RET_OK;
+  }
+
+  memcpy(name, start, len);
+  name[len] = '\0';
+
+  return texpr_call(e, name, args, nr, out);
+}
+
+static ret_t texpr_primary(texpr_t* e, texpr_value_t* out) {
+  char c = 0;
+
+  texpr_skip_space(e);
+  c = *(e->p);
+
+  if (c == '(') {
+    e->p++;
+    return_value_if_fail(texpr_ternary(e, out) == RET_OK, RET_BAD_PARAMS);
+    return_value_if_fail(texpr_match(e, ")"), RET_BAD_PARAMS);
+
+    return RET_OK;
+  } else if (c == '"' || c == '\'') {
+    return texpr_parse_string(e, out);
+  } else if (c == '$') {
+    return texpr_parse_variable(e, out);
+  } else if (texpr_is_name_start(c)) {
+    return texpr_parse_call(e, out);
+  } else {
+    const char* end = texpr_parse_number(e->p, out);
+    return_value_if_fail(end != NULL, RET_BAD_PARAMS);
+    e->p = end;
+
+    return RET_OK;
+  }
+}
+
+static ret_t texpr_unary(texpr_t* e, texpr_value_t* out);
+
+static ret_t texpr_unary_op(texpr_t* e, texpr_value_t* out) {
+  texpr_value_t v;
+
+  texpr_skip_space(e);
+  switch (*(e->p)) {
+    case '-': {
+      e->p++;
+      return_value_if_fail(texpr_unary(e, &v) == RET_OK, RET_BAD_PARAMS);
+      texpr_to_number(e, &v, out);
+      if (out->type == TEXPR_DOUBLE) {
+        out->v.f64 = -(out->v.f64);
+      } else if (out->type == TEXPR_INT64 && out->v.i64 != INT64_MIN) {
+        out->v.i64 = -(out->v.i64);
+      } else if (out->type == TEXPR_UINT64 && out->v.u64 == (uint64_t)INT64_MAX + 1) {
+        texpr_set_int64(out, INT64_MIN);
+      } else {
+        texpr_set_double(out, -texpr_double(out));
+      }
+      break;
+    }
+    case '+': {
+      e->p++;
+      return_value_if_fail(texpr_unary(e, &v) == RET_OK, RET_BAD_PARAMS);
+      texpr_to_number(e, &v, out);
+      break;
+    }
+    case '!': {
+      e->p++;
+      return_value_if_fail(texpr_unary(e, &v) == RET_OK, RET_BAD_PARAMS);
+      texpr_set_bool(out, !texpr_truthy(&v));
+      break;
+    }
+    case '~': {
+      e->p++;
+      return_value_if_fail(texpr_unary(e, &v) == RET_OK, RET_BAD_PARAMS);
+      texpr_set_int64(out, ~texpr_int64(e, &v));
+      break;
+    }
+    default: {
+      return texpr_primary(e, out);
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t texpr_unary(texpr_t* e, texpr_value_t* out) {
+  ret_t ret = RET_OK;
+  return_value_if_fail(e->depth < TYPED_EXPR_MAX_DEPTH, RET_BAD_PARAMS);
+
+  e->depth++;
+  ret = texpr_unary_op(e, out);
+  e->depth--;
+
+  return ret;
+}
+
+static ret_t texpr_multiplicative(texpr_t* e, texpr_value_t* out) {
+  return_value_if_fail(texpr_unary(e, out) == RET_OK, RET_BAD_PARAMS);
+
+  while (TRUE) {
+    char op = 0;
+    texpr_value_t r;
+    texpr_value_t l = *out;
+
+    if (texpr_match(e, "*")) {
+      op = '*';
+    } else if (texpr_match(e, "/")) {
+      op = '/';
+    } else if (texpr_match(e, "%")) {
+      op = '%';
+    } else {
+      break;
+    }
+
+    return_value_if_fail(texpr_unary(e, &r) == RET_OK, RET_BAD_PARAMS);
+    if (e->skip == 0) {
+      return_value_if_fail(texpr_arith(e, op, &l, &r, out) == RET_OK, RET_BAD_PARAMS);
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t texpr_additive(texpr_t* e, texpr_value_t* out) {
+  return_value_if_fail(texpr_multiplicative(e, out) == RET_OK, RET_BAD_PARAMS);
+
+  while (TRUE) {
+    char op = 0;
+    texpr_value_t r;
+    texpr_value_t l = *out;
+
+    if (texpr_match(e, "+")) {
+      op = '+';
+    } else if (texpr_match(e, "-")) {
+      op = '-';
+    } else {
+      break;
+    }
+
+    return_value_if_fail(texpr_multiplicative(e, &r) == RET_OK, RET_BAD_PARAMS);
+    if (e->skip == 0) {
+      return_value_if_fail(texpr_arith(e, op, &l, &r, out) == RET_OK, RET_BAD_PARAMS);
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t texpr_relational(texpr_t* e, texpr_value_t* out) {
+  return_value_if_fail(texpr_additive(e, out) == RET_OK, RET_BAD_PARAMS);
+
+  while (TRUE) {
+    char op = 0;
+    int32_t cmp = 0;
+    texpr_value_t r;
+    texpr_value_t l = *out;
+
+    if (texpr_match(e, "<=")) {
+      op = 'l';
+    } else if (texpr_match(e, ">=")) {
+      op = 'g';
+    } else if (texpr_match(e, "<")) {
+      op = '<';
+    } else if (texpr_match(e, ">")) {
+      op = '>';
+    } else {
+      break;
+    }
+
+    return_value_if_fail(texpr_additive(e, &r) == RET_OK, RET_BAD_PARAMS);
+    if (e->skip == 0) {
+      cmp = texpr_compare(e, &l, &r);
+      if (op == 'l') {
+        texpr_set_bool(out, cmp <= 0);
+      } else if (op == 'g') {
+        texpr_set_bool(out, cmp >= 0);
+      } else {
+        texpr_set_bool(out, op == '<' ? cmp < 0 : cmp > 0);
+      }
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t texpr_equality(texpr_t* e, texpr_value_t* out) {
+  return_value_if_fail(texpr_relational(e, out) == RET_OK, RET_BAD_PARAMS);
+
+  while (TRUE) {
+    bool_t equal = FALSE;
+    texpr_value_t r;
+    texpr_value_t l = *out;
+
+    if (texpr_match(e, "==")) {
+      equal = TRUE;
+    } else if (texpr_match(e, "!=")) {
+      equal = FALSE;
+    } else {
+      break;
+    }
+
+    return_value_if_fail(texpr_relational(e, &r) == RET_OK, RET_BAD_PARAMS);
+    if (e->skip == 0) {
+      bool_t same = FALSE;
+      if (l.type == TEXPR_BOOL && r.type == TEXPR_BOOL) {
+        same = !(l.v.b) == !(r.v.b);
+      } else {
+        same = texpr_compare(e, &l, &r) == 0;
+      }
+      texpr_set_bool(out, equal ? same : !same);
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t texpr_bit_and(texpr_t* e, texpr_value_t* out) {
+  return_value_if_fail(texpr_equality(e, out) == RET_OK, RET_BAD_PARAMS);
+
+  while (texpr_match_single(e, '&', "&")) {
+    texpr_value_t r;
+    texpr_value_t l = *out;
+
+    return_value_if_fail(texpr_equality(e, &r) == RET_OK, RET_BAD_PARAMS);
+    if (e->skip == 0) {
+      texpr_set_int64(out, texpr_int64(e, &l) & texpr_int64(e, &r));
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t texpr_bit_xor(texpr_t* e, texpr_value_t* out) {
+  return_value_if_fail(texpr_bit_and(e, out) == RET_OK, RET_BAD_PARAMS);
+
+  while (texpr_match_single(e, '^', "")) {
+    texpr_value_t r;
+    texpr_value_t l = *out;
+
+    return_value_if_fail(texpr_bit_and(e, &r) == RET_OK, RET_BAD_PARAMS);
+    if (e->skip == 0) {
+      texpr_set_int64(out, texpr_int64(e, &l) ^ texpr_int64(e, &r));
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t texpr_bit_or(texpr_t* e, texpr_value_t* out) {
+  return_value_if_fail(texpr_bit_xor(e, out) == RET_OK, RET_BAD_PARAMS);
+
+  while (texpr_match_single(e, '|', "|")) {
+    texpr_value_t r;
+    texpr_value_t l = *out;
+
+    return_value_if_fail(texpr_bit_xor(e, &r) == RET_OK, RET_BAD_PARAMS);
+    if (e->skip == 0) {
+      texpr_set_int64(out, texpr_int64(e, &l) | texpr_int64(e, &r));
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t texpr_logic_and(texpr_t* e, texpr_value_t* out) {
+  return_value_if_fail(texpr_bit_or(e, out) == RET_OK, RET_BAD_PARAMS);
+
+  while (texpr_match(e, "&&")) {
+    texpr_value_t r;
+    bool_t l = texpr_truthy(out);
+
+    e->skip += l ? 0 : 1;
+    return_value_if_fail(texpr_bit_or(e, &r) == RET_OK, RET_BAD_PARAMS);
+    e->skip -= l ? 0 : 1;
+    texpr_set_bool(out, l && texpr_truthy(&r));
+  }
+
+  return RET_OK;
+}
+
+static ret_t texpr_logic_or(texpr_t* e, texpr_value_t* out) {
+  return_value_if_fail(texpr_logic_and(e, out) == RET_OK, RET_BAD_PARAMS);
+
+  while (texpr_match(e, "||")) {
+    texpr_value_t r;
+    bool_t l = texpr_truthy(out);
+
+    e->skip += l ? 1 : 0;
+    return_value_if_fail(texpr_logic_and(e, &r) == RET_OK, RET_BAD_PARAMS);
+    e->skip -= l ? 1 : 0;
+    texpr_set_bool(out, l || texpr_truthy(&r));
+  }
+
+  return RET_OK;
+}
+
+static ret_t texpr_ternary(texpr_t* e, texpr_value_t* out) {
+  bool_t cond = FALSE;
+  texpr_value_t a;
+  texpr_value_t b;
+
+  return_value_if_fail(texpr_logic_or(e, out) == RET_OK, RET_BAD_PARAMS);
+  if (!texpr_match(e, "?")) {
+    return RET_OK;
+  }
+
+  cond = texpr_truthy(out);
+
+  e->skip += cond ? 0 : 1;
+  return_value_if_fail(texpr_ternary(e, &a) == RET_OK, RET_BAD_PARAMS);
+  e->skip -= cond ? 0 : 1;
+  return_value_if_fail(texpr_match(e, ":"), RET_BAD_PARAMS);
+
+  e->skip += cond ? 1 : 0;
+  return_value_if_fail(texpr_ternary(e, &b) == RET_OK, RET_BAD_PARAMS);
+  e->skip -= cond ? 1 : 0;
+
+  *out = cond ? a : b;
+
+  return RET_OK;
+}
+
+static ret_t texpr_to_value(texpr_t* e, texpr_value_t* r, value_t* v) {
+  switch (r->type) {
+    case TEXPR_BOOL: {
+      value_set_bool(v, r->v.b);
+      break;
+    }
+    case TEXPR_INT64: {
+      value_set_int64(v, r->v.i64);
+      break;
+    }
+    case TEXPR_UINT64: {
+      value_set_uint64(v, r->v.u64);
+      break;
+    }
+    case TEXPR_DOUBLE: {
+      value_set_double(v, r->v.f64);
+      break;
+    }
+    case TEXPR_STR: {
+      /*结果需要以'\0'结束，不在buff末尾时复制一次*/
+      if (!(r->in_buff) || r->v.s.offset + r->v.s.size != e->buff->size) {
+        uint32_t offset = e->buff->size;
+        return_value_if_fail(texpr_append(e, r) == RET_OK, RET_OOM);
+        texpr_set_buff_str(r, offset, e->buff->size - offset);
+      }
+      value_set_str(v, texpr_str(e, r));
+      break;
+    }
+    default: {
+      value_set_int(v, 0);
+      break;
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t typed_expr_eval(const char* expr, typed_expr_get_variable_t get_variable, void* ctx,
+                      str_t* buff, value_t* v) {
+  texpr_t e;
+  texpr_value_t result;
+  return_value_if_fail(expr != NULL && get_variable != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(buff != NULL && v != NULL, RET_BAD_PARAMS);
+
+  memset(&e, 0x00, sizeof(e));
+  e.p = expr;
+  e.ctx = ctx;
+  e.buff = buff;
+  e.get_variable = get_variable;
+
+  str_clear(buff);
+  return_value_if_fail(str_extend(buff, 32) == RET_OK, RET_OOM);
+
+  if (texpr_ternary(&e, &result) != RET_OK) {
+    return RET_FAIL;
+  }
+
+  texpr_skip_space(&e);
+  return_value_if_fail(*(e.p) == '\0', RET_FAIL);
+
+  return texpr_to_value(&e, &result, v);
+}
@@ -0,0 +1,68 @@
+﻿/**
+ * File:   typed_expr.h
+ * Author: AWTK Develop Team
+ * Brief:  typed expression evaluator
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#ifndef TK_TYPED_EXPR_H
+#define TK_TYPED_EXPR_H
+
+#include "tkc/str.h"
+#include "tkc/value.h"
+
+BEGIN_C_DECLS
+
+typedef ret_t (*typed_expr_get_variable_t)(void* ctx, const char* name, value_t* v);
+
+/**
+ * @class typed_expr_t
+ * @annotation ["fake"]
+ *
+ * 带类型的表达式求值。语法与eval_execute相同($name为变量，函数调用交给eval_default_hooks)，
+ * 但中间结果直接保存int64/uint64/double/bool和字符串的视图，不经过double和字符串复制：
+ *
+ * * 整数运算的结果仍然是整数(溢出或者除不尽时为double)，int64/uint64不损失精度。
+ * * 比较和逻辑运算的结果为bool。&&、||和?:只计算需要的分支。
+ * * 字符串常量直接引用表达式，拼接的字符串和从模型读取的字符串放在调用者提供的缓冲区中，
+ *   缓冲区可以重复使用，不需要每次分配内存。
+ *
+ * 编译时定义WITH_MVVM_TYPED_EXPR(scons MVVM_TYPED_EXPR=1)，view\_model\_eval就使用本求值器。
+ *
+ */
+
+/**
+ * @method typed_expr_eval
+ * @annotation ["static"]
+ * 计算表达式的值。
+ *
+ * 结果为字符串时，指向buff中的数据，在下一次使用同一个buff求值之前有效。
+ *
+ * @param {const char*} expr 表达式。
+ * @param {typed_expr_get_variable_t} get_variable 读取变量的函数(变量名不含"$")。
+ * @param {void*} ctx get_variable的上下文。
+ * @param {str_t*} buff 存放字符串的缓冲区。
+ * @param {value_t*} v 计算结果。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t typed_expr_eval(const char* expr, typed_expr_get_variable_t get_variable, void* ctx,
+                      str_t* buff, value_t* v);
+
+END_C_DECLS
+
+#endif /*TK_TYPED_EXPR_H*/
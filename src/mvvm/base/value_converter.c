@@ -21,7 +21,7 @@
 
 #include "tkc/mem.h"
 #include "tkc/slist.h"
-#include "tkc/object_default.h"
+#include "mvvm/base/registry.h"
 #include "mvvm/base/value_converter.h"
 
 ret_t value_converter_to_view(value_converter_t* converter, const value_t* from, value_t* to) {
@@ -42,9 +42,79 @@ ret_t value_converter_to_model(value_converter_t* converter, const value_t* from
   return converter->to_model(converter, from, to);
 }
 
+ret_t value_converter_hold_result(value_t* to, value_t* result) {
+  return_value_if_fail(to != NULL && result != NULL, RET_BAD_PARAMS);
+
+  if (result->type == VALUE_TYPE_STRING && !(result->free_handle)) {
+    value_dup_str(to, value_str(result));
+    return_value_if_fail(value_str(result) == NULL || value_str(to) != NULL, RET_OOM);
+  } else {
+    *to = *result;
+  }
+  memset(result, 0x00, sizeof(value_t));
+
+  return RET_OK;
+}
+
+static ret_t value_converter_batch(value_converter_t* converter, value_converter_to_view_t convert,
+                                   const value_t* from, value_t* to, uint32_t nr) {
+  value_t v;
+  uint32_t i = 0;
+  ret_t ret = RET_OK;
+
+  for (i = 0; i < nr; i++) {
+    value_set_int(&v, 0);
+    ret = convert(converter, from + i, &v);
+    if (ret == RET_OK) {
+      ret = value_converter_hold_result(to + i, &v);
+    }
+
+    if (ret != RET_OK) {
+      value_reset(&v);
+      break;
+    }
+  }
+
+  if (ret != RET_OK) {
+    while (i-- > 0) {
+      value_reset(to + i);
+    }
+  }
+
+  return ret;
+}
+
+ret_t value_converter_to_model_batch(value_converter_t* converter, const value_t* from, value_t* to,
+                                     uint32_t nr) {
+  return_value_if_fail(converter != NULL && converter->object.vt != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(converter->to_model != NULL && converter->object.ref_count > 0,
+                       RET_BAD_PARAMS);
+  return_value_if_fail(from != NULL && to != NULL, RET_BAD_PARAMS);
+
+  if (converter->to_model_batch != NULL) {
+    return converter->to_model_batch(converter, from, to, nr);
+  }
+
+  return value_converter_batch(converter, converter->to_model, from, to, nr);
+}
+
+ret_t value_converter_to_view_batch(value_converter_t* converter, const value_t* from, value_t* to,
+                                    uint32_t nr) {
+  return_value_if_fail(converter != NULL && converter->object.vt != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(converter->to_view != NULL && converter->object.ref_count > 0,
+                       RET_BAD_PARAMS);
+  return_value_if_fail(from != NULL && to != NULL, RET_BAD_PARAMS);
+
+  if (converter->to_view_batch != NULL) {
+    return converter->to_view_batch(converter, from, to, nr);
+  }
+
+  return value_converter_batch(converter, converter->to_view, from, to, nr);
+}
+
 typedef struct _value_converter_factory_t {
-  object_t* cache;
-  object_t* creators;
+  registry_t cache;
+  registry_t creators;
   slist_t generic_creators;
 } value_converter_factory_t;
 
@@ -54,8 +124,8 @@ static value_converter_factory_t* value_converter_factory_create(void) {
   value_converter_factory_t* factory = TKMEM_ZALLOC(value_converter_factory_t);
   return_value_if_fail(factory != NULL, NULL);
 
-  factory->cache = object_default_create();
-  factory->creators = object_default_create();
+  registry_init(&(factory->cache), (tk_destroy_t)object_unref);
+  registry_init(&(factory->creators), NULL);
   slist_init(&(factory->generic_creators), NULL, NULL);
 
   return factory;
@@ -64,8 +134,8 @@ static value_converter_factory_t* value_converter_factory_create(void) {
 static ret_t value_converter_factory_destroy(value_converter_factory_t* factory) {
   return_value_if_fail(factory != NULL, RET_BAD_PARAMS);
 
-  object_unref(factory->cache);
-  object_unref(factory->creators);
+  registry_deinit(&(factory->cache));
+  registry_deinit(&(factory->creators));
   slist_deinit(&(factory->generic_creators));
 
   return RET_OK;
@@ -89,7 +159,7 @@ value_converter_t* value_converter_do_create(const char* name) {
   tk_create_t create = NULL;
   return_value_if_fail(name != NULL && s_factory != NULL, NULL);
 
-  create = (tk_create_t)object_get_prop_pointer(s_factory->creators, name);
+  create = (tk_create_t)registry_get(&(s_factory->creators), name);
   if (create != NULL) {
     return (value_converter_t*)create();
   } else {
@@ -98,7 +168,7 @@ value_converter_t* value_converter_do_create(const char* name) {
 }
 
 static value_converter_t* value_converter_get(const char* name) {
-  object_t* obj = object_get_prop_object(s_factory->cache, name);
+  object_t* obj = OBJECT(registry_get(&(s_factory->cache), name));
 
   if (obj != NULL) {
     object_ref(obj);
@@ -110,7 +180,7 @@ static value_converter_t* value_converter_get(const char* name) {
 static ret_t value_converter_put(const char* name, value_converter_t* c) {
   return_value_if_fail(name != NULL && c != NULL, RET_BAD_PARAMS);
 
-  return object_set_prop_object(s_factory->cache, name, OBJECT(c));
+  return registry_set(&(s_factory->cache), name, object_ref(OBJECT(c)));
 }
 
 value_converter_t* value_converter_create(const char* name) {
@@ -134,7 +204,7 @@ ret_t value_converter_register(const char* name, tk_create_t create) {
   return_value_if_fail(name != NULL, RET_BAD_PARAMS);
   return_value_if_fail(create != NULL && s_factory != NULL, RET_BAD_PARAMS);
 
-  return object_set_prop_pointer(s_factory->creators, name, create);
+  return registry_set(&(s_factory->creators), name, create);
 }
 
 ret_t value_converter_register_generic(value_converter_create_t create) {
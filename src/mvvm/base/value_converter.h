@@ -34,6 +34,10 @@ typedef ret_t (*value_converter_to_model_t)(value_converter_t* converter, const
                                             value_t* to);
 typedef ret_t (*value_converter_to_view_t)(value_converter_t* converter, const value_t* from,
                                            value_t* to);
+typedef ret_t (*value_converter_to_model_batch_t)(value_converter_t* converter,
+                                                  const value_t* from, value_t* to, uint32_t nr);
+typedef ret_t (*value_converter_to_view_batch_t)(value_converter_t* converter,
+                                                 const value_t* from, value_t* to, uint32_t nr);
 
 /**
  * @class value_converter_t
@@ -43,6 +47,9 @@ typedef ret_t (*value_converter_to_view_t)(value_converter_t* converter, const v
  *
  * 如果数据在View上显示的格式和在Model中保存的格式不一样，value_converter负责在两者之间转换。
  *
+ * 列表中同一列的数据可以一次批量转换。转换器可以提供to_view_batch/to_model_batch，
+ * 减少逐个调用的开销(比如JS转换器每次调用都要进出脚本引擎)，没有提供时逐个转换。
+ *
  */
 struct _value_converter_t {
   object_t object;
@@ -50,6 +57,8 @@ struct _value_converter_t {
   /*private*/
   value_converter_to_model_t to_model;
   value_converter_to_view_t to_view;
+  value_converter_to_model_batch_t to_model_batch;
+  value_converter_to_view_batch_t to_view_batch;
 };
 
 /**
@@ -76,6 +85,50 @@ ret_t value_converter_to_model(value_converter_t* converter, const value_t* from
  */
 ret_t value_converter_to_view(value_converter_t* converter, const value_t* from, value_t* to);
 
+/**
+ * @method value_converter_to_model_batch
+ * 批量将value转换成适合model存储的格式。
+ *
+ *> 与单个转换不同，每个转换结果都是独立的(不引用转换器内部的缓冲区)，用完之后调用value_reset释放。
+ *
+ * @param {value_converter_t*} converter converter对象。
+ * @param {const value_t*} from 源value的数组。
+ * @param {value_t*} to 转换结果的数组。
+ * @param {uint32_t} nr 个数。
+ *
+ * @return {ret_t} 返回RET_OK表示全部成功，否则表示失败(失败时to中没有需要释放的值)。
+ */
+ret_t value_converter_to_model_batch(value_converter_t* converter, const value_t* from, value_t* to,
+                                     uint32_t nr);
+
+/**
+ * @method value_converter_to_view_batch
+ * 批量将value转换成适合view显示的格式。
+ *
+ *> 与单个转换不同，每个转换结果都是独立的(不引用转换器内部的缓冲区)，用完之后调用value_reset释放。
+ *
+ * @param {value_converter_t*} converter converter对象。
+ * @param {const value_t*} from 源value的数组。
+ * @param {value_t*} to 转换结果的数组。
+ * @param {uint32_t} nr 个数。
+ *
+ * @return {ret_t} 返回RET_OK表示全部成功，否则表示失败(失败时to中没有需要释放的值)。
+ */
+ret_t value_converter_to_view_batch(value_converter_t* converter, const value_t* from, value_t* to,
+                                    uint32_t nr);
+
+/**
+ * @method value_converter_hold_result
+ * 把单个转换的结果变成独立的值(复制引用转换器内部缓冲区的字符串)，用于实现批量转换。
+ *
+ * @annotation ["static"]
+ * @param {value_t*} to 独立的值。
+ * @param {value_t*} result 单个转换的结果(之后不需要再释放)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t value_converter_hold_result(value_t* to, value_t* result);
+
 /**
  * @method value_converter_create
  * 创建指定名称的值转换器。
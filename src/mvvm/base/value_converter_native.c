@@ -0,0 +1,504 @@
+﻿/**
+ * File:   value_converter_native.c
+ * Author: AWTK Develop Team
+ * Brief:  built-in native value converters
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "mvvm/base/value_converter_native.h"
+
+#define NATIVE_MAX_DECIMALS 10
+#define NATIVE_DEFAULT_DATETIME_FORMAT "YYYY-MM-DD hh:mm:ss"
+
+typedef enum _native_type_t {
+  NATIVE_LINEAR = 0,
+  NATIVE_ENUM,
+  NATIVE_THOUSANDS,
+  NATIVE_DATETIME
+} native_type_t;
+
+static ret_t value_converter_native_on_destroy(object_t* obj) {
+  value_converter_native_t* native = VALUE_CONVERTER_NATIVE(obj);
+
+  TKMEM_FREE(native->items);
+  TKMEM_FREE(native->args);
+
+  return RET_OK;
+}
+
+static const object_vtable_t s_value_converter_native_vtable = {
+    .type = "value_converter_native",
+    .desc = "value_converter_native",
+    .size = sizeof(value_converter_native_t),
+    .is_collection = FALSE,
+    .on_destroy = value_converter_native_on_destroy};
+
+static bool_t native_parse_number(const char* str, double* v) {
+  char* end = NULL;
+
+  if (str == NULL || *str == '\0') {
+    return FALSE;
+  }
+
+  *v = strtod(str, &end);
+
+  return *end == '\0';
+}
+
+static bool_t native_parse_decimals(const char* str, int32_t* decimals) {
+  double v = 0;
+
+  if (str == NULL || *str == '\0') {
+    *decimals = -1;
+    return TRUE;
+  }
+
+  if (!native_parse_number(str, &v) || v < 0 || v > NATIVE_MAX_DECIMALS || v != (int32_t)v) {
+    return FALSE;
+  }
+  *decimals = (int32_t)v;
+
+  return TRUE;
+}
+
+static ret_t native_set_number(value_t* to, double v, int32_t decimals) {
+  char str[64];
+
+  if (decimals < 0) {
+    value_set_double(to, v);
+  } else {
+    tk_snprintf(str, sizeof(str), "%.*f", decimals, v);
+    value_dup_str(to, str);
+  }
+
+  return RET_OK;
+}
+
+static ret_t native_set_model_number(value_t* to, double v) {
+  double r = floor(v + 0.5);
+
+  if (fabs(v - r) < 1e-6 * (fabs(v) > 1 ? fabs(v) : 1) && r >= INT32_MIN && r <= INT32_MAX) {
+    value_set_int(to, (int32_t)r);
+  } else {
+    value_set_double(to, v);
+  }
+
+  return RET_OK;
+}
+
+static ret_t native_linear_to_view(value_converter_native_t* native, const value_t* from,
+                                   value_t* to) {
+  return native_set_number(to, value_double(from) * native->k + native->b, native->decimals);
+}
+
+static ret_t native_linear_to_model(value_converter_native_t* native, const value_t* from,
+                                    value_t* to) {
+  return native_set_model_number(to, (value_double(from) - native->b) / native->k);
+}
+
+static ret_t native_enum_to_view(value_converter_native_t* native, const value_t* from,
+                                 value_t* to) {
+  int32_t index = value_int(from);
+  return_value_if_fail(index >= 0 && index < (int32_t)(native->items_nr), RET_NOT_FOUND);
+
+  value_set_str(to, native->items[index]);
+
+  return RET_OK;
+}
+
+static ret_t native_enum_to_model(value_converter_native_t* native, const value_t* from,
+                                  value_t* to) {
+  uint32_t i = 0;
+  const char* str = NULL;
+
+  if (from->type != VALUE_TYPE_STRING) {
+    value_set_int(to, value_int(from));
+    return RET_OK;
+  }
+
+  str = value_str(from);
+  for (i = 0; i < native->items_nr; i++) {
+    if (tk_str_eq(native->items[i], str)) {
+      value_set_int(to, i);
+      return RET_OK;
+    }
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static ret_t native_thousands_to_view(value_converter_native_t* native, const value_t* from,
+                                      value_t* to) {
+  char num[64];
+  char str[96];
+  uint32_t i = 0;
+  uint32_t n = 0;
+  uint32_t len = 0;
+  uint32_t digits = 0;
+  double v = value_double(from);
+  int32_t decimals = native->decimals < 0 ? 0 : native->decimals;
+
+  tk_snprintf(num, sizeof(num), "%.*f", decimals, fabs(v));
+  for (digits = 0; num[digits] >= '0' && num[digits] <= '9'; digits++) {
+  }
+
+  if (v < 0 && strspn(num, "0.") != strlen(num)) {
+    str[len++] = '-';
+  }
+
+  for (i = 0, n = digits; i < digits; i++, n--) {
+    if (i > 0 && n % 3 == 0) {
+      str[len++] = ',';
+    }
+    str[len++] = num[i];
+  }
+  tk_strncpy(str + len, num + digits, sizeof(str) - len - 1);
+  value_dup_str(to, str);
+
+  return RET_OK;
+}
+
+static ret_t native_thousands_to_model(value_converter_native_t* native, const value_t* from,
+                                       value_t* to) {
+  char num[64];
+  double v = 0;
+  uint32_t len = 0;
+  const char* p = NULL;
+
+  if (from->type != VALUE_TYPE_STRING) {
+    v = value_double(from);
+  } else {
+    for (p = value_str(from); p != NULL && *p && len + 1 < sizeof(num); p++) {
+      if (*p != ',' && *p != ' ') {
+        num[len++] = *p;
+      }
+    }
+    num[len] = '\0';
+    return_value_if_fail(native_parse_number(num, &v), RET_BAD_PARAMS);
+  }
+
+  if (native->decimals > 0) {
+    value_set_double(to, v);
+  } else {
+    value_set_int64(to, (int64_t)floor(v + 0.5));
+  }
+
+  return RET_OK;
+}
+
+/*http://howardhinnant.github.io/date_algorithms.html*/
+static int64_t native_days_from_civil(int64_t y, int32_t m, int32_t d) {
+  int64_t era = 0;
+  int64_t yoe = 0;
+  int64_t doy = 0;
+  int64_t doe = 0;
+
+  y -= m <= 2;
+  era = (y >= 0 ? y : y - 399) / 400;
+  yoe = y - era * 400;
+  doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+  return era * 146097 + doe - 719468;
+}
+
+static void native_civil_from_days(int64_t z, int64_t* y, int32_t* m, int32_t* d) {
+  int64_t era = 0;
+  int64_t doe = 0;
+  int64_t yoe = 0;
+  int64_t doy = 0;
+  int64_t mp = 0;
+
+  z += 719468;
+  era = (z >= 0 ? z : z - 146096) / 146097;
+  doe = z - era * 146097;
+  yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  mp = (5 * doy + 2) / 153;
+  *d = (int32_t)(doy - (153 * mp + 2) / 5 + 1);
+  *m = (int32_t)(mp < 10 ? mp + 3 : mp - 9);
+  *y = yoe + era * 400 + (*m <= 2);
+}
+
+/*返回format当前位置的字段在fields中的序号(年月日时分秒)，并设置字段的宽度*/
+static int32_t native_datetime_field(const char* p, uint32_t* width) {
+  static const char* s_fields[] = {"YYYY", "MM", "DD", "hh", "mm", "ss"};
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(s_fields); i++) {
+    if (tk_str_start_with(p, s_fields[i])) {
+      *width = strlen(s_fields[i]);
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+static ret_t native_datetime_to_view(value_converter_native_t* native, const value_t* from,
+                                     value_t* to) {
+  str_t str;
+  int64_t y = 0;
+  int32_t m = 0;
+  int32_t d = 0;
+  char field[32];
+  uint32_t width = 0;
+  const char* p = native->format;
+  int64_t t = value_int64(from);
+  int64_t days = (t >= 0 ? t : t - 86399) / 86400;
+  int64_t secs = t - days * 86400;
+  int64_t fields[6];
+
+  native_civil_from_days(days, &y, &m, &d);
+  fields[0] = y;
+  fields[1] = m;
+  fields[2] = d;
+  fields[3] = secs / 3600;
+  fields[4] = (secs / 60) % 60;
+  fields[5] = secs % 60;
+
+  return_value_if_fail(str_init(&str, 32) != NULL, RET_OOM);
+  while (*p) {
+    int32_t i = native_datetime_field(p, &width);
+    if (i >= 0) {
+      tk_snprintf(field, sizeof(field), "%0*lld", (int)width, (long long)fields[i]);
+      str_append(&str, field);
+      p += width;
+    } else {
+      str_append_char(&str, *p++);
+    }
+  }
+
+  value_dup_str(to, str.str);
+  str_reset(&str);
+
+  return RET_OK;
+}
+
+static ret_t native_datetime_to_model(value_converter_native_t* native, const value_t* from,
+                                      value_t* to) {
+  uint32_t width = 0;
+  const char* p = native->format;
+  const char* s = NULL;
+  int64_t fields[6] = {1970, 1, 1, 0, 0, 0};
+
+  if (from->type != VALUE_TYPE_STRING) {
+    value_set_int64(to, value_int64(from));
+    return RET_OK;
+  }
+
+  s = value_str(from);
+  return_value_if_fail(s != NULL, RET_BAD_PARAMS);
+
+  while (*p) {
+    int32_t i = native_datetime_field(p, &width);
+    if (i >= 0) {
+      uint32_t n = 0;
+      int64_t v = 0;
+      for (n = 0; n < width && *s >= '0' && *s <= '9'; n++, s++) {
+        v = v * 10 + (*s - '0');
+      }
+      return_value_if_fail(n > 0, RET_BAD_PARAMS);
+      fields[i] = v;
+      p += width;
+    } else {
+      return_value_if_fail(*s == *p, RET_BAD_PARAMS);
+      p++;
+      s++;
+    }
+  }
+  return_value_if_fail(*s == '\0', RET_BAD_PARAMS);
+  return_value_if_fail(fields[1] >= 1 && fields[1] <= 12, RET_BAD_PARAMS);
+  return_value_if_fail(fields[2] >= 1 && fields[2] <= 31, RET_BAD_PARAMS);
+  return_value_if_fail(fields[3] < 24 && fields[4] < 60 && fields[5] < 60, RET_BAD_PARAMS);
+
+  value_set_int64(to, native_days_from_civil(fields[0], (int32_t)fields[1], (int32_t)fields[2]) *
+                              86400 +
+                          fields[3] * 3600 + fields[4] * 60 + fields[5]);
+
+  return RET_OK;
+}
+
+static ret_t value_converter_native_to_view(value_converter_t* c, const value_t* from,
+                                            value_t* to) {
+  value_converter_native_t* native = VALUE_CONVERTER_NATIVE(c);
+
+  switch (native->type) {
+    case NATIVE_LINEAR: {
+      return native_linear_to_view(native, from, to);
+    }
+    case NATIVE_ENUM: {
+      return native_enum_to_view(native, from, to);
+    }
+    case NATIVE_THOUSANDS: {
+      return native_thousands_to_view(native, from, to);
+    }
+    case NATIVE_DATETIME: {
+      return native_datetime_to_view(native, from, to);
+    }
+    default:
+      break;
+  }
+
+  return RET_NOT_IMPL;
+}
+
+static ret_t value_converter_native_to_model(value_converter_t* c, const value_t* from,
+                                             value_t* to) {
+  value_converter_native_t* native = VALUE_CONVERTER_NATIVE(c);
+
+  switch (native->type) {
+    case NATIVE_LINEAR: {
+      return native_linear_to_model(native, from, to);
+    }
+    case NATIVE_ENUM: {
+      return native_enum_to_model(native, from, to);
+    }
+    case NATIVE_THOUSANDS: {
+      return native_thousands_to_model(native, from, to);
+    }
+    case NATIVE_DATETIME: {
+      return native_datetime_to_model(native, from, to);
+    }
+    default:
+      break;
+  }
+
+  return RET_NOT_IMPL;
+}
+
+/*把参数按":"切分成items(原地修改args)*/
+static ret_t value_converter_native_split(value_converter_native_t* native) {
+  char* p = native->args;
+  uint32_t nr = 1;
+
+  for (p = native->args; *p; p++) {
+    nr += *p == ':';
+  }
+
+  native->items = TKMEM_ZALLOCN(char*, nr);
+  return_value_if_fail(native->items != NULL, RET_OOM);
+
+  native->items[native->items_nr++] = native->args;
+  for (p = native->args; *p; p++) {
+    if (*p == ':') {
+      *p = '\0';
+      native->items[native->items_nr++] = p + 1;
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t value_converter_native_parse(value_converter_native_t* native, const char* type) {
+  char** items = native->items;
+  uint32_t nr = native->items_nr;
+
+  if (tk_str_eq(type, "scale")) {
+    native->type = NATIVE_LINEAR;
+    if (nr < 1 || nr > 2 || !native_parse_number(items[0], &(native->k)) ||
+        !native_parse_decimals(nr > 1 ? items[1] : NULL, &(native->decimals))) {
+      return RET_BAD_PARAMS;
+    }
+    native->b = 0;
+  } else if (tk_str_eq(type, "linear")) {
+    native->type = NATIVE_LINEAR;
+    if (nr < 2 || nr > 3 || !native_parse_number(items[0], &(native->k)) ||
+        !native_parse_number(items[1], &(native->b)) ||
+        !native_parse_decimals(nr > 2 ? items[2] : NULL, &(native->decimals))) {
+      return RET_BAD_PARAMS;
+    }
+  } else if (tk_str_eq(type, "enum")) {
+    native->type = NATIVE_ENUM;
+  } else if (tk_str_eq(type, "thousands")) {
+    native->type = NATIVE_THOUSANDS;
+    if (nr > 1 || !native_parse_decimals(items[0], &(native->decimals))) {
+      return RET_BAD_PARAMS;
+    }
+  } else {
+    return RET_NOT_FOUND;
+  }
+
+  if (native->type == NATIVE_LINEAR && native->k == 0) {
+    return RET_BAD_PARAMS;
+  }
+
+  return RET_OK;
+}
+
+value_converter_t* value_converter_native_create(const char* name) {
+  object_t* obj = NULL;
+  char type[TK_NAME_LEN + 1];
+  value_converter_t* value_convert = NULL;
+  value_converter_native_t* native = NULL;
+  const char* args = NULL;
+  return_value_if_fail(name != NULL, NULL);
+
+  /*只认带参数(含":")的名称，其它名称(如JS中定义的datetime)留给别的转换器*/
+  args = strchr(name, ':');
+  if (args == NULL || args - name > TK_NAME_LEN) {
+    return NULL;
+  }
+
+  memset(type, 0x00, sizeof(type));
+  tk_strncpy(type, name, args - name);
+  if (!tk_str_eq(type, "scale") && !tk_str_eq(type, "linear") && !tk_str_eq(type, "enum") &&
+      !tk_str_eq(type, "thousands") && !tk_str_eq(type, "datetime")) {
+    return NULL;
+  }
+
+  obj = object_create(&s_value_converter_native_vtable);
+  return_value_if_fail(obj != NULL, NULL);
+
+  value_convert = VALUE_CONVERTER(obj);
+  value_convert->to_view = value_converter_native_to_view;
+  value_convert->to_model = value_converter_native_to_model;
+
+  native = VALUE_CONVERTER_NATIVE(obj);
+  native->decimals = -1;
+
+  if (tk_str_eq(type, "datetime")) {
+    native->type = NATIVE_DATETIME;
+    native->args = tk_strdup(args[1] != '\0' ? args + 1 : NATIVE_DEFAULT_DATETIME_FORMAT);
+    native->format = native->args;
+    goto_error_if_fail(native->args != NULL);
+
+    return value_convert;
+  }
+
+  native->args = tk_strdup(args + 1);
+  goto_error_if_fail(native->args != NULL);
+  goto_error_if_fail(value_converter_native_split(native) == RET_OK);
+  if (value_converter_native_parse(native, type) != RET_OK) {
+    log_warn("%s: invalid arguments of \"%s\"\n", __FUNCTION__, name);
+    goto error;
+  }
+
+  return value_convert;
+error:
+  object_unref(obj);
+
+  return NULL;
+}
+
+ret_t value_converter_native_init(void) {
+  return value_converter_register_generic(value_converter_native_create);
+}
@@ -0,0 +1,90 @@
+﻿/**
+ * File:   value_converter_native.h
+ * Author: AWTK Develop Team
+ * Brief:  built-in native value converters
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#ifndef TK_VALUE_CONVERTER_NATIVE_H
+#define TK_VALUE_CONVERTER_NATIVE_H
+
+#include "mvvm/base/value_converter.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class value_converter_native_t
+ * @parent value_converter_t
+ *
+ * 内置的C语言数据格式转换器，参数放在转换器的名称中，用":"分隔：
+ *
+ * * scale:k[:decimals] 定点数/比例缩放。显示值 = 模型值 * k。
+ * * linear:k:b[:decimals] 单位换算。显示值 = 模型值 * k + b(如摄氏度到华氏度为linear:1.8:32)。
+ * * enum:item0:item1:... 整数和字符串之间的映射。
+ * * thousands:[decimals] 带千分位分隔符的数字。
+ * * datetime:[format] 时间(从1970年开始的秒数，UTC)和字符串之间的转换。
+ *   format中的YYYY/MM/DD/hh/mm/ss分别表示年/月/日/时/分/秒，缺省为"YYYY-MM-DD hh:mm:ss"。
+ *
+ * 名称中必须有":"(参数可以为空，如"thousands:")，不带":"的名称(如datetime)留给其它转换器。
+ * 指定了decimals时，显示值为保留decimals位小数的字符串，否则为浮点数。
+ * 转换到模型时，scale/linear的结果接近整数时为整数，这样定点数不会因为舍入误差而少1。
+ *
+ * 比如：
+ *
+ * ```xml
+ * <label v-data:text="{temp, Converter=scale:0.1:1}"/>
+ * ```
+ *
+ */
+typedef struct _value_converter_native_t {
+  value_converter_t value_converter;
+
+  /*private*/
+  int32_t type;
+  double k;
+  double b;
+  int32_t decimals;
+  const char* format;
+  char** items;
+  uint32_t items_nr;
+  char* args;
+} value_converter_native_t;
+
+/**
+ * @method value_converter_native_create
+ * 根据名称创建内置的转换器。
+ *
+ * @annotation ["constructor"]
+ * @param {const char*} name 转换器的名称(含参数)。
+ *
+ * @return {value_converter_t*} 名称不是内置的转换器(不含":")或者参数无效时返回NULL。
+ */
+value_converter_t* value_converter_native_create(const char* name);
+
+/**
+ * @method value_converter_native_init
+ * 注册内置的转换器。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t value_converter_native_init(void);
+
+#define VALUE_CONVERTER_NATIVE(converter) ((value_converter_native_t*)(converter))
+
+END_C_DECLS
+
+#endif /*TK_VALUE_CONVERTER_NATIVE_H*/
@@ -21,7 +21,7 @@
 
 #include "tkc/mem.h"
 #include "tkc/slist.h"
-#include "tkc/object_default.h"
+#include "mvvm/base/registry.h"
 #include "mvvm/base/value_validator.h"
 
 bool_t value_validator_is_valid(value_validator_t* validator, const value_t* value, str_t* msg) {
@@ -44,8 +44,8 @@ ret_t value_validator_fix(value_validator_t* validator, value_t* value) {
 }
 
 typedef struct _value_validator_factory_t {
-  object_t* cache;
-  object_t* creators;
+  registry_t cache;
+  registry_t creators;
   slist_t generic_creators;
 } value_validator_factory_t;
 
@@ -55,8 +55,8 @@ static value_validator_factory_t* value_validator_factory_create(void) {
   value_validator_factory_t* factory = TKMEM_ZALLOC(value_validator_factory_t);
   return_value_if_fail(factory != NULL, NULL);
 
-  factory->cache = object_default_create();
-  factory->creators = object_default_create();
+  registry_init(&(factory->cache), (tk_destroy_t)object_unref);
+  registry_init(&(factory->creators), NULL);
   slist_init(&(factory->generic_creators), NULL, NULL);
 
   return factory;
@@ -65,8 +65,8 @@ static value_validator_factory_t* value_validator_factory_create(void) {
 static ret_t value_validator_factory_destroy(value_validator_factory_t* factory) {
   return_value_if_fail(factory != NULL, RET_BAD_PARAMS);
 
-  object_unref(factory->cache);
-  object_unref(factory->creators);
+  registry_deinit(&(factory->cache));
+  registry_deinit(&(factory->creators));
   slist_deinit(&(factory->generic_creators));
 
   return RET_OK;
@@ -90,7 +90,7 @@ value_validator_t* value_validator_do_create(const char* name) {
   tk_create_t create = NULL;
   return_value_if_fail(name != NULL && s_factory != NULL, NULL);
 
-  create = (tk_create_t)object_get_prop_pointer(s_factory->creators, name);
+  create = (tk_create_t)registry_get(&(s_factory->creators), name);
   if (create != NULL) {
     return (value_validator_t*)create();
   } else {
@@ -99,7 +99,7 @@ value_validator_t* value_validator_do_create(const char* name) {
 }
 
 static value_validator_t* value_validator_get(const char* name) {
-  object_t* obj = object_get_prop_object(s_factory->cache, name);
+  object_t* obj = OBJECT(registry_get(&(s_factory->cache), name));
 
   if (obj != NULL) {
     object_ref(obj);
@@ -111,7 +111,7 @@ static value_validator_t* value_validator_get(const char* name) {
 static ret_t value_validator_put(const char* name, value_validator_t* c) {
   return_value_if_fail(name != NULL && c != NULL, RET_BAD_PARAMS);
 
-  return object_set_prop_object(s_factory->cache, name, OBJECT(c));
+  return registry_set(&(s_factory->cache), name, object_ref(OBJECT(c)));
 }
 
 value_validator_t* value_validator_create(const char* name) {
@@ -150,7 +150,7 @@ ret_t value_validator_register(const char* name, tk_create_t create) {
   return_value_if_fail(name != NULL, RET_BAD_PARAMS);
   return_value_if_fail(create != NULL && s_factory != NULL, RET_BAD_PARAMS);
 
-  return object_set_prop_pointer(s_factory->creators, name, create);
+  return registry_set(&(s_factory->creators), name, create);
 }
 
 ret_t value_validator_register_generic(value_validator_create_t create) {
@@ -19,15 +19,19 @@
  *
  */
 
+#include "tkc/fs.h"
+#include "tkc/mem.h"
 #include "tkc/str.h"
 #include "tkc/utils.h"
 #include "tkc/expr_eval.h"
+#include "mvvm/base/typed_expr.h"
 #include "mvvm/base/view_model.h"
 
 view_model_t* view_model_init(view_model_t* view_model) {
   return_value_if_fail(view_model != NULL, NULL);
 
   str_init(&(view_model->last_error), 0);
+  str_init(&(view_model->eval_buff), 0);
   view_model->preprocess_expr = NULL;
   view_model->preprocess_prop = NULL;
 
@@ -38,6 +42,7 @@ ret_t view_model_deinit(view_model_t* view_model) {
   return_value_if_fail(view_model != NULL, RET_BAD_PARAMS);
 
   str_reset(&(view_model->last_error));
+  str_reset(&(view_model->eval_buff));
 
   return RET_OK;
 }
@@ -155,6 +160,214 @@ ret_t view_model_set_prop(view_model_t* view_model, const char* name, const valu
   return object_set_prop_if_diff(OBJECT(view_model), name, value);
 }
 
+int32_t view_model_get_prop_id(view_model_t* view_model, const char* name) {
+  return_value_if_fail(view_model != NULL && name != NULL, VIEW_MODEL_PROP_ID_INVALID);
+
+  if (view_model->vt != NULL && view_model->vt->get_prop_id != NULL) {
+    return view_model->vt->get_prop_id(view_model, name);
+  }
+
+  return VIEW_MODEL_PROP_ID_INVALID;
+}
+
+ret_t view_model_get_prop_by_id(view_model_t* view_model, int32_t id, value_t* value) {
+  return_value_if_fail(view_model != NULL && value != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(id != VIEW_MODEL_PROP_ID_INVALID, RET_BAD_PARAMS);
+
+  if (view_model->vt != NULL && view_model->vt->get_prop_by_id != NULL) {
+    return view_model->vt->get_prop_by_id(view_model, id, value);
+  }
+
+  return RET_NOT_IMPL;
+}
+
+static bool_t view_model_has_dirty_props(view_model_t* view_model) {
+  return view_model->vt != NULL && view_model->vt->get_dirty_props != NULL &&
+         view_model->vt->clear_dirty_props != NULL;
+}
+
+ret_t view_model_set_prop_by_id(view_model_t* view_model, int32_t id, const value_t* value) {
+  value_t old;
+  ret_t ret = RET_NOT_IMPL;
+  return_value_if_fail(view_model != NULL && value != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(id != VIEW_MODEL_PROP_ID_INVALID, RET_BAD_PARAMS);
+
+  if (view_model->vt == NULL || view_model->vt->set_prop_by_id == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  /*支持脏属性的模型在set_prop_by_id中比较新旧值，值变化时才标记脏位*/
+  if (!view_model_has_dirty_props(view_model)) {
+    value_set_int(&old, 0);
+    if (view_model_get_prop_by_id(view_model, id, &old) == RET_OK) {
+      if (value_equal(&old, value)) {
+        return RET_OK;
+      }
+    }
+  }
+
+  ret = view_model->vt->set_prop_by_id(view_model, id, value);
+  if (ret == RET_OK) {
+    if (view_model_notify_dirty_props(view_model) == RET_OK ||
+        !view_model_has_dirty_props(view_model)) {
+      emitter_dispatch_simple_event(EMITTER(view_model), EVT_PROP_CHANGED);
+    }
+  }
+
+  return ret;
+}
+
+static ret_t view_model_publish_dirty_props(view_model_t* view_model, bool_t all) {
+  uint32_t i = 0;
+  uint32_t size = 0;
+  const uint32_t* dirty = NULL;
+  view_model_props_dirty_event_t e;
+
+  if (!view_model_has_dirty_props(view_model)) {
+    return RET_NOT_FOUND;
+  }
+
+  dirty = view_model->vt->get_dirty_props(view_model, &size);
+  for (i = 0; dirty != NULL && i < size; i++) {
+    if (dirty[i] != 0) {
+      break;
+    }
+  }
+
+  if (!all && (dirty == NULL || i >= size)) {
+    return RET_NOT_FOUND;
+  }
+
+  e.all = all;
+  e.dirty = dirty;
+  e.size = dirty != NULL ? size : 0;
+  e.e = event_init(EVT_VIEW_MODEL_PROPS_DIRTY, view_model);
+  emitter_dispatch(EMITTER(view_model), (event_t*)&e);
+
+  return view_model->vt->clear_dirty_props(view_model);
+}
+
+ret_t view_model_notify_dirty_props(view_model_t* view_model) {
+  return_value_if_fail(view_model != NULL, RET_BAD_PARAMS);
+
+  return view_model_publish_dirty_props(view_model, FALSE);
+}
+
+ret_t view_model_begin_update(view_model_t* view_model) {
+  return_value_if_fail(view_model != NULL, RET_BAD_PARAMS);
+
+  if (view_model->vt != NULL && view_model->vt->begin_update != NULL) {
+    return view_model->vt->begin_update(view_model);
+  }
+
+  return RET_OK;
+}
+
+ret_t view_model_end_update(view_model_t* view_model) {
+  return_value_if_fail(view_model != NULL, RET_BAD_PARAMS);
+
+  if (view_model->vt != NULL && view_model->vt->end_update != NULL) {
+    return view_model->vt->end_update(view_model);
+  }
+
+  return RET_OK;
+}
+
+ret_t view_model_get_row_props(view_model_t* view_model, uint32_t index, const char** names,
+                               value_t* values, uint32_t nr) {
+  return_value_if_fail(view_model != NULL && names != NULL && values != NULL, RET_BAD_PARAMS);
+
+  if (view_model->vt == NULL || view_model->vt->get_row_props == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  return view_model->vt->get_row_props(view_model, index, names, values, nr);
+}
+
+ret_t view_model_save_snapshot(view_model_t* view_model, view_model_snapshot_t* snapshot) {
+  return_value_if_fail(view_model != NULL && snapshot != NULL, RET_BAD_PARAMS);
+
+  if (view_model->vt == NULL || view_model->vt->save_snapshot == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  return view_model->vt->save_snapshot(view_model, snapshot);
+}
+
+ret_t view_model_load_snapshot(view_model_t* view_model, view_model_snapshot_t* snapshot) {
+  ret_t ret = RET_OK;
+  return_value_if_fail(view_model != NULL && snapshot != NULL, RET_BAD_PARAMS);
+
+  if (view_model->vt == NULL || view_model->vt->load_snapshot == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  ret = view_model->vt->load_snapshot(view_model, snapshot);
+
+  /*逐个恢复的属性不单独通知，最后统一刷新*/
+  if (view_model->vt->clear_dirty_props != NULL) {
+    view_model->vt->clear_dirty_props(view_model);
+  }
+
+  if (object_is_collection(OBJECT(view_model))) {
+    emitter_dispatch_simple_event(EMITTER(view_model), EVT_ITEMS_CHANGED);
+  } else {
+    view_model_notify_props_changed(view_model);
+  }
+
+  return ret;
+}
+
+ret_t view_model_save_snapshot_to_file(view_model_t* view_model, const char* filename) {
+  ret_t ret = RET_OK;
+  uint32_t size = 0;
+  const void* data = NULL;
+  view_model_snapshot_t snapshot;
+  return_value_if_fail(view_model != NULL && filename != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(view_model_snapshot_init(&snapshot) != NULL, RET_OOM);
+
+  ret = view_model_save_snapshot(view_model, &snapshot);
+  if (ret == RET_OK) {
+    data = view_model_snapshot_get_data(&snapshot, &size);
+    if (file_write(filename, data, size) != (int32_t)size) {
+      ret = RET_IO;
+    }
+  }
+  view_model_snapshot_deinit(&snapshot);
+
+  return ret;
+}
+
+ret_t view_model_load_snapshot_from_data(view_model_t* view_model, const void* data,
+                                         uint32_t size) {
+  ret_t ret = RET_OK;
+  view_model_snapshot_t snapshot;
+  return_value_if_fail(view_model != NULL && data != NULL, RET_BAD_PARAMS);
+
+  ret = view_model_snapshot_attach(&snapshot, data, size);
+  if (ret == RET_OK) {
+    ret = view_model_load_snapshot(view_model, &snapshot);
+  }
+  view_model_snapshot_deinit(&snapshot);
+
+  return ret;
+}
+
+ret_t view_model_load_snapshot_from_file(view_model_t* view_model, const char* filename) {
+  ret_t ret = RET_OK;
+  uint32_t size = 0;
+  uint8_t* data = NULL;
+  return_value_if_fail(view_model != NULL && filename != NULL, RET_BAD_PARAMS);
+
+  data = file_read(filename, &size);
+  return_value_if_fail(data != NULL, RET_IO);
+
+  ret = view_model_load_snapshot_from_data(view_model, data, size);
+  TKMEM_FREE(data);
+
+  return ret;
+}
+
 bool_t view_model_can_exec(view_model_t* view_model, const char* name, const char* args) {
   return_value_if_fail(view_model != NULL && name != NULL, FALSE);
   if (object_is_collection(OBJECT(view_model))) {
@@ -183,6 +396,8 @@ ret_t view_model_exec(view_model_t* view_model, const char* name, const char* ar
   }
 
   if (ret == RET_OBJECT_CHANGED) {
+    /*命令可能直接修改了模型的字段，发布已有的脏属性并要求全部刷新*/
+    view_model_publish_dirty_props(view_model, TRUE);
     emitter_dispatch_simple_event(EMITTER(view_model), EVT_PROP_CHANGED);
   } else if (ret == RET_ITEMS_CHANGED) {
     emitter_dispatch_simple_event(EMITTER(view_model), EVT_ITEMS_CHANGED);
@@ -191,6 +406,28 @@ ret_t view_model_exec(view_model_t* view_model, const char* name, const char* ar
   return ret;
 }
 
+#ifdef WITH_MVVM_TYPED_EXPR
+static ret_t vm_get_typed_variable(void* ctx, const char* name, value_t* v) {
+  return view_model_get_prop(VIEW_MODEL(ctx), name, v);
+}
+
+static ret_t view_model_eval_expr(view_model_t* view_model, const char* expr, value_t* v) {
+  if (typed_expr_eval(expr, vm_get_typed_variable, view_model, &(view_model->eval_buff), v) !=
+      RET_OK) {
+    log_warn("expr error: %s\n", expr);
+    value_set_int(v, 0);
+    return RET_FAIL;
+  }
+
+  /*字符串结果在eval_buff中，下次求值时会被覆盖，和eval_execute一样返回一份拷贝*/
+  if (v->type == VALUE_TYPE_STRING) {
+    const char* str = value_str(v);
+    value_dup_str(v, str);
+  }
+
+  return RET_OK;
+}
+#else
 static EvalFunc vm_get_func(const char* name, void* user_data) {
   const EvalHooks* hooks = eval_default_hooks();
 
@@ -216,6 +453,37 @@ static EvalResult vm_get_variable(const char* name, void* user_data, ExprValue*
   return hooks->get_variable(name, user_data, output);
 }
 
+static ret_t view_model_eval_expr(view_model_t* view_model, const char* expr, value_t* v) {
+  EvalHooks hooks;
+  ExprValue result;
+  EvalResult ret;
+
+  hooks.get_func = vm_get_func;
+  hooks.get_variable = vm_get_variable;
+
+  ret = eval_execute(expr, &hooks, (void*)view_model, &result);
+  if (ret == EVAL_RESULT_OK) {
+    if (result.type == EXPR_VALUE_TYPE_STRING) {
+      value_dup_str(v, result.v.str.str);
+    } else {
+      double res = result.v.val;
+      if (res > (int64_t)res) {
+        value_set_double(v, res);
+      } else {
+        value_set_int64(v, (int64_t)res);
+      }
+    }
+    expr_value_clear(&result);
+
+    return RET_OK;
+  } else {
+    log_warn("expr error: %s\n", eval_result_to_string(ret));
+    value_set_int(v, 0);
+    return RET_FAIL;
+  }
+}
+#endif /*WITH_MVVM_TYPED_EXPR*/
+
 ret_t view_model_eval(view_model_t* view_model, const char* expr, value_t* v) {
   object_t* obj = OBJECT(view_model);
   return_value_if_fail(expr != NULL && v != NULL, RET_BAD_PARAMS);
@@ -225,36 +493,14 @@ ret_t view_model_eval(view_model_t* view_model, const char* expr, value_t* v) {
   if (tk_is_valid_name(expr)) {
     return view_model_get_prop(view_model, expr, v);
   } else {
-    EvalHooks hooks;
-    ExprValue result;
-    EvalResult ret;
-
-    hooks.get_func = vm_get_func;
-    hooks.get_variable = vm_get_variable;
-
-    ret = eval_execute(expr, &hooks, (void*)view_model, &result);
-    if (ret == EVAL_RESULT_OK) {
-      if (result.type == EXPR_VALUE_TYPE_STRING) {
-        value_dup_str(v, result.v.str.str);
-      } else {
-        double res = result.v.val;
-        if (res > (int64_t)res) {
-          value_set_double(v, res);
-        } else {
-          value_set_int64(v, (int64_t)res);
-        }
-      }
-      expr_value_clear(&result);
-
-      return RET_OK;
-    } else {
-      log_warn("expr error: %s\n", eval_result_to_string(ret));
-      value_set_int(v, 0);
-      return RET_FAIL;
-    }
+    return view_model_eval_expr(view_model, expr, v);
   }
 }
 
 ret_t view_model_notify_props_changed(view_model_t* view_model) {
+  return_value_if_fail(view_model != NULL, RET_BAD_PARAMS);
+
+  view_model_publish_dirty_props(view_model, TRUE);
+
   return emitter_dispatch_simple_event(EMITTER(view_model), EVT_PROPS_CHANGED);
 }
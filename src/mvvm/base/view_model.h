@@ -25,6 +25,7 @@
 #include "tkc/str.h"
 #include "tkc/object.h"
 #include "mvvm/base/navigator_request.h"
+#include "mvvm/base/view_model_snapshot.h"
 
 BEGIN_C_DECLS
 
@@ -38,6 +39,22 @@ typedef ret_t (*view_model_on_unmount_t)(view_model_t* view_model);
 typedef const char* (*view_model_preprocess_expr_t)(view_model_t* view_model, const char* expr);
 typedef const char* (*view_model_preprocess_prop_t)(view_model_t* view_model, const char* prop);
 
+typedef int32_t (*view_model_get_prop_id_t)(view_model_t* view_model, const char* name);
+typedef ret_t (*view_model_get_prop_by_id_t)(view_model_t* view_model, int32_t id, value_t* v);
+typedef ret_t (*view_model_set_prop_by_id_t)(view_model_t* view_model, int32_t id,
+                                             const value_t* v);
+typedef const uint32_t* (*view_model_get_dirty_props_t)(view_model_t* view_model,
+                                                        uint32_t* size);
+typedef ret_t (*view_model_clear_dirty_props_t)(view_model_t* view_model);
+typedef ret_t (*view_model_save_snapshot_t)(view_model_t* view_model,
+                                            view_model_snapshot_t* snapshot);
+typedef ret_t (*view_model_load_snapshot_t)(view_model_t* view_model,
+                                            view_model_snapshot_t* snapshot);
+typedef ret_t (*view_model_begin_update_t)(view_model_t* view_model);
+typedef ret_t (*view_model_end_update_t)(view_model_t* view_model);
+typedef ret_t (*view_model_get_row_props_t)(view_model_t* view_model, uint32_t index,
+                                            const char** names, value_t* values, uint32_t nr);
+
 typedef view_model_t* (*view_model_create_t)(navigator_request_t* req);
 
 typedef struct _model_vtable_t {
@@ -45,6 +62,24 @@ typedef struct _model_vtable_t {
   view_model_on_mount_t on_mount;
   view_model_on_will_unmount_t on_will_unmount;
   view_model_on_unmount_t on_unmount;
+
+  /*可选：支持按属性ID访问属性(gen_vm.js生成的view model会提供)*/
+  view_model_get_prop_id_t get_prop_id;
+  view_model_get_prop_by_id_t get_prop_by_id;
+  view_model_set_prop_by_id_t set_prop_by_id;
+
+  /*可选：按属性ID记录的脏位集合*/
+  view_model_get_dirty_props_t get_dirty_props;
+  view_model_clear_dirty_props_t clear_dirty_props;
+
+  /*可选：保存/恢复二进制快照*/
+  view_model_save_snapshot_t save_snapshot;
+  view_model_load_snapshot_t load_snapshot;
+
+  /*可选：集合模型一次读取一行的多个属性，begin_update/end_update之间可以缓存行对象*/
+  view_model_begin_update_t begin_update;
+  view_model_end_update_t end_update;
+  view_model_get_row_props_t get_row_props;
 } view_model_vtable_t;
 
 /**
@@ -59,6 +94,7 @@ struct _view_model_t {
 
   /*private*/
   str_t last_error;
+  str_t eval_buff;
   const view_model_vtable_t* vt;
 
   view_model_preprocess_expr_t preprocess_expr;
@@ -163,6 +199,9 @@ bool_t view_model_has_prop(view_model_t* view_model, const char* name);
  * @method view_model_eval
  * 计算表达式的值。
  *
+ *> 定义WITH\_MVVM\_TYPED\_EXPR时使用typed\_expr求值。表达式的结果为字符串时，
+ *> 和eval\_execute一样返回一份拷贝，调用者用value\_reset释放。
+ *
  * @param {view_model_t*} view_model view_model对象。
  * @param {const char*} expr 表达式。
  * @param {value_t*} value 计算结果。
@@ -195,6 +234,151 @@ ret_t view_model_get_prop(view_model_t* view_model, const char* name, value_t* v
  */
 ret_t view_model_set_prop(view_model_t* view_model, const char* name, const value_t* value);
 
+/**
+ * @method view_model_get_prop_id
+ * 获取属性名对应的属性ID。
+ * 数据绑定在绑定时调用本函数，之后用ID读写属性，避免每次刷新都比较字符串。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {const char*} name 属性名。
+ *
+ * @return {int32_t} 返回属性ID，不支持或不存在时返回VIEW_MODEL_PROP_ID_INVALID。
+ */
+int32_t view_model_get_prop_id(view_model_t* view_model, const char* name);
+
+/**
+ * @method view_model_get_prop_by_id
+ * 获取指定ID属性的值。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {int32_t} id 属性ID。
+ * @param {value_t*} value 属性值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_get_prop_by_id(view_model_t* view_model, int32_t id, value_t* value);
+
+/**
+ * @method view_model_set_prop_by_id
+ * 设置指定ID属性的值。值发生变化时触发EVT_PROP_CHANGED事件。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {int32_t} id 属性ID。
+ * @param {const value_t*} value 属性值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_set_prop_by_id(view_model_t* view_model, int32_t id, const value_t* value);
+
+/**
+ * @method view_model_notify_dirty_props
+ * 发布脏属性集合(EVT_VIEW_MODEL_PROPS_DIRTY事件)，然后清除模型中的脏位。
+ * 绑定上下文据此只刷新受影响的数据绑定。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ *
+ * @return {ret_t} 返回RET_OK表示已经发布，模型不支持或者没有脏属性时返回RET_NOT_FOUND。
+ */
+ret_t view_model_notify_dirty_props(view_model_t* view_model);
+
+/**
+ * @method view_model_begin_update
+ * 开始一次刷新(数据绑定把模型的数据更新到界面)。
+ * 在view_model_end_update之前，模型可以缓存读取到的行对象。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_begin_update(view_model_t* view_model);
+
+/**
+ * @method view_model_end_update
+ * 结束一次刷新，模型释放view_model_begin_update之后缓存的数据。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_end_update(view_model_t* view_model);
+
+/**
+ * @method view_model_get_row_props
+ * 一次读取集合模型中指定行的多个属性。
+ * 字符串类型的值会复制一份，调用者需要调用value_reset释放values中的每一项。
+ * 读取失败的项，类型为VALUE_TYPE_INVALID。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} index 行的序数。
+ * @param {const char**} names 属性名数组(不带"[index]."前缀)。
+ * @param {value_t*} values 用于返回属性值的数组。
+ * @param {uint32_t} nr 属性的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，模型不支持时返回RET_NOT_IMPL。
+ */
+ret_t view_model_get_row_props(view_model_t* view_model, uint32_t index, const char** names,
+                               value_t* values, uint32_t nr);
+
+/**
+ * @method view_model_save_snapshot
+ * 把模型的属性保存到快照。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {view_model_snapshot_t*} snapshot 快照对象(已经用view_model_snapshot_init初始化)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，模型不支持时返回RET_NOT_IMPL，否则表示失败。
+ */
+ret_t view_model_save_snapshot(view_model_t* view_model, view_model_snapshot_t* snapshot);
+
+/**
+ * @method view_model_load_snapshot
+ * 从快照恢复模型的属性。快照中不认识的字段被忽略，快照中没有的属性保持不变。
+ * 恢复完成之后只触发一次EVT_PROPS_CHANGED(集合模型为EVT_ITEMS_CHANGED)事件。
+ * 生成的模型先用view_model_snapshot_validate检查整个快照，数据损坏时不修改任何属性。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {view_model_snapshot_t*} snapshot 快照对象(已经用view_model_snapshot_attach关联数据)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，模型不支持时返回RET_NOT_IMPL，否则表示失败。
+ */
+ret_t view_model_load_snapshot(view_model_t* view_model, view_model_snapshot_t* snapshot);
+
+/**
+ * @method view_model_save_snapshot_to_file
+ * 把模型的属性保存到快照文件。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {const char*} filename 文件名。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_save_snapshot_to_file(view_model_t* view_model, const char* filename);
+
+/**
+ * @method view_model_load_snapshot_from_data
+ * 从内存中的快照数据恢复模型的属性。
+ * 数据可以是ROM中的资源或者映射到内存的文件，字符串在恢复时直接从数据中拷贝，不需要额外的缓冲区。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {const void*} data 快照数据。
+ * @param {uint32_t} size 数据的长度。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_load_snapshot_from_data(view_model_t* view_model, const void* data,
+                                         uint32_t size);
+
+/**
+ * @method view_model_load_snapshot_from_file
+ * 从快照文件恢复模型的属性。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {const char*} filename 文件名。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_load_snapshot_from_file(view_model_t* view_model, const char* filename);
+
 /**
  * @method view_model_can_exec
  * 检查指定的命令是否可以执行。
@@ -221,7 +405,7 @@ ret_t view_model_exec(view_model_t* view_model, const char* name, const char* ar
 
 /**
  * @method view_model_notify_props_changed
- * 触发props改变事件。
+ * 触发props改变事件，触发之前先发布模型中尚未发布的脏属性。
  *
  * @param {view_model_t*} view_model view_model对象。
  *
@@ -233,6 +417,7 @@ ret_t view_model_notify_props_changed(view_model_t* view_model);
 
 #define VIEW_MODEL_PROP_CURSOR "index"
 #define VIEW_MODEL_PROP_ITEMS "items"
+#define VIEW_MODEL_PROP_ID_INVALID -1
 
 /**
  * @enum view_model_event_type_t
@@ -265,6 +450,30 @@ typedef enum _model_event_type_t {
    * 视图销毁时通知模型。
    */
   EVT_VIEW_MODEL_UNMOUNT,
+  /**
+   * @const EVT_VIEW_MODEL_PROPS_DIRTY
+   *
+   * 模型的部分属性发生变化(紧接着会触发EVT_PROP_CHANGED或EVT_PROPS_CHANGED)。
+   */
+  EVT_VIEW_MODEL_PROPS_DIRTY,
+  /**
+   * @const EVT_VIEW_MODEL_ITEM_INSERTED
+   *
+   * 集合模型中插入了一项(view_model_item_event_t)。
+   */
+  EVT_VIEW_MODEL_ITEM_INSERTED,
+  /**
+   * @const EVT_VIEW_MODEL_ITEM_REMOVED
+   *
+   * 集合模型中删除了一项(view_model_item_event_t)。
+   */
+  EVT_VIEW_MODEL_ITEM_REMOVED,
+  /**
+   * @const EVT_VIEW_MODEL_ITEM_CHANGED
+   *
+   * 集合模型中一项的属性发生变化，位置不变(view_model_item_event_t)。
+   */
+  EVT_VIEW_MODEL_ITEM_CHANGED,
 } view_model_event_type_t;
 
 /**
@@ -283,6 +492,50 @@ typedef struct _model_will_mount_event_t {
   navigator_request_t* req;
 } view_model_will_mount_event_t;
 
+/**
+ * @class view_model_props_dirty_event_t
+ * @parent event_t
+ * 模型属性变化时发布的脏属性集合。
+ *
+ */
+typedef struct _model_props_dirty_event_t {
+  event_t e;
+
+  /**
+   * @property {bool_t} all
+   * 为TRUE时表示没有标记脏位的属性也可能发生了变化(如执行命令之后)，需要全部刷新。
+   */
+  bool_t all;
+
+  /**
+   * @property {const uint32_t*} dirty
+   * 按属性ID索引的位集合。
+   */
+  const uint32_t* dirty;
+
+  /**
+   * @property {uint32_t} size
+   * 位集合的长度(uint32_t的个数)。
+   */
+  uint32_t size;
+} view_model_props_dirty_event_t;
+
+/**
+ * @class view_model_item_event_t
+ * @parent event_t
+ * 集合模型中单项变化时的数据结构。
+ *
+ */
+typedef struct _model_item_event_t {
+  event_t e;
+
+  /**
+   * @property {uint32_t} index
+   * 变化的项的序数(删除时为删除之前的序数)。
+   */
+  uint32_t index;
+} view_model_item_event_t;
+
 END_C_DECLS
 
 #endif /*TK_VIEW_MODEL_H*/
@@ -94,3 +94,27 @@ ret_t view_model_array_deinit(view_model_t* view_model) {
 ret_t view_model_array_notify_items_changed(view_model_t* view_model) {
   return emitter_dispatch_simple_event(EMITTER(view_model), EVT_ITEMS_CHANGED);
 }
+
+static ret_t view_model_array_notify_item(view_model_t* view_model, uint32_t type,
+                                          uint32_t index) {
+  view_model_item_event_t e;
+  return_value_if_fail(view_model != NULL, RET_BAD_PARAMS);
+
+  memset(&e, 0x00, sizeof(e));
+  e.e = event_init(type, view_model);
+  e.index = index;
+
+  return emitter_dispatch(EMITTER(view_model), (event_t*)&e);
+}
+
+ret_t view_model_array_notify_item_inserted(view_model_t* view_model, uint32_t index) {
+  return view_model_array_notify_item(view_model, EVT_VIEW_MODEL_ITEM_INSERTED, index);
+}
+
+ret_t view_model_array_notify_item_removed(view_model_t* view_model, uint32_t index) {
+  return view_model_array_notify_item(view_model, EVT_VIEW_MODEL_ITEM_REMOVED, index);
+}
+
+ret_t view_model_array_notify_item_changed(view_model_t* view_model, uint32_t index) {
+  return view_model_array_notify_item(view_model, EVT_VIEW_MODEL_ITEM_CHANGED, index);
+}
@@ -103,6 +103,39 @@ ret_t view_model_array_set_cursor(view_model_t* view_model, uint32_t cursor);
  */
 ret_t view_model_array_notify_items_changed(view_model_t* view_model);
 
+/**
+ * @method view_model_array_notify_item_inserted
+ * 触发EVT_VIEW_MODEL_ITEM_INSERTED事件。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} index 插入的项的序数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_notify_item_inserted(view_model_t* view_model, uint32_t index);
+
+/**
+ * @method view_model_array_notify_item_removed
+ * 触发EVT_VIEW_MODEL_ITEM_REMOVED事件。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} index 删除的项(删除之前)的序数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_notify_item_removed(view_model_t* view_model, uint32_t index);
+
+/**
+ * @method view_model_array_notify_item_changed
+ * 触发EVT_VIEW_MODEL_ITEM_CHANGED事件。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} index 变化的项的序数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_notify_item_changed(view_model_t* view_model, uint32_t index);
+
 #define VIEW_MODEL_ARRAY(view_model) ((view_model_array_t*)(view_model))
 
 END_C_DECLS
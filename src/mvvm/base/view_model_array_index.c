@@ -0,0 +1,718 @@
+﻿/**
+ * File:   view_model_array_index.c
+ * Author: AWTK Develop Team
+ * Brief:  prefix/trigram index of a collection field
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "mvvm/base/view_model_array.h"
+#include "mvvm/base/view_model_array_view.h"
+#include "mvvm/base/view_model_array_index.h"
+
+#define TRIGRAM_OF(p) \
+  ((((uint32_t)(uint8_t)(p)[0] << 16) | ((uint32_t)(uint8_t)(p)[1] << 8) | (uint8_t)(p)[2]) + 1)
+
+static ret_t view_model_array_index_grow(void** data, uint32_t* capacity, uint32_t size,
+                                         uint32_t elm_size) {
+  void* p = NULL;
+  uint32_t new_capacity = 0;
+
+  if (size <= *capacity) {
+    return RET_OK;
+  }
+
+  new_capacity = tk_max(size, *capacity + (*capacity >> 1) + 8);
+  p = TKMEM_REALLOC(*data, new_capacity * elm_size);
+  return_value_if_fail(p != NULL, RET_OOM);
+
+  *data = p;
+  *capacity = new_capacity;
+
+  return RET_OK;
+}
+
+static char to_lower(char c) {
+  return (c >= 'A' && c <= 'Z') ? (c - 'A' + 'a') : c;
+}
+
+static char* view_model_array_index_dup_lower(const char* str) {
+  uint32_t i = 0;
+  uint32_t len = strlen(str);
+  char* key = (char*)TKMEM_ALLOC(len + 1);
+  return_value_if_fail(key != NULL, NULL);
+
+  for (i = 0; i <= len; i++) {
+    key[i] = to_lower(str[i]);
+  }
+
+  return key;
+}
+
+/*key为原始的值，query已经转换成小写*/
+static bool_t view_model_array_index_match(const char* key, const char* query,
+                                           bool_t substring) {
+  const char* s = key;
+
+  do {
+    const char* k = s;
+    const char* q = query;
+
+    while (*q && to_lower(*k) == *q) {
+      k++;
+      q++;
+    }
+
+    if (*q == '\0') {
+      return TRUE;
+    }
+  } while (substring && *s++);
+
+  return FALSE;
+}
+
+/*********************** trigram ************************/
+
+static view_model_array_index_posting_t* view_model_array_index_posting_find(
+    view_model_array_index_t* index, uint32_t trigram, bool_t create);
+
+static ret_t view_model_array_index_postings_rehash(view_model_array_index_t* index) {
+  uint32_t i = 0;
+  uint32_t capacity = index->postings_capacity;
+  view_model_array_index_posting_t* postings = index->postings;
+  uint32_t new_capacity = capacity > 0 ? capacity * 2 : 256;
+
+  index->postings = TKMEM_ZALLOCN(view_model_array_index_posting_t, new_capacity);
+  if (index->postings == NULL) {
+    index->postings = postings;
+    return RET_OOM;
+  }
+
+  index->postings_nr = 0;
+  index->postings_capacity = new_capacity;
+  for (i = 0; i < capacity; i++) {
+    view_model_array_index_posting_t* iter = postings + i;
+
+    if (iter->trigram != 0) {
+      view_model_array_index_posting_t* p =
+          view_model_array_index_posting_find(index, iter->trigram, TRUE);
+      *p = *iter;
+    }
+  }
+  TKMEM_FREE(postings);
+
+  return RET_OK;
+}
+
+static view_model_array_index_posting_t* view_model_array_index_posting_find(
+    view_model_array_index_t* index, uint32_t trigram, bool_t create) {
+  uint32_t mask = 0;
+  uint32_t i = 0;
+
+  if (create && (index->postings_nr + 1) * 2 > index->postings_capacity) {
+    return_value_if_fail(view_model_array_index_postings_rehash(index) == RET_OK, NULL);
+  }
+
+  if (index->postings_capacity == 0) {
+    return NULL;
+  }
+
+  mask = index->postings_capacity - 1;
+  for (i = (trigram * 2654435761u) & mask;; i = (i + 1) & mask) {
+    view_model_array_index_posting_t* iter = index->postings + i;
+
+    if (iter->trigram == trigram) {
+      return iter;
+    } else if (iter->trigram == 0) {
+      if (!create) {
+        return NULL;
+      }
+
+      iter->trigram = trigram;
+      index->postings_nr++;
+
+      return iter;
+    }
+  }
+}
+
+static ret_t view_model_array_index_trigram_add(view_model_array_index_t* index, uint32_t id) {
+  const char* p = index->entries[id].key;
+  view_model_array_index_posting_t* posting = NULL;
+
+  for (; p[0] && p[1] && p[2]; p++) {
+    posting = view_model_array_index_posting_find(index, TRIGRAM_OF(p), TRUE);
+    return_value_if_fail(posting != NULL, RET_OOM);
+
+    /*同一个关键字中重复的trigram只记一次*/
+    if (posting->nr > 0 && posting->ids[posting->nr - 1] == id) {
+      continue;
+    }
+
+    return_value_if_fail(view_model_array_index_grow((void**)&(posting->ids),
+                                                     &(posting->capacity), posting->nr + 1,
+                                                     sizeof(uint32_t)) == RET_OK,
+                         RET_OOM);
+    posting->ids[posting->nr++] = id;
+  }
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_index_trigram_remove(view_model_array_index_t* index,
+                                                   uint32_t id) {
+  uint32_t i = 0;
+  const char* p = index->entries[id].key;
+  view_model_array_index_posting_t* posting = NULL;
+
+  for (; p[0] && p[1] && p[2]; p++) {
+    posting = view_model_array_index_posting_find(index, TRIGRAM_OF(p), FALSE);
+    if (posting == NULL) {
+      continue;
+    }
+
+    for (i = 0; i < posting->nr; i++) {
+      if (posting->ids[i] == id) {
+        posting->ids[i] = posting->ids[--posting->nr];
+        break;
+      }
+    }
+  }
+
+  return RET_OK;
+}
+
+/*********************** sorted keys ************************/
+
+/*返回第一个关键字大于(upper为TRUE)或不小于key的位置*/
+static uint32_t view_model_array_index_bound(view_model_array_index_t* index, const char* key,
+                                             bool_t upper) {
+  uint32_t low = 0;
+  uint32_t high = index->rows;
+
+  while (low < high) {
+    uint32_t mid = low + ((high - low) >> 1);
+    int32_t ret = strcmp(index->entries[index->order[mid]].key, key);
+
+    if (ret < 0 || (upper && ret == 0)) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+static ret_t view_model_array_index_order_add(view_model_array_index_t* index, uint32_t id) {
+  uint32_t pos = view_model_array_index_bound(index, index->entries[id].key, TRUE);
+
+  memmove(index->order + pos + 1, index->order + pos, (index->rows - pos) * sizeof(uint32_t));
+  index->order[pos] = id;
+
+  return RET_OK;
+}
+
+/*调用时rows还包括要删除的行*/
+static ret_t view_model_array_index_order_remove(view_model_array_index_t* index, uint32_t id) {
+  uint32_t pos = view_model_array_index_bound(index, index->entries[id].key, FALSE);
+
+  while (pos < index->rows && index->order[pos] != id) {
+    pos++;
+  }
+  return_value_if_fail(pos < index->rows, RET_NOT_FOUND);
+
+  memmove(index->order + pos, index->order + pos + 1, (index->rows - pos - 1) * sizeof(uint32_t));
+
+  return RET_OK;
+}
+
+/*********************** entries ************************/
+
+static int32_t view_model_array_index_entry_alloc(view_model_array_index_t* index,
+                                                  const char* key) {
+  uint32_t id = 0;
+  char* lower = view_model_array_index_dup_lower(key != NULL ? key : "");
+  return_value_if_fail(lower != NULL, -1);
+
+  if (index->free_nr > 0) {
+    id = index->free_ids[--index->free_nr];
+  } else {
+    uint32_t capacity = index->entries_capacity;
+
+    if (view_model_array_index_grow((void**)&(index->entries), &(index->entries_capacity),
+                                    index->entries_nr + 1,
+                                    sizeof(view_model_array_index_entry_t)) != RET_OK ||
+        view_model_array_index_grow((void**)&(index->free_ids), &capacity,
+                                    index->entries_capacity, sizeof(uint32_t)) != RET_OK) {
+      TKMEM_FREE(lower);
+      return -1;
+    }
+    id = index->entries_nr++;
+  }
+
+  index->entries[id].key = lower;
+
+  return id;
+}
+
+static ret_t view_model_array_index_entry_free(view_model_array_index_t* index, uint32_t id) {
+  TKMEM_FREE(index->entries[id].key);
+  index->free_ids[index->free_nr++] = id;
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_index_add_key(view_model_array_index_t* index, uint32_t id) {
+  view_model_array_index_order_add(index, id);
+  if (index->trigram) {
+    return view_model_array_index_trigram_add(index, id);
+  }
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_index_remove_key(view_model_array_index_t* index, uint32_t id) {
+  view_model_array_index_order_remove(index, id);
+  if (index->trigram) {
+    view_model_array_index_trigram_remove(index, id);
+  }
+
+  return RET_OK;
+}
+
+ret_t view_model_array_index_insert(view_model_array_index_t* index, uint32_t row,
+                                    const char* key) {
+  uint32_t i = 0;
+  int32_t id = 0;
+  return_value_if_fail(index != NULL && row <= index->rows, RET_BAD_PARAMS);
+
+  if (index->rows + 1 > index->rows_capacity) {
+    uint32_t capacity = index->rows_capacity;
+
+    return_value_if_fail(view_model_array_index_grow((void**)&(index->row_entries), &capacity,
+                                                     index->rows + 1, sizeof(uint32_t)) == RET_OK,
+                         RET_OOM);
+    return_value_if_fail(view_model_array_index_grow((void**)&(index->order),
+                                                     &(index->rows_capacity), capacity,
+                                                     sizeof(uint32_t)) == RET_OK,
+                         RET_OOM);
+  }
+
+  id = view_model_array_index_entry_alloc(index, key);
+  return_value_if_fail(id >= 0, RET_OOM);
+
+  for (i = row; i < index->rows; i++) {
+    index->entries[index->row_entries[i]].row++;
+  }
+  memmove(index->row_entries + row + 1, index->row_entries + row,
+          (index->rows - row) * sizeof(uint32_t));
+  index->row_entries[row] = id;
+  index->entries[id].row = row;
+
+  view_model_array_index_add_key(index, id);
+  index->rows++;
+
+  return RET_OK;
+}
+
+ret_t view_model_array_index_remove(view_model_array_index_t* index, uint32_t row) {
+  uint32_t i = 0;
+  uint32_t id = 0;
+  return_value_if_fail(index != NULL && row < index->rows, RET_BAD_PARAMS);
+
+  id = index->row_entries[row];
+  view_model_array_index_remove_key(index, id);
+
+  memmove(index->row_entries + row, index->row_entries + row + 1,
+          (index->rows - row - 1) * sizeof(uint32_t));
+  index->rows--;
+  for (i = row; i < index->rows; i++) {
+    index->entries[index->row_entries[i]].row--;
+  }
+
+  return view_model_array_index_entry_free(index, id);
+}
+
+ret_t view_model_array_index_update(view_model_array_index_t* index, uint32_t row,
+                                    const char* key) {
+  uint32_t id = 0;
+  char* lower = NULL;
+  return_value_if_fail(index != NULL && row < index->rows, RET_BAD_PARAMS);
+
+  lower = view_model_array_index_dup_lower(key != NULL ? key : "");
+  return_value_if_fail(lower != NULL, RET_OOM);
+
+  id = index->row_entries[row];
+  if (strcmp(lower, index->entries[id].key) == 0) {
+    TKMEM_FREE(lower);
+    return RET_OK;
+  }
+
+  view_model_array_index_remove_key(index, id);
+  TKMEM_FREE(index->entries[id].key);
+  index->entries[id].key = lower;
+
+  /*order中已经去掉了这一行，插入时需要按rows-1计算*/
+  index->rows--;
+  view_model_array_index_add_key(index, id);
+  index->rows++;
+
+  return RET_OK;
+}
+
+ret_t view_model_array_index_clear(view_model_array_index_t* index) {
+  uint32_t i = 0;
+  return_value_if_fail(index != NULL, RET_BAD_PARAMS);
+
+  for (i = 0; i < index->rows; i++) {
+    TKMEM_FREE(index->entries[index->row_entries[i]].key);
+  }
+
+  for (i = 0; i < index->postings_capacity; i++) {
+    TKMEM_FREE(index->postings[i].ids);
+  }
+  TKMEM_FREE(index->postings);
+
+  index->rows = 0;
+  index->free_nr = 0;
+  index->entries_nr = 0;
+  index->result_nr = 0;
+  index->postings_nr = 0;
+  index->postings_capacity = 0;
+
+  return RET_OK;
+}
+
+/*********************** search ************************/
+
+static ret_t view_model_array_index_result_push(view_model_array_index_t* index, uint32_t row) {
+  return_value_if_fail(view_model_array_index_grow((void**)&(index->result),
+                                                   &(index->result_capacity),
+                                                   index->result_nr + 1,
+                                                   sizeof(uint32_t)) == RET_OK,
+                       RET_OOM);
+  index->result[index->result_nr++] = row;
+
+  return RET_OK;
+}
+
+static int compare_row(const void* a, const void* b) {
+  uint32_t ra = *(const uint32_t*)a;
+  uint32_t rb = *(const uint32_t*)b;
+
+  return ra < rb ? -1 : (ra > rb ? 1 : 0);
+}
+
+static ret_t view_model_array_index_search_prefix(view_model_array_index_t* index,
+                                                  const char* query) {
+  uint32_t len = strlen(query);
+  uint32_t pos = view_model_array_index_bound(index, query, FALSE);
+
+  for (; pos < index->rows; pos++) {
+    const view_model_array_index_entry_t* iter = index->entries + index->order[pos];
+
+    if (strncmp(iter->key, query, len) != 0) {
+      break;
+    }
+    return_value_if_fail(view_model_array_index_result_push(index, iter->row) == RET_OK,
+                         RET_OOM);
+  }
+
+  if (index->result_nr > 1) {
+    qsort(index->result, index->result_nr, sizeof(uint32_t), compare_row);
+  }
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_index_search_substring(view_model_array_index_t* index,
+                                                     const char* query) {
+  uint32_t i = 0;
+  const char* p = query;
+  view_model_array_index_posting_t* best = NULL;
+
+  if (!index->trigram || strlen(query) < 3) {
+    for (i = 0; i < index->rows; i++) {
+      if (strstr(index->entries[index->row_entries[i]].key, query) != NULL) {
+        return_value_if_fail(view_model_array_index_result_push(index, i) == RET_OK, RET_OOM);
+      }
+    }
+
+    return RET_OK;
+  }
+
+  /*取最短的倒排表，再逐个确认*/
+  for (; p[0] && p[1] && p[2]; p++) {
+    view_model_array_index_posting_t* iter =
+        view_model_array_index_posting_find(index, TRIGRAM_OF(p), FALSE);
+
+    if (iter == NULL || iter->nr == 0) {
+      return RET_OK;
+    }
+
+    if (best == NULL || iter->nr < best->nr) {
+      best = iter;
+    }
+  }
+
+  for (i = 0; i < best->nr; i++) {
+    const view_model_array_index_entry_t* iter = index->entries + best->ids[i];
+
+    if (strstr(iter->key, query) != NULL) {
+      return_value_if_fail(view_model_array_index_result_push(index, iter->row) == RET_OK,
+                           RET_OOM);
+    }
+  }
+
+  if (index->result_nr > 1) {
+    qsort(index->result, index->result_nr, sizeof(uint32_t), compare_row);
+  }
+
+  return RET_OK;
+}
+
+ret_t view_model_array_index_search(view_model_array_index_t* index, const char* query,
+                                    bool_t substring) {
+  uint32_t i = 0;
+  return_value_if_fail(index != NULL, RET_BAD_PARAMS);
+
+  str_set(&(index->temp), query != NULL ? query : "");
+  for (i = 0; i < index->temp.size; i++) {
+    index->temp.str[i] = to_lower(index->temp.str[i]);
+  }
+  index->result_nr = 0;
+
+  if (index->temp.size == 0) {
+    for (i = 0; i < index->rows; i++) {
+      return_value_if_fail(view_model_array_index_result_push(index, i) == RET_OK, RET_OOM);
+    }
+
+    return RET_OK;
+  }
+
+  if (substring) {
+    return view_model_array_index_search_substring(index, index->temp.str);
+  } else {
+    return view_model_array_index_search_prefix(index, index->temp.str);
+  }
+}
+
+/*********************** source ************************/
+
+static const char* view_model_array_index_get_key(view_model_array_index_t* index,
+                                                  view_model_t* source, uint32_t row) {
+  value_t v;
+  char name[TK_NUM_MAX_LEN + 4];
+
+  tk_snprintf(name, sizeof(name) - 1, "[%u].", row);
+  str_set(&(index->temp), name);
+  str_append(&(index->temp), index->field.str);
+
+  if (object_get_prop(OBJECT(source), index->temp.str, &v) != RET_OK) {
+    return "";
+  }
+
+  str_from_value(&(index->temp), &v);
+
+  return index->temp.str;
+}
+
+static ret_t view_model_array_index_load(view_model_array_index_t* index) {
+  uint32_t i = 0;
+  uint32_t items = object_get_prop_int(OBJECT(index->source), VIEW_MODEL_PROP_ITEMS, 0);
+
+  view_model_array_index_clear(index);
+  for (i = 0; i < items; i++) {
+    const char* key = view_model_array_index_get_key(index, index->source, i);
+    return_value_if_fail(view_model_array_index_insert(index, i, key) == RET_OK, RET_OOM);
+  }
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_index_on_source_event(void* ctx, event_t* e) {
+  const char* key = NULL;
+  view_model_array_index_t* index = VIEW_MODEL_ARRAY_INDEX(ctx);
+  view_model_item_event_t* evt = (view_model_item_event_t*)e;
+
+  switch (e->type) {
+    case EVT_VIEW_MODEL_ITEM_INSERTED: {
+      key = view_model_array_index_get_key(index, index->source, evt->index);
+      view_model_array_index_insert(index, evt->index, key);
+      break;
+    }
+    case EVT_VIEW_MODEL_ITEM_REMOVED: {
+      view_model_array_index_remove(index, evt->index);
+      break;
+    }
+    case EVT_VIEW_MODEL_ITEM_CHANGED: {
+      key = view_model_array_index_get_key(index, index->source, evt->index);
+      view_model_array_index_update(index, evt->index, key);
+      break;
+    }
+    default: {
+      view_model_array_index_load(index);
+      break;
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t view_model_array_index_attach(view_model_array_index_t* index, view_model_t* source,
+                                    const char* field) {
+  return_value_if_fail(index != NULL && index->source == NULL, RET_BAD_PARAMS);
+  return_value_if_fail(source != NULL && object_is_collection(OBJECT(source)), RET_BAD_PARAMS);
+  return_value_if_fail(field != NULL, RET_BAD_PARAMS);
+
+  index->source = source;
+  object_ref(OBJECT(source));
+  str_set(&(index->field), field);
+  view_model_array_index_load(index);
+
+  emitter_on(EMITTER(source), EVT_VIEW_MODEL_ITEM_INSERTED, view_model_array_index_on_source_event,
+             index);
+  emitter_on(EMITTER(source), EVT_VIEW_MODEL_ITEM_REMOVED, view_model_array_index_on_source_event,
+             index);
+  emitter_on(EMITTER(source), EVT_VIEW_MODEL_ITEM_CHANGED, view_model_array_index_on_source_event,
+             index);
+  emitter_on(EMITTER(source), EVT_ITEMS_CHANGED, view_model_array_index_on_source_event, index);
+
+  return RET_OK;
+}
+
+bool_t view_model_array_index_filter(void* ctx, view_model_t* source, uint32_t row) {
+  view_model_array_index_t* index = VIEW_MODEL_ARRAY_INDEX(ctx);
+  return_value_if_fail(index != NULL && index->source != NULL, TRUE);
+
+  if (index->query.size == 0) {
+    return TRUE;
+  }
+
+  if (index->applying) {
+    return row < index->rows && (index->marks[row >> 5] & (1u << (row & 31))) != 0;
+  }
+
+  /*单项变化时直接检查源集合中的值，不依赖索引和视图处理事件的先后顺序*/
+  return view_model_array_index_match(view_model_array_index_get_key(index, source, row),
+                                      index->query.str, index->substring);
+}
+
+ret_t view_model_array_index_filter_view(view_model_array_index_t* index, view_model_t* view,
+                                         const char* query, bool_t substring) {
+  uint32_t i = 0;
+  ret_t ret = RET_OK;
+  bool_t narrow = FALSE;
+  uint32_t words = 0;
+  uint32_t* marks = NULL;
+  view_model_array_view_t* array_view = VIEW_MODEL_ARRAY_VIEW(view);
+  return_value_if_fail(index != NULL && index->source != NULL && view != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(array_view->source == index->source, RET_BAD_PARAMS);
+
+  query = query != NULL ? query : "";
+  if (array_view->filter == view_model_array_index_filter && array_view->filter_ctx == index &&
+      substring == index->substring) {
+    narrow = view_model_array_index_match(query, index->query.str, FALSE);
+  }
+
+  return_value_if_fail(view_model_array_index_search(index, query, substring) == RET_OK, RET_OOM);
+  str_set(&(index->query), index->temp.str);
+  index->substring = substring;
+
+  words = tk_max((index->rows + 31) / 32, 1);
+  marks = (uint32_t*)TKMEM_REALLOC(index->marks, words * sizeof(uint32_t));
+  return_value_if_fail(marks != NULL, RET_OOM);
+  index->marks = marks;
+  memset(index->marks, 0x00, words * sizeof(uint32_t));
+
+  for (i = 0; i < index->result_nr; i++) {
+    uint32_t row = index->result[i];
+    index->marks[row >> 5] |= 1u << (row & 31);
+  }
+
+  index->applying = TRUE;
+  ret = view_model_array_view_set_filter(view, view_model_array_index_filter, index, narrow);
+  index->applying = FALSE;
+
+  return ret;
+}
+
+/*********************** object ************************/
+
+static ret_t view_model_array_index_on_destroy(object_t* obj) {
+  view_model_array_index_t* index = VIEW_MODEL_ARRAY_INDEX(obj);
+
+  if (index->source != NULL) {
+    emitter_off_by_ctx(EMITTER(index->source), index);
+    object_unref(OBJECT(index->source));
+    index->source = NULL;
+  }
+
+  view_model_array_index_clear(index);
+  TKMEM_FREE(index->entries);
+  TKMEM_FREE(index->free_ids);
+  TKMEM_FREE(index->row_entries);
+  TKMEM_FREE(index->order);
+  TKMEM_FREE(index->result);
+  TKMEM_FREE(index->marks);
+  str_reset(&(index->query));
+  str_reset(&(index->field));
+  str_reset(&(index->temp));
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_index_get_prop(object_t* obj, const char* name, value_t* v) {
+  view_model_array_index_t* index = VIEW_MODEL_ARRAY_INDEX(obj);
+
+  if (tk_str_eq(name, VIEW_MODEL_ARRAY_INDEX_PROP_ROWS)) {
+    value_set_uint32(v, index->rows);
+  } else {
+    return RET_NOT_FOUND;
+  }
+
+  return RET_OK;
+}
+
+static const object_vtable_t s_view_model_array_index_vtable = {
+    .type = "view_model_array_index",
+    .desc = "view_model_array_index",
+    .size = sizeof(view_model_array_index_t),
+    .is_collection = FALSE,
+    .on_destroy = view_model_array_index_on_destroy,
+    .get_prop = view_model_array_index_get_prop};
+
+view_model_array_index_t* view_model_array_index_create(bool_t trigram) {
+  object_t* obj = object_create(&s_view_model_array_index_vtable);
+  view_model_array_index_t* index = VIEW_MODEL_ARRAY_INDEX(obj);
+  return_value_if_fail(index != NULL, NULL);
+
+  index->trigram = trigram;
+  str_init(&(index->query), 0);
+  str_init(&(index->field), 0);
+  str_init(&(index->temp), 0);
+
+  return index;
+}
+
+view_model_array_index_t* view_model_array_index_cast(object_t* obj) {
+  return_value_if_fail(obj != NULL && obj->vt == &s_view_model_array_index_vtable, NULL);
+
+  return VIEW_MODEL_ARRAY_INDEX(obj);
+}
@@ -0,0 +1,247 @@
+﻿/**
+ * File:   view_model_array_index.h
+ * Author: AWTK Develop Team
+ * Brief:  prefix/trigram index of a collection field
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#ifndef TK_VIEW_MODEL_ARRAY_INDEX_H
+#define TK_VIEW_MODEL_ARRAY_INDEX_H
+
+#include "tkc/str.h"
+#include "tkc/object.h"
+#include "mvvm/base/view_model.h"
+
+BEGIN_C_DECLS
+
+/*private*/
+typedef struct _view_model_array_index_entry_t {
+  char* key;
+  uint32_t row;
+} view_model_array_index_entry_t;
+
+/*private*/
+typedef struct _view_model_array_index_posting_t {
+  uint32_t trigram;
+  uint32_t nr;
+  uint32_t capacity;
+  uint32_t* ids;
+} view_model_array_index_posting_t;
+
+/**
+ * @class view_model_array_index_t
+ * @parent object_t
+ *
+ * 集合模型中某个字符串字段的索引，用于快速搜索(不区分ASCII字母的大小写)。
+ *
+ * 前缀搜索在按关键字排序的表中二分查找。启用trigram时，还可以搜索包含指定子串的行：
+ * 先取子串中每三个字节对应的倒排表中最短的一个，再逐个确认。
+ *
+ * 索引可以通过view_model_array_index_attach跟随集合模型的单项变化事件增量更新，
+ * 也可以由调用者(比如JS)直接按行插入、删除和修改。
+ *
+ */
+typedef struct _view_model_array_index_t {
+  object_t object;
+
+  /**
+   * @property {uint32_t} rows
+   * @annotation ["readable"]
+   * 行数。
+   */
+  uint32_t rows;
+
+  /**
+   * @property {bool_t} trigram
+   * @annotation ["readable"]
+   * 是否支持子串搜索。
+   */
+  bool_t trigram;
+
+  /**
+   * @property {uint32_t*} result
+   * @annotation ["readable"]
+   * 最近一次搜索结果(升序的行号)。
+   */
+  uint32_t* result;
+
+  /**
+   * @property {uint32_t} result_nr
+   * @annotation ["readable"]
+   * 最近一次搜索结果的个数。
+   */
+  uint32_t result_nr;
+
+  /*private*/
+  view_model_array_index_entry_t* entries;
+  uint32_t entries_nr;
+  uint32_t entries_capacity;
+  uint32_t* free_ids;
+  uint32_t free_nr;
+
+  uint32_t* row_entries;
+  uint32_t* order;
+  uint32_t rows_capacity;
+
+  view_model_array_index_posting_t* postings;
+  uint32_t postings_nr;
+  uint32_t postings_capacity;
+
+  uint32_t result_capacity;
+  uint32_t* marks;
+  bool_t applying;
+  bool_t substring;
+  str_t query;
+
+  view_model_t* source;
+  str_t field;
+  str_t temp;
+} view_model_array_index_t;
+
+/**
+ * @method view_model_array_index_create
+ * 创建索引对象。
+ *
+ * @annotation ["constructor"]
+ *
+ * @param {bool_t} trigram 是否支持子串搜索(需要额外的内存)。
+ *
+ * @return {view_model_array_index_t*} 返回索引对象。
+ */
+view_model_array_index_t* view_model_array_index_create(bool_t trigram);
+
+/**
+ * @method view_model_array_index_cast
+ * 转换为索引对象。
+ *
+ * @annotation ["cast"]
+ *
+ * @param {object_t*} obj 对象。
+ *
+ * @return {view_model_array_index_t*} 对象是索引时返回它，否则返回NULL。
+ */
+view_model_array_index_t* view_model_array_index_cast(object_t* obj);
+
+/**
+ * @method view_model_array_index_insert
+ * 在指定的位置插入一行，之后的行号加1。
+ *
+ * @param {view_model_array_index_t*} index 索引对象。
+ * @param {uint32_t} row 行号(不能大于rows)。
+ * @param {const char*} key 关键字。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_index_insert(view_model_array_index_t* index, uint32_t row,
+                                    const char* key);
+
+/**
+ * @method view_model_array_index_remove
+ * 删除指定的行，之后的行号减1。
+ *
+ * @param {view_model_array_index_t*} index 索引对象。
+ * @param {uint32_t} row 行号。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_index_remove(view_model_array_index_t* index, uint32_t row);
+
+/**
+ * @method view_model_array_index_update
+ * 修改指定行的关键字。
+ *
+ * @param {view_model_array_index_t*} index 索引对象。
+ * @param {uint32_t} row 行号。
+ * @param {const char*} key 关键字。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_index_update(view_model_array_index_t* index, uint32_t row,
+                                    const char* key);
+
+/**
+ * @method view_model_array_index_clear
+ * 清除全部行。
+ *
+ * @param {view_model_array_index_t*} index 索引对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_index_clear(view_model_array_index_t* index);
+
+/**
+ * @method view_model_array_index_search
+ * 搜索。结果(升序的行号)放在result中，到下一次搜索之前有效。
+ *
+ * @param {view_model_array_index_t*} index 索引对象。
+ * @param {const char*} query 要搜索的字符串(空字符串匹配全部的行)。
+ * @param {bool_t} substring TRUE表示搜索包含query的行，FALSE表示搜索以query开头的行。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_index_search(view_model_array_index_t* index, const char* query,
+                                    bool_t substring);
+
+/**
+ * @method view_model_array_index_attach
+ * 从集合模型的指定字段建立索引，并跟随集合模型的变化事件更新。
+ *
+ *> 集合模型需要用view_model_array_notify_item_xxx通知单项的变化。
+ *
+ * @param {view_model_array_index_t*} index 索引对象。
+ * @param {view_model_t*} source 集合模型。
+ * @param {const char*} field 字段名。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_index_attach(view_model_array_index_t* index, view_model_t* source,
+                                    const char* field);
+
+/**
+ * @method view_model_array_index_filter
+ * 按搜索条件过滤的函数，作为view_model_array_view_set_filter的参数(ctx为索引对象)。
+ *
+ * @param {void*} ctx 索引对象。
+ * @param {view_model_t*} source 集合模型。
+ * @param {uint32_t} row 行号。
+ *
+ * @return {bool_t} 返回TRUE表示满足最近一次view_model_array_index_filter_view设置的搜索条件。
+ */
+bool_t view_model_array_index_filter(void* ctx, view_model_t* source, uint32_t row);
+
+/**
+ * @method view_model_array_index_filter_view
+ * 搜索，并用搜索结果过滤集合模型的视图(view_model_array_view_t)。
+ * 新的搜索字符串以上一次的开头(如边输入边搜索)时，视图只检查当前可见的项。
+ *
+ * @param {view_model_array_index_t*} index 已经attach到视图的源集合的索引对象。
+ * @param {view_model_t*} view 视图。
+ * @param {const char*} query 要搜索的字符串。
+ * @param {bool_t} substring TRUE表示搜索包含query的行，FALSE表示搜索以query开头的行。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_index_filter_view(view_model_array_index_t* index, view_model_t* view,
+                                         const char* query, bool_t substring);
+
+#define VIEW_MODEL_ARRAY_INDEX_PROP_ROWS "rows"
+
+#define VIEW_MODEL_ARRAY_INDEX(obj) ((view_model_array_index_t*)(obj))
+
+END_C_DECLS
+
+#endif /*TK_VIEW_MODEL_ARRAY_INDEX_H*/
@@ -0,0 +1,515 @@
+﻿/**
+ * File:   view_model_array_paged.c
+ * Author: AWTK Develop Team
+ * Brief:  paged collection view model
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "mvvm/base/utils.h"
+#include "mvvm/base/view_model_array_paged.h"
+
+typedef enum _page_state_t { PAGE_EMPTY = 0, PAGE_LOADING, PAGE_READY } page_state_t;
+
+static ret_t view_model_array_paged_page_reset(view_model_array_paged_t* paged,
+                                               view_model_array_paged_page_t* page) {
+  uint32_t i = 0;
+
+  for (i = 0; page->values != NULL && i < page->nr * paged->fields_nr; i++) {
+    value_reset(page->values + i);
+  }
+
+  page->nr = 0;
+  page->time = 0;
+  page->stamp = 0;
+  page->index = -1;
+  page->state = PAGE_EMPTY;
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_paged_set_pages(view_model_array_paged_t* paged, uint32_t nr) {
+  uint32_t i = 0;
+  view_model_array_paged_page_t* pages = NULL;
+
+  if (nr <= paged->pages_nr) {
+    return RET_OK;
+  }
+
+  pages = TKMEM_REALLOCT(view_model_array_paged_page_t, paged->pages, nr);
+  return_value_if_fail(pages != NULL, RET_OOM);
+
+  for (i = paged->pages_nr; i < nr; i++) {
+    memset(pages + i, 0x00, sizeof(*pages));
+    pages[i].index = -1;
+  }
+  paged->pages = pages;
+  paged->pages_nr = nr;
+
+  return RET_OK;
+}
+
+static uint32_t view_model_array_paged_pages_total(view_model_array_paged_t* paged) {
+  return (paged->items + paged->page_size - 1) / paged->page_size;
+}
+
+static view_model_array_paged_page_t* view_model_array_paged_find(
+    view_model_array_paged_t* paged, uint32_t index) {
+  uint32_t i = 0;
+
+  for (i = 0; i < paged->pages_nr; i++) {
+    view_model_array_paged_page_t* iter = paged->pages + i;
+
+    if (iter->state != PAGE_EMPTY && iter->index == (int32_t)index) {
+      return iter;
+    }
+  }
+
+  return NULL;
+}
+
+static bool_t view_model_array_paged_is_stale(view_model_array_paged_t* paged,
+                                              view_model_array_paged_page_t* page) {
+  return page->state == PAGE_LOADING && time_now_ms() - page->time >= paged->loading_timeout;
+}
+
+/*刷新过程中已经访问过的页不淘汰，否则超过缓存容量的列表每次刷新都会把缓存整个换一遍*/
+static bool_t view_model_array_paged_can_evict(view_model_array_paged_t* paged,
+                                               view_model_array_paged_page_t* page,
+                                               int32_t keep) {
+  if (page->index == keep) {
+    return FALSE;
+  }
+
+  if (paged->updating && page->stamp > paged->update_stamp) {
+    return FALSE;
+  }
+
+  return page->state == PAGE_READY || view_model_array_paged_is_stale(paged, page);
+}
+
+/*优先使用空闲的页，否则淘汰最久没有使用的页。正在加载(没有超时)的页和keep页不淘汰*/
+static view_model_array_paged_page_t* view_model_array_paged_alloc(
+    view_model_array_paged_t* paged, int32_t keep) {
+  uint32_t i = 0;
+  view_model_array_paged_page_t* lru = NULL;
+
+  for (i = 0; i < paged->pages_nr; i++) {
+    view_model_array_paged_page_t* iter = paged->pages + i;
+
+    if (iter->state == PAGE_EMPTY) {
+      lru = iter;
+      break;
+    }
+
+    if (view_model_array_paged_can_evict(paged, iter, keep)) {
+      if (lru == NULL || iter->stamp < lru->stamp) {
+        lru = iter;
+      }
+    }
+  }
+
+  if (lru != NULL) {
+    view_model_array_paged_page_reset(paged, lru);
+    if (lru->values == NULL) {
+      lru->values = TKMEM_ZALLOCN(value_t, paged->page_size * paged->fields_nr);
+      return_value_if_fail(lru->values != NULL, NULL);
+    }
+  }
+
+  return lru;
+}
+
+static view_model_array_paged_page_t* view_model_array_paged_load(
+    view_model_array_paged_t* paged, view_model_array_paged_page_t* page, uint32_t index) {
+  ret_t ret = RET_OK;
+  uint32_t start = index * paged->page_size;
+  uint32_t nr = tk_min(paged->page_size, paged->items - start);
+
+  page->index = index;
+  page->state = PAGE_LOADING;
+  page->time = time_now_ms();
+  page->stamp = ++paged->stamp;
+
+  /*数据源同步提交的数据马上就可以用，不需要再通知*/
+  paged->fetching = TRUE;
+  ret = paged->source.fetch(paged->source.ctx, VIEW_MODEL(paged), start, nr);
+  paged->fetching = FALSE;
+
+  if (ret != RET_OK && page->state == PAGE_LOADING) {
+    view_model_array_paged_page_reset(paged, page);
+    return NULL;
+  }
+
+  return page;
+}
+
+static view_model_array_paged_page_t* view_model_array_paged_request(
+    view_model_array_paged_t* paged, uint32_t index, int32_t keep) {
+  view_model_array_paged_page_t* page = view_model_array_paged_alloc(paged, keep);
+
+  if (page == NULL) {
+    return NULL;
+  }
+
+  return view_model_array_paged_load(paged, page, index);
+}
+
+/*刷新过程中只加载可见区间内的页*/
+static bool_t view_model_array_paged_is_visible(view_model_array_paged_t* paged,
+                                                uint32_t index) {
+  uint32_t start = index * paged->page_size;
+
+  if (!paged->updating) {
+    return TRUE;
+  }
+
+  return start < (uint64_t)(paged->visible_start) + paged->visible_nr &&
+         start + paged->page_size > paged->visible_start;
+}
+
+static ret_t view_model_array_paged_read_ahead(view_model_array_paged_t* paged, uint32_t index) {
+  uint32_t i = 0;
+  int32_t total = view_model_array_paged_pages_total(paged);
+
+  if ((int32_t)index == paged->last_page) {
+    return RET_OK;
+  }
+
+  if (paged->last_page >= 0) {
+    paged->direction = (int32_t)index > paged->last_page ? 1 : -1;
+  }
+  paged->last_page = index;
+
+  for (i = 1; i <= paged->read_ahead; i++) {
+    int32_t iter = (int32_t)index + paged->direction * (int32_t)i;
+
+    if (iter < 0 || iter >= total) {
+      break;
+    }
+
+    if (!view_model_array_paged_is_visible(paged, iter)) {
+      break;
+    }
+
+    if (view_model_array_paged_find(paged, iter) == NULL) {
+      view_model_array_paged_request(paged, iter, index);
+    }
+  }
+
+  return RET_OK;
+}
+
+static view_model_array_paged_page_t* view_model_array_paged_touch(
+    view_model_array_paged_t* paged, uint32_t row) {
+  uint32_t index = row / paged->page_size;
+  bool_t visible = view_model_array_paged_is_visible(paged, index);
+  view_model_array_paged_page_t* page = view_model_array_paged_find(paged, index);
+
+  /*提交数据时刷新界面只读取缓存，不再发起新的请求*/
+  if (paged->filling || !visible) {
+    return page;
+  }
+
+  if (page == NULL) {
+    page = view_model_array_paged_request(paged, index, -1);
+  } else if (view_model_array_paged_is_stale(paged, page)) {
+    page = view_model_array_paged_load(paged, page, index);
+  }
+
+  if (page != NULL) {
+    page->stamp = ++paged->stamp;
+  }
+  view_model_array_paged_read_ahead(paged, index);
+
+  return page;
+}
+
+static int32_t view_model_array_paged_field_index(view_model_array_paged_t* paged,
+                                                  const char* name) {
+  uint32_t i = 0;
+
+  for (i = 0; i < paged->fields_nr; i++) {
+    if (tk_str_eq(paged->fields[i], name)) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+static ret_t view_model_array_paged_on_destroy(object_t* obj) {
+  uint32_t i = 0;
+  view_model_array_paged_t* paged = VIEW_MODEL_ARRAY_PAGED(obj);
+
+  for (i = 0; i < paged->pages_nr; i++) {
+    view_model_array_paged_page_reset(paged, paged->pages + i);
+    TKMEM_FREE(paged->pages[i].values);
+  }
+  TKMEM_FREE(paged->pages);
+
+  for (i = 0; i < paged->fields_nr; i++) {
+    TKMEM_FREE(paged->fields[i]);
+  }
+  TKMEM_FREE(paged->fields);
+
+  if (paged->source.destroy != NULL) {
+    paged->source.destroy(paged->source.ctx);
+  }
+  view_model_array_deinit(VIEW_MODEL(obj));
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_paged_set_prop(object_t* obj, const char* name, const value_t* v) {
+  return_value_if_fail(obj != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+
+  if (tk_str_eq(VIEW_MODEL_PROP_CURSOR, name)) {
+    view_model_array_set_cursor(VIEW_MODEL(obj), value_int(v));
+
+    return RET_OK;
+  }
+
+  return RET_NOT_IMPL;
+}
+
+static ret_t view_model_array_paged_get_prop(object_t* obj, const char* name, value_t* v) {
+  uint32_t index = 0;
+  int32_t field = -1;
+  const char* prop = NULL;
+  view_model_array_paged_page_t* page = NULL;
+  view_model_array_paged_t* paged = VIEW_MODEL_ARRAY_PAGED(obj);
+  return_value_if_fail(obj != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+
+  if (tk_str_eq(VIEW_MODEL_PROP_ITEMS, name)) {
+    value_set_int(v, paged->items);
+
+    return RET_OK;
+  } else if (tk_str_eq(VIEW_MODEL_PROP_CURSOR, name)) {
+    value_set_int(v, VIEW_MODEL_ARRAY(obj)->cursor);
+
+    return RET_OK;
+  }
+
+  prop = destruct_array_prop_name(name, &index);
+  return_value_if_fail(prop != NULL && prop != name, RET_NOT_FOUND);
+  return_value_if_fail(index < paged->items, RET_BAD_PARAMS);
+
+  if (tk_str_eq(prop, VIEW_MODEL_ARRAY_PAGED_PROP_LOADING)) {
+    page = view_model_array_paged_touch(paged, index);
+    value_set_bool(v, page == NULL || page->state != PAGE_READY);
+
+    return RET_OK;
+  }
+
+  field = view_model_array_paged_field_index(paged, prop);
+  return_value_if_fail(field >= 0, RET_NOT_FOUND);
+
+  page = view_model_array_paged_touch(paged, index);
+  if (page != NULL && page->state == PAGE_READY) {
+    index = index % paged->page_size;
+    return_value_if_fail(index < page->nr, RET_BAD_PARAMS);
+
+    return value_copy(v, page->values + index * paged->fields_nr + field);
+  }
+
+  value_set_str(v, "");
+
+  return RET_OK;
+}
+
+static bool_t view_model_array_paged_can_exec(object_t* obj, const char* name, const char* args) {
+  return_value_if_fail(obj != NULL && name != NULL, FALSE);
+
+  return FALSE;
+}
+
+static ret_t view_model_array_paged_exec(object_t* obj, const char* name, const char* args) {
+  return_value_if_fail(obj != NULL && name != NULL, RET_BAD_PARAMS);
+
+  return RET_NOT_IMPL;
+}
+
+static ret_t view_model_array_paged_begin_update(view_model_t* view_model) {
+  view_model_array_paged_t* paged = VIEW_MODEL_ARRAY_PAGED(view_model);
+
+  paged->updating = TRUE;
+  paged->update_stamp = paged->stamp;
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_paged_end_update(view_model_t* view_model) {
+  view_model_array_paged_t* paged = VIEW_MODEL_ARRAY_PAGED(view_model);
+
+  paged->updating = FALSE;
+
+  return RET_OK;
+}
+
+static const view_model_vtable_t s_view_model_array_paged_vtable = {
+    .begin_update = view_model_array_paged_begin_update,
+    .end_update = view_model_array_paged_end_update};
+
+static const object_vtable_t s_model_array_paged_vtable = {
+    .type = "view_model_array_paged",
+    .desc = "view_model_array_paged",
+    .size = sizeof(view_model_array_paged_t),
+    .is_collection = TRUE,
+    .on_destroy = view_model_array_paged_on_destroy,
+
+    .get_prop = view_model_array_paged_get_prop,
+    .set_prop = view_model_array_paged_set_prop,
+    .can_exec = view_model_array_paged_can_exec,
+    .exec = view_model_array_paged_exec};
+
+view_model_t* view_model_array_paged_create(const view_model_array_paged_source_t* source,
+                                            const char** fields, uint32_t fields_nr,
+                                            uint32_t page_size, uint32_t cache_pages) {
+  uint32_t i = 0;
+  object_t* obj = NULL;
+  view_model_array_paged_t* paged = NULL;
+  return_value_if_fail(source != NULL && source->count != NULL && source->fetch != NULL, NULL);
+  return_value_if_fail(fields != NULL && fields_nr > 0 && page_size > 0, NULL);
+
+  obj = object_create(&s_model_array_paged_vtable);
+  paged = VIEW_MODEL_ARRAY_PAGED(obj);
+  return_value_if_fail(paged != NULL, NULL);
+
+  view_model_array_init(VIEW_MODEL(obj));
+  VIEW_MODEL(obj)->vt = &s_view_model_array_paged_vtable;
+  paged->source = *source;
+  paged->page_size = page_size;
+  paged->read_ahead = 1;
+  paged->visible_nr = 0xffffffff;
+  paged->loading_timeout = VIEW_MODEL_ARRAY_PAGED_LOADING_TIMEOUT;
+  paged->last_page = -1;
+  paged->direction = 1;
+
+  paged->fields = TKMEM_ZALLOCN(char*, fields_nr);
+  goto_error_if_fail(paged->fields != NULL);
+  for (i = 0; i < fields_nr; i++) {
+    paged->fields[i] = tk_strdup(fields[i]);
+    goto_error_if_fail(paged->fields[i] != NULL);
+    paged->fields_nr++;
+  }
+
+  goto_error_if_fail(view_model_array_paged_set_pages(
+                         paged, tk_max(cache_pages, paged->read_ahead + 2)) == RET_OK);
+  paged->items = tk_max(paged->source.count(paged->source.ctx), 0);
+
+  return VIEW_MODEL(obj);
+error:
+  object_unref(obj);
+
+  return NULL;
+}
+
+ret_t view_model_array_paged_set_read_ahead(view_model_t* view_model, uint32_t pages) {
+  view_model_array_paged_t* paged = VIEW_MODEL_ARRAY_PAGED(view_model);
+  return_value_if_fail(paged != NULL, RET_BAD_PARAMS);
+
+  paged->read_ahead = pages;
+
+  return view_model_array_paged_set_pages(paged, pages + 2);
+}
+
+ret_t view_model_array_paged_fill(view_model_t* view_model, uint32_t start, uint32_t nr,
+                                  const value_t* values) {
+  uint32_t i = 0;
+  view_model_array_paged_page_t* page = NULL;
+  view_model_array_paged_t* paged = VIEW_MODEL_ARRAY_PAGED(view_model);
+  return_value_if_fail(paged != NULL && values != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(start % paged->page_size == 0 && nr <= paged->page_size, RET_BAD_PARAMS);
+
+  page = view_model_array_paged_find(paged, start / paged->page_size);
+  if (page == NULL) {
+    return RET_NOT_FOUND;
+  }
+
+  for (i = 0; i < page->nr * paged->fields_nr; i++) {
+    value_reset(page->values + i);
+  }
+
+  for (i = 0; i < nr * paged->fields_nr; i++) {
+    value_deep_copy(page->values + i, values + i);
+  }
+  page->nr = nr;
+  page->state = PAGE_READY;
+
+  /*只通知提交的这些行，整体刷新会读取所有行，超过缓存容量时会不停地换页*/
+  if (!paged->fetching) {
+    paged->filling = TRUE;
+    for (i = 0; i < nr; i++) {
+      view_model_array_notify_item_changed(view_model, start + i);
+    }
+    paged->filling = FALSE;
+  }
+
+  return RET_OK;
+}
+
+ret_t view_model_array_paged_reload(view_model_t* view_model) {
+  uint32_t i = 0;
+  view_model_array_paged_t* paged = VIEW_MODEL_ARRAY_PAGED(view_model);
+  return_value_if_fail(paged != NULL, RET_BAD_PARAMS);
+
+  for (i = 0; i < paged->pages_nr; i++) {
+    view_model_array_paged_page_reset(paged, paged->pages + i);
+  }
+
+  paged->last_page = -1;
+  paged->direction = 1;
+  paged->items = tk_max(paged->source.count(paged->source.ctx), 0);
+
+  return view_model_array_notify_items_changed(view_model);
+}
+
+ret_t view_model_array_paged_set_visible(view_model_t* view_model, uint32_t start, uint32_t nr) {
+  view_model_array_paged_t* paged = VIEW_MODEL_ARRAY_PAGED(view_model);
+  return_value_if_fail(paged != NULL, RET_BAD_PARAMS);
+
+  if (paged->visible_start == start && paged->visible_nr == nr) {
+    return RET_OK;
+  }
+
+  paged->visible_start = start;
+  paged->visible_nr = nr;
+
+  return view_model_notify_props_changed(view_model);
+}
+
+ret_t view_model_array_paged_set_loading_timeout(view_model_t* view_model, uint32_t ms) {
+  view_model_array_paged_t* paged = VIEW_MODEL_ARRAY_PAGED(view_model);
+  return_value_if_fail(paged != NULL, RET_BAD_PARAMS);
+
+  paged->loading_timeout = ms;
+
+  return RET_OK;
+}
+
+bool_t view_model_array_paged_is_loaded(view_model_t* view_model, uint32_t index) {
+  view_model_array_paged_page_t* page = NULL;
+  view_model_array_paged_t* paged = VIEW_MODEL_ARRAY_PAGED(view_model);
+  return_value_if_fail(paged != NULL && index < paged->items, FALSE);
+
+  page = view_model_array_paged_find(paged, index / paged->page_size);
+
+  return page != NULL && page->state == PAGE_READY;
+}
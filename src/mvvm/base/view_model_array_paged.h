@@ -0,0 +1,243 @@
+﻿/**
+ * File:   view_model_array_paged.h
+ * Author: AWTK Develop Team
+ * Brief:  paged collection view model
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#ifndef TK_VIEW_MODEL_ARRAY_PAGED_H
+#define TK_VIEW_MODEL_ARRAY_PAGED_H
+
+#include "mvvm/base/view_model_array.h"
+
+BEGIN_C_DECLS
+
+/**
+ * 返回数据源中的总行数。
+ */
+typedef int32_t (*view_model_array_paged_count_t)(void* ctx);
+
+/**
+ * 请求读取[start, start + nr)行。
+ * 数据就绪后(可以在本函数中，也可以在之后)调用view_model_array_paged_fill提交数据。
+ */
+typedef ret_t (*view_model_array_paged_fetch_t)(void* ctx, view_model_t* view_model,
+                                                uint32_t start, uint32_t nr);
+
+/**
+ * @class view_model_array_paged_source_t
+ *
+ * 分页集合模型的数据源(文件、本地数据库或者回调函数)。
+ *
+ */
+typedef struct _view_model_array_paged_source_t {
+  view_model_array_paged_count_t count;
+  view_model_array_paged_fetch_t fetch;
+  tk_destroy_t destroy;
+  void* ctx;
+} view_model_array_paged_source_t;
+
+/*private*/
+typedef struct _view_model_array_paged_page_t {
+  int32_t index;
+  uint32_t state;
+  uint32_t stamp;
+  uint32_t nr;
+  uint64_t time;
+  value_t* values;
+} view_model_array_paged_page_t;
+
+struct _model_array_paged_t;
+typedef struct _model_array_paged_t view_model_array_paged_t;
+
+/**
+ * @class view_model_array_paged_t
+ * @parent view_model_array_t
+ *
+ * 分页加载的集合模型。
+ *
+ * 数据按固定大小的页从数据源读取，只在内存中缓存最近使用的若干页(LRU)，
+ * 并按滚动的方向预读后面的页。适用于数据量远大于内存的场景(如历史记录)。
+ *
+ * 访问还没有加载的行时，属性返回空字符串，"[i].loading"返回TRUE。
+ * 异步加载的数据提交之后，对提交的每一行触发EVT_VIEW_MODEL_ITEM_CHANGED事件。
+ *
+ * 绑定刷新时(view_model_begin_update/view_model_end_update之间)只加载可见区间内的页，
+ * 并且不淘汰本次刷新已经访问过的页，所以行数超过缓存容量的列表也不会反复换页。
+ * 列表滚动时用view_model_array_paged_set_visible更新可见区间。
+ *
+ * 超过loading_timeout还没有提交数据的页可以被淘汰，再次访问时重新请求。
+ *
+ */
+struct _model_array_paged_t {
+  view_model_array_t view_model_array;
+
+  /**
+   * @property {uint32_t} items
+   * @annotation ["readable"]
+   * 总行数。
+   */
+  uint32_t items;
+
+  /**
+   * @property {uint32_t} page_size
+   * @annotation ["readable"]
+   * 每页的行数。
+   */
+  uint32_t page_size;
+
+  /**
+   * @property {uint32_t} read_ahead
+   * @annotation ["readable"]
+   * 预读的页数。
+   */
+  uint32_t read_ahead;
+
+  /**
+   * @property {uint32_t} visible_start
+   * @annotation ["readable"]
+   * 可见区间的起始行。
+   */
+  uint32_t visible_start;
+
+  /**
+   * @property {uint32_t} visible_nr
+   * @annotation ["readable"]
+   * 可见区间的行数(缺省为全部)。
+   */
+  uint32_t visible_nr;
+
+  /**
+   * @property {uint32_t} loading_timeout
+   * @annotation ["readable"]
+   * 加载超时的时间(毫秒)。
+   */
+  uint32_t loading_timeout;
+
+  /*private*/
+  view_model_array_paged_source_t source;
+  char** fields;
+  uint32_t fields_nr;
+
+  view_model_array_paged_page_t* pages;
+  uint32_t pages_nr;
+  uint32_t stamp;
+  int32_t last_page;
+  int32_t direction;
+  bool_t fetching;
+  bool_t filling;
+  bool_t updating;
+  uint32_t update_stamp;
+};
+
+/**
+ * @method view_model_array_paged_create
+ * 创建分页集合模型。
+ *
+ * @param {const view_model_array_paged_source_t*} source 数据源(模型销毁时调用source->destroy)。
+ * @param {const char**} fields 每行的字段名。
+ * @param {uint32_t} fields_nr 字段的个数。
+ * @param {uint32_t} page_size 每页的行数。
+ * @param {uint32_t} cache_pages 缓存的页数。
+ *
+ * @return {view_model_t*} 返回view_model对象。
+ */
+view_model_t* view_model_array_paged_create(const view_model_array_paged_source_t* source,
+                                            const char** fields, uint32_t fields_nr,
+                                            uint32_t page_size, uint32_t cache_pages);
+
+/**
+ * @method view_model_array_paged_set_read_ahead
+ * 设置预读的页数(缺省为1)。缓存的页数会相应增加，保证预读的页不会挤掉正在访问的页。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} pages 预读的页数(0表示不预读)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_paged_set_read_ahead(view_model_t* view_model, uint32_t pages);
+
+/**
+ * @method view_model_array_paged_fill
+ * 提交一页的数据。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} start 起始行(请求时的start)。
+ * @param {uint32_t} nr 行数。
+ * @param {const value_t*} values 数据，按行存放，每行fields_nr个值，模型会复制一份。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，该页已经不需要时返回RET_NOT_FOUND，否则表示失败。
+ */
+ret_t view_model_array_paged_fill(view_model_t* view_model, uint32_t start, uint32_t nr,
+                                  const value_t* values);
+
+/**
+ * @method view_model_array_paged_reload
+ * 丢弃全部缓存，重新获取总行数，并触发EVT_ITEMS_CHANGED事件。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_paged_reload(view_model_t* view_model);
+
+/**
+ * @method view_model_array_paged_set_visible
+ * 设置可见区间，有变化时触发EVT_PROPS_CHANGED事件刷新界面。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} start 起始行。
+ * @param {uint32_t} nr 行数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_paged_set_visible(view_model_t* view_model, uint32_t start, uint32_t nr);
+
+/**
+ * @method view_model_array_paged_set_loading_timeout
+ * 设置加载超时的时间(缺省为VIEW_MODEL_ARRAY_PAGED_LOADING_TIMEOUT)。
+ * 超时的页可以被淘汰，再次访问时重新请求。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} ms 超时的时间(毫秒)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_paged_set_loading_timeout(view_model_t* view_model, uint32_t ms);
+
+/**
+ * @method view_model_array_paged_is_loaded
+ * 检查指定的行是否已经加载。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} index 行的序数。
+ *
+ * @return {bool_t} 返回TRUE表示已经加载，否则表示没有加载。
+ */
+bool_t view_model_array_paged_is_loaded(view_model_t* view_model, uint32_t index);
+
+#define VIEW_MODEL_ARRAY_PAGED_PROP_LOADING "loading"
+
+#ifndef VIEW_MODEL_ARRAY_PAGED_LOADING_TIMEOUT
+#define VIEW_MODEL_ARRAY_PAGED_LOADING_TIMEOUT 3000
+#endif /*VIEW_MODEL_ARRAY_PAGED_LOADING_TIMEOUT*/
+
+#define VIEW_MODEL_ARRAY_PAGED(view_model) ((view_model_array_paged_t*)(view_model))
+
+END_C_DECLS
+
+#endif /*TK_VIEW_MODEL_ARRAY_PAGED_H*/
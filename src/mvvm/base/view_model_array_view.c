@@ -0,0 +1,631 @@
+﻿/**
+ * File:   view_model_array_view.c
+ * Author: AWTK Develop Team
+ * Brief:  sorted/filtered view of view_model_array
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "mvvm/base/utils.h"
+#include "mvvm/base/view_model_array_view.h"
+
+static ret_t view_model_array_view_extend(view_model_array_view_t* view, uint32_t size) {
+  uint32_t* sorted = NULL;
+  uint32_t* visible = NULL;
+  uint32_t capacity = 0;
+
+  if (size <= view->capacity) {
+    return RET_OK;
+  }
+
+  capacity = tk_max(size, view->capacity + (view->capacity >> 1));
+  sorted = (uint32_t*)TKMEM_REALLOC(view->sorted, capacity * sizeof(uint32_t));
+  return_value_if_fail(sorted != NULL, RET_OOM);
+  view->sorted = sorted;
+
+  visible = (uint32_t*)TKMEM_REALLOC(view->visible, capacity * sizeof(uint32_t));
+  return_value_if_fail(visible != NULL, RET_OOM);
+  view->visible = visible;
+  view->capacity = capacity;
+
+  return RET_OK;
+}
+
+/*比较结果相同时按源集合中的序数比较，保证任意两项都有确定的先后顺序*/
+static int32_t view_model_array_view_cmp(view_model_array_view_t* view, uint32_t a, uint32_t b) {
+  int32_t ret = 0;
+
+  if (view->compare != NULL) {
+    ret = view->compare(view->compare_ctx, view->source, a, b);
+  }
+
+  if (ret == 0) {
+    ret = a < b ? -1 : (a > b ? 1 : 0);
+  }
+
+  return ret;
+}
+
+static bool_t view_model_array_view_is_visible(view_model_array_view_t* view, uint32_t index) {
+  return view->filter == NULL || view->filter(view->filter_ctx, view->source, index);
+}
+
+/*自底向上的归并排序，visible作为临时空间*/
+static ret_t view_model_array_view_sort(view_model_array_view_t* view) {
+  uint32_t lo = 0;
+  uint32_t width = 0;
+  uint32_t n = view->size;
+  uint32_t* src = view->sorted;
+  uint32_t* dst = view->visible;
+
+  for (width = 1; width < n; width *= 2) {
+    for (lo = 0; lo < n; lo += 2 * width) {
+      uint32_t mid = tk_min(lo + width, n);
+      uint32_t hi = tk_min(lo + 2 * width, n);
+      uint32_t i = lo;
+      uint32_t j = mid;
+      uint32_t k = lo;
+
+      while (i < mid && j < hi) {
+        if (view_model_array_view_cmp(view, src[j], src[i]) < 0) {
+          dst[k++] = src[j++];
+        } else {
+          dst[k++] = src[i++];
+        }
+      }
+
+      while (i < mid) {
+        dst[k++] = src[i++];
+      }
+
+      while (j < hi) {
+        dst[k++] = src[j++];
+      }
+    }
+
+    dst = src;
+    src = (src == view->sorted) ? view->visible : view->sorted;
+  }
+
+  if (src != view->sorted) {
+    memcpy(view->sorted, src, n * sizeof(uint32_t));
+  }
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_view_refilter(view_model_array_view_t* view, bool_t narrow) {
+  uint32_t i = 0;
+  uint32_t nr = 0;
+  uint32_t index = 0;
+
+  if (narrow) {
+    for (i = 0; i < view->visible_size; i++) {
+      index = view->visible[i];
+      if (view_model_array_view_is_visible(view, index)) {
+        view->visible[nr++] = index;
+      }
+    }
+  } else {
+    for (i = 0; i < view->size; i++) {
+      index = view->sorted[i];
+      if (view_model_array_view_is_visible(view, index)) {
+        view->visible[nr++] = index;
+      }
+    }
+  }
+  view->visible_size = nr;
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_view_reload(view_model_array_view_t* view) {
+  uint32_t i = 0;
+  uint32_t size = object_get_prop_int(OBJECT(view->source), VIEW_MODEL_PROP_ITEMS, 0);
+  return_value_if_fail(view_model_array_view_extend(view, size) == RET_OK, RET_OOM);
+
+  view->size = size;
+  for (i = 0; i < size; i++) {
+    view->sorted[i] = i;
+  }
+
+  if (view->compare != NULL) {
+    view_model_array_view_sort(view);
+  }
+
+  return view_model_array_view_refilter(view, FALSE);
+}
+
+/*返回第一个排在index之后的位置*/
+static uint32_t view_model_array_view_bound(view_model_array_view_t* view, const uint32_t* arr,
+                                            uint32_t nr, uint32_t index) {
+  uint32_t low = 0;
+  uint32_t high = nr;
+
+  while (low < high) {
+    uint32_t mid = low + ((high - low) >> 1);
+
+    if (view_model_array_view_cmp(view, arr[mid], index) > 0) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+
+  return low;
+}
+
+static int32_t view_model_array_view_find(const uint32_t* arr, uint32_t nr, uint32_t index) {
+  uint32_t i = 0;
+
+  for (i = 0; i < nr; i++) {
+    if (arr[i] == index) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+static ret_t view_model_array_view_insert_at(uint32_t* arr, uint32_t* nr, uint32_t pos,
+                                             uint32_t index) {
+  memmove(arr + pos + 1, arr + pos, (*nr - pos) * sizeof(uint32_t));
+  arr[pos] = index;
+  *nr = *nr + 1;
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_view_remove_at(uint32_t* arr, uint32_t* nr, uint32_t pos) {
+  memmove(arr + pos, arr + pos + 1, (*nr - pos - 1) * sizeof(uint32_t));
+  *nr = *nr - 1;
+
+  return RET_OK;
+}
+
+/*源集合中插入(delta为1)或删除(delta为-1)一项之后，调整之后的项的序数*/
+static ret_t view_model_array_view_shift(view_model_array_view_t* view, uint32_t index,
+                                         int32_t delta) {
+  uint32_t i = 0;
+
+  for (i = 0; i < view->size; i++) {
+    if (view->sorted[i] >= index) {
+      view->sorted[i] += delta;
+    }
+  }
+
+  for (i = 0; i < view->visible_size; i++) {
+    if (view->visible[i] >= index) {
+      view->visible[i] += delta;
+    }
+  }
+
+  return RET_OK;
+}
+
+/*把源集合中的一项放到排列中，返回它在视图中的位置，不可见时返回-1*/
+static int32_t view_model_array_view_place(view_model_array_view_t* view, uint32_t index) {
+  uint32_t pos = view_model_array_view_bound(view, view->sorted, view->size, index);
+
+  view_model_array_view_insert_at(view->sorted, &(view->size), pos, index);
+  if (!view_model_array_view_is_visible(view, index)) {
+    return -1;
+  }
+
+  pos = view_model_array_view_bound(view, view->visible, view->visible_size, index);
+  view_model_array_view_insert_at(view->visible, &(view->visible_size), pos, index);
+
+  return pos;
+}
+
+/*从排列中移除源集合中的一项，返回它原来在视图中的位置，原来不可见时返回-1*/
+static int32_t view_model_array_view_unplace(view_model_array_view_t* view, uint32_t index) {
+  int32_t pos = view_model_array_view_find(view->sorted, view->size, index);
+
+  if (pos >= 0) {
+    view_model_array_view_remove_at(view->sorted, &(view->size), pos);
+  }
+
+  pos = view_model_array_view_find(view->visible, view->visible_size, index);
+  if (pos >= 0) {
+    view_model_array_view_remove_at(view->visible, &(view->visible_size), pos);
+  }
+
+  return pos;
+}
+
+static ret_t view_model_array_view_on_item_inserted(view_model_array_view_t* view,
+                                                    uint32_t index) {
+  int32_t pos = 0;
+  return_value_if_fail(index <= view->size, RET_BAD_PARAMS);
+  return_value_if_fail(view_model_array_view_extend(view, view->size + 1) == RET_OK, RET_OOM);
+
+  view_model_array_view_shift(view, index, 1);
+  pos = view_model_array_view_place(view, index);
+  if (pos >= 0) {
+    view_model_array_notify_item_inserted(VIEW_MODEL(view), pos);
+  }
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_view_on_item_removed(view_model_array_view_t* view,
+                                                   uint32_t index) {
+  int32_t pos = 0;
+  return_value_if_fail(index < view->size, RET_BAD_PARAMS);
+
+  pos = view_model_array_view_unplace(view, index);
+  view_model_array_view_shift(view, index + 1, -1);
+  if (pos >= 0) {
+    view_model_array_notify_item_removed(VIEW_MODEL(view), pos);
+  }
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_view_on_item_changed(view_model_array_view_t* view,
+                                                   uint32_t index) {
+  int32_t old_pos = 0;
+  int32_t new_pos = 0;
+  return_value_if_fail(index < view->size, RET_BAD_PARAMS);
+
+  old_pos = view_model_array_view_unplace(view, index);
+  new_pos = view_model_array_view_place(view, index);
+
+  if (old_pos >= 0 && old_pos == new_pos) {
+    view_model_array_notify_item_changed(VIEW_MODEL(view), new_pos);
+  } else {
+    if (old_pos >= 0) {
+      view_model_array_notify_item_removed(VIEW_MODEL(view), old_pos);
+    }
+
+    if (new_pos >= 0) {
+      view_model_array_notify_item_inserted(VIEW_MODEL(view), new_pos);
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_view_on_source_event(void* ctx, event_t* e) {
+  view_model_array_view_t* view = VIEW_MODEL_ARRAY_VIEW(ctx);
+  view_model_item_event_t* evt = (view_model_item_event_t*)e;
+
+  switch (e->type) {
+    case EVT_VIEW_MODEL_ITEM_INSERTED: {
+      view_model_array_view_on_item_inserted(view, evt->index);
+      break;
+    }
+    case EVT_VIEW_MODEL_ITEM_REMOVED: {
+      view_model_array_view_on_item_removed(view, evt->index);
+      break;
+    }
+    case EVT_VIEW_MODEL_ITEM_CHANGED: {
+      view_model_array_view_on_item_changed(view, evt->index);
+      break;
+    }
+    case EVT_ITEMS_CHANGED: {
+      view_model_array_view_reload(view);
+      view_model_array_notify_items_changed(VIEW_MODEL(view));
+      break;
+    }
+    default: {
+      /*原样转发(保留prop_change_event_t等的名称和值)，只把target换成视图*/
+      void* target = e->target;
+
+      e->target = view;
+      emitter_dispatch(EMITTER(view), e);
+      e->target = target;
+      break;
+    }
+  }
+
+  return RET_OK;
+}
+
+/*把"[i].xxx"中视图的序数换成源集合的序数*/
+static const char* view_model_array_view_map_prop(view_model_array_view_t* view, const char* name,
+                                                  uint32_t* source_index) {
+  uint32_t index = 0;
+  char prefix[TK_NUM_MAX_LEN + 4];
+  const char* prop = destruct_array_prop_name(name, &index);
+  return_value_if_fail(prop != NULL, NULL);
+
+  if (prop == name) {
+    return name;
+  }
+  return_value_if_fail(index < view->visible_size, NULL);
+
+  *source_index = view->visible[index];
+  tk_snprintf(prefix, sizeof(prefix) - 1, "[%u].", *source_index);
+  str_set(&(view->temp), prefix);
+  str_append(&(view->temp), prop);
+
+  return view->temp.str;
+}
+
+static ret_t view_model_array_view_on_destroy(object_t* obj) {
+  view_model_array_view_t* view = VIEW_MODEL_ARRAY_VIEW(obj);
+
+  emitter_off_by_ctx(EMITTER(view->source), view);
+  object_unref(OBJECT(view->source));
+
+  TKMEM_FREE(view->sorted);
+  TKMEM_FREE(view->visible);
+  str_reset(&(view->sort_prop));
+  str_reset(&(view->filter_expr));
+  str_reset(&(view->temp));
+  view_model_array_deinit(VIEW_MODEL(obj));
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_view_set_prop(object_t* obj, const char* name, const value_t* v) {
+  ret_t ret = RET_OK;
+  uint32_t index = 0xffffffff;
+  view_model_array_view_t* view = VIEW_MODEL_ARRAY_VIEW(obj);
+  return_value_if_fail(obj != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+
+  if (tk_str_eq(VIEW_MODEL_PROP_CURSOR, name)) {
+    view_model_array_set_cursor(VIEW_MODEL(obj), value_int(v));
+
+    return RET_OK;
+  }
+
+  name = view_model_array_view_map_prop(view, name, &index);
+  return_value_if_fail(name != NULL, RET_BAD_PARAMS);
+
+  ret = object_set_prop(OBJECT(view->source), name, v);
+  if (ret == RET_OK && index != 0xffffffff) {
+    view_model_array_view_on_item_changed(view, index);
+  }
+
+  return ret;
+}
+
+static ret_t view_model_array_view_get_prop(object_t* obj, const char* name, value_t* v) {
+  uint32_t index = 0;
+  view_model_array_view_t* view = VIEW_MODEL_ARRAY_VIEW(obj);
+  return_value_if_fail(obj != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+
+  if (tk_str_eq(VIEW_MODEL_PROP_ITEMS, name)) {
+    value_set_int(v, view->visible_size);
+
+    return RET_OK;
+  } else if (tk_str_eq(VIEW_MODEL_PROP_CURSOR, name)) {
+    value_set_int(v, VIEW_MODEL_ARRAY(obj)->cursor);
+
+    return RET_OK;
+  }
+
+  name = view_model_array_view_map_prop(view, name, &index);
+  return_value_if_fail(name != NULL, RET_BAD_PARAMS);
+
+  return object_get_prop(OBJECT(view->source), name, v);
+}
+
+/*集合模型的命令参数是当前项的序数，需要换成源集合的序数*/
+static const char* view_model_array_view_map_args(view_model_array_view_t* view,
+                                                  const char* args, char* buff,
+                                                  uint32_t* source_index) {
+  uint32_t index = 0;
+
+  if (args == NULL || args[0] < '0' || args[0] > '9') {
+    return args;
+  }
+
+  index = tk_atoi(args);
+  if (index >= view->visible_size) {
+    return args;
+  }
+
+  *source_index = view->visible[index];
+  tk_snprintf(buff, TK_NUM_MAX_LEN, "%u", *source_index);
+
+  return buff;
+}
+
+static bool_t view_model_array_view_can_exec(object_t* obj, const char* name, const char* args) {
+  uint32_t index = 0;
+  char buff[TK_NUM_MAX_LEN + 1];
+  view_model_array_view_t* view = VIEW_MODEL_ARRAY_VIEW(obj);
+  return_value_if_fail(obj != NULL && name != NULL, FALSE);
+
+  args = view_model_array_view_map_args(view, args, buff, &index);
+
+  return object_can_exec(OBJECT(view->source), name, args);
+}
+
+static ret_t view_model_array_view_exec(object_t* obj, const char* name, const char* args) {
+  ret_t ret = RET_OK;
+  uint32_t index = 0xffffffff;
+  char buff[TK_NUM_MAX_LEN + 1];
+  view_model_array_view_t* view = VIEW_MODEL_ARRAY_VIEW(obj);
+  return_value_if_fail(obj != NULL && name != NULL, RET_BAD_PARAMS);
+
+  args = view_model_array_view_map_args(view, args, buff, &index);
+
+  ret = object_exec(OBJECT(view->source), name, args);
+  if (ret == RET_ITEMS_CHANGED) {
+    view_model_array_view_reload(view);
+  } else if (ret == RET_OBJECT_CHANGED && index != 0xffffffff) {
+    view_model_array_view_on_item_changed(view, index);
+  }
+
+  return ret;
+}
+
+static const object_vtable_t s_model_array_view_vtable = {
+    .type = "view_model_array_view",
+    .desc = "view_model_array_view",
+    .size = sizeof(view_model_array_view_t),
+    .is_collection = TRUE,
+    .on_destroy = view_model_array_view_on_destroy,
+
+    .get_prop = view_model_array_view_get_prop,
+    .set_prop = view_model_array_view_set_prop,
+    .can_exec = view_model_array_view_can_exec,
+    .exec = view_model_array_view_exec};
+
+view_model_t* view_model_array_view_create(view_model_t* source) {
+  object_t* obj = NULL;
+  view_model_array_view_t* view = NULL;
+  return_value_if_fail(source != NULL && object_is_collection(OBJECT(source)), NULL);
+
+  obj = object_create(&s_model_array_view_vtable);
+  view = VIEW_MODEL_ARRAY_VIEW(obj);
+  return_value_if_fail(view != NULL, NULL);
+
+  view_model_array_init(VIEW_MODEL(obj));
+  str_init(&(view->sort_prop), 0);
+  str_init(&(view->filter_expr), 0);
+  str_init(&(view->temp), 0);
+  view->ascending = TRUE;
+  view->source = source;
+  object_ref(OBJECT(source));
+  view_model_array_view_reload(view);
+
+  emitter_on(EMITTER(source), EVT_VIEW_MODEL_ITEM_INSERTED, view_model_array_view_on_source_event,
+             view);
+  emitter_on(EMITTER(source), EVT_VIEW_MODEL_ITEM_REMOVED, view_model_array_view_on_source_event,
+             view);
+  emitter_on(EMITTER(source), EVT_VIEW_MODEL_ITEM_CHANGED, view_model_array_view_on_source_event,
+             view);
+  emitter_on(EMITTER(source), EVT_ITEMS_CHANGED, view_model_array_view_on_source_event, view);
+  emitter_on(EMITTER(source), EVT_PROP_CHANGED, view_model_array_view_on_source_event, view);
+  emitter_on(EMITTER(source), EVT_PROPS_CHANGED, view_model_array_view_on_source_event, view);
+
+  return VIEW_MODEL(obj);
+}
+
+ret_t view_model_array_view_set_compare(view_model_t* view_model,
+                                        view_model_array_view_compare_t compare, void* ctx) {
+  view_model_array_view_t* view = VIEW_MODEL_ARRAY_VIEW(view_model);
+  return_value_if_fail(view != NULL, RET_BAD_PARAMS);
+
+  view->compare = compare;
+  view->compare_ctx = ctx;
+
+  /*只需要对已有的排列重新排序，不需要访问源集合*/
+  view_model_array_view_sort(view);
+  view_model_array_view_refilter(view, FALSE);
+
+  return view_model_array_notify_items_changed(view_model);
+}
+
+static int32_t view_model_array_view_compare_prop(void* ctx, view_model_t* source, uint32_t a,
+                                                  uint32_t b) {
+  value_t va;
+  value_t vb;
+  int32_t ret = 0;
+  char name[TK_NAME_LEN + TK_NUM_MAX_LEN + 4];
+  view_model_array_view_t* view = VIEW_MODEL_ARRAY_VIEW(ctx);
+
+  value_set_int(&va, 0);
+  value_set_int(&vb, 0);
+  tk_snprintf(name, sizeof(name) - 1, "[%u].%s", a, view->sort_prop.str);
+  object_get_prop(OBJECT(source), name, &va);
+  tk_snprintf(name, sizeof(name) - 1, "[%u].%s", b, view->sort_prop.str);
+  object_get_prop(OBJECT(source), name, &vb);
+
+  if (va.type == VALUE_TYPE_STRING && vb.type == VALUE_TYPE_STRING) {
+    ret = tk_str_cmp(value_str(&va), value_str(&vb));
+  } else {
+    double da = value_double(&va);
+    double db = value_double(&vb);
+
+    ret = da < db ? -1 : (da > db ? 1 : 0);
+  }
+
+  return view->ascending ? ret : -ret;
+}
+
+ret_t view_model_array_view_set_sort_prop(view_model_t* view_model, const char* prop,
+                                          bool_t ascending) {
+  view_model_array_view_t* view = VIEW_MODEL_ARRAY_VIEW(view_model);
+  return_value_if_fail(view != NULL, RET_BAD_PARAMS);
+
+  if (prop == NULL || *prop == '\0') {
+    return view_model_array_view_set_compare(view_model, NULL, NULL);
+  }
+
+  view->ascending = ascending;
+  str_set(&(view->sort_prop), prop);
+
+  return view_model_array_view_set_compare(view_model, view_model_array_view_compare_prop, view);
+}
+
+ret_t view_model_array_view_set_filter(view_model_t* view_model,
+                                       view_model_array_view_filter_t filter, void* ctx,
+                                       bool_t narrow) {
+  view_model_array_view_t* view = VIEW_MODEL_ARRAY_VIEW(view_model);
+  return_value_if_fail(view != NULL, RET_BAD_PARAMS);
+
+  view->filter = filter;
+  view->filter_ctx = ctx;
+  view_model_array_view_refilter(view, narrow && filter != NULL);
+
+  return view_model_array_notify_items_changed(view_model);
+}
+
+static bool_t view_model_array_view_filter_expr(void* ctx, view_model_t* source,
+                                                uint32_t index) {
+  value_t v;
+  bool_t ret = FALSE;
+  view_model_array_view_t* view = VIEW_MODEL_ARRAY_VIEW(ctx);
+  uint32_t cursor = VIEW_MODEL_ARRAY(source)->cursor;
+
+  value_set_int(&v, 0);
+  view_model_array_set_cursor(source, index);
+  if (view_model_eval(source, view->filter_expr.str, &v) == RET_OK) {
+    ret = value_bool(&v);
+  }
+  view_model_array_set_cursor(source, cursor);
+  value_reset(&v);
+
+  return ret;
+}
+
+ret_t view_model_array_view_set_filter_expr(view_model_t* view_model, const char* expr,
+                                            bool_t narrow) {
+  view_model_array_view_t* view = VIEW_MODEL_ARRAY_VIEW(view_model);
+  return_value_if_fail(view != NULL, RET_BAD_PARAMS);
+
+  if (expr == NULL || *expr == '\0') {
+    return view_model_array_view_set_filter(view_model, NULL, NULL, FALSE);
+  }
+
+  str_set(&(view->filter_expr), expr);
+
+  return view_model_array_view_set_filter(view_model, view_model_array_view_filter_expr, view,
+                                          narrow);
+}
+
+int32_t view_model_array_view_get_source_index(view_model_t* view_model, uint32_t index) {
+  view_model_array_view_t* view = VIEW_MODEL_ARRAY_VIEW(view_model);
+  return_value_if_fail(view != NULL && index < view->visible_size, -1);
+
+  return view->visible[index];
+}
+
+int32_t view_model_array_view_size(view_model_t* view_model) {
+  view_model_array_view_t* view = VIEW_MODEL_ARRAY_VIEW(view_model);
+  return_value_if_fail(view != NULL, 0);
+
+  return view->visible_size;
+}
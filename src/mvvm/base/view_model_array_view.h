@@ -0,0 +1,178 @@
+﻿/**
+ * File:   view_model_array_view.h
+ * Author: AWTK Develop Team
+ * Brief:  sorted/filtered view of view_model_array
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#ifndef TK_VIEW_MODEL_ARRAY_VIEW_H
+#define TK_VIEW_MODEL_ARRAY_VIEW_H
+
+#include "mvvm/base/view_model_array.h"
+
+BEGIN_C_DECLS
+
+/**
+ * 比较源集合中的两项(a和b为源集合中的序数)。
+ */
+typedef int32_t (*view_model_array_view_compare_t)(void* ctx, view_model_t* source, uint32_t a,
+                                                   uint32_t b);
+
+/**
+ * 检查源集合中的一项是否可见(index为源集合中的序数)。
+ */
+typedef bool_t (*view_model_array_view_filter_t)(void* ctx, view_model_t* source, uint32_t index);
+
+struct _model_array_view_t;
+typedef struct _model_array_view_t view_model_array_view_t;
+
+/**
+ * @class view_model_array_view_t
+ * @parent view_model_array_t
+ *
+ * 集合模型的排序/过滤视图。
+ *
+ * 视图不拷贝源集合中的数据，只维护一个序数的排列：全部项按排序规则排列的序数表，
+ * 以及其中满足过滤条件的子序列。访问"[i].xxx"时转换为源集合中对应的项。
+ *
+ * 源集合通过view_model_array_notify_item_xxx通知单项的变化时，视图增量地更新排列，
+ * 并以视图中的序数触发EVT_VIEW_MODEL_ITEM_XXX事件。
+ * 源集合触发EVT_ITEMS_CHANGED时，视图重新排序。
+ *
+ */
+struct _model_array_view_t {
+  view_model_array_t view_model_array;
+
+  /**
+   * @property {view_model_t*} source
+   * @annotation ["readable"]
+   * 源集合。
+   */
+  view_model_t* source;
+
+  /*private*/
+  uint32_t* sorted;
+  uint32_t* visible;
+  uint32_t size;
+  uint32_t visible_size;
+  uint32_t capacity;
+
+  view_model_array_view_compare_t compare;
+  void* compare_ctx;
+  view_model_array_view_filter_t filter;
+  void* filter_ctx;
+
+  str_t sort_prop;
+  bool_t ascending;
+  str_t filter_expr;
+  str_t temp;
+};
+
+/**
+ * @method view_model_array_view_create
+ * 创建集合模型的视图。
+ *
+ * @param {view_model_t*} source 源集合(视图会增加它的引用计数)。
+ *
+ * @return {view_model_t*} 返回view_model对象。
+ */
+view_model_t* view_model_array_view_create(view_model_t* source);
+
+/**
+ * @method view_model_array_view_set_compare
+ * 设置排序的比较函数，并重新排序。
+ * 比较结果相同的项按源集合中的顺序排列。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {view_model_array_view_compare_t} compare 比较函数(NULL表示保持源集合中的顺序)。
+ * @param {void*} ctx 比较函数的上下文。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_view_set_compare(view_model_t* view_model,
+                                        view_model_array_view_compare_t compare, void* ctx);
+
+/**
+ * @method view_model_array_view_set_sort_prop
+ * 按指定的属性排序。字符串按字典序比较，其它类型按数值比较。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {const char*} prop 属性名(NULL表示保持源集合中的顺序)。
+ * @param {bool_t} ascending 是否升序。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_view_set_sort_prop(view_model_t* view_model, const char* prop,
+                                          bool_t ascending);
+
+/**
+ * @method view_model_array_view_set_filter
+ * 设置过滤函数，并重新过滤。
+ *
+ *> 如果新的条件比原来的更严格(比如搜索的关键字在原来的基础上增加了字符)，
+ *> narrow为TRUE时只检查当前可见的项，而不用检查全部的项。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {view_model_array_view_filter_t} filter 过滤函数(NULL表示全部可见)。
+ * @param {void*} ctx 过滤函数的上下文。
+ * @param {bool_t} narrow 新的条件是否比原来的更严格。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_view_set_filter(view_model_t* view_model,
+                                       view_model_array_view_filter_t filter, void* ctx,
+                                       bool_t narrow);
+
+/**
+ * @method view_model_array_view_set_filter_expr
+ * 设置过滤表达式，并重新过滤。表达式中用item.xxx访问当前项的属性，如"item.stock > 0"。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {const char*} expr 表达式(NULL或空字符串表示全部可见)。
+ * @param {bool_t} narrow 新的条件是否比原来的更严格。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_view_set_filter_expr(view_model_t* view_model, const char* expr,
+                                            bool_t narrow);
+
+/**
+ * @method view_model_array_view_get_source_index
+ * 获取视图中的项在源集合中的序数。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} index 视图中的序数。
+ *
+ * @return {int32_t} 返回源集合中的序数，失败返回-1。
+ */
+int32_t view_model_array_view_get_source_index(view_model_t* view_model, uint32_t index);
+
+/**
+ * @method view_model_array_view_size
+ * 获取可见的项数。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ *
+ * @return {int32_t} 返回可见的项数。
+ */
+int32_t view_model_array_view_size(view_model_t* view_model);
+
+#define VIEW_MODEL_ARRAY_VIEW(view_model) ((view_model_array_view_t*)(view_model))
+
+END_C_DECLS
+
+#endif /*TK_VIEW_MODEL_ARRAY_VIEW_H*/
@@ -21,7 +21,7 @@
 
 #include "tkc/mem.h"
 #include "tkc/utils.h"
-#include "tkc/object_default.h"
+#include "mvvm/base/navigator_trace.h"
 #include "mvvm/base/view_model_factory.h"
 
 static view_model_factory_t* s_model_factory;
@@ -31,11 +31,7 @@ ret_t view_model_factory_init(void) {
     s_model_factory = TKMEM_ZALLOC(view_model_factory_t);
     return_value_if_fail(s_model_factory != NULL, RET_OOM);
 
-    s_model_factory->creators = object_default_create();
-    if (s_model_factory->creators == NULL) {
-      TKMEM_FREE(s_model_factory);
-      s_model_factory = NULL;
-    }
+    registry_init(&(s_model_factory->creators), NULL);
   }
 
   return s_model_factory != NULL ? RET_OK : RET_FAIL;
@@ -44,37 +40,42 @@ ret_t view_model_factory_init(void) {
 bool_t view_model_factory_exist(const char* type) {
   return_value_if_fail(s_model_factory != NULL && type != NULL, FALSE);
 
-  return object_has_prop((s_model_factory->creators), type);
+  return registry_has(&(s_model_factory->creators), type);
 }
 
 ret_t view_model_factory_unregister(const char* type) {
   return_value_if_fail(s_model_factory != NULL && type != NULL, RET_BAD_PARAMS);
 
-  return object_remove_prop((s_model_factory->creators), type);
+  return registry_remove(&(s_model_factory->creators), type);
 }
 
 ret_t view_model_factory_register(const char* type, view_model_create_t create) {
   return_value_if_fail(s_model_factory != NULL && type != NULL && create != NULL, RET_BAD_PARAMS);
 
-  return object_set_prop_pointer(s_model_factory->creators, type, create);
+  return registry_set(&(s_model_factory->creators), type, create);
 }
 
 view_model_t* view_model_factory_create_model(const char* type, navigator_request_t* req) {
+  uint64_t start = 0;
+  view_model_t* view_model = NULL;
   view_model_create_t create = NULL;
   return_value_if_fail(s_model_factory != NULL && type != NULL && req != NULL, NULL);
-  create = (view_model_create_t)object_get_prop_pointer(s_model_factory->creators, type);
+  create = (view_model_create_t)registry_get(&(s_model_factory->creators), type);
   if (create != NULL) {
-    return create(req);
+    start = navigator_trace_now();
+    view_model = create(req);
+    navigator_trace_add(NAVIGATOR_TRACE_VIEW_MODEL_CREATE, start);
+
+    return view_model;
   } else {
     return NULL;
   }
 }
 
 ret_t view_model_factory_deinit(void) {
-  return_value_if_fail(s_model_factory != NULL && s_model_factory->creators != NULL,
-                       RET_BAD_PARAMS);
+  return_value_if_fail(s_model_factory != NULL, RET_BAD_PARAMS);
 
-  object_unref(s_model_factory->creators);
+  registry_deinit(&(s_model_factory->creators));
   TKMEM_FREE(s_model_factory);
 
   s_model_factory = NULL;
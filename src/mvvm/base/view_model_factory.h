@@ -22,6 +22,7 @@
 #ifndef TK_VIEW_MODEL_FACTORY_H
 #define TK_VIEW_MODEL_FACTORY_H
 
+#include "mvvm/base/registry.h"
 #include "mvvm/base/view_model.h"
 
 BEGIN_C_DECLS
@@ -33,7 +34,7 @@ BEGIN_C_DECLS
  *
  */
 typedef struct _model_factory_t {
-  object_t* creators;
+  registry_t creators;
 } view_model_factory_t;
 
 /**
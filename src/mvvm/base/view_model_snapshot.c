@@ -0,0 +1,402 @@
+﻿/**
+ * File:   view_model_snapshot.c
+ * Author: AWTK Develop Team
+ * Brief:  binary snapshot of view model
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "mvvm/base/view_model.h"
+#include "mvvm/base/view_model_snapshot.h"
+
+static void view_model_snapshot_put(uint8_t* p, uint64_t v, uint32_t size) {
+  uint32_t i = 0;
+
+  for (i = 0; i < size; i++) {
+    p[i] = (uint8_t)(v >> (i * 8));
+  }
+}
+
+static uint64_t view_model_snapshot_get(const uint8_t* p, uint32_t size) {
+  uint32_t i = 0;
+  uint64_t v = 0;
+
+  for (i = 0; i < size; i++) {
+    v |= ((uint64_t)(p[i])) << (i * 8);
+  }
+
+  return v;
+}
+
+/*返回固定长度类型的数据长度，其它类型返回0，数据之前有4字节的长度*/
+static uint32_t view_model_snapshot_type_size(uint32_t type) {
+  switch (type) {
+    case VALUE_TYPE_BOOL:
+    case VALUE_TYPE_INT8:
+    case VALUE_TYPE_UINT8: {
+      return 1;
+    }
+    case VALUE_TYPE_INT16:
+    case VALUE_TYPE_UINT16: {
+      return 2;
+    }
+    case VALUE_TYPE_INT32:
+    case VALUE_TYPE_UINT32:
+    case VALUE_TYPE_FLOAT32: {
+      return 4;
+    }
+    case VALUE_TYPE_INT64:
+    case VALUE_TYPE_UINT64:
+    case VALUE_TYPE_DOUBLE: {
+      return 8;
+    }
+    default: {
+      return 0;
+    }
+  }
+}
+
+static ret_t view_model_snapshot_extend(view_model_snapshot_t* snapshot, uint32_t size) {
+  uint8_t* data = NULL;
+  uint32_t capacity = 0;
+
+  if (snapshot->size + size <= snapshot->capacity) {
+    return RET_OK;
+  }
+
+  capacity = snapshot->capacity + (snapshot->capacity >> 1) + size;
+  data = (uint8_t*)TKMEM_REALLOC(snapshot->data, capacity);
+  return_value_if_fail(data != NULL, RET_OOM);
+
+  snapshot->data = data;
+  snapshot->capacity = capacity;
+
+  return RET_OK;
+}
+
+view_model_snapshot_t* view_model_snapshot_init(view_model_snapshot_t* snapshot) {
+  return_value_if_fail(snapshot != NULL, NULL);
+
+  memset(snapshot, 0x00, sizeof(*snapshot));
+  return_value_if_fail(view_model_snapshot_extend(snapshot, 64) == RET_OK, NULL);
+
+  view_model_snapshot_put(snapshot->data, VIEW_MODEL_SNAPSHOT_MAGIC, 4);
+  view_model_snapshot_put(snapshot->data + 4, VIEW_MODEL_SNAPSHOT_VERSION, 2);
+  view_model_snapshot_put(snapshot->data + 6, 0, 2);
+  view_model_snapshot_put(snapshot->data + 8, 0, 4);
+  snapshot->size = VIEW_MODEL_SNAPSHOT_HEADER_SIZE;
+
+  return snapshot;
+}
+
+ret_t view_model_snapshot_attach(view_model_snapshot_t* snapshot, const void* data, uint32_t size) {
+  const uint8_t* p = (const uint8_t*)data;
+  return_value_if_fail(snapshot != NULL && data != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(size >= VIEW_MODEL_SNAPSHOT_HEADER_SIZE, RET_BAD_PARAMS);
+
+  memset(snapshot, 0x00, sizeof(*snapshot));
+  if (view_model_snapshot_get(p, 4) != VIEW_MODEL_SNAPSHOT_MAGIC) {
+    log_warn("%s: invalid snapshot\n", __FUNCTION__);
+    return RET_BAD_PARAMS;
+  }
+
+  if (view_model_snapshot_get(p + 4, 2) > VIEW_MODEL_SNAPSHOT_VERSION) {
+    log_warn("%s: snapshot version is not supported\n", __FUNCTION__);
+    return RET_NOT_IMPL;
+  }
+
+  snapshot->readonly = TRUE;
+  snapshot->data = (uint8_t*)p;
+  snapshot->size = size;
+  snapshot->capacity = size;
+  snapshot->nr = (uint32_t)view_model_snapshot_get(p + 8, 4);
+  snapshot->cursor = VIEW_MODEL_SNAPSHOT_HEADER_SIZE;
+
+  return RET_OK;
+}
+
+ret_t view_model_snapshot_write(view_model_snapshot_t* snapshot, uint32_t field_id,
+                                const value_t* v) {
+  uint8_t* p = NULL;
+  uint64_t raw = 0;
+  uint32_t size = 0;
+  const char* str = NULL;
+  uint32_t type = VALUE_TYPE_INVALID;
+  return_value_if_fail(snapshot != NULL && v != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(!snapshot->readonly && snapshot->data != NULL, RET_BAD_PARAMS);
+
+  type = v->type;
+  switch (type) {
+    case VALUE_TYPE_BOOL: {
+      raw = value_bool(v) ? 1 : 0;
+      break;
+    }
+    case VALUE_TYPE_INT8:
+    case VALUE_TYPE_INT16:
+    case VALUE_TYPE_INT32:
+    case VALUE_TYPE_INT64: {
+      raw = (uint64_t)value_int64(v);
+      break;
+    }
+    case VALUE_TYPE_UINT8:
+    case VALUE_TYPE_UINT16:
+    case VALUE_TYPE_UINT32:
+    case VALUE_TYPE_UINT64: {
+      raw = value_uint64(v);
+      break;
+    }
+    case VALUE_TYPE_FLOAT:
+    case VALUE_TYPE_FLOAT32: {
+      uint32_t u = 0;
+      float f = (float)value_float(v);
+
+      memcpy(&u, &f, sizeof(u));
+      raw = u;
+      type = VALUE_TYPE_FLOAT32;
+      break;
+    }
+    case VALUE_TYPE_DOUBLE: {
+      double d = value_double(v);
+
+      memcpy(&raw, &d, sizeof(raw));
+      break;
+    }
+    case VALUE_TYPE_STRING: {
+      str = value_str(v);
+      str = str != NULL ? str : "";
+      break;
+    }
+    default: {
+      return RET_NOT_IMPL;
+    }
+  }
+
+  size = str != NULL ? (4 + strlen(str) + 1) : view_model_snapshot_type_size(type);
+  return_value_if_fail(view_model_snapshot_extend(snapshot, 5 + size) == RET_OK, RET_OOM);
+
+  p = snapshot->data + snapshot->size;
+  view_model_snapshot_put(p, field_id, 4);
+  p[4] = (uint8_t)type;
+
+  if (str != NULL) {
+    view_model_snapshot_put(p + 5, size - 4, 4);
+    memcpy(p + 9, str, size - 4);
+  } else {
+    view_model_snapshot_put(p + 5, raw, size);
+  }
+
+  snapshot->nr++;
+  snapshot->size += 5 + size;
+  view_model_snapshot_put(snapshot->data + 8, snapshot->nr, 4);
+
+  return RET_OK;
+}
+
+static ret_t view_model_snapshot_to_value(uint32_t type, const uint8_t* p, uint32_t size,
+                                          value_t* v) {
+  uint64_t raw = view_model_snapshot_get(p, view_model_snapshot_type_size(type));
+
+  switch (type) {
+    case VALUE_TYPE_BOOL: {
+      value_set_bool(v, raw != 0);
+      break;
+    }
+    case VALUE_TYPE_INT8: {
+      value_set_int8(v, (int8_t)raw);
+      break;
+    }
+    case VALUE_TYPE_UINT8: {
+      value_set_uint8(v, (uint8_t)raw);
+      break;
+    }
+    case VALUE_TYPE_INT16: {
+      value_set_int16(v, (int16_t)raw);
+      break;
+    }
+    case VALUE_TYPE_UINT16: {
+      value_set_uint16(v, (uint16_t)raw);
+      break;
+    }
+    case VALUE_TYPE_INT32: {
+      value_set_int32(v, (int32_t)raw);
+      break;
+    }
+    case VALUE_TYPE_UINT32: {
+      value_set_uint32(v, (uint32_t)raw);
+      break;
+    }
+    case VALUE_TYPE_INT64: {
+      value_set_int64(v, (int64_t)raw);
+      break;
+    }
+    case VALUE_TYPE_UINT64: {
+      value_set_uint64(v, raw);
+      break;
+    }
+    case VALUE_TYPE_FLOAT32: {
+      float f = 0;
+      uint32_t u = (uint32_t)raw;
+
+      memcpy(&f, &u, sizeof(f));
+      value_set_float(v, f);
+      break;
+    }
+    case VALUE_TYPE_DOUBLE: {
+      double d = 0;
+
+      memcpy(&d, &raw, sizeof(d));
+      value_set_double(v, d);
+      break;
+    }
+    case VALUE_TYPE_STRING: {
+      return_value_if_fail(size > 0 && p[size - 1] == '\0', RET_BAD_PARAMS);
+      value_set_str(v, (const char*)p);
+      break;
+    }
+    default: {
+      return RET_NOT_IMPL;
+    }
+  }
+
+  return RET_OK;
+}
+
+/*解析cursor处的记录，返回头部的长度(数据长度放在size中)，记录不完整时返回0*/
+static uint32_t view_model_snapshot_parse(view_model_snapshot_t* snapshot, uint32_t cursor,
+                                          uint32_t* size) {
+  uint32_t head = 5;
+  const uint8_t* p = snapshot->data + cursor;
+  uint32_t left = snapshot->size - cursor;
+
+  if (left < head) {
+    return 0;
+  }
+
+  *size = view_model_snapshot_type_size(p[4]);
+  if (*size == 0) {
+    head = 9;
+    if (left < head) {
+      return 0;
+    }
+    *size = (uint32_t)view_model_snapshot_get(p + 5, 4);
+  }
+
+  return left - head >= *size ? head : 0;
+}
+
+ret_t view_model_snapshot_read(view_model_snapshot_t* snapshot, uint32_t* field_id, value_t* v) {
+  uint32_t size = 0;
+  uint32_t head = 0;
+  const uint8_t* p = NULL;
+  return_value_if_fail(snapshot != NULL && field_id != NULL && v != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(snapshot->readonly, RET_BAD_PARAMS);
+
+  while (snapshot->cursor < snapshot->size) {
+    p = snapshot->data + snapshot->cursor;
+    head = view_model_snapshot_parse(snapshot, snapshot->cursor, &size);
+    return_value_if_fail(head > 0, RET_BAD_PARAMS);
+
+    snapshot->cursor += head + size;
+
+    /*跳过不认识的类型*/
+    if (view_model_snapshot_to_value(p[4], p + head, size, v) == RET_OK) {
+      *field_id = (uint32_t)view_model_snapshot_get(p, 4);
+
+      return RET_OK;
+    }
+  }
+
+  return RET_EOS;
+}
+
+ret_t view_model_snapshot_validate(view_model_snapshot_t* snapshot) {
+  uint32_t nr = 0;
+  uint32_t size = 0;
+  uint32_t head = 0;
+  uint32_t cursor = 0;
+  const uint8_t* p = NULL;
+  return_value_if_fail(snapshot != NULL && snapshot->readonly, RET_BAD_PARAMS);
+
+  for (cursor = VIEW_MODEL_SNAPSHOT_HEADER_SIZE; cursor < snapshot->size; cursor += head + size) {
+    p = snapshot->data + cursor;
+    head = view_model_snapshot_parse(snapshot, cursor, &size);
+    if (head == 0) {
+      return RET_BAD_PARAMS;
+    }
+
+    if (p[4] == VALUE_TYPE_STRING && (size == 0 || p[head + size - 1] != '\0')) {
+      return RET_BAD_PARAMS;
+    }
+    nr++;
+  }
+
+  return nr == snapshot->nr ? RET_OK : RET_BAD_PARAMS;
+}
+
+const void* view_model_snapshot_get_data(view_model_snapshot_t* snapshot, uint32_t* size) {
+  return_value_if_fail(snapshot != NULL && size != NULL, NULL);
+
+  *size = snapshot->size;
+
+  return snapshot->data;
+}
+
+ret_t view_model_snapshot_deinit(view_model_snapshot_t* snapshot) {
+  return_value_if_fail(snapshot != NULL, RET_BAD_PARAMS);
+
+  if (!snapshot->readonly) {
+    TKMEM_FREE(snapshot->data);
+  }
+  memset(snapshot, 0x00, sizeof(*snapshot));
+
+  return RET_OK;
+}
+
+uint32_t view_model_snapshot_field_id(const char* name) {
+  uint32_t hash = 2166136261u;
+  return_value_if_fail(name != NULL, 0);
+
+  while (*name) {
+    hash ^= (uint8_t)(*name++);
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+int32_t view_model_snapshot_find_field(const view_model_snapshot_field_t* fields, uint32_t nr,
+                                       uint32_t field_id) {
+  int32_t low = 0;
+  int32_t high = (int32_t)nr - 1;
+  return_value_if_fail(fields != NULL || nr == 0, VIEW_MODEL_PROP_ID_INVALID);
+
+  while (low <= high) {
+    int32_t mid = low + ((high - low) >> 1);
+    uint32_t iter = fields[mid].field_id;
+
+    if (iter == field_id) {
+      return fields[mid].prop_id;
+    } else if (iter < field_id) {
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+
+  return VIEW_MODEL_PROP_ID_INVALID;
+}
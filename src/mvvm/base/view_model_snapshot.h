@@ -0,0 +1,180 @@
+﻿/**
+ * File:   view_model_snapshot.h
+ * Author: AWTK Develop Team
+ * Brief:  binary snapshot of view model
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#ifndef TK_VIEW_MODEL_SNAPSHOT_H
+#define TK_VIEW_MODEL_SNAPSHOT_H
+
+#include "tkc/value.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class view_model_snapshot_t
+ *
+ * view model的二进制快照，用于快速保存和恢复模型的属性。
+ *
+ * 格式(小端)：头部为魔数(4字节)、格式版本(2字节)、保留(2字节)、字段个数(4字节)，
+ * 之后是若干字段，每个字段为字段ID(4字节)、值类型(1字节)和数据。
+ * 整数、浮点数和布尔值的数据长度由类型决定，其它类型(如字符串)先写4字节的长度。
+ * 读取时跳过不认识的类型，模型也会忽略不认识的字段ID，所以新旧版本的快照可以互相读取。
+ *
+ * 字段ID一般是属性名的哈希值(参考view_model_snapshot_field_id)，调整属性的顺序不影响已有的快照。
+ *
+ */
+typedef struct _view_model_snapshot_t {
+  /**
+   * @property {uint32_t} nr
+   * @annotation ["readable"]
+   * 字段的个数。
+   */
+  uint32_t nr;
+
+  /*private*/
+  uint8_t* data;
+  uint32_t size;
+  uint32_t capacity;
+  uint32_t cursor;
+  bool_t readonly;
+} view_model_snapshot_t;
+
+/**
+ * @class view_model_snapshot_field_t
+ *
+ * 快照的字段ID与属性ID的对应关系。
+ *
+ */
+typedef struct _view_model_snapshot_field_t {
+  uint32_t field_id;
+  int32_t prop_id;
+} view_model_snapshot_field_t;
+
+/**
+ * @method view_model_snapshot_init
+ * 初始化快照，用于写入。
+ *
+ * @param {view_model_snapshot_t*} snapshot 快照对象。
+ *
+ * @return {view_model_snapshot_t*} 返回快照对象，失败返回NULL。
+ */
+view_model_snapshot_t* view_model_snapshot_init(view_model_snapshot_t* snapshot);
+
+/**
+ * @method view_model_snapshot_attach
+ * 关联已有的数据，用于读取。数据不会被拷贝，读取期间必须保持有效(可以是映射到内存的文件)。
+ *
+ * @param {view_model_snapshot_t*} snapshot 快照对象。
+ * @param {const void*} data 数据。
+ * @param {uint32_t} size 数据的长度。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败(如魔数不对或者版本太新)。
+ */
+ret_t view_model_snapshot_attach(view_model_snapshot_t* snapshot, const void* data, uint32_t size);
+
+/**
+ * @method view_model_snapshot_write
+ * 写入一个字段。
+ *
+ * @param {view_model_snapshot_t*} snapshot 快照对象。
+ * @param {uint32_t} field_id 字段ID。
+ * @param {const value_t*} v 值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，不支持的类型(如指针)返回RET_NOT_IMPL，否则表示失败。
+ */
+ret_t view_model_snapshot_write(view_model_snapshot_t* snapshot, uint32_t field_id,
+                                const value_t* v);
+
+/**
+ * @method view_model_snapshot_read
+ * 读取下一个字段。字符串直接指向快照的数据，不需要释放。
+ *
+ * @param {view_model_snapshot_t*} snapshot 快照对象。
+ * @param {uint32_t*} field_id 返回字段ID。
+ * @param {value_t*} v 返回值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，RET_EOS表示没有更多的字段，否则表示数据已经损坏。
+ */
+ret_t view_model_snapshot_read(view_model_snapshot_t* snapshot, uint32_t* field_id, value_t* v);
+
+/**
+ * @method view_model_snapshot_validate
+ * 检查整个快照的数据是否完整(只遍历记录，不移动读取的位置)。
+ * 恢复模型之前先检查，数据损坏时模型保持原样，不会只恢复一部分。
+ *
+ * @param {view_model_snapshot_t*} snapshot 快照对象(由view_model_snapshot_attach关联数据)。
+ *
+ * @return {ret_t} 返回RET_OK表示完整，否则表示数据已经损坏(记录被截断、字符串没有结束符或者字段个数不符)。
+ */
+ret_t view_model_snapshot_validate(view_model_snapshot_t* snapshot);
+
+/**
+ * @method view_model_snapshot_get_data
+ * 获取快照的数据。
+ *
+ * @param {view_model_snapshot_t*} snapshot 快照对象。
+ * @param {uint32_t*} size 返回数据的长度。
+ *
+ * @return {const void*} 返回数据。
+ */
+const void* view_model_snapshot_get_data(view_model_snapshot_t* snapshot, uint32_t* size);
+
+/**
+ * @method view_model_snapshot_deinit
+ * ~初始化。
+ *
+ * @param {view_model_snapshot_t*} snapshot 快照对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_snapshot_deinit(view_model_snapshot_t* snapshot);
+
+/**
+ * @method view_model_snapshot_field_id
+ * 计算属性名对应的字段ID(FNV-1a哈希，与gen_vm.js生成的一致)。
+ *
+ * @param {const char*} name 属性名。
+ *
+ * @return {uint32_t} 返回字段ID。
+ */
+uint32_t view_model_snapshot_field_id(const char* name);
+
+/**
+ * @method view_model_snapshot_find_field
+ * 在按字段ID排序的表中查找字段对应的属性ID。
+ *
+ * @param {const view_model_snapshot_field_t*} fields 字段表。
+ * @param {uint32_t} nr 字段表的长度。
+ * @param {uint32_t} field_id 字段ID。
+ *
+ * @return {int32_t} 返回属性ID，找不到返回VIEW_MODEL_PROP_ID_INVALID。
+ */
+int32_t view_model_snapshot_find_field(const view_model_snapshot_field_t* fields, uint32_t nr,
+                                       uint32_t field_id);
+
+/*集合模型中每条记录之前的字段，值为记录的序数*/
+#define VIEW_MODEL_SNAPSHOT_FIELD_ITEM 0
+
+#define VIEW_MODEL_SNAPSHOT_MAGIC 0x534d5654
+#define VIEW_MODEL_SNAPSHOT_VERSION 1
+#define VIEW_MODEL_SNAPSHOT_HEADER_SIZE 12
+
+END_C_DECLS
+
+#endif /*TK_VIEW_MODEL_SNAPSHOT_H*/
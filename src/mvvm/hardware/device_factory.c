@@ -20,40 +20,40 @@
  */
 
 #include "device_factory.h"
-#include "tkc/object_default.h"
+#include "mvvm/base/registry.h"
 
-static object_t* g_creators = NULL;
+static registry_t s_creators;
+static uint32_t s_init_count = 0;
 
 ret_t device_factory_init(void) {
-  if (g_creators == NULL) {
-    g_creators = object_default_create();
-  } else {
-    object_unref(g_creators);
+  if (s_init_count == 0) {
+    registry_init(&s_creators, NULL);
   }
+  s_init_count++;
 
   return RET_OK;
 }
 
 bool_t device_factory_has(const char* type) {
   return_value_if_fail(type != NULL, RET_BAD_PARAMS);
-  return_value_if_fail(g_creators != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(s_init_count > 0, FALSE);
 
-  return object_get_prop_pointer(g_creators, type) != NULL;
+  return registry_has(&s_creators, type);
 }
 
 ret_t device_factory_unregister(const char* type) {
   return_value_if_fail(type != NULL, RET_BAD_PARAMS);
-  return_value_if_fail(g_creators != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(s_init_count > 0, RET_BAD_PARAMS);
 
-  return object_remove_prop(g_creators, type);
+  return registry_remove(&s_creators, type);
 }
 
 object_t* device_factory_create_device(const char* type, const char* args) {
   device_object_create_t create = NULL;
   return_value_if_fail(type != NULL, NULL);
-  return_value_if_fail(g_creators != NULL, NULL);
+  return_value_if_fail(s_init_count > 0, NULL);
 
-  create = (device_object_create_t)object_get_prop_pointer(g_creators, type);
+  create = (device_object_create_t)registry_get(&s_creators, type);
   return_value_if_fail(create != NULL, NULL);
 
   return create(args);
@@ -62,21 +62,17 @@ object_t* device_factory_create_device(const char* type, const char* args) {
 ret_t device_factory_register(const char* type, device_object_create_t create) {
   return_value_if_fail(type != NULL, RET_BAD_PARAMS);
   return_value_if_fail(create != NULL, RET_BAD_PARAMS);
-  return_value_if_fail(g_creators != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(s_init_count > 0, RET_BAD_PARAMS);
 
-  return object_set_prop_pointer(g_creators, type, create);
+  return registry_set(&s_creators, type, create);
 }
 
 ret_t device_factory_deinit(void) {
-  return_value_if_fail(g_creators != NULL, RET_BAD_PARAMS);
-
-  if (g_creators->ref_count > 1) {
-    object_unref(g_creators);
-  } else if (g_creators->ref_count == 1) {
-    object_unref(g_creators);
-    g_creators = NULL;
-  } else {
-    g_creators = NULL;
+  return_value_if_fail(s_init_count > 0, RET_BAD_PARAMS);
+
+  s_init_count--;
+  if (s_init_count == 0) {
+    registry_deinit(&s_creators);
   }
 
   return RET_OK;
@@ -23,7 +23,9 @@
 #include "jerryscript-port.h"
 #include "jerryscript-ext/handler.h"
 
+#include "tkc/mem.h"
 #include "tkc/utils.h"
+#include "tkc/darray.h"
 #include "base/idle.h"
 #include "base/timer.h"
 #include "base/widget.h"
@@ -35,6 +37,7 @@
 #include "mvvm/jerryscript/jsobj.h"
 #include "mvvm/jerryscript/jerryscript_awtk.h"
 #include "mvvm/jerryscript/mvvm_jerryscript.h"
+#include "mvvm/jerryscript/view_model_jerryscript.h"
 
 static ret_t ret_t_init(void) {
   jerry_value_t obj = jerry_get_global_object();
@@ -66,10 +69,38 @@ static ret_t timer_info_on_destroy(void* data) {
 
   uint32_t func = (char*)(item->ctx) - (char*)NULL;
   jerry_release_value(func);
+  TKMEM_FREE(item->on_destroy_ctx);
 
   return RET_OK;
 }
 
+#ifdef WITH_JSOBJ_PROFILER
+/*timerAdd/idleAdd可选的最后一个参数为名称，用于统计函数执行时间*/
+static char* jerry_value_dup_name(const jerry_value_t args_p[], const jerry_length_t args_cnt,
+                                  uint32_t index) {
+  str_t str;
+  char* name = NULL;
+
+  if (index < args_cnt && jerry_value_is_string(args_p[index])) {
+    str_init(&str, 0);
+    name = tk_strdup(jerry_get_utf8_value(args_p[index], &str));
+    str_reset(&str);
+  }
+
+  return name;
+}
+
+static const char* timer_info_name(const timer_info_t* timer) {
+  return timer->on_destroy_ctx != NULL ? (const char*)(timer->on_destroy_ctx) : "anonymous";
+}
+
+static const char* idle_info_name(const idle_info_t* idle) {
+  return idle->on_destroy_ctx != NULL ? (const char*)(idle->on_destroy_ctx) : "anonymous";
+}
+#else
+#define jerry_value_dup_name(args_p, args_cnt, index) NULL
+#endif /*WITH_JSOBJ_PROFILER*/
+
 static ret_t call_on_timer(const timer_info_t* timer) {
   jerry_value_t res;
   jerry_value_t args[1];
@@ -77,7 +108,9 @@ static ret_t call_on_timer(const timer_info_t* timer) {
   jerry_value_t func = (jerry_value_t)((char*)timer->ctx - (char*)NULL);
 
   args[0] = jerry_create_undefined();
+  JSOBJ_PROFILE_BEGIN(start);
   res = jerry_call_function(func, this_value, args, 1);
+  JSOBJ_PROFILE_END(start, timer->ctx, "timer", timer_info_name(timer));
 
   jerry_release_value(args[0]);
   jerry_release_value(this_value);
@@ -95,8 +128,10 @@ jerry_value_t wrap_timer_add(const jerry_value_t func_obj_val, const jerry_value
     uint32_t duration_ms = (uint32_t)jerry_get_number_value(args_p[1]);
     void* ctx = (char*)NULL + (int32_t)on_timer;
 
+    char* name = jerry_value_dup_name(args_p, args_cnt, 2);
+
     ret = (uint32_t)timer_add(call_on_timer, ctx, duration_ms);
-    timer_set_on_destroy(ret, timer_info_on_destroy, NULL);
+    timer_set_on_destroy(ret, timer_info_on_destroy, name);
   } else {
     log_warn("%s invalid args\n", __FUNCTION__);
   }
@@ -109,6 +144,7 @@ static ret_t idle_info_on_destroy(void* data) {
 
   uint32_t func = (char*)(item->ctx) - (char*)NULL;
   jerry_release_value(func);
+  TKMEM_FREE(item->on_destroy_ctx);
 
   return RET_OK;
 }
@@ -120,7 +156,9 @@ static ret_t call_on_idle(const idle_info_t* idle) {
   jerry_value_t func = (jerry_value_t)((char*)idle->ctx - (char*)NULL);
 
   args[0] = jerry_create_undefined();
+  JSOBJ_PROFILE_BEGIN(start);
   res = jerry_call_function(func, this_value, args, 1);
+  JSOBJ_PROFILE_END(start, idle->ctx, "idle", idle_info_name(idle));
 
   jerry_release_value(args[0]);
   jerry_release_value(this_value);
@@ -137,8 +175,10 @@ jerry_value_t wrap_idle_add(const jerry_value_t func_obj_val, const jerry_value_
     jerry_value_t on_idle = jerry_acquire_value(args_p[0]);
     void* ctx = (char*)NULL + (int32_t)on_idle;
 
+    char* name = jerry_value_dup_name(args_p, args_cnt, 1);
+
     ret = (uint32_t)idle_add(call_on_idle, ctx);
-    idle_set_on_destroy(ret, idle_info_on_destroy, NULL);
+    idle_set_on_destroy(ret, idle_info_on_destroy, name);
   } else {
     log_warn("%s invalid args\n", __FUNCTION__);
   }
@@ -146,6 +186,135 @@ jerry_value_t wrap_idle_add(const jerry_value_t func_obj_val, const jerry_value_
   return jerry_create_number(ret);
 }
 
+/*requestAnimationFrame: 同一帧内的回调在一个定时器中依次执行，共享同一个时间戳*/
+#ifndef JERRYSCRIPT_ANIMATION_FRAME_DURATION
+#define JERRYSCRIPT_ANIMATION_FRAME_DURATION 16
+#endif /*JERRYSCRIPT_ANIMATION_FRAME_DURATION*/
+
+typedef struct _animation_frame_t {
+  uint32_t id;
+  jerry_value_t func;
+} animation_frame_t;
+
+static uint32_t s_animation_frame_id = 0;
+static darray_t s_animation_frames;
+static darray_t* s_animation_frames_dispatching = NULL;
+static uint32_t s_animation_frame_timer = TK_INVALID_ID;
+
+static ret_t animation_frame_destroy(animation_frame_t* frame) {
+  jerry_release_value(frame->func);
+  TKMEM_FREE(frame);
+
+  return RET_OK;
+}
+
+static int animation_frame_compare(const void* a, const void* b) {
+  const animation_frame_t* frame = (const animation_frame_t*)a;
+
+  return (int)(frame->id) - tk_pointer_to_int(b);
+}
+
+static ret_t animation_frames_init(darray_t* frames) {
+  darray_init(frames, 10, (tk_destroy_t)animation_frame_destroy,
+              (tk_compare_t)animation_frame_compare);
+
+  return RET_OK;
+}
+
+static ret_t call_on_animation_frame(const timer_info_t* timer) {
+  uint32_t i = 0;
+  darray_t frames = s_animation_frames;
+  jerry_value_t this_value = jerry_create_undefined();
+  jerry_value_t now = jerry_create_number((double)(timer->now));
+
+  /*执行期间新请求的回调，在下一帧执行*/
+  animation_frames_init(&s_animation_frames);
+  s_animation_frames_dispatching = &frames;
+
+  for (i = 0; i < frames.size; i++) {
+    animation_frame_t* frame = (animation_frame_t*)(frames.elms[i]);
+
+    if (frame->id != TK_INVALID_ID) {
+      /*已经开始执行的回调不能再取消*/
+      frame->id = TK_INVALID_ID;
+      JSOBJ_PROFILE_BEGIN(start);
+      jerry_value_t res = jerry_call_function(frame->func, this_value, &now, 1);
+      JSOBJ_PROFILE_END(start, NULL, "frame", "requestAnimationFrame");
+      jerry_value_check(res);
+      jerry_release_value(res);
+    }
+  }
+
+  s_animation_frames_dispatching = NULL;
+  darray_deinit(&frames);
+  jerry_release_value(now);
+  jerry_release_value(this_value);
+
+  if (s_animation_frames.size > 0) {
+    return RET_REPEAT;
+  } else {
+    s_animation_frame_timer = TK_INVALID_ID;
+    return RET_REMOVE;
+  }
+}
+
+jerry_value_t wrap_request_animation_frame(const jerry_value_t func_obj_val,
+                                           const jerry_value_t this_p,
+                                           const jerry_value_t args_p[],
+                                           const jerry_length_t args_cnt) {
+  animation_frame_t* frame = NULL;
+  return_value_if_fail(args_cnt >= 1 && jerry_value_is_function(args_p[0]),
+                       jerry_create_number(TK_INVALID_ID));
+
+  frame = TKMEM_ZALLOC(animation_frame_t);
+  return_value_if_fail(frame != NULL, jerry_create_number(TK_INVALID_ID));
+
+  if (++s_animation_frame_id == TK_INVALID_ID) {
+    s_animation_frame_id++;
+  }
+
+  frame->id = s_animation_frame_id;
+  frame->func = jerry_acquire_value(args_p[0]);
+  darray_push(&s_animation_frames, frame);
+
+  if (s_animation_frame_timer == TK_INVALID_ID) {
+    s_animation_frame_timer =
+        timer_add(call_on_animation_frame, NULL, JERRYSCRIPT_ANIMATION_FRAME_DURATION);
+  }
+
+  return jerry_create_number(frame->id);
+}
+
+jerry_value_t wrap_cancel_animation_frame(const jerry_value_t func_obj_val,
+                                          const jerry_value_t this_p,
+                                          const jerry_value_t args_p[],
+                                          const jerry_length_t args_cnt) {
+  uint32_t id = 0;
+  animation_frame_t* frame = NULL;
+  return_value_if_fail(args_cnt >= 1, jerry_create_number(RET_BAD_PARAMS));
+
+  id = (uint32_t)jerry_get_number_value(args_p[0]);
+  if (id == TK_INVALID_ID) {
+    return jerry_create_number(RET_NOT_FOUND);
+  }
+
+  if (darray_remove(&s_animation_frames, tk_pointer_from_int(id)) == RET_OK) {
+    return jerry_create_number(RET_OK);
+  }
+
+  /*当前帧还没有执行的回调*/
+  if (s_animation_frames_dispatching != NULL) {
+    frame = (animation_frame_t*)darray_find(s_animation_frames_dispatching,
+                                            tk_pointer_from_int(id));
+    if (frame != NULL) {
+      frame->id = TK_INVALID_ID;
+      return jerry_create_number(RET_OK);
+    }
+  }
+
+  return jerry_create_number(RET_NOT_FOUND);
+}
+
 jerry_value_t wrap_timer_remove(const jerry_value_t func_obj_val, const jerry_value_t this_p,
                                 const jerry_value_t args_p[], const jerry_length_t args_cnt) {
   ret_t ret = 0;
@@ -208,6 +377,9 @@ static view_model_t* view_model_jerryscript_create_with_widget(navigator_request
   view_model_t* view_model = NULL;
   const char* vmodel = NULL;
   char name[TK_NAME_LEN + 5];
+#ifdef WITH_JERRY_SNAPSHOT
+  char snapshot[TK_NAME_LEN + 15];
+#endif /*WITH_JERRY_SNAPSHOT*/
   const asset_info_t* asset = NULL;
   widget_t* widget = WIDGET(object_get_prop_pointer(OBJECT(req), NAVIGATOR_ARG_VIEW));
   return_value_if_fail(widget != NULL, NULL);
@@ -221,6 +393,20 @@ static view_model_t* view_model_jerryscript_create_with_widget(navigator_request
     *p = '\0';
   }
 
+#ifdef WITH_JERRY_SNAPSHOT
+  /*优先使用构建时生成的snapshot，不能使用时再加载源码*/
+  tk_snprintf(snapshot, sizeof(snapshot), "%s%s", name, VIEW_MODEL_JERRYSCRIPT_SNAPSHOT_EXT);
+  asset = widget_load_asset(widget, ASSET_TYPE_DATA, snapshot);
+  if (asset != NULL) {
+    view_model = view_model_jerryscript_create_from_snapshot(name, asset->data, asset->size, req);
+    widget_unload_asset(widget, asset);
+
+    if (view_model != NULL) {
+      return view_model;
+    }
+  }
+#endif /*WITH_JERRY_SNAPSHOT*/
+
   asset = widget_load_asset(widget, ASSET_TYPE_SCRIPT, name);
   return_value_if_fail(asset != NULL, NULL);
 
@@ -232,6 +418,7 @@ static view_model_t* view_model_jerryscript_create_with_widget(navigator_request
 
 ret_t jerryscript_awtk_init(void) {
   ret_t_init();
+  animation_frames_init(&s_animation_frames);
   jerryx_handler_register_global((const jerry_char_t*)"exit", wrap_quit);
   jerryx_handler_register_global((const jerry_char_t*)"quit", wrap_quit);
 
@@ -239,6 +426,10 @@ ret_t jerryscript_awtk_init(void) {
   jerryx_handler_register_global((const jerry_char_t*)"timerRemove", wrap_timer_remove);
   jerryx_handler_register_global((const jerry_char_t*)"idleAdd", wrap_idle_add);
   jerryx_handler_register_global((const jerry_char_t*)"idleRemove", wrap_idle_remove);
+  jerryx_handler_register_global((const jerry_char_t*)"requestAnimationFrame",
+                                 wrap_request_animation_frame);
+  jerryx_handler_register_global((const jerry_char_t*)"cancelAnimationFrame",
+                                 wrap_cancel_animation_frame);
   jerryx_handler_register_global((const jerry_char_t*)"navigateTo", wrap_navigate_to);
   view_model_factory_register(".js", view_model_jerryscript_create_with_widget);
 
@@ -246,5 +437,11 @@ ret_t jerryscript_awtk_init(void) {
 }
 
 ret_t jerryscript_awtk_deinit(void) {
+  if (s_animation_frame_timer != TK_INVALID_ID) {
+    timer_remove(s_animation_frame_timer);
+    s_animation_frame_timer = TK_INVALID_ID;
+  }
+  darray_deinit(&s_animation_frames);
+
   return RET_OK;
 }
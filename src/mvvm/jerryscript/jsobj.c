@@ -20,14 +20,239 @@
  */
 
 #include "jsobj.h"
+#include "tkc/mem.h"
 #include "tkc/utils.h"
 #include "tkc/named_value.h"
 #include "jerryscript-port.h"
-#include "tkc/object_default.h"
+#include "mvvm/jerryscript/object_jerryscript.h"
 #include "jerryscript-ext/handler.h"
 
 static ret_t jerry_value_to_obj(jerry_value_t value, object_t* obj);
-static ret_t jerry_value_from_obj(jerry_value_t value, object_t* obj);
+
+#ifndef JSOBJ_PROP_NAME_CACHE_SIZE
+#define JSOBJ_PROP_NAME_CACHE_SIZE 128
+#endif /*JSOBJ_PROP_NAME_CACHE_SIZE*/
+
+typedef struct _jsobj_prop_name_t {
+  char name[TK_NAME_LEN + 1];
+  jerry_value_t value;
+
+  /*包装object_t时共享的访问器，第一次用到时创建*/
+  bool_t has_accessors;
+  jerry_value_t getter;
+  jerry_value_t setter;
+} jsobj_prop_name_t;
+
+/*按名称直接映射的属性名缓存，避免每次访问属性都创建JS字符串*/
+static jsobj_prop_name_t s_prop_names[JSOBJ_PROP_NAME_CACHE_SIZE];
+
+static uint32_t jsobj_prop_name_hash(const char* name) {
+  uint32_t hash = 5381;
+
+  while (*name) {
+    hash = ((hash << 5) + hash) + (uint8_t)(*name++);
+  }
+
+  return hash;
+}
+
+static ret_t jsobj_prop_name_release(jsobj_prop_name_t* iter) {
+  if (iter->name[0] != '\0') {
+    jerry_release_value(iter->value);
+    if (iter->has_accessors) {
+      jerry_release_value(iter->getter);
+      jerry_release_value(iter->setter);
+      iter->has_accessors = FALSE;
+    }
+    iter->name[0] = '\0';
+  }
+
+  return RET_OK;
+}
+
+static jsobj_prop_name_t* jsobj_prop_name_lookup(const char* name) {
+  jsobj_prop_name_t* iter = NULL;
+
+  /*空的名字无法和空闲的位置区分，缓存后创建的JS字符串不会被释放，不缓存*/
+  if (name[0] == '\0' || strlen(name) > TK_NAME_LEN) {
+    return NULL;
+  }
+
+  iter = s_prop_names + (jsobj_prop_name_hash(name) % JSOBJ_PROP_NAME_CACHE_SIZE);
+  if (iter->name[0] == '\0' || !tk_str_eq(iter->name, name)) {
+    jsobj_prop_name_release(iter);
+
+    tk_strncpy(iter->name, name, TK_NAME_LEN);
+    iter->value = jerry_create_string((const jerry_char_t*)name);
+  }
+
+  return iter;
+}
+
+static jerry_value_t jsobj_prop_name(const char* name) {
+  jsobj_prop_name_t* iter = jsobj_prop_name_lookup(name);
+
+  if (iter == NULL) {
+    return jerry_create_string((const jerry_char_t*)name);
+  }
+
+  return jerry_acquire_value(iter->value);
+}
+
+/*每次加载JS代码后增加，用于判断缓存的JS函数是否需要重新解析*/
+static uint32_t s_code_version = 1;
+
+uint32_t jsobj_get_code_version(void) {
+  return s_code_version;
+}
+
+ret_t jsobj_inc_code_version(void) {
+  s_code_version++;
+  if (s_code_version == 0) {
+    s_code_version = 1;
+  }
+
+  return RET_OK;
+}
+
+/*JS函数执行时间统计，按owner+scope+func查找，记录数量通常不多，线性查找即可*/
+static darray_t s_profiles;
+
+typedef struct _jsobj_profile_key_t {
+  const void* owner;
+  const char* scope;
+  const char* func;
+} jsobj_profile_key_t;
+
+static int jsobj_profile_compare(const void* a, const void* b) {
+  const jsobj_profile_t* profile = (const jsobj_profile_t*)a;
+  const jsobj_profile_key_t* key = (const jsobj_profile_key_t*)b;
+
+  /*同名的两个模型实例分别统计*/
+  if (profile->owner != key->owner) {
+    return -1;
+  }
+
+  if (strncmp(profile->scope, key->scope, TK_NAME_LEN) != 0) {
+    return -1;
+  }
+
+  return strncmp(profile->func, key->func, TK_NAME_LEN);
+}
+
+#ifdef WITH_JSOBJ_PROFILER
+static object_t* jsobj_profiler_owner(jerry_value_t obj) {
+  return OBJECT(jsobj_get_prop_pointer(obj, JSOBJ_NATIVE_MODEL));
+}
+
+static const char* jsobj_profiler_scope(jerry_value_t obj) {
+  object_t* model = jsobj_profiler_owner(obj);
+
+  return (model != NULL && model->name != NULL) ? model->name : "global";
+}
+#endif /*WITH_JSOBJ_PROFILER*/
+
+ret_t jsobj_profiler_record(const void* owner, const char* scope, const char* func, uint64_t cost) {
+  jsobj_profile_t* profile = NULL;
+  jsobj_profile_key_t key = {owner, scope, func};
+  return_value_if_fail(scope != NULL && func != NULL, RET_BAD_PARAMS);
+
+  profile = (jsobj_profile_t*)darray_find(&s_profiles, &key);
+  if (profile == NULL) {
+    profile = TKMEM_ZALLOC(jsobj_profile_t);
+    return_value_if_fail(profile != NULL, RET_OOM);
+
+    profile->owner = owner;
+    tk_strncpy(profile->scope, scope, TK_NAME_LEN);
+    tk_strncpy(profile->func, func, TK_NAME_LEN);
+    if (darray_push(&s_profiles, profile) != RET_OK) {
+      TKMEM_FREE(profile);
+      return RET_OOM;
+    }
+  }
+
+  profile->count++;
+  profile->total_time += cost;
+  if (cost > profile->max_time) {
+    profile->max_time = cost;
+  }
+
+  return RET_OK;
+}
+
+ret_t jsobj_profiler_foreach(tk_visit_t visit, void* ctx) {
+  uint32_t i = 0;
+  uint32_t k = 0;
+  void** elms = s_profiles.elms;
+  return_value_if_fail(visit != NULL, RET_BAD_PARAMS);
+
+  /*按累计时间从大到小排序*/
+  for (i = 1; i < s_profiles.size; i++) {
+    void* iter = elms[i];
+    uint64_t total_time = ((jsobj_profile_t*)iter)->total_time;
+
+    for (k = i; k > 0 && ((jsobj_profile_t*)(elms[k - 1]))->total_time < total_time; k--) {
+      elms[k] = elms[k - 1];
+    }
+    elms[k] = iter;
+  }
+
+  for (i = 0; i < s_profiles.size; i++) {
+    if (visit(ctx, elms[i]) != RET_OK) {
+      break;
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t jsobj_profile_dump(void* ctx, const void* data) {
+  const jsobj_profile_t* profile = (const jsobj_profile_t*)data;
+  uint32_t avg = (uint32_t)(profile->total_time / profile->count);
+
+  log_info("%-32s %-24s %8u %12u %8u %8u\n", profile->scope, profile->func, profile->count,
+           (uint32_t)(profile->total_time), avg, (uint32_t)(profile->max_time));
+
+  return RET_OK;
+}
+
+ret_t jsobj_profiler_dump(void) {
+  if (s_profiles.size > 0) {
+    log_info("%-32s %-24s %8s %12s %8s %8s\n", "scope", "func", "count", "total(us)", "avg(us)",
+             "max(us)");
+    jsobj_profiler_foreach(jsobj_profile_dump, NULL);
+  }
+
+  return RET_OK;
+}
+
+ret_t jsobj_profiler_reset(void) {
+  return darray_clear(&s_profiles);
+}
+
+ret_t jsobj_init(void) {
+  memset(s_prop_names, 0x00, sizeof(s_prop_names));
+  darray_init(&s_profiles, 10, default_destroy, (tk_compare_t)jsobj_profile_compare);
+  object_jerryscript_init();
+
+  return RET_OK;
+}
+
+ret_t jsobj_deinit(void) {
+  uint32_t i = 0;
+
+#ifdef WITH_JSOBJ_PROFILER
+  jsobj_profiler_dump();
+#endif /*WITH_JSOBJ_PROFILER*/
+  darray_deinit(&s_profiles);
+  object_jerryscript_deinit();
+
+  for (i = 0; i < JSOBJ_PROP_NAME_CACHE_SIZE; i++) {
+    jsobj_prop_name_release(s_prop_names + i);
+  }
+
+  return RET_OK;
+}
 
 #if !defined(NDEBUG)
 #define JERRY_BUFFER_SIZE (40 * 1024)
@@ -196,7 +421,7 @@ ret_t jerry_value_check(jerry_value_t value) {
 }
 
 bool_t jsobj_has_prop(jerry_value_t obj, const char* name) {
-  jerry_value_t prop_name = jerry_create_string((const jerry_char_t*)name);
+  jerry_value_t prop_name = jsobj_prop_name(name);
   jerry_value_t has_prop_js = jerry_has_property(obj, prop_name);
   bool_t has_prop = (bool_t)jerry_get_boolean_value(has_prop_js);
   jerry_release_value(has_prop_js);
@@ -207,7 +432,7 @@ bool_t jsobj_has_prop(jerry_value_t obj, const char* name) {
 
 jerry_value_t jsobj_get_global(const char* name) {
   jerry_value_t global_obj = jerry_get_global_object();
-  jerry_value_t prop_name = jerry_create_string((const jerry_char_t*)name);
+  jerry_value_t prop_name = jsobj_prop_name(name);
   jerry_value_t prop_value = jerry_get_property(global_obj, prop_name);
   jerry_release_value(prop_name);
 
@@ -228,7 +453,7 @@ jerry_value_t jsobj_get_model(const char* name) {
 }
 
 jerry_value_t jsobj_get_prop_value(jerry_value_t obj, const char* name) {
-  jerry_value_t prop_name = jerry_create_string((const jerry_char_t*)name);
+  jerry_value_t prop_name = jsobj_prop_name(name);
   jerry_value_t prop_value = jerry_get_property(obj, prop_name);
   jerry_release_value(prop_name);
   jerry_value_check(prop_value);
@@ -237,10 +462,10 @@ jerry_value_t jsobj_get_prop_value(jerry_value_t obj, const char* name) {
 }
 
 ret_t jsobj_set_prop_value(jerry_value_t obj, const char* name, jerry_value_t prop_value) {
-  jerry_value_t prop_name = jerry_create_string((const jerry_char_t*)name);
-
-  jerry_set_property(obj, prop_name, prop_value);
+  jerry_value_t prop_name = jsobj_prop_name(name);
+  jerry_value_t jsret = jerry_set_property(obj, prop_name, prop_value);
 
+  jerry_release_value(jsret);
   jerry_release_value(prop_name);
 
   return RET_OK;
@@ -268,7 +493,12 @@ char* jerry_get_utf8_value(jerry_value_t value, str_t* temp) {
 ret_t jsobj_get_prop(jerry_value_t obj, const char* name, value_t* v, str_t* temp) {
   ret_t ret = RET_FAIL;
   jerry_value_t prop_value = jsobj_get_prop_value(obj, name);
-  ret = jerry_value_to_value(prop_value, v, temp);
+
+  if (jerry_value_is_undefined(prop_value)) {
+    ret = RET_NOT_FOUND;
+  } else {
+    ret = jerry_value_to_value(prop_value, v, temp);
+  }
   jerry_release_value(prop_value);
 
   return ret;
@@ -294,22 +524,62 @@ ret_t jsobj_exec(jerry_value_t obj, const char* name, const char* args) {
   return ret;
 }
 
+static const char* jsobj_can_exec_name(const char* name, char jsname[TK_NAME_LEN + 1]) {
+  tk_snprintf(jsname, TK_NAME_LEN, "can%s", name);
+  if (islower(jsname[3])) {
+    jsname[3] = toupper(jsname[3]);
+  }
+
+  return jsname;
+}
+
+static ret_t jsobj_call_exec(jerry_value_t obj, jerry_value_t func, const char* name,
+                             jerry_value_t jsargs) {
+  ret_t ret = RET_NOT_IMPL;
+
+  if (jerry_value_is_function(func)) {
+    JSOBJ_PROFILE_BEGIN(start);
+    jerry_value_t jsret = jerry_call_function(func, obj, &jsargs, 1);
+    JSOBJ_PROFILE_END(start, jsobj_profiler_owner(obj), jsobj_profiler_scope(obj), name);
+    ret = (ret_t)jerry_get_number_value(jsret);
+    jerry_release_value(jsret);
+  } else if (!jerry_value_is_undefined(func)) {
+    log_debug("not function %s\n", name);
+  }
+
+  return ret;
+}
+
+static bool_t jsobj_call_can_exec(jerry_value_t obj, jerry_value_t func, const char* name,
+                                  const char* args) {
+  bool_t ret = FALSE;
+#ifdef WITH_JSOBJ_PROFILER
+  char jsname[TK_NAME_LEN + 1];
+#endif /*WITH_JSOBJ_PROFILER*/
+
+  if (jerry_value_is_function(func)) {
+    jerry_value_t jsargs = jerry_create_str(args);
+    JSOBJ_PROFILE_BEGIN(start);
+    jerry_value_t jsret = jerry_call_function(func, obj, &jsargs, 1);
+    JSOBJ_PROFILE_END(start, jsobj_profiler_owner(obj), jsobj_profiler_scope(obj),
+                      jsobj_can_exec_name(name, jsname));
+    ret = jerry_get_boolean_value(jsret);
+    jerry_release_value(jsret);
+    jerry_release_value(jsargs);
+  } else {
+    log_debug("not function %s\n", name);
+  }
+
+  return ret;
+}
+
 ret_t jsobj_exec_ex(jerry_value_t obj, const char* name, jerry_value_t jsargs) {
-  ret_t ret = RET_FAIL;
+  ret_t ret = RET_NOT_IMPL;
 
   if (jsobj_has_prop(obj, name)) {
     jerry_value_t func = jsobj_get_prop_value(obj, name);
-    if (jerry_value_is_function(func)) {
-      jerry_value_t jsret = jerry_call_function(func, obj, &jsargs, 1);
-      ret = (ret_t)jerry_get_number_value(jsret);
-      jerry_release_value(func);
-      jerry_release_value(jsret);
-    } else {
-      ret = RET_NOT_IMPL;
-      log_debug("not function %s\n", name);
-    }
-  } else {
-    ret = RET_NOT_IMPL;
+    ret = jsobj_call_exec(obj, func, name, jsargs);
+    jerry_release_value(func);
   }
 
   return ret;
@@ -318,25 +588,12 @@ ret_t jsobj_exec_ex(jerry_value_t obj, const char* name, jerry_value_t jsargs) {
 bool_t jsobj_can_exec(jerry_value_t obj, const char* name, const char* args) {
   bool_t ret = FALSE;
   char jsname[TK_NAME_LEN + 1];
-  tk_snprintf(jsname, TK_NAME_LEN, "can%s", name);
-  if (islower(jsname[3])) {
-    jsname[3] = toupper(jsname[3]);
-  }
 
+  jsobj_can_exec_name(name, jsname);
   if (jsobj_has_prop(obj, jsname)) {
     jerry_value_t func = jsobj_get_prop_value(obj, jsname);
-
-    if (jerry_value_is_function(func)) {
-      jerry_value_t jsargs = jerry_create_str(args);
-      jerry_value_t jsret = jerry_call_function(func, obj, &jsargs, 1);
-      ret = jerry_get_boolean_value(jsret);
-      jerry_release_value(func);
-      jerry_release_value(jsret);
-      jerry_release_value(jsargs);
-    } else {
-      ret = FALSE;
-      log_debug("not function %s\n", name);
-    }
+    ret = jsobj_call_can_exec(obj, func, name, args);
+    jerry_release_value(func);
   } else {
     ret = jsobj_has_prop_func(obj, name);
     if (!ret) {
@@ -347,6 +604,122 @@ bool_t jsobj_can_exec(jerry_value_t obj, const char* name, const char* args) {
   return ret;
 }
 
+/*******************************************/
+
+typedef struct _jsobj_method_t {
+  /*命令对应的函数，不存在时为undefined*/
+  jerry_value_t func;
+  /*canXxx对应的函数，不存在时为undefined*/
+  jerry_value_t can_exec;
+} jsobj_method_t;
+
+static ret_t jsobj_method_destroy(jsobj_method_t* method) {
+  jerry_release_value(method->func);
+  jerry_release_value(method->can_exec);
+  TKMEM_FREE(method);
+
+  return RET_OK;
+}
+
+static jerry_value_t jsobj_get_prop_value_if_exist(jerry_value_t obj, const char* name) {
+  if (jsobj_has_prop(obj, name)) {
+    return jsobj_get_prop_value(obj, name);
+  } else {
+    return jerry_create_undefined();
+  }
+}
+
+static jsobj_method_t* jsobj_method_cache_find(jsobj_method_cache_t* cache, jerry_value_t obj,
+                                               const char* name) {
+  char jsname[TK_NAME_LEN + 1];
+  jsobj_method_t* method = NULL;
+
+  method = (jsobj_method_t*)registry_get(&(cache->methods), name);
+  if (method != NULL) {
+    return method;
+  }
+
+  method = TKMEM_ZALLOC(jsobj_method_t);
+  return_value_if_fail(method != NULL, NULL);
+
+  method->func = jsobj_get_prop_value_if_exist(obj, name);
+  method->can_exec = jsobj_get_prop_value_if_exist(obj, jsobj_can_exec_name(name, jsname));
+
+  if (registry_set(&(cache->methods), name, method) != RET_OK) {
+    jsobj_method_destroy(method);
+    method = NULL;
+  }
+
+  return method;
+}
+
+ret_t jsobj_method_cache_init(jsobj_method_cache_t* cache) {
+  return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
+
+  registry_init(&(cache->methods), (tk_destroy_t)jsobj_method_destroy);
+
+  return RET_OK;
+}
+
+ret_t jsobj_method_cache_clear(jsobj_method_cache_t* cache) {
+  return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
+
+  /*registry_deinit之后注册表仍然可以继续使用*/
+  return registry_deinit(&(cache->methods));
+}
+
+ret_t jsobj_method_cache_deinit(jsobj_method_cache_t* cache) {
+  return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
+
+  return registry_deinit(&(cache->methods));
+}
+
+ret_t jsobj_method_cache_exec_ex(jsobj_method_cache_t* cache, jerry_value_t obj, const char* name,
+                                 jerry_value_t jsargs) {
+  jsobj_method_t* method = NULL;
+  return_value_if_fail(cache != NULL && name != NULL, RET_BAD_PARAMS);
+
+  if (strlen(name) > TK_NAME_LEN) {
+    return jsobj_exec_ex(obj, name, jsargs);
+  }
+
+  method = jsobj_method_cache_find(cache, obj, name);
+  return_value_if_fail(method != NULL, RET_OOM);
+
+  return jsobj_call_exec(obj, method->func, name, jsargs);
+}
+
+ret_t jsobj_method_cache_exec(jsobj_method_cache_t* cache, jerry_value_t obj, const char* name,
+                              const char* args) {
+  jerry_value_t jsargs = jerry_create_str(args);
+  ret_t ret = jsobj_method_cache_exec_ex(cache, obj, name, jsargs);
+  jerry_release_value(jsargs);
+
+  return ret;
+}
+
+bool_t jsobj_method_cache_can_exec(jsobj_method_cache_t* cache, jerry_value_t obj,
+                                   const char* name, const char* args) {
+  jsobj_method_t* method = NULL;
+  return_value_if_fail(cache != NULL && name != NULL, FALSE);
+
+  if (strlen(name) > TK_NAME_LEN) {
+    return jsobj_can_exec(obj, name, args);
+  }
+
+  method = jsobj_method_cache_find(cache, obj, name);
+  return_value_if_fail(method != NULL, FALSE);
+
+  if (!jerry_value_is_undefined(method->can_exec)) {
+    return jsobj_call_can_exec(obj, method->can_exec, name, args);
+  } else if (jerry_value_is_function(method->func)) {
+    return TRUE;
+  } else {
+    log_debug("not find function %s\n", name);
+    return FALSE;
+  }
+}
+
 bool_t jsobj_has_prop_func(jerry_value_t obj, const char* name) {
   jerry_value_t value = jsobj_get_prop_value(obj, name);
 
@@ -357,6 +730,166 @@ bool_t jsobj_has_prop_func(jerry_value_t obj, const char* name) {
   return ret;
 }
 
+/*******************************************/
+
+/*把object_t包装成JS对象：属性定义为访问器，读写直接转发给object_t*/
+static void jsobj_host_object_free(void* native_p) {
+  object_unref(OBJECT(native_p));
+}
+
+static void jsobj_host_prop_name_free(void* native_p) {
+  TKMEM_FREE(native_p);
+}
+
+static const jerry_object_native_info_t s_host_object_info = {jsobj_host_object_free};
+static const jerry_object_native_info_t s_host_prop_name_info = {jsobj_host_prop_name_free};
+
+static object_t* jsobj_get_host_object(jerry_value_t value) {
+  void* p = NULL;
+
+  if (jerry_get_object_native_pointer(value, &p, &s_host_object_info)) {
+    return OBJECT(p);
+  }
+
+  return NULL;
+}
+
+static const char* jsobj_get_host_prop_name(jerry_value_t func) {
+  void* p = NULL;
+
+  if (jerry_get_object_native_pointer(func, &p, &s_host_prop_name_info)) {
+    return (const char*)p;
+  }
+
+  return NULL;
+}
+
+static jerry_value_t jsobj_host_prop_get(const jerry_value_t func_obj_val,
+                                         const jerry_value_t this_p, const jerry_value_t args_p[],
+                                         const jerry_length_t args_cnt) {
+  value_t v;
+  str_t str;
+  jerry_value_t ret = 0;
+  object_t* obj = jsobj_get_host_object(this_p);
+  const char* name = jsobj_get_host_prop_name(func_obj_val);
+
+  if (obj == NULL || name == NULL || object_get_prop(obj, name, &v) != RET_OK) {
+    return jerry_create_undefined();
+  }
+
+  str_init(&str, 0);
+  ret = jerry_value_from_value(&v, &str);
+  str_reset(&str);
+
+  return ret;
+}
+
+static jerry_value_t jsobj_host_prop_set(const jerry_value_t func_obj_val,
+                                         const jerry_value_t this_p, const jerry_value_t args_p[],
+                                         const jerry_length_t args_cnt) {
+  value_t v;
+  str_t str;
+  object_t* obj = jsobj_get_host_object(this_p);
+  const char* name = jsobj_get_host_prop_name(func_obj_val);
+
+  if (obj != NULL && name != NULL && args_cnt > 0) {
+    str_init(&str, 0);
+    value_set_int(&v, 0);
+    if (jerry_value_to_value(args_p[0], &v, &str) == RET_OK) {
+      object_set_prop(obj, name, &v);
+    }
+    value_reset(&v);
+    str_reset(&str);
+  }
+
+  return jerry_create_undefined();
+}
+
+static jerry_value_t jsobj_create_host_accessor(const char* name, jerry_external_handler_t handler) {
+  jerry_value_t func = jerry_create_external_function(handler);
+  jerry_set_object_native_pointer(func, tk_strdup(name), &s_host_prop_name_info);
+
+  return func;
+}
+
+/*
+ * 同名属性的访问器是共享的(属性名放在访问器的native pointer中)，缓存在属性名缓存里，
+ * 只在第一次用到某个属性名时创建。属性名被缓存淘汰后，已经定义的属性仍然持有原来的访问器。
+ */
+static ret_t jsobj_get_host_accessors(const char* name, jerry_value_t* getter,
+                                      jerry_value_t* setter) {
+  jsobj_prop_name_t* iter = jsobj_prop_name_lookup(name);
+
+  if (iter == NULL) {
+    *getter = jsobj_create_host_accessor(name, jsobj_host_prop_get);
+    *setter = jsobj_create_host_accessor(name, jsobj_host_prop_set);
+    return RET_OK;
+  }
+
+  if (!iter->has_accessors) {
+    iter->getter = jsobj_create_host_accessor(name, jsobj_host_prop_get);
+    iter->setter = jsobj_create_host_accessor(name, jsobj_host_prop_set);
+    iter->has_accessors = TRUE;
+  }
+
+  *getter = jerry_acquire_value(iter->getter);
+  *setter = jerry_acquire_value(iter->setter);
+
+  return RET_OK;
+}
+
+static ret_t visit_host_object_prop(void* ctx, const void* data) {
+  jerry_value_t jsret = 0;
+  jerry_value_t prop_name = 0;
+  jerry_property_descriptor_t desc;
+  named_value_t* nv = (named_value_t*)data;
+  jerry_value_t value = *(jerry_value_t*)ctx;
+
+  jerry_init_property_descriptor_fields(&desc);
+  desc.is_get_defined = true;
+  desc.is_set_defined = true;
+  jsobj_get_host_accessors(nv->name, &desc.getter, &desc.setter);
+  desc.is_enumerable_defined = true;
+  desc.is_enumerable = true;
+  desc.is_configurable_defined = true;
+  desc.is_configurable = true;
+
+  prop_name = jsobj_prop_name(nv->name);
+  jsret = jerry_define_own_property(value, prop_name, &desc);
+  jerry_value_check(jsret);
+
+  jerry_release_value(jsret);
+  jerry_release_value(prop_name);
+  jerry_free_property_descriptor_fields(&desc);
+
+  return RET_OK;
+}
+
+jerry_value_t jerry_value_from_object(object_t* obj) {
+  jerry_value_t value = 0;
+  return_value_if_fail(obj != NULL, jerry_create_undefined());
+
+  if (object_is_jerryscript(obj)) {
+    return jerry_acquire_value(object_jerryscript_get_jsobj(obj));
+  }
+
+  value = jerry_create_object();
+  jerry_set_object_native_pointer(value, object_ref(obj), &s_host_object_info);
+  object_foreach_prop(obj, visit_host_object_prop, &value);
+
+  return value;
+}
+
+object_t* jerry_value_to_object(jerry_value_t value) {
+  object_t* obj = jsobj_get_host_object(value);
+
+  if (obj != NULL) {
+    return object_ref(obj);
+  }
+
+  return object_jerryscript_create(value);
+}
+
 ret_t jerry_value_to_value(jerry_value_t value, value_t* v, str_t* temp) {
   ret_t ret = RET_NOT_IMPL;
 
@@ -384,12 +917,19 @@ ret_t jerry_value_to_value(jerry_value_t value, value_t* v, str_t* temp) {
       ret = RET_OK;
     } else if (jerry_value_is_object(value)) {
       void* p = NULL;
-      if (jerry_get_object_native_pointer(value, &p, NULL)) {
+      object_t* host = jsobj_get_host_object(value);
+
+      if (host != NULL) {
+        value_set_object(v, object_ref(host));
+        v->free_handle = TRUE;
+        ret = RET_OK;
+      } else if (jerry_get_object_native_pointer(value, &p, NULL)) {
         value_set_pointer(v, p);
         ret = RET_OK;
       } else {
-        object_t* obj = object_default_create();
-        jerry_value_to_obj(value, obj);
+        object_t* obj = jerry_value_to_object(value);
+        return_value_if_fail(obj != NULL, RET_OOM);
+
         value_set_object(v, obj);
         v->free_handle = TRUE;
         ret = RET_OK;
@@ -418,9 +958,7 @@ jerry_value_t jerry_value_from_value(const value_t* v, str_t* temp) {
     value = jerry_create_object();
     jerry_set_object_native_pointer(value, (void*)value_pointer(v), NULL);
   } else if (v->type == VALUE_TYPE_OBJECT) {
-    object_t* obj = OBJECT(value_object(v));
-    value = jerry_create_object();
-    jerry_value_from_obj(value, obj);
+    value = jerry_value_from_object(OBJECT(value_object(v)));
   } else {
     value = jerry_create_number(value_float(v));
   }
@@ -488,7 +1026,15 @@ ret_t jsobj_set_prop_int(jerry_value_t obj, const char* name, int32_t value) {
   return jsobj_set_prop(obj, name, &v, NULL);
 }
 
-static jerry_value_t jsobj_get_converter(const char* name) {
+ret_t jsobj_remove_prop(jerry_value_t obj, const char* name) {
+  jerry_value_t prop_name = jsobj_prop_name(name);
+  bool ret = jerry_delete_property(obj, prop_name);
+  jerry_release_value(prop_name);
+
+  return ret ? RET_OK : RET_NOT_FOUND;
+}
+
+jerry_value_t jsvalue_converter_get(const char* name) {
   jerry_value_t factory = jsobj_get_global(JSOBJ_VALUE_CONVERTERS);
   jerry_value_t converter = jsobj_get_prop_value(factory, name);
   jerry_release_value(factory);
@@ -504,19 +1050,27 @@ bool_t jsvalue_converter_exist(const char* name) {
   return exist;
 }
 
-static ret_t value_convert(const char* converter_name, const char* func_name, const value_t* from,
-                           value_t* to, str_t* temp) {
+ret_t jsvalue_converter_call(jerry_value_t converter, jerry_value_t func, const value_t* from,
+                             value_t* to, str_t* temp) {
   ret_t ret = RET_OK;
-  jerry_value_t converter = jsobj_get_converter(converter_name);
-  jerry_value_t func = jsobj_get_prop_value(converter, func_name);
 
   if (jerry_value_is_function(func)) {
     jerry_value_t jsfrom = jerry_value_from_value(from, temp);
     jerry_value_t jsret = jerry_call_function(func, converter, &jsfrom, 1);
     ret = jerry_value_to_value(jsret, to, temp);
     jerry_release_value(jsret);
+    jerry_release_value(jsfrom);
   }
 
+  return ret;
+}
+
+static ret_t value_convert(const char* converter_name, const char* func_name, const value_t* from,
+                           value_t* to, str_t* temp) {
+  jerry_value_t converter = jsvalue_converter_get(converter_name);
+  jerry_value_t func = jsobj_get_prop_value(converter, func_name);
+  ret_t ret = jsvalue_converter_call(converter, func, from, to, temp);
+
   jerry_release_value(func);
   jerry_release_value(converter);
 
@@ -531,7 +1085,7 @@ ret_t jsvalue_converter_to_model(const char* name, const value_t* from, value_t*
   return value_convert(name, JSOBJ_VALUE_CONVERTER_TO_VIEW_MODEL, from, to, temp);
 }
 
-static jerry_value_t jsobj_get_validator(const char* name) {
+jerry_value_t jsvalue_validator_get(const char* name) {
   jerry_value_t factory = jsobj_get_global(JSOBJ_VALUE_VALIDATORS);
   jerry_value_t validator = jsobj_get_prop_value(factory, name);
   jerry_release_value(factory);
@@ -547,10 +1101,9 @@ bool_t jsvalue_validator_exist(const char* name) {
   return exist;
 }
 
-ret_t jsvalue_validator_is_valid(const char* name, const value_t* value, str_t* msg) {
+ret_t jsvalue_validator_call_is_valid(jerry_value_t validator, jerry_value_t func,
+                                      const value_t* value, str_t* msg) {
   ret_t ret = RET_OK;
-  jerry_value_t validator = jsobj_get_validator(name);
-  jerry_value_t func = jsobj_get_prop_value(validator, JSOBJ_VALUE_VALIDATOR_IS_VALID);
 
   if (jerry_value_is_function(func)) {
     jerry_value_t jsvalue = jerry_value_from_value(value, msg);
@@ -572,63 +1125,44 @@ ret_t jsvalue_validator_is_valid(const char* name, const value_t* value, str_t*
       }
     }
     jerry_release_value(jsret);
+    jerry_release_value(jsvalue);
   }
 
-  jerry_release_value(func);
-  jerry_release_value(validator);
-
   return ret;
 }
 
-ret_t jsvalue_validator_fix(const char* name, value_t* v) {
+ret_t jsvalue_validator_call_fix(jerry_value_t validator, jerry_value_t func, value_t* v) {
   ret_t ret = RET_OK;
-  jerry_value_t validator = jsobj_get_validator(name);
-  jerry_value_t func = jsobj_get_prop_value(validator, JSOBJ_VALUE_VALIDATOR_FIX);
 
   if (jerry_value_is_function(func)) {
     jerry_value_t jsvalue = jerry_value_from_value(v, NULL);
     jerry_value_t jsret = jerry_call_function(func, validator, &jsvalue, 1);
     ret = jerry_value_to_value(jsret, v, NULL);
     jerry_release_value(jsret);
-  } else {
-    ret = RET_OK;
+    jerry_release_value(jsvalue);
   }
 
-  jerry_release_value(func);
-  jerry_release_value(validator);
-
   return ret;
 }
 
-/*******************************************/
-
-typedef struct _jerry_value_from_obj_ctx_t {
-  str_t* str;
-  jerry_value_t value;
-} jerry_value_from_obj_ctx_t;
-
-static ret_t visit_object_prop(void* ctx, const void* data) {
-  named_value_t* nv = (named_value_t*)data;
-  jerry_value_from_obj_ctx_t* info = (jerry_value_from_obj_ctx_t*)ctx;
+ret_t jsvalue_validator_is_valid(const char* name, const value_t* value, str_t* msg) {
+  jerry_value_t validator = jsvalue_validator_get(name);
+  jerry_value_t func = jsobj_get_prop_value(validator, JSOBJ_VALUE_VALIDATOR_IS_VALID);
+  ret_t ret = jsvalue_validator_call_is_valid(validator, func, value, msg);
 
-  jsobj_set_prop(info->value, nv->name, &(nv->value), info->str);
+  jerry_release_value(func);
+  jerry_release_value(validator);
 
-  return RET_OK;
+  return ret;
 }
 
-static ret_t jerry_value_from_obj(jerry_value_t value, object_t* obj) {
-  str_t str;
-  ret_t ret = RET_OK;
-  jerry_value_from_obj_ctx_t info;
-
-  str_init(&str, 0);
-
-  info.str = &str;
-  info.value = value;
-
-  ret = object_foreach_prop(obj, visit_object_prop, &info);
+ret_t jsvalue_validator_fix(const char* name, value_t* v) {
+  jerry_value_t validator = jsvalue_validator_get(name);
+  jerry_value_t func = jsobj_get_prop_value(validator, JSOBJ_VALUE_VALIDATOR_FIX);
+  ret_t ret = jsvalue_validator_call_fix(validator, func, v);
 
-  str_reset(&str);
+  jerry_release_value(func);
+  jerry_release_value(validator);
 
   return ret;
 }
@@ -758,12 +1292,17 @@ jerry_value_t js_return_result(const jerry_value_t func_obj_val, const jerry_val
 }
 
 jerry_value_t jerry_value_from_navigator_request(navigator_request_t* req) {
-  jerry_value_t obj = jerry_create_object();
+  jerry_value_t obj = 0;
 
   if (req != NULL) {
-    jerry_value_from_obj(obj, OBJECT(req));
+    obj = jerry_value_from_object(OBJECT(req));
+    /*onResult/nativeRequest只属于JS对象，不能通过访问器写回req*/
+    jsobj_remove_prop(obj, JSOBJ_ON_RESULT);
+    jsobj_remove_prop(obj, STR_NATIVE_REQ);
     ENSURE(jsobj_set_prop_str(obj, NAVIGATOR_ARG_TARGET, req->target) == RET_OK);
     ENSURE(jsobj_set_prop_pointer(obj, STR_NATIVE_REQ, OBJECT(req)) == RET_OK);
+  } else {
+    obj = jerry_create_object();
   }
 
   ENSURE(jsobj_set_prop_func(obj, JSOBJ_ON_RESULT, js_return_result) == RET_OK);
@@ -23,11 +23,19 @@
 #define TK_JSOBJ_H
 
 #include "tkc/str.h"
+#include "tkc/darray.h"
 #include "jerryscript.h"
+#include "mvvm/base/registry.h"
 #include "mvvm/base/navigator_request.h"
 
 BEGIN_C_DECLS
 
+ret_t jsobj_init(void);
+ret_t jsobj_deinit(void);
+
+uint32_t jsobj_get_code_version(void);
+ret_t jsobj_inc_code_version(void);
+
 jerry_value_t jsobj_get_model(const char* name);
 
 bool_t jsobj_has_prop(jerry_value_t obj, const char* name);
@@ -45,11 +53,27 @@ ret_t jsobj_set_prop_value(jerry_value_t obj, const char* name, jerry_value_t pr
 ret_t jsobj_set_prop(jerry_value_t obj, const char* name, const value_t* v, str_t* temp);
 ret_t jsobj_set_prop_func(jerry_value_t obj, const char* name, jerry_external_handler_t handler_p);
 ret_t jsobj_set_prop_int(jerry_value_t obj, const char* name, int32_t value);
+ret_t jsobj_remove_prop(jerry_value_t obj, const char* name);
 
 ret_t jsobj_exec(jerry_value_t obj, const char* name, const char* args);
 ret_t jsobj_exec_ex(jerry_value_t obj, const char* name, jerry_value_t args);
 bool_t jsobj_can_exec(jerry_value_t obj, const char* name, const char* args);
 
+/*按命令名(散列表)缓存已解析的函数(包括不存在的canXxx)，模型的方法改变后需要调用clear*/
+typedef struct _jsobj_method_cache_t {
+  registry_t methods;
+} jsobj_method_cache_t;
+
+ret_t jsobj_method_cache_init(jsobj_method_cache_t* cache);
+ret_t jsobj_method_cache_clear(jsobj_method_cache_t* cache);
+ret_t jsobj_method_cache_deinit(jsobj_method_cache_t* cache);
+ret_t jsobj_method_cache_exec(jsobj_method_cache_t* cache, jerry_value_t obj, const char* name,
+                              const char* args);
+ret_t jsobj_method_cache_exec_ex(jsobj_method_cache_t* cache, jerry_value_t obj, const char* name,
+                                 jerry_value_t args);
+bool_t jsobj_method_cache_can_exec(jsobj_method_cache_t* cache, jerry_value_t obj,
+                                   const char* name, const char* args);
+
 jerry_value_t jerry_value_from_navigator_request(navigator_request_t* req);
 navigator_request_t* jerry_value_to_navigator_request(jerry_value_t value);
 
@@ -57,25 +81,76 @@ ret_t jerry_value_to_value(jerry_value_t value, value_t* v, str_t* temp);
 jerry_value_t jerry_value_from_value(const value_t* v, str_t* temp);
 void* jerry_value_to_pointer(jerry_value_t value);
 jerry_value_t jerry_value_from_pointer(void* ptr);
+char* jerry_get_utf8_value(jerry_value_t value, str_t* temp);
+
+/*
+ * object_t和JS对象之间互相包装(不复制属性)，包装对象持有被包装对象的引用。
+ * jsobj_deinit之后，jerry_value_to_object返回的包装对象不再可用(访问返回失败)。
+ */
+jerry_value_t jerry_value_from_object(object_t* obj);
+object_t* jerry_value_to_object(jerry_value_t value);
 ret_t jerry_value_check(jerry_value_t value);
 
 bool_t jsvalue_converter_exist(const char* name);
+jerry_value_t jsvalue_converter_get(const char* name);
+ret_t jsvalue_converter_call(jerry_value_t converter, jerry_value_t func, const value_t* from,
+                             value_t* to, str_t* temp);
 ret_t jsvalue_converter_to_view(const char* name, const value_t* from, value_t* to, str_t* temp);
 ret_t jsvalue_converter_to_model(const char* name, const value_t* from, value_t* to, str_t* temp);
 
 bool_t jsvalue_validator_exist(const char* name);
+jerry_value_t jsvalue_validator_get(const char* name);
+ret_t jsvalue_validator_call_is_valid(jerry_value_t validator, jerry_value_t func,
+                                      const value_t* value, str_t* msg);
+ret_t jsvalue_validator_call_fix(jerry_value_t validator, jerry_value_t func, value_t* v);
 ret_t jsvalue_validator_is_valid(const char* name, const value_t* v, str_t* msg);
 ret_t jsvalue_validator_fix(const char* name, value_t* v);
 
 #define JSOBJ_VALUE_CONVERTERS "ValueConverters"
 #define JSOBJ_VALUE_CONVERTER_TO_VIEW "toView"
 #define JSOBJ_VALUE_CONVERTER_TO_VIEW_MODEL "toModel"
+#define JSOBJ_VALUE_CONVERTER_TO_VIEW_BATCH "toViewBatch"
+#define JSOBJ_VALUE_CONVERTER_TO_VIEW_MODEL_BATCH "toModelBatch"
 #define JSOBJ_VALUE_VALIDATORS "ValueValidators"
 #define JSOBJ_VALUE_VALIDATOR_FIX "fix"
 #define JSOBJ_VALUE_VALIDATOR_IS_VALID "isValid"
 #define JSOBJ_VALUE_VALIDATOR_RESULT "result"
 #define JSOBJ_VALUE_VALIDATOR_MESSAGE "message"
 #define JSOBJ_ON_RESULT "onResult"
+#define JSOBJ_NATIVE_MODEL "nativeModel"
+
+/*JS函数执行时间统计。定义WITH_JSOBJ_PROFILER时才会在调用点计时，否则没有任何开销*/
+typedef struct _jsobj_profile_t {
+  /*记录按owner+scope+func区分。owner为模型/转换器/校验器对象或者定时器的JS函数，只用于比较*/
+  const void* owner;
+  /*模型/转换器/校验器的名称，或者timer/idle/frame*/
+  char scope[TK_NAME_LEN + 1];
+  /*函数名*/
+  char func[TK_NAME_LEN + 1];
+  uint32_t count;
+  /*累计时间和最长时间(us)*/
+  uint64_t total_time;
+  uint64_t max_time;
+} jsobj_profile_t;
+
+ret_t jsobj_profiler_record(const void* owner, const char* scope, const char* func, uint64_t cost);
+ret_t jsobj_profiler_foreach(tk_visit_t visit, void* ctx);
+ret_t jsobj_profiler_dump(void);
+ret_t jsobj_profiler_reset(void);
+
+#ifdef WITH_JSOBJ_PROFILER
+#ifndef JSOBJ_PROFILER_NOW
+#include "tkc/time_now.h"
+#define JSOBJ_PROFILER_NOW() time_now_us()
+#endif /*JSOBJ_PROFILER_NOW*/
+
+#define JSOBJ_PROFILE_BEGIN(start) uint64_t start = JSOBJ_PROFILER_NOW()
+#define JSOBJ_PROFILE_END(start, owner, scope, func) \
+  jsobj_profiler_record(owner, scope, func, JSOBJ_PROFILER_NOW() - start)
+#else
+#define JSOBJ_PROFILE_BEGIN(start)
+#define JSOBJ_PROFILE_END(start, owner, scope, func)
+#endif /*WITH_JSOBJ_PROFILER*/
 
 END_C_DECLS
 
@@ -20,12 +20,15 @@
  */
 
 #include "tkc/utils.h"
+#include "tkc/time_now.h"
 #include "jerryscript-port.h"
 #include "jerryscript-ext/handler.h"
 #include "mvvm/base/view_model_factory.h"
 #include "mvvm/jerryscript/jsobj.h"
 #include "mvvm/jerryscript/jerryscript_awtk.h"
 #include "mvvm/jerryscript/mvvm_jerryscript.h"
+#include "mvvm/jerryscript/numeric_series_jerryscript.h"
+#include "mvvm/jerryscript/view_model_array_index_jerryscript.h"
 
 const char* s_boot_code =
     "var ValueConverters = {};\n \
@@ -38,9 +41,21 @@ const char* s_boot_code =
                            console.log('hello awtk'); \n \
                            ";
 
+#ifndef MVVM_JERRYSCRIPT_HEAP_WARN_THRESHOLD
+#define MVVM_JERRYSCRIPT_HEAP_WARN_THRESHOLD 0
+#endif /*MVVM_JERRYSCRIPT_HEAP_WARN_THRESHOLD*/
+
+/*jerryscript没有提供GC的回调，只能统计通过mvvm_jerryscript_gc手动执行的回收*/
+static uint32_t s_manual_gc_count = 0;
+static uint32_t s_manual_gc_time = 0;
+static uint32_t s_heap_warn_threshold = MVVM_JERRYSCRIPT_HEAP_WARN_THRESHOLD;
+
 ret_t mvvm_jerryscript_init(void) {
   jerry_init(JERRY_INIT_EMPTY);
+  jsobj_init();
   jerryx_handler_register_global((const jerry_char_t*)"print", jerryx_handler_print);
+  numeric_series_jerryscript_init();
+  view_model_array_index_jerryscript_init();
 
   return_value_if_fail(value_validator_jerryscript_init() == RET_OK, RET_FAIL);
   return_value_if_fail(value_converter_jerryscript_init() == RET_OK, RET_FAIL);
@@ -63,6 +78,7 @@ jerry_value_t jerryscript_eval(const char* name, const char* code, uint32_t code
 
   jsret = jerry_run(jscode);
   jerry_value_check(jsret);
+  jsobj_inc_code_version();
 
   jerry_release_value(jscode);
 
@@ -79,10 +95,81 @@ ret_t jerryscript_run(const char* name, const char* code, uint32_t code_size) {
   return RET_OK;
 }
 
+ret_t mvvm_jerryscript_get_mem_stats(mvvm_jerryscript_mem_stats_t* stats) {
+  jerry_heap_stats_t heap_stats;
+  return_value_if_fail(stats != NULL, RET_BAD_PARAMS);
+
+  memset(stats, 0x00, sizeof(*stats));
+  stats->manual_gc_count = s_manual_gc_count;
+  stats->manual_gc_time = s_manual_gc_time;
+
+  memset(&heap_stats, 0x00, sizeof(heap_stats));
+  if (!jerry_get_memory_stats(&heap_stats)) {
+    return RET_NOT_IMPL;
+  }
+
+  stats->size = heap_stats.size;
+  stats->allocated = heap_stats.allocated_bytes;
+  stats->peak = heap_stats.peak_allocated_bytes;
+
+  return RET_OK;
+}
+
+ret_t mvvm_jerryscript_dump_mem_stats(void) {
+  mvvm_jerryscript_mem_stats_t stats;
+
+  if (mvvm_jerryscript_get_mem_stats(&stats) == RET_OK) {
+    log_info("js heap: size=%u allocated=%u peak=%u manual_gc_count=%u manual_gc_time=%ums\n",
+             stats.size, stats.allocated, stats.peak, stats.manual_gc_count,
+             stats.manual_gc_time);
+  } else {
+    log_info("js heap: mem stats disabled manual_gc_count=%u manual_gc_time=%ums\n",
+             stats.manual_gc_count, stats.manual_gc_time);
+  }
+
+  return RET_OK;
+}
+
+ret_t mvvm_jerryscript_gc(void) {
+  uint64_t start = time_now_ms();
+
+  jerry_gc(JERRY_GC_SEVERITY_HIGH);
+
+  s_manual_gc_count++;
+  s_manual_gc_time += (uint32_t)(time_now_ms() - start);
+
+  return RET_OK;
+}
+
+ret_t mvvm_jerryscript_set_heap_warn_threshold(uint32_t threshold) {
+  s_heap_warn_threshold = threshold;
+
+  return RET_OK;
+}
+
+ret_t mvvm_jerryscript_check_heap(const char* name) {
+  mvvm_jerryscript_mem_stats_t stats;
+
+  if (s_heap_warn_threshold == 0 || mvvm_jerryscript_get_mem_stats(&stats) != RET_OK) {
+    return RET_OK;
+  }
+
+  if (stats.allocated > s_heap_warn_threshold) {
+    log_warn("js heap: %s allocated=%u > threshold=%u (size=%u peak=%u)\n",
+             name != NULL ? name : "", stats.allocated, s_heap_warn_threshold, stats.size,
+             stats.peak);
+    return RET_FAIL;
+  }
+
+  return RET_OK;
+}
+
 ret_t mvvm_jerryscript_deinit(void) {
+  mvvm_jerryscript_dump_mem_stats();
   value_converter_jerryscript_deinit();
   value_validator_jerryscript_deinit();
   jerryscript_awtk_deinit();
+  jsobj_deinit();
   jerry_cleanup();
 
   return RET_OK;
@@ -59,6 +59,92 @@ ret_t jerryscript_run(const char* name, const char* code, uint32_t code_size);
  */
 jerry_value_t jerryscript_eval(const char* name, const char* code, uint32_t code_size);
 
+/**
+ * @class mvvm_jerryscript_mem_stats_t
+ * JS堆的内存统计信息。
+ */
+typedef struct _mvvm_jerryscript_mem_stats_t {
+  /**
+   * @property {uint32_t} size
+   * @annotation ["readable"]
+   * 堆的总大小(字节)。
+   */
+  uint32_t size;
+  /**
+   * @property {uint32_t} allocated
+   * @annotation ["readable"]
+   * 当前已分配的内存(字节)。
+   */
+  uint32_t allocated;
+  /**
+   * @property {uint32_t} peak
+   * @annotation ["readable"]
+   * 已分配内存的峰值(字节)。
+   */
+  uint32_t peak;
+  /**
+   * @property {uint32_t} manual_gc_count
+   * @annotation ["readable"]
+   * 通过mvvm_jerryscript_gc手动执行垃圾回收的次数(不包括引擎在分配内存时自动执行的回收)。
+   */
+  uint32_t manual_gc_count;
+  /**
+   * @property {uint32_t} manual_gc_time
+   * @annotation ["readable"]
+   * 通过mvvm_jerryscript_gc手动执行垃圾回收的总时间(毫秒，不包括引擎自动执行的回收)。
+   */
+  uint32_t manual_gc_time;
+} mvvm_jerryscript_mem_stats_t;
+
+/**
+ * @method mvvm_jerryscript_get_mem_stats
+ * 获取JS堆的内存统计信息。
+ *
+ * > size/allocated/peak需要在编译jerryscript时启用内存统计(JERRY_MEM_STATS=1)。
+ *
+ * @param {mvvm_jerryscript_mem_stats_t*} stats 用于返回统计信息。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，RET_NOT_IMPL表示没有启用内存统计。
+ */
+ret_t mvvm_jerryscript_get_mem_stats(mvvm_jerryscript_mem_stats_t* stats);
+
+/**
+ * @method mvvm_jerryscript_dump_mem_stats
+ * 将JS堆的内存统计信息输出到日志。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t mvvm_jerryscript_dump_mem_stats(void);
+
+/**
+ * @method mvvm_jerryscript_gc
+ * 手动执行垃圾回收，并记录回收的次数和时间(见manual\_gc\_count/manual\_gc\_time)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t mvvm_jerryscript_gc(void);
+
+/**
+ * @method mvvm_jerryscript_set_heap_warn_threshold
+ * 设置JS堆的警告阈值。
+ * 创建view_model后，如果已分配的内存超过该值，输出警告日志。
+ *
+ * @param {uint32_t} threshold 阈值(字节)，0表示不检查。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t mvvm_jerryscript_set_heap_warn_threshold(uint32_t threshold);
+
+/**
+ * @method mvvm_jerryscript_check_heap
+ * 检查JS堆的使用是否超过警告阈值，如果超过则输出警告日志。
+ *
+ * @param {const char*} name 名称(通常是view_model的名称)。
+ *
+ * @return {ret_t} 返回RET_OK表示没有超过阈值，否则表示超过。
+ */
+ret_t mvvm_jerryscript_check_heap(const char* name);
+
 /**
  * @method mvvm_jerryscript_deinit
  * ~初始化MVVM jerryscript。
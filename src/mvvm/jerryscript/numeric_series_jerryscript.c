@@ -0,0 +1,199 @@
+﻿/**
+ * File:   numeric_series_jerryscript.c
+ * Author: AWTK Develop Team
+ * Brief:  numeric series for jerryscript
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#include "tkc/utils.h"
+#include "jerryscript-ext/handler.h"
+#include "mvvm/jerryscript/jsobj.h"
+#include "mvvm/jerryscript/numeric_series_jerryscript.h"
+
+static ret_t numeric_series_jerryscript_set_typedarray(numeric_series_t* series, uint32_t index,
+                                                       jerry_value_t value) {
+  uint32_t nr = 0;
+  jerry_length_t offset = 0;
+  jerry_length_t length = 0;
+  jerry_value_t buffer = jerry_get_typedarray_buffer(value, &offset, &length);
+
+  nr = length / sizeof(float_t);
+  if (index + nr > series->size) {
+    if (numeric_series_resize(series, index + nr) != RET_OK) {
+      jerry_release_value(buffer);
+      return RET_OOM;
+    }
+  }
+
+  jerry_arraybuffer_read(buffer, offset, (uint8_t*)(series->data + index), nr * sizeof(float_t));
+  jerry_release_value(buffer);
+
+  return numeric_series_mark_dirty(series, index, index + nr);
+}
+
+static ret_t numeric_series_jerryscript_set_array(numeric_series_t* series, uint32_t index,
+                                                  jerry_value_t value) {
+  uint32_t i = 0;
+  uint32_t nr = jerry_get_array_length(value);
+
+  if (index + nr > series->size) {
+    return_value_if_fail(numeric_series_resize(series, index + nr) == RET_OK, RET_OOM);
+  }
+
+  for (i = 0; i < nr; i++) {
+    jerry_value_t item = jerry_get_property_by_index(value, i);
+    series->data[index + i] = jerry_value_is_number(item) ? jerry_get_number_value(item) : 0;
+    jerry_release_value(item);
+  }
+
+  return numeric_series_mark_dirty(series, index, index + nr);
+}
+
+ret_t numeric_series_jerryscript_set(numeric_series_t* series, uint32_t index,
+                                     jerry_value_t value) {
+  return_value_if_fail(series != NULL && index <= series->size, RET_BAD_PARAMS);
+
+  if (jerry_value_is_number(value)) {
+    float_t v = jerry_get_number_value(value);
+
+    return numeric_series_set_n(series, index, &v, 1);
+  } else if (jerry_value_is_typedarray(value) && sizeof(float_t) == sizeof(float) &&
+             jerry_get_typedarray_type(value) == JERRY_TYPEDARRAY_FLOAT32) {
+    return numeric_series_jerryscript_set_typedarray(series, index, value);
+  } else if (jerry_value_is_array(value)) {
+    return numeric_series_jerryscript_set_array(series, index, value);
+  }
+
+  return RET_BAD_PARAMS;
+}
+
+static numeric_series_t* numeric_series_jerryscript_get(jerry_value_t value, object_t** obj) {
+  *obj = jerry_value_to_object(value);
+
+  return *obj != NULL ? numeric_series_cast(*obj) : NULL;
+}
+
+static jerry_value_t wrap_numeric_series_push(const jerry_value_t func_obj_val,
+                                              const jerry_value_t this_p,
+                                              const jerry_value_t args_p[],
+                                              const jerry_length_t args_cnt) {
+  object_t* obj = NULL;
+  ret_t ret = RET_BAD_PARAMS;
+  numeric_series_t* series = numeric_series_jerryscript_get(this_p, &obj);
+
+  if (series != NULL && args_cnt >= 1) {
+    ret = numeric_series_jerryscript_set(series, series->size, args_p[0]);
+  }
+  object_unref(obj);
+
+  return jerry_create_number(ret);
+}
+
+static jerry_value_t wrap_numeric_series_set(const jerry_value_t func_obj_val,
+                                             const jerry_value_t this_p,
+                                             const jerry_value_t args_p[],
+                                             const jerry_length_t args_cnt) {
+  object_t* obj = NULL;
+  ret_t ret = RET_BAD_PARAMS;
+  numeric_series_t* series = numeric_series_jerryscript_get(this_p, &obj);
+
+  if (series != NULL && args_cnt >= 2) {
+    uint32_t index = (uint32_t)jerry_get_number_value(args_p[0]);
+    ret = numeric_series_jerryscript_set(series, index, args_p[1]);
+  }
+  object_unref(obj);
+
+  return jerry_create_number(ret);
+}
+
+static jerry_value_t wrap_numeric_series_get(const jerry_value_t func_obj_val,
+                                             const jerry_value_t this_p,
+                                             const jerry_value_t args_p[],
+                                             const jerry_length_t args_cnt) {
+  float_t v = 0;
+  object_t* obj = NULL;
+  numeric_series_t* series = numeric_series_jerryscript_get(this_p, &obj);
+
+  if (series != NULL && args_cnt >= 1) {
+    v = numeric_series_get(series, (uint32_t)jerry_get_number_value(args_p[0]), 0);
+  }
+  object_unref(obj);
+
+  return jerry_create_number(v);
+}
+
+static jerry_value_t wrap_numeric_series_size(const jerry_value_t func_obj_val,
+                                              const jerry_value_t this_p,
+                                              const jerry_value_t args_p[],
+                                              const jerry_length_t args_cnt) {
+  uint32_t size = 0;
+  object_t* obj = NULL;
+  numeric_series_t* series = numeric_series_jerryscript_get(this_p, &obj);
+
+  if (series != NULL) {
+    size = series->size;
+  }
+  object_unref(obj);
+
+  return jerry_create_number(size);
+}
+
+static jerry_value_t wrap_numeric_series_clear(const jerry_value_t func_obj_val,
+                                               const jerry_value_t this_p,
+                                               const jerry_value_t args_p[],
+                                               const jerry_length_t args_cnt) {
+  object_t* obj = NULL;
+  ret_t ret = RET_BAD_PARAMS;
+  numeric_series_t* series = numeric_series_jerryscript_get(this_p, &obj);
+
+  if (series != NULL) {
+    ret = numeric_series_clear(series);
+  }
+  object_unref(obj);
+
+  return jerry_create_number(ret);
+}
+
+static jerry_value_t wrap_create_numeric_series(const jerry_value_t func_obj_val,
+                                                const jerry_value_t this_p,
+                                                const jerry_value_t args_p[],
+                                                const jerry_length_t args_cnt) {
+  jerry_value_t jsobj = 0;
+  numeric_series_t* series = NULL;
+  uint32_t capacity = args_cnt >= 1 ? (uint32_t)jerry_get_number_value(args_p[0]) : 0;
+
+  series = numeric_series_create(capacity);
+  return_value_if_fail(series != NULL, jerry_create_null());
+
+  jsobj = jerry_value_from_object(OBJECT(series));
+  object_unref(OBJECT(series));
+
+  jsobj_set_prop_func(jsobj, "push", wrap_numeric_series_push);
+  jsobj_set_prop_func(jsobj, "set", wrap_numeric_series_set);
+  jsobj_set_prop_func(jsobj, "get", wrap_numeric_series_get);
+  jsobj_set_prop_func(jsobj, "size", wrap_numeric_series_size);
+  jsobj_set_prop_func(jsobj, "clear", wrap_numeric_series_clear);
+
+  return jsobj;
+}
+
+ret_t numeric_series_jerryscript_init(void) {
+  jerryx_handler_register_global((const jerry_char_t*)"createNumericSeries",
+                                 wrap_create_numeric_series);
+
+  return RET_OK;
+}
@@ -0,0 +1,57 @@
+﻿/**
+ * File:   numeric_series_jerryscript.h
+ * Author: AWTK Develop Team
+ * Brief:  numeric series for jerryscript
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#ifndef TK_NUMERIC_SERIES_JERRYSCRIPT_H
+#define TK_NUMERIC_SERIES_JERRYSCRIPT_H
+
+#include "jerryscript.h"
+#include "mvvm/base/numeric_series.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @method numeric_series_jerryscript_init
+ * 注册JS函数createNumericSeries(capacity)。
+ *
+ * 它返回的JS对象包装了numeric_series_t，作为模型的属性值时，直接以对象的形式绑定到控件。
+ * JS对象提供push(value)/set(index, value)/get(index)/size()/clear()等方法，
+ * value可以是数值、数组或Float32Array(启用typed array时一次复制全部数据)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t numeric_series_jerryscript_init(void);
+
+/**
+ * @method numeric_series_jerryscript_set
+ * 从指定位置开始写入JS数据，超出size的部分会追加到后面。
+ *
+ * @param {numeric_series_t*} series numeric_series对象。
+ * @param {uint32_t} index 起始位置(不能大于size)。
+ * @param {jerry_value_t} value 数值、数组或Float32Array。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t numeric_series_jerryscript_set(numeric_series_t* series, uint32_t index,
+                                     jerry_value_t value);
+
+END_C_DECLS
+
+#endif /*TK_NUMERIC_SERIES_JERRYSCRIPT_H*/
@@ -0,0 +1,199 @@
+﻿/**
+ * File:   object_jerryscript.c
+ * Author: AWTK Develop Team
+ * Brief:  wrap jerryscript object to an object_t
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#include "tkc/utils.h"
+#include "tkc/darray.h"
+#include "tkc/named_value.h"
+#include "mvvm/jerryscript/jsobj.h"
+#include "mvvm/jerryscript/object_jerryscript.h"
+
+/*所有存活的包装对象，jerry_cleanup之前需要释放它们持有的JS对象*/
+static darray_t s_objects;
+
+static ret_t object_jerryscript_release(object_jerryscript_t* o) {
+  if (o->valid) {
+    jerry_release_value(o->jsobj);
+    o->valid = FALSE;
+  }
+
+  return RET_OK;
+}
+
+static ret_t object_jerryscript_on_destroy(object_t* obj) {
+  object_jerryscript_t* o = OBJECT_JERRYSCRIPT(obj);
+
+  object_jerryscript_release(o);
+  darray_remove(&s_objects, o);
+  str_reset(&(o->temp));
+
+  return RET_OK;
+}
+
+static int32_t object_jerryscript_compare(object_t* obj, object_t* other) {
+  return tk_str_cmp(obj->name, other->name);
+}
+
+static ret_t object_jerryscript_set_prop(object_t* obj, const char* name, const value_t* v) {
+  object_jerryscript_t* o = OBJECT_JERRYSCRIPT(obj);
+  return_value_if_fail(obj != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(o->valid, RET_BAD_PARAMS);
+
+  return jsobj_set_prop(o->jsobj, name, v, &(o->temp));
+}
+
+static ret_t object_jerryscript_get_prop(object_t* obj, const char* name, value_t* v) {
+  object_jerryscript_t* o = OBJECT_JERRYSCRIPT(obj);
+  return_value_if_fail(obj != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(o->valid, RET_BAD_PARAMS);
+
+  return jsobj_get_prop(o->jsobj, name, v, &(o->temp));
+}
+
+static ret_t object_jerryscript_remove_prop(object_t* obj, const char* name) {
+  object_jerryscript_t* o = OBJECT_JERRYSCRIPT(obj);
+  return_value_if_fail(obj != NULL && name != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(o->valid, RET_BAD_PARAMS);
+
+  return jsobj_remove_prop(o->jsobj, name);
+}
+
+typedef struct _object_jerryscript_foreach_ctx_t {
+  ret_t ret;
+  void* ctx;
+  tk_visit_t on_prop;
+  str_t name;
+  str_t value;
+} object_jerryscript_foreach_ctx_t;
+
+static bool visit_jsobj_prop(const jerry_value_t property_name,
+                             const jerry_value_t property_value, void* user_data_p) {
+  value_t v;
+  named_value_t nv;
+  object_jerryscript_foreach_ctx_t* info = (object_jerryscript_foreach_ctx_t*)user_data_p;
+
+  nv.name = jerry_get_utf8_value(property_name, &(info->name));
+  return_value_if_fail(nv.name != NULL, false);
+
+  value_set_int(&v, 0);
+  if (jerry_value_to_value(property_value, &v, &(info->value)) == RET_OK) {
+    nv.value = v;
+    info->ret = info->on_prop(info->ctx, &nv);
+  }
+  value_reset(&v);
+
+  return info->ret == RET_OK;
+}
+
+static ret_t object_jerryscript_foreach_prop(object_t* obj, tk_visit_t on_prop, void* ctx) {
+  object_jerryscript_foreach_ctx_t info;
+  object_jerryscript_t* o = OBJECT_JERRYSCRIPT(obj);
+  return_value_if_fail(obj != NULL && on_prop != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(o->valid, RET_BAD_PARAMS);
+
+  info.ret = RET_OK;
+  info.ctx = ctx;
+  info.on_prop = on_prop;
+  str_init(&(info.name), 0);
+  str_init(&(info.value), 0);
+
+  jerry_foreach_object_property(o->jsobj, visit_jsobj_prop, &info);
+
+  str_reset(&(info.name));
+  str_reset(&(info.value));
+
+  return info.ret;
+}
+
+static bool_t object_jerryscript_can_exec(object_t* obj, const char* name, const char* args) {
+  object_jerryscript_t* o = OBJECT_JERRYSCRIPT(obj);
+  return_value_if_fail(obj != NULL && name != NULL, FALSE);
+  return_value_if_fail(o->valid, FALSE);
+
+  return jsobj_can_exec(o->jsobj, name, args);
+}
+
+static ret_t object_jerryscript_exec(object_t* obj, const char* name, const char* args) {
+  object_jerryscript_t* o = OBJECT_JERRYSCRIPT(obj);
+  return_value_if_fail(obj != NULL && name != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(o->valid, RET_BAD_PARAMS);
+
+  return jsobj_exec(o->jsobj, name, args);
+}
+
+static const object_vtable_t s_object_jerryscript_vtable = {
+    .type = "object_jerryscript",
+    .desc = "object_jerryscript",
+    .size = sizeof(object_jerryscript_t),
+    .is_collection = FALSE,
+    .on_destroy = object_jerryscript_on_destroy,
+
+    .compare = object_jerryscript_compare,
+    .get_prop = object_jerryscript_get_prop,
+    .set_prop = object_jerryscript_set_prop,
+    .remove_prop = object_jerryscript_remove_prop,
+    .foreach_prop = object_jerryscript_foreach_prop,
+    .can_exec = object_jerryscript_can_exec,
+    .exec = object_jerryscript_exec};
+
+object_t* object_jerryscript_create(jerry_value_t jsobj) {
+  object_t* obj = NULL;
+  object_jerryscript_t* o = NULL;
+  return_value_if_fail(jerry_value_is_object(jsobj), NULL);
+
+  obj = object_create(&s_object_jerryscript_vtable);
+  o = OBJECT_JERRYSCRIPT(obj);
+  return_value_if_fail(o != NULL, NULL);
+
+  o->jsobj = jerry_acquire_value(jsobj);
+  o->valid = TRUE;
+  str_init(&(o->temp), 0);
+  darray_push(&s_objects, o);
+
+  return obj;
+}
+
+bool_t object_is_jerryscript(object_t* obj) {
+  return obj != NULL && obj->vt == &s_object_jerryscript_vtable;
+}
+
+jerry_value_t object_jerryscript_get_jsobj(object_t* obj) {
+  object_jerryscript_t* o = OBJECT_JERRYSCRIPT(obj);
+  return_value_if_fail(object_is_jerryscript(obj) && o->valid, jerry_create_undefined());
+
+  return o->jsobj;
+}
+
+ret_t object_jerryscript_init(void) {
+  darray_init(&s_objects, 10, NULL, NULL);
+
+  return RET_OK;
+}
+
+static ret_t object_jerryscript_release_visit(void* ctx, const void* data) {
+  return object_jerryscript_release(OBJECT_JERRYSCRIPT(data));
+}
+
+ret_t object_jerryscript_deinit(void) {
+  darray_foreach(&s_objects, object_jerryscript_release_visit, NULL);
+  darray_deinit(&s_objects);
+
+  return RET_OK;
+}
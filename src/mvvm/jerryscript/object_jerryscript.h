@@ -0,0 +1,107 @@
+﻿/**
+ * File:   object_jerryscript.h
+ * Author: AWTK Develop Team
+ * Brief:  wrap jerryscript object to an object_t
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#ifndef TK_OBJECT_JERRYSCRIPT_H
+#define TK_OBJECT_JERRYSCRIPT_H
+
+#include "tkc/str.h"
+#include "tkc/object.h"
+#include "jerryscript.h"
+
+BEGIN_C_DECLS
+
+struct _object_jerryscript_t;
+typedef struct _object_jerryscript_t object_jerryscript_t;
+
+/**
+ * @class object_jerryscript_t
+ * @parent object_t
+ *
+ * 把JS对象包装成object_t。
+ *
+ * 属性的读写直接转发给JS对象，创建时不复制任何属性。
+ * 包装对象持有JS对象的引用，销毁时释放。
+ * jsobj_deinit(jerry_cleanup之前)会释放所有存活的包装对象持有的引用，之后的访问都返回失败。
+ *
+ */
+struct _object_jerryscript_t {
+  object_t object;
+
+  /*private*/
+  jerry_value_t jsobj;
+  /*jsobj_deinit之后为FALSE*/
+  bool_t valid;
+
+  /*避免每次动态分配内存*/
+  str_t temp;
+};
+
+/**
+ * @method object_jerryscript_create
+ * 将jsobj包装成object_t对象。
+ *
+ * @param {jerry_value_t} jsobj js对象(内部会增加引用计数)。
+ *
+ * @return {object_t*} 返回object对象。
+ */
+object_t* object_jerryscript_create(jerry_value_t jsobj);
+
+/**
+ * @method object_jerryscript_get_jsobj
+ * 获取包装的js对象。
+ *
+ * @param {object_t*} obj object_jerryscript对象。
+ *
+ * @return {jerry_value_t} 返回js对象(不增加引用计数)。
+ */
+jerry_value_t object_jerryscript_get_jsobj(object_t* obj);
+
+/**
+ * @method object_jerryscript_init
+ * 初始化object_jerryscript，由jsobj_init调用。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t object_jerryscript_init(void);
+
+/**
+ * @method object_jerryscript_deinit
+ * 释放所有存活的object_jerryscript对象持有的JS对象，由jsobj_deinit调用。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t object_jerryscript_deinit(void);
+
+/**
+ * @method object_is_jerryscript
+ * 判断对象是否是object_jerryscript对象。
+ *
+ * @param {object_t*} obj object对象。
+ *
+ * @return {bool_t} 返回TRUE表示是，否则表示不是。
+ */
+bool_t object_is_jerryscript(object_t* obj);
+
+#define OBJECT_JERRYSCRIPT(obj) ((object_jerryscript_t*)(obj))
+
+END_C_DECLS
+
+#endif /*TK_OBJECT_JERRYSCRIPT_H*/
@@ -26,9 +26,54 @@
 #include "mvvm/jerryscript/jsobj.h"
 #include "mvvm/jerryscript/value_converter_jerryscript.h"
 
+/*所有存活的JS converter，jerry_cleanup之前需要释放它们持有的JS对象*/
+static darray_t s_converters;
+
+/*Array.map会传入(value, index, array)，包装一下，toView/toModel只收到value*/
+#define VALUE_CONVERTER_JERRYSCRIPT_MAP                            \
+  "(function(arr, func, obj) {"                                    \
+  "  return arr.map(function(v) { return func.call(obj, v); });" \
+  "})"
+static jerry_value_t s_map_func;
+
+static ret_t value_converter_jerryscript_release(value_converter_jerryscript_t* jsconverter) {
+  if (jsconverter->version != 0) {
+    jerry_release_value(jsconverter->jsobj);
+    jerry_release_value(jsconverter->to_view);
+    jerry_release_value(jsconverter->to_model);
+    jerry_release_value(jsconverter->to_view_batch);
+    jerry_release_value(jsconverter->to_model_batch);
+    jsconverter->version = 0;
+  }
+
+  return RET_OK;
+}
+
+static ret_t value_converter_jerryscript_resolve(value_converter_jerryscript_t* jsconverter) {
+  uint32_t version = jsobj_get_code_version();
+
+  if (jsconverter->version != version) {
+    value_converter_jerryscript_release(jsconverter);
+
+    jsconverter->jsobj = jsvalue_converter_get(OBJECT(jsconverter)->name);
+    jsconverter->to_view = jsobj_get_prop_value(jsconverter->jsobj, JSOBJ_VALUE_CONVERTER_TO_VIEW);
+    jsconverter->to_model =
+        jsobj_get_prop_value(jsconverter->jsobj, JSOBJ_VALUE_CONVERTER_TO_VIEW_MODEL);
+    jsconverter->to_view_batch =
+        jsobj_get_prop_value(jsconverter->jsobj, JSOBJ_VALUE_CONVERTER_TO_VIEW_BATCH);
+    jsconverter->to_model_batch =
+        jsobj_get_prop_value(jsconverter->jsobj, JSOBJ_VALUE_CONVERTER_TO_VIEW_MODEL_BATCH);
+    jsconverter->version = version;
+  }
+
+  return RET_OK;
+}
+
 static ret_t value_converter_jerryscript_on_destroy(object_t* obj) {
   value_converter_jerryscript_t* jsconverter = VALUE_CONVERTER_JERRYSCRIPT(obj);
 
+  value_converter_jerryscript_release(jsconverter);
+  darray_remove(&s_converters, jsconverter);
   str_reset(&(jsconverter->temp));
 
   return RET_OK;
@@ -42,18 +87,156 @@ static const object_vtable_t s_value_converter_jerryscript_vtable = {
 
 static ret_t value_converter_jerryscript_to_view(value_converter_t* c, const value_t* from,
                                                  value_t* to) {
-  object_t* obj = OBJECT(c);
+  ret_t ret = RET_OK;
   value_converter_jerryscript_t* jsconverter = VALUE_CONVERTER_JERRYSCRIPT(c);
 
-  return jsvalue_converter_to_view(obj->name, from, to, &(jsconverter->temp));
+  value_converter_jerryscript_resolve(jsconverter);
+
+  JSOBJ_PROFILE_BEGIN(start);
+  ret = jsvalue_converter_call(jsconverter->jsobj, jsconverter->to_view, from, to,
+                               &(jsconverter->temp));
+  JSOBJ_PROFILE_END(start, c, OBJECT(c)->name, JSOBJ_VALUE_CONVERTER_TO_VIEW);
+
+  return ret;
 }
 
 static ret_t value_converter_jerryscript_to_model(value_converter_t* c, const value_t* from,
                                                   value_t* to) {
-  object_t* obj = OBJECT(c);
+  ret_t ret = RET_OK;
+  value_converter_jerryscript_t* jsconverter = VALUE_CONVERTER_JERRYSCRIPT(c);
+
+  value_converter_jerryscript_resolve(jsconverter);
+
+  JSOBJ_PROFILE_BEGIN(start);
+  ret = jsvalue_converter_call(jsconverter->jsobj, jsconverter->to_model, from, to,
+                               &(jsconverter->temp));
+  JSOBJ_PROFILE_END(start, c, OBJECT(c)->name, JSOBJ_VALUE_CONVERTER_TO_VIEW_MODEL);
+
+  return ret;
+}
+
+static jerry_value_t value_converter_jerryscript_get_map_func(void) {
+  if (!jerry_value_is_function(s_map_func)) {
+    const char* name = "value_converter_map";
+    const char* code = VALUE_CONVERTER_JERRYSCRIPT_MAP;
+    jerry_value_t jscode = jerry_parse((const jerry_char_t*)name, strlen(name),
+                                       (const jerry_char_t*)code, strlen(code), JERRY_PARSE_NO_OPTS);
+
+    if (!jerry_value_is_error(jscode)) {
+      s_map_func = jerry_run(jscode);
+      if (!jerry_value_is_function(s_map_func)) {
+        jerry_release_value(s_map_func);
+        s_map_func = 0;
+      }
+    }
+    jerry_release_value(jscode);
+  }
+
+  return s_map_func;
+}
+
+static jerry_value_t value_converter_jerryscript_call_batch(
+    value_converter_jerryscript_t* jsconverter, jerry_value_t func, jerry_value_t batch_func,
+    jerry_value_t jsfrom) {
+  jerry_value_t jsret = 0;
+
+  if (jerry_value_is_function(batch_func)) {
+    jsret = jerry_call_function(batch_func, jsconverter->jsobj, &jsfrom, 1);
+  } else {
+    jerry_value_t args[3];
+    jerry_value_t jsthis = jerry_create_undefined();
+
+    args[0] = jsfrom;
+    args[1] = func;
+    args[2] = jsconverter->jsobj;
+    jsret = jerry_call_function(value_converter_jerryscript_get_map_func(), jsthis, args, 3);
+    jerry_release_value(jsthis);
+  }
+
+  return jsret;
+}
+
+static ret_t value_converter_jerryscript_batch(value_converter_jerryscript_t* jsconverter,
+                                               jerry_value_t func, jerry_value_t batch_func,
+                                               const value_t* from, value_t* to, uint32_t nr) {
+  value_t v;
+  uint32_t i = 0;
+  ret_t ret = RET_OK;
+  jerry_value_t jsret = 0;
+  jerry_value_t jsfrom = 0;
+  str_t* temp = &(jsconverter->temp);
+
+  if (!jerry_value_is_function(func) && !jerry_value_is_function(batch_func)) {
+    return RET_NOT_IMPL;
+  }
+
+  jsfrom = jerry_create_array(nr);
+  for (i = 0; i < nr; i++) {
+    jerry_value_t item = jerry_value_from_value(from + i, temp);
+    jerry_release_value(jerry_set_property_by_index(jsfrom, i, item));
+    jerry_release_value(item);
+  }
+
+  jsret = value_converter_jerryscript_call_batch(jsconverter, func, batch_func, jsfrom);
+  if (jerry_value_is_error(jsret) || !jerry_value_is_array(jsret) ||
+      jerry_get_array_length(jsret) != nr) {
+    ret = RET_FAIL;
+  }
+
+  for (i = 0; i < nr && ret == RET_OK; i++) {
+    jerry_value_t item = jerry_get_property_by_index(jsret, i);
+
+    ret = jerry_value_to_value(item, &v, temp);
+    if (ret == RET_OK) {
+      ret = value_converter_hold_result(to + i, &v);
+      if (ret != RET_OK) {
+        value_reset(&v);
+      }
+    }
+    jerry_release_value(item);
+
+    if (ret != RET_OK) {
+      while (i-- > 0) {
+        value_reset(to + i);
+      }
+      break;
+    }
+  }
+
+  jerry_release_value(jsret);
+  jerry_release_value(jsfrom);
+
+  return ret;
+}
+
+static ret_t value_converter_jerryscript_to_view_batch(value_converter_t* c, const value_t* from,
+                                                       value_t* to, uint32_t nr) {
+  ret_t ret = RET_OK;
   value_converter_jerryscript_t* jsconverter = VALUE_CONVERTER_JERRYSCRIPT(c);
 
-  return jsvalue_converter_to_model(obj->name, from, to, &(jsconverter->temp));
+  value_converter_jerryscript_resolve(jsconverter);
+
+  JSOBJ_PROFILE_BEGIN(start);
+  ret = value_converter_jerryscript_batch(jsconverter, jsconverter->to_view,
+                                          jsconverter->to_view_batch, from, to, nr);
+  JSOBJ_PROFILE_END(start, c, OBJECT(c)->name, JSOBJ_VALUE_CONVERTER_TO_VIEW_BATCH);
+
+  return ret;
+}
+
+static ret_t value_converter_jerryscript_to_model_batch(value_converter_t* c, const value_t* from,
+                                                        value_t* to, uint32_t nr) {
+  ret_t ret = RET_OK;
+  value_converter_jerryscript_t* jsconverter = VALUE_CONVERTER_JERRYSCRIPT(c);
+
+  value_converter_jerryscript_resolve(jsconverter);
+
+  JSOBJ_PROFILE_BEGIN(start);
+  ret = value_converter_jerryscript_batch(jsconverter, jsconverter->to_model,
+                                          jsconverter->to_model_batch, from, to, nr);
+  JSOBJ_PROFILE_END(start, c, OBJECT(c)->name, JSOBJ_VALUE_CONVERTER_TO_VIEW_MODEL_BATCH);
+
+  return ret;
 }
 
 static value_converter_t* value_converter_jerryscript_create(const char* name) {
@@ -68,19 +251,37 @@ static value_converter_t* value_converter_jerryscript_create(const char* name) {
   value_convert = VALUE_CONVERTER(obj);
   value_convert->to_view = value_converter_jerryscript_to_view;
   value_convert->to_model = value_converter_jerryscript_to_model;
+  value_convert->to_view_batch = value_converter_jerryscript_to_view_batch;
+  value_convert->to_model_batch = value_converter_jerryscript_to_model_batch;
 
   jsconverter = VALUE_CONVERTER_JERRYSCRIPT(obj);
   str_init(&(jsconverter->temp), 0);
 
   object_set_name(obj, name);
+  value_converter_jerryscript_resolve(jsconverter);
+  darray_push(&s_converters, jsconverter);
 
   return value_convert;
 }
 
 ret_t value_converter_jerryscript_init(void) {
+  darray_init(&s_converters, 10, NULL, NULL);
+
   return value_converter_register_generic(value_converter_jerryscript_create);
 }
 
+static ret_t value_converter_jerryscript_release_visit(void* ctx, const void* data) {
+  return value_converter_jerryscript_release(VALUE_CONVERTER_JERRYSCRIPT(data));
+}
+
 ret_t value_converter_jerryscript_deinit(void) {
+  darray_foreach(&s_converters, value_converter_jerryscript_release_visit, NULL);
+  darray_deinit(&s_converters);
+
+  if (jerry_value_is_function(s_map_func)) {
+    jerry_release_value(s_map_func);
+  }
+  s_map_func = 0;
+
   return RET_OK;
 }
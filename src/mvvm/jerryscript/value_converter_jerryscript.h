@@ -36,12 +36,23 @@ BEGIN_C_DECLS
  *
  * JS的全局对象ValueConverters，记录了所有的ValueConverter。
  *
+ * 批量转换时，如果JS的ValueConverter提供了toViewBatch/toModelBatch，用数组调用它们，
+ * 否则在JS中用Array.prototype.map调用toView/toModel，整批数据只需要进出脚本引擎一次。
+ *
  */
 typedef struct _value_converter_jerryscript_t {
   value_converter_t value_converter;
 
   /*private*/
   str_t temp;
+
+  /*创建时解析的JS函数，加载新的JS代码后重新解析(version为0表示没有解析)*/
+  uint32_t version;
+  jerry_value_t jsobj;
+  jerry_value_t to_view;
+  jerry_value_t to_model;
+  jerry_value_t to_view_batch;
+  jerry_value_t to_model_batch;
 } value_converter_jerryscript_t;
 
 #define VALUE_CONVERTER_JERRYSCRIPT(c) ((value_converter_jerryscript_t*)c)
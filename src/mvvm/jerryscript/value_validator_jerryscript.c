@@ -26,22 +26,76 @@
 #include "mvvm/jerryscript/jsobj.h"
 #include "mvvm/jerryscript/value_validator_jerryscript.h"
 
+/*所有存活的JS validator，jerry_cleanup之前需要释放它们持有的JS对象*/
+static darray_t s_validators;
+
+static ret_t value_validator_jerryscript_release(value_validator_jerryscript_t* jsvalidator) {
+  if (jsvalidator->version != 0) {
+    jerry_release_value(jsvalidator->jsobj);
+    jerry_release_value(jsvalidator->is_valid);
+    jerry_release_value(jsvalidator->fix);
+    jsvalidator->version = 0;
+  }
+
+  return RET_OK;
+}
+
+static ret_t value_validator_jerryscript_resolve(value_validator_jerryscript_t* jsvalidator) {
+  uint32_t version = jsobj_get_code_version();
+
+  if (jsvalidator->version != version) {
+    value_validator_jerryscript_release(jsvalidator);
+
+    jsvalidator->jsobj = jsvalue_validator_get(OBJECT(jsvalidator)->name);
+    jsvalidator->is_valid =
+        jsobj_get_prop_value(jsvalidator->jsobj, JSOBJ_VALUE_VALIDATOR_IS_VALID);
+    jsvalidator->fix = jsobj_get_prop_value(jsvalidator->jsobj, JSOBJ_VALUE_VALIDATOR_FIX);
+    jsvalidator->version = version;
+  }
+
+  return RET_OK;
+}
+
+static ret_t value_validator_jerryscript_on_destroy(object_t* obj) {
+  value_validator_jerryscript_t* jsvalidator = VALUE_VALIDATOR_JERRYSCRIPT(obj);
+
+  value_validator_jerryscript_release(jsvalidator);
+  darray_remove(&s_validators, jsvalidator);
+
+  return RET_OK;
+}
+
 static const object_vtable_t s_value_validator_jerryscript_vtable = {
     .type = "value_validator_jerryscript",
     .desc = "value_validator_jerryscript",
-    .size = sizeof(value_validator_jerryscript_t)};
+    .size = sizeof(value_validator_jerryscript_t),
+    .on_destroy = value_validator_jerryscript_on_destroy};
 
 static bool_t value_validator_jerryscript_is_valid(value_validator_t* c, const value_t* v,
                                                    str_t* msg) {
-  object_t* obj = OBJECT(c);
+  ret_t ret = RET_OK;
+  value_validator_jerryscript_t* jsvalidator = VALUE_VALIDATOR_JERRYSCRIPT(c);
 
-  return jsvalue_validator_is_valid(obj->name, v, msg) == RET_OK;
+  value_validator_jerryscript_resolve(jsvalidator);
+
+  JSOBJ_PROFILE_BEGIN(start);
+  ret = jsvalue_validator_call_is_valid(jsvalidator->jsobj, jsvalidator->is_valid, v, msg);
+  JSOBJ_PROFILE_END(start, c, OBJECT(c)->name, JSOBJ_VALUE_VALIDATOR_IS_VALID);
+
+  return ret == RET_OK;
 }
 
 static ret_t value_validator_jerryscript_fix(value_validator_t* c, value_t* v) {
-  object_t* obj = OBJECT(c);
+  ret_t ret = RET_OK;
+  value_validator_jerryscript_t* jsvalidator = VALUE_VALIDATOR_JERRYSCRIPT(c);
+
+  value_validator_jerryscript_resolve(jsvalidator);
 
-  return jsvalue_validator_fix(obj->name, v);
+  JSOBJ_PROFILE_BEGIN(start);
+  ret = jsvalue_validator_call_fix(jsvalidator->jsobj, jsvalidator->fix, v);
+  JSOBJ_PROFILE_END(start, c, OBJECT(c)->name, JSOBJ_VALUE_VALIDATOR_FIX);
+
+  return ret;
 }
 
 static value_validator_t* value_validator_jerryscript_create(const char* name) {
@@ -57,13 +111,25 @@ static value_validator_t* value_validator_jerryscript_create(const char* name) {
   validator->fix = value_validator_jerryscript_fix;
   object_set_name(obj, name);
 
+  value_validator_jerryscript_resolve(VALUE_VALIDATOR_JERRYSCRIPT(obj));
+  darray_push(&s_validators, obj);
+
   return validator;
 }
 
 ret_t value_validator_jerryscript_init(void) {
+  darray_init(&s_validators, 10, NULL, NULL);
+
   return value_validator_register_generic(value_validator_jerryscript_create);
 }
 
+static ret_t value_validator_jerryscript_release_visit(void* ctx, const void* data) {
+  return value_validator_jerryscript_release(VALUE_VALIDATOR_JERRYSCRIPT(data));
+}
+
 ret_t value_validator_jerryscript_deinit(void) {
+  darray_foreach(&s_validators, value_validator_jerryscript_release_visit, NULL);
+  darray_deinit(&s_validators);
+
   return RET_OK;
 }
@@ -23,6 +23,7 @@
 #define TK_VALUE_VALIDATOR_JERRYSCRIPT_H
 
 #include "tkc/str.h"
+#include "jerryscript.h"
 #include "mvvm/base/value_validator.h"
 
 BEGIN_C_DECLS
@@ -38,6 +39,13 @@ BEGIN_C_DECLS
  */
 typedef struct _value_validator_jerryscript_t {
   value_validator_t value_validator;
+
+  /*private*/
+  /*创建时解析的JS函数，加载新的JS代码后重新解析(version为0表示没有解析)*/
+  uint32_t version;
+  jerry_value_t jsobj;
+  jerry_value_t is_valid;
+  jerry_value_t fix;
 } value_validator_jerryscript_t;
 
 #define VALUE_VALIDATOR_JERRYSCRIPT(c) ((value_validator_jerryscript_t*)c)
@@ -0,0 +1,199 @@
+﻿/**
+ * File:   view_model_array_index_jerryscript.c
+ * Author: AWTK Develop Team
+ * Brief:  collection search index for jerryscript
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#include "tkc/utils.h"
+#include "jerryscript-ext/handler.h"
+#include "mvvm/jerryscript/jsobj.h"
+#include "mvvm/jerryscript/view_model_array_index_jerryscript.h"
+
+static view_model_array_index_t* view_model_array_index_jerryscript_get(jerry_value_t value,
+                                                                        object_t** obj) {
+  *obj = jerry_value_to_object(value);
+
+  return *obj != NULL ? view_model_array_index_cast(*obj) : NULL;
+}
+
+static const char* view_model_array_index_jerryscript_get_key(jerry_value_t value, str_t* temp) {
+  const char* key = NULL;
+
+  if (jerry_value_is_string(value)) {
+    key = jerry_get_utf8_value(value, temp);
+  } else {
+    jerry_value_t str = jerry_value_to_string(value);
+
+    key = jerry_value_is_error(str) ? NULL : jerry_get_utf8_value(str, temp);
+    jerry_release_value(str);
+  }
+
+  return key != NULL ? key : "";
+}
+
+static jerry_value_t wrap_view_model_array_index_insert(const jerry_value_t func_obj_val,
+                                                        const jerry_value_t this_p,
+                                                        const jerry_value_t args_p[],
+                                                        const jerry_length_t args_cnt) {
+  str_t str;
+  object_t* obj = NULL;
+  ret_t ret = RET_BAD_PARAMS;
+  view_model_array_index_t* index = view_model_array_index_jerryscript_get(this_p, &obj);
+
+  str_init(&str, 0);
+  if (index != NULL && args_cnt >= 2) {
+    uint32_t row = (uint32_t)jerry_get_number_value(args_p[0]);
+    ret = view_model_array_index_insert(
+        index, row, view_model_array_index_jerryscript_get_key(args_p[1], &str));
+  }
+  str_reset(&str);
+  object_unref(obj);
+
+  return jerry_create_number(ret);
+}
+
+static jerry_value_t wrap_view_model_array_index_update(const jerry_value_t func_obj_val,
+                                                        const jerry_value_t this_p,
+                                                        const jerry_value_t args_p[],
+                                                        const jerry_length_t args_cnt) {
+  str_t str;
+  object_t* obj = NULL;
+  ret_t ret = RET_BAD_PARAMS;
+  view_model_array_index_t* index = view_model_array_index_jerryscript_get(this_p, &obj);
+
+  str_init(&str, 0);
+  if (index != NULL && args_cnt >= 2) {
+    uint32_t row = (uint32_t)jerry_get_number_value(args_p[0]);
+    ret = view_model_array_index_update(
+        index, row, view_model_array_index_jerryscript_get_key(args_p[1], &str));
+  }
+  str_reset(&str);
+  object_unref(obj);
+
+  return jerry_create_number(ret);
+}
+
+static jerry_value_t wrap_view_model_array_index_remove(const jerry_value_t func_obj_val,
+                                                        const jerry_value_t this_p,
+                                                        const jerry_value_t args_p[],
+                                                        const jerry_length_t args_cnt) {
+  object_t* obj = NULL;
+  ret_t ret = RET_BAD_PARAMS;
+  view_model_array_index_t* index = view_model_array_index_jerryscript_get(this_p, &obj);
+
+  if (index != NULL && args_cnt >= 1) {
+    ret = view_model_array_index_remove(index, (uint32_t)jerry_get_number_value(args_p[0]));
+  }
+  object_unref(obj);
+
+  return jerry_create_number(ret);
+}
+
+static jerry_value_t wrap_view_model_array_index_clear(const jerry_value_t func_obj_val,
+                                                       const jerry_value_t this_p,
+                                                       const jerry_value_t args_p[],
+                                                       const jerry_length_t args_cnt) {
+  object_t* obj = NULL;
+  ret_t ret = RET_BAD_PARAMS;
+  view_model_array_index_t* index = view_model_array_index_jerryscript_get(this_p, &obj);
+
+  if (index != NULL) {
+    ret = view_model_array_index_clear(index);
+  }
+  object_unref(obj);
+
+  return jerry_create_number(ret);
+}
+
+static jerry_value_t wrap_view_model_array_index_size(const jerry_value_t func_obj_val,
+                                                      const jerry_value_t this_p,
+                                                      const jerry_value_t args_p[],
+                                                      const jerry_length_t args_cnt) {
+  uint32_t size = 0;
+  object_t* obj = NULL;
+  view_model_array_index_t* index = view_model_array_index_jerryscript_get(this_p, &obj);
+
+  if (index != NULL) {
+    size = index->rows;
+  }
+  object_unref(obj);
+
+  return jerry_create_number(size);
+}
+
+static jerry_value_t wrap_view_model_array_index_search(const jerry_value_t func_obj_val,
+                                                        const jerry_value_t this_p,
+                                                        const jerry_value_t args_p[],
+                                                        const jerry_length_t args_cnt) {
+  str_t str;
+  uint32_t i = 0;
+  object_t* obj = NULL;
+  jerry_value_t result = 0;
+  view_model_array_index_t* index = view_model_array_index_jerryscript_get(this_p, &obj);
+
+  str_init(&str, 0);
+  if (index != NULL && args_cnt >= 1) {
+    bool_t substring = args_cnt >= 2 ? jerry_value_to_boolean(args_p[1]) : FALSE;
+    const char* query = view_model_array_index_jerryscript_get_key(args_p[0], &str);
+
+    if (view_model_array_index_search(index, query, substring) == RET_OK) {
+      result = jerry_create_array(index->result_nr);
+
+      for (i = 0; i < index->result_nr; i++) {
+        jerry_value_t row = jerry_create_number(index->result[i]);
+        jerry_release_value(jerry_set_property_by_index(result, i, row));
+        jerry_release_value(row);
+      }
+    }
+  }
+  str_reset(&str);
+  object_unref(obj);
+
+  return result != 0 ? result : jerry_create_array(0);
+}
+
+static jerry_value_t wrap_create_array_index(const jerry_value_t func_obj_val,
+                                             const jerry_value_t this_p,
+                                             const jerry_value_t args_p[],
+                                             const jerry_length_t args_cnt) {
+  jerry_value_t jsobj = 0;
+  view_model_array_index_t* index = NULL;
+  bool_t trigram = args_cnt >= 1 ? jerry_value_to_boolean(args_p[0]) : FALSE;
+
+  index = view_model_array_index_create(trigram);
+  return_value_if_fail(index != NULL, jerry_create_null());
+
+  jsobj = jerry_value_from_object(OBJECT(index));
+  object_unref(OBJECT(index));
+
+  jsobj_set_prop_func(jsobj, "insert", wrap_view_model_array_index_insert);
+  jsobj_set_prop_func(jsobj, "update", wrap_view_model_array_index_update);
+  jsobj_set_prop_func(jsobj, "remove", wrap_view_model_array_index_remove);
+  jsobj_set_prop_func(jsobj, "clear", wrap_view_model_array_index_clear);
+  jsobj_set_prop_func(jsobj, "size", wrap_view_model_array_index_size);
+  jsobj_set_prop_func(jsobj, "search", wrap_view_model_array_index_search);
+
+  return jsobj;
+}
+
+ret_t view_model_array_index_jerryscript_init(void) {
+  jerryx_handler_register_global((const jerry_char_t*)"createArrayIndex",
+                                 wrap_create_array_index);
+
+  return RET_OK;
+}
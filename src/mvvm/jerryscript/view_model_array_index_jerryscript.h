@@ -0,0 +1,44 @@
+﻿/**
+ * File:   view_model_array_index_jerryscript.h
+ * Author: AWTK Develop Team
+ * Brief:  collection search index for jerryscript
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#ifndef TK_VIEW_MODEL_ARRAY_INDEX_JERRYSCRIPT_H
+#define TK_VIEW_MODEL_ARRAY_INDEX_JERRYSCRIPT_H
+
+#include "jerryscript.h"
+#include "mvvm/base/view_model_array_index.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @method view_model_array_index_jerryscript_init
+ * 注册JS函数createArrayIndex(trigram)。
+ *
+ * 它返回的JS对象包装了view_model_array_index_t，由JS集合模型在增删改时同步维护：
+ * insert(row, key)/remove(row)/update(row, key)/clear()/size()，
+ * search(query, substring)返回匹配的行号数组(升序)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_index_jerryscript_init(void);
+
+END_C_DECLS
+
+#endif /*TK_VIEW_MODEL_ARRAY_INDEX_JERRYSCRIPT_H*/
@@ -25,10 +25,100 @@
 #include "mvvm/jerryscript/jsobj.h"
 #include "mvvm/jerryscript/view_model_array_jerryscript.h"
 
+static ret_t view_model_array_jerryscript_invalidate_rows(
+    view_model_array_jerryscript_t* view_modeljs) {
+  uint32_t i = 0;
+
+  if (view_modeljs->rows_valid) {
+    for (i = 0; i < view_modeljs->rows_size; i++) {
+      jerry_release_value(view_modeljs->rows[i]);
+    }
+    view_modeljs->rows_size = 0;
+    view_modeljs->rows_valid = FALSE;
+  }
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_jerryscript_ensure_rows(
+    view_model_array_jerryscript_t* view_modeljs) {
+  uint32_t i = 0;
+  uint32_t size = 0;
+
+  if (view_modeljs->rows_valid) {
+    return RET_OK;
+  }
+
+  size = jerry_get_array_length(view_modeljs->jsobj);
+  if (size > view_modeljs->rows_capacity) {
+    jerry_value_t* rows =
+        (jerry_value_t*)TKMEM_REALLOC(view_modeljs->rows, size * sizeof(jerry_value_t));
+    return_value_if_fail(rows != NULL, RET_OOM);
+
+    view_modeljs->rows = rows;
+    view_modeljs->rows_capacity = size;
+  }
+
+  /*行对象在第一次访问时才获取*/
+  for (i = 0; i < size; i++) {
+    view_modeljs->rows[i] = jerry_create_undefined();
+  }
+  view_modeljs->rows_size = size;
+  view_modeljs->rows_valid = TRUE;
+
+  return RET_OK;
+}
+
+static uint32_t view_model_array_jerryscript_get_size(
+    view_model_array_jerryscript_t* view_modeljs) {
+  if (view_modeljs->updating > 0 &&
+      view_model_array_jerryscript_ensure_rows(view_modeljs) == RET_OK) {
+    return view_modeljs->rows_size;
+  } else {
+    return jerry_get_array_length(view_modeljs->jsobj);
+  }
+}
+
+/*刷新过程中返回缓存的行对象，否则(或者缓存分配失败时)直接读取。调用者用put_row归还*/
+static jerry_value_t view_model_array_jerryscript_get_row(
+    view_model_array_jerryscript_t* view_modeljs, uint32_t index, bool_t* cached) {
+  *cached = view_modeljs->updating > 0 &&
+            view_model_array_jerryscript_ensure_rows(view_modeljs) == RET_OK &&
+            index < view_modeljs->rows_size;
+
+  if (!(*cached)) {
+    return jerry_get_property_by_index(view_modeljs->jsobj, index);
+  }
+
+  if (jerry_value_is_undefined(view_modeljs->rows[index])) {
+    view_modeljs->rows[index] = jerry_get_property_by_index(view_modeljs->jsobj, index);
+  }
+
+  return view_modeljs->rows[index];
+}
+
+static ret_t view_model_array_jerryscript_put_row(view_model_array_jerryscript_t* view_modeljs,
+                                                  jerry_value_t row, bool_t cached) {
+  if (!cached) {
+    jerry_release_value(row);
+  }
+
+  return RET_OK;
+}
+
+static ret_t view_model_array_jerryscript_on_changed(void* ctx, event_t* e) {
+  view_model_array_jerryscript_invalidate_rows(VIEW_MODEL_ARRAY_JERRYSCRIPT(ctx));
+
+  return RET_OK;
+}
+
 static ret_t view_model_array_jerryscript_on_destroy(object_t* obj) {
   view_model_array_jerryscript_t* view_modeljs = VIEW_MODEL_ARRAY_JERRYSCRIPT(obj);
 
+  view_model_array_jerryscript_invalidate_rows(view_modeljs);
+  TKMEM_FREE(view_modeljs->rows);
   str_reset(&(view_modeljs->temp));
+  jsobj_method_cache_deinit(&(view_modeljs->methods));
   view_model_array_deinit(VIEW_MODEL(obj));
   ;
   jerry_release_value(view_modeljs->jsobj);
@@ -56,7 +146,8 @@ static ret_t view_model_array_jerryscript_set_prop(object_t* obj, const char* na
 
   name = destruct_array_prop_name(name, &index);
   return_value_if_fail(name != NULL, RET_BAD_PARAMS);
-  return_value_if_fail(index < jerry_get_array_length(view_modeljs->jsobj), RET_BAD_PARAMS);
+  return_value_if_fail(index < view_model_array_jerryscript_get_size(view_modeljs),
+                       RET_BAD_PARAMS);
 
   jsprop = jerry_get_property_by_index(view_modeljs->jsobj, index);
   ret = jsobj_set_prop(jsprop, name, v, &(view_modeljs->temp));
@@ -67,13 +158,14 @@ static ret_t view_model_array_jerryscript_set_prop(object_t* obj, const char* na
 
 static ret_t view_model_array_jerryscript_get_prop(object_t* obj, const char* name, value_t* v) {
   uint32_t index = 0;
+  bool_t cached = FALSE;
   jerry_value_t jsprop = 0;
   ret_t ret = RET_NOT_FOUND;
   view_model_array_jerryscript_t* view_modeljs = VIEW_MODEL_ARRAY_JERRYSCRIPT(obj);
   return_value_if_fail(obj != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
   if (tk_str_eq(VIEW_MODEL_PROP_ITEMS, name)) {
-    value_set_int(v, jerry_get_array_length(view_modeljs->jsobj));
+    value_set_int(v, view_model_array_jerryscript_get_size(view_modeljs));
 
     return RET_OK;
   } else if (tk_str_eq(VIEW_MODEL_PROP_CURSOR, name)) {
@@ -84,14 +176,13 @@ static ret_t view_model_array_jerryscript_get_prop(object_t* obj, const char* na
 
   name = destruct_array_prop_name(name, &index);
   return_value_if_fail(name != NULL, RET_BAD_PARAMS);
-  return_value_if_fail(index < jerry_get_array_length(view_modeljs->jsobj), RET_BAD_PARAMS);
+  return_value_if_fail(index < view_model_array_jerryscript_get_size(view_modeljs),
+                       RET_BAD_PARAMS);
 
   value_set_int(v, 0);
-  jsprop = jerry_get_property_by_index(view_modeljs->jsobj, index);
-  if (jsobj_has_prop(jsprop, name)) {
-    ret = jsobj_get_prop(jsprop, name, v, &(view_modeljs->temp));
-  }
-  jerry_release_value(jsprop);
+  jsprop = view_model_array_jerryscript_get_row(view_modeljs, index, &cached);
+  ret = jsobj_get_prop(jsprop, name, v, &(view_modeljs->temp));
+  view_model_array_jerryscript_put_row(view_modeljs, jsprop, cached);
 
   return ret;
 }
@@ -101,14 +192,14 @@ static bool_t view_model_array_jerryscript_can_exec(object_t* obj, const char* n
   view_model_array_jerryscript_t* view_modeljs = VIEW_MODEL_ARRAY_JERRYSCRIPT(obj);
   return_value_if_fail(obj != NULL && name != NULL, RET_BAD_PARAMS);
 
-  return jsobj_can_exec(view_modeljs->jsobj, name, args);
+  return jsobj_method_cache_can_exec(&(view_modeljs->methods), view_modeljs->jsobj, name, args);
 }
 
 static ret_t view_model_array_jerryscript_exec(object_t* obj, const char* name, const char* args) {
   view_model_array_jerryscript_t* view_modeljs = VIEW_MODEL_ARRAY_JERRYSCRIPT(obj);
   return_value_if_fail(obj != NULL && name != NULL, RET_BAD_PARAMS);
 
-  return jsobj_exec(view_modeljs->jsobj, name, args);
+  return jsobj_method_cache_exec(&(view_modeljs->methods), view_modeljs->jsobj, name, args);
 }
 
 static const object_vtable_t s_obj_view_model_array_jerryscript_vtable = {
@@ -129,7 +220,8 @@ static ret_t view_model_jerryscript_on_will_mount(view_model_t* view_model,
   view_model_array_jerryscript_t* view_modeljs = VIEW_MODEL_ARRAY_JERRYSCRIPT(view_model);
   jerry_value_t jsargs = jerry_value_from_navigator_request(req);
 
-  ret_t ret = jsobj_exec_ex(view_modeljs->jsobj, "onWillMount", jsargs);
+  ret_t ret = jsobj_method_cache_exec_ex(&(view_modeljs->methods), view_modeljs->jsobj,
+                                         "onWillMount", jsargs);
   jerry_release_value(jsargs);
 
   return ret;
@@ -138,26 +230,56 @@ static ret_t view_model_jerryscript_on_will_mount(view_model_t* view_model,
 static ret_t view_model_jerryscript_on_mount(view_model_t* view_model) {
   view_model_array_jerryscript_t* view_modeljs = VIEW_MODEL_ARRAY_JERRYSCRIPT(view_model);
 
-  return jsobj_exec(view_modeljs->jsobj, "onMount", NULL);
+  return jsobj_method_cache_exec(&(view_modeljs->methods), view_modeljs->jsobj, "onMount", NULL);
 }
 
 static ret_t view_model_jerryscript_on_will_unmount(view_model_t* view_model) {
   view_model_array_jerryscript_t* view_modeljs = VIEW_MODEL_ARRAY_JERRYSCRIPT(view_model);
 
-  return jsobj_exec(view_modeljs->jsobj, "onWillUnmount", NULL);
+  return jsobj_method_cache_exec(&(view_modeljs->methods), view_modeljs->jsobj, "onWillUnmount",
+                                 NULL);
 }
 
 static ret_t view_model_jerryscript_on_unmount(view_model_t* view_model) {
   view_model_array_jerryscript_t* view_modeljs = VIEW_MODEL_ARRAY_JERRYSCRIPT(view_model);
 
-  return jsobj_exec(view_modeljs->jsobj, "onUnmount", NULL);
+  return jsobj_method_cache_exec(&(view_modeljs->methods), view_modeljs->jsobj, "onUnmount", NULL);
+}
+
+static ret_t view_model_jerryscript_begin_update(view_model_t* view_model) {
+  view_model_array_jerryscript_t* view_modeljs = VIEW_MODEL_ARRAY_JERRYSCRIPT(view_model);
+
+  view_modeljs->updating++;
+
+  return RET_OK;
+}
+
+static ret_t view_model_jerryscript_end_update(view_model_t* view_model) {
+  view_model_array_jerryscript_t* view_modeljs = VIEW_MODEL_ARRAY_JERRYSCRIPT(view_model);
+  return_value_if_fail(view_modeljs->updating > 0, RET_BAD_PARAMS);
+
+  view_modeljs->updating--;
+  if (view_modeljs->updating == 0) {
+    view_model_array_jerryscript_invalidate_rows(view_modeljs);
+  }
+
+  return RET_OK;
+}
+
+static ret_t view_model_jerryscript_get_row_props(view_model_t* view_model, uint32_t index,
+                                                  const char** names, value_t* values,
+                                                  uint32_t nr) {
+  return view_model_array_jerryscript_get_row_props(view_model, index, names, values, nr);
 }
 
 const static view_model_vtable_t s_view_model_jerryscript_vtable = {
     .on_will_mount = view_model_jerryscript_on_will_mount,
     .on_mount = view_model_jerryscript_on_mount,
     .on_will_unmount = view_model_jerryscript_on_will_unmount,
-    .on_unmount = view_model_jerryscript_on_unmount};
+    .on_unmount = view_model_jerryscript_on_unmount,
+    .begin_update = view_model_jerryscript_begin_update,
+    .end_update = view_model_jerryscript_end_update,
+    .get_row_props = view_model_jerryscript_get_row_props};
 
 view_model_t* view_model_array_jerryscript_create(jerry_value_t jsobj) {
   object_t* obj = object_create(&s_obj_view_model_array_jerryscript_vtable);
@@ -166,8 +288,49 @@ view_model_t* view_model_array_jerryscript_create(jerry_value_t jsobj) {
 
   view_modeljs->jsobj = jsobj;
   str_init(&(view_modeljs->temp), 0);
+  jsobj_method_cache_init(&(view_modeljs->methods));
   view_model_array_init(VIEW_MODEL(obj));
   VIEW_MODEL(view_modeljs)->vt = &s_view_model_jerryscript_vtable;
 
+  emitter_on(EMITTER(obj), EVT_ITEMS_CHANGED, view_model_array_jerryscript_on_changed, obj);
+  emitter_on(EMITTER(obj), EVT_PROPS_CHANGED, view_model_array_jerryscript_on_changed, obj);
+
   return VIEW_MODEL(obj);
 }
+
+ret_t view_model_array_jerryscript_reload_methods(view_model_t* view_model) {
+  view_model_array_jerryscript_t* view_modeljs = VIEW_MODEL_ARRAY_JERRYSCRIPT(view_model);
+  return_value_if_fail(view_modeljs != NULL, RET_BAD_PARAMS);
+
+  return jsobj_method_cache_clear(&(view_modeljs->methods));
+}
+
+ret_t view_model_array_jerryscript_get_row_props(view_model_t* view_model, uint32_t index,
+                                                 const char** names, value_t* values,
+                                                 uint32_t nr) {
+  value_t v;
+  uint32_t i = 0;
+  bool_t cached = FALSE;
+  jerry_value_t row = 0;
+  view_model_array_jerryscript_t* view_modeljs = VIEW_MODEL_ARRAY_JERRYSCRIPT(view_model);
+  return_value_if_fail(view_modeljs != NULL && names != NULL && values != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(index < view_model_array_jerryscript_get_size(view_modeljs),
+                       RET_BAD_PARAMS);
+
+  row = view_model_array_jerryscript_get_row(view_modeljs, index, &cached);
+  for (i = 0; i < nr; i++) {
+    value_set_int(&v, 0);
+    memset(values + i, 0x00, sizeof(value_t));
+
+    if (jsobj_get_prop(row, names[i], &v, &(view_modeljs->temp)) == RET_OK) {
+      if (v.type == VALUE_TYPE_STRING) {
+        value_dup_str(values + i, value_str(&v));
+      } else {
+        values[i] = v;
+      }
+    }
+  }
+  view_model_array_jerryscript_put_row(view_modeljs, row, cached);
+
+  return RET_OK;
+}
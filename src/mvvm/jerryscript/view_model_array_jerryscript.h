@@ -24,6 +24,7 @@
 
 #include "tkc/str.h"
 #include "jerryscript.h"
+#include "mvvm/jerryscript/jsobj.h"
 #include "mvvm/base/view_model_array.h"
 
 BEGIN_C_DECLS
@@ -46,6 +47,16 @@ struct _model_jerryscript_array_t {
 
   /*避免每次动态分配内存*/
   str_t temp;
+
+  /*缓存已解析的命令函数*/
+  jsobj_method_cache_t methods;
+
+  /*刷新过程中(begin_update/end_update之间)缓存数组长度和行对象，items/props改变时失效*/
+  uint32_t updating;
+  bool_t rows_valid;
+  uint32_t rows_size;
+  uint32_t rows_capacity;
+  jerry_value_t* rows;
 };
 
 /**
@@ -58,6 +69,34 @@ struct _model_jerryscript_array_t {
  */
 view_model_t* view_model_array_jerryscript_create(jerry_value_t jsobj);
 
+/**
+ * @method view_model_array_jerryscript_reload_methods
+ * JS对象的方法改变后，清除缓存的命令函数，下次执行时重新解析。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_jerryscript_reload_methods(view_model_t* view_model);
+
+/**
+ * @method view_model_array_jerryscript_get_row_props
+ * 一次读取指定行的多个属性(只获取一次行对象)。
+ * 字符串类型的值会复制一份，调用者需要调用value_reset释放values中的每一项。
+ * 读取失败的项，类型为VALUE_TYPE_INVALID。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} index 行的序数。
+ * @param {const char**} names 属性名数组(不带"[index]."前缀)。
+ * @param {value_t*} values 用于返回属性值的数组。
+ * @param {uint32_t} nr 属性的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_array_jerryscript_get_row_props(view_model_t* view_model, uint32_t index,
+                                                 const char** names, value_t* values,
+                                                 uint32_t nr);
+
 #define VIEW_MODEL_ARRAY_JERRYSCRIPT(view_model) ((view_model_array_jerryscript_t*)(view_model))
 
 END_C_DECLS
@@ -21,7 +21,9 @@
 
 #include "tkc/mem.h"
 #include "tkc/utils.h"
+#include "mvvm/base/navigator_trace.h"
 #include "mvvm/jerryscript/jsobj.h"
+#include "mvvm/jerryscript/mvvm_jerryscript.h"
 #include "mvvm/jerryscript/view_model_jerryscript.h"
 #include "mvvm/jerryscript/view_model_array_jerryscript.h"
 #include "mvvm/jerryscript/view_model_normal_jerryscript.h"
@@ -108,18 +110,47 @@ ret_t view_model_jerryscript_load(const char* name, const char* code, uint32_t c
       ret = RET_OK;
     }
     jerry_release_value(jsret);
+    jsobj_inc_code_version();
   }
   jerry_release_value(jscode);
 
   return ret;
 }
 
-#define STR_NATIVE_MODEL "nativeModel"
+ret_t view_model_jerryscript_load_snapshot(const char* name, const void* data, uint32_t size) {
+  ret_t ret = RET_FAIL;
+  jerry_value_t jsret = 0;
+  const uint32_t* snapshot = (const uint32_t*)data;
+  return_value_if_fail(name != NULL && data != NULL && size > 0, RET_BAD_PARAMS);
+
+  /*snapshot的数据需要4字节对齐*/
+  if ((tk_pointer_to_int(data) & 0x03) != 0) {
+    uint32_t* buff = (uint32_t*)TKMEM_ALLOC(size);
+    return_value_if_fail(buff != NULL, RET_OOM);
+
+    memcpy(buff, data, size);
+    ret = view_model_jerryscript_load_snapshot(name, buff, size);
+    TKMEM_FREE(buff);
+
+    return ret;
+  }
+
+  jsret = jerry_exec_snapshot(snapshot, size, 0, JERRY_SNAPSHOT_EXEC_COPY_DATA);
+  if (jerry_value_is_error(jsret)) {
+    log_warn("%s: snapshot of %s is invalid or mismatch with the engine\n", __FUNCTION__, name);
+  } else {
+    ret = RET_OK;
+    jsobj_inc_code_version();
+  }
+  jerry_release_value(jsret);
+
+  return ret;
+}
 
 jerry_value_t wrap_notify_props_changed(const jerry_value_t func_obj_val,
                                         const jerry_value_t this_p, const jerry_value_t args_p[],
                                         const jerry_length_t args_cnt) {
-  object_t* obj = OBJECT(jsobj_get_prop_pointer(this_p, STR_NATIVE_MODEL));
+  object_t* obj = OBJECT(jsobj_get_prop_pointer(this_p, JSOBJ_NATIVE_MODEL));
 
   return jerry_create_number(object_notify_changed(obj));
 }
@@ -127,18 +158,33 @@ jerry_value_t wrap_notify_props_changed(const jerry_value_t func_obj_val,
 jerry_value_t wrap_notify_items_changed(const jerry_value_t func_obj_val,
                                         const jerry_value_t this_p, const jerry_value_t args_p[],
                                         const jerry_length_t args_cnt) {
-  object_t* obj = OBJECT(jsobj_get_prop_pointer(this_p, STR_NATIVE_MODEL));
+  object_t* obj = OBJECT(jsobj_get_prop_pointer(this_p, JSOBJ_NATIVE_MODEL));
 
   return jerry_create_number(view_model_array_notify_items_changed(VIEW_MODEL(obj)));
 }
 
-view_model_t* view_model_jerryscript_create(const char* name, const char* code, uint32_t code_size,
-                                            navigator_request_t* req) {
+jerry_value_t wrap_notify_methods_changed(const jerry_value_t func_obj_val,
+                                          const jerry_value_t this_p, const jerry_value_t args_p[],
+                                          const jerry_length_t args_cnt) {
+  object_t* obj = OBJECT(jsobj_get_prop_pointer(this_p, JSOBJ_NATIVE_MODEL));
+
+  return jerry_create_number(view_model_jerryscript_reload_methods(VIEW_MODEL(obj)));
+}
+
+ret_t view_model_jerryscript_reload_methods(view_model_t* view_model) {
+  return_value_if_fail(view_model != NULL, RET_BAD_PARAMS);
+
+  if (object_is_collection(OBJECT(view_model))) {
+    return view_model_array_jerryscript_reload_methods(view_model);
+  } else {
+    return view_model_normal_jerryscript_reload_methods(view_model);
+  }
+}
+
+static view_model_t* view_model_jerryscript_create_model(const char* name,
+                                                         navigator_request_t* req) {
   jerry_value_t jsobj = 0;
   view_model_t* view_model = NULL;
-  return_value_if_fail(name != NULL && code != NULL && code_size > 0, NULL);
-
-  return_value_if_fail(view_model_jerryscript_load(name, code, code_size) == RET_OK, NULL);
 
   jsobj = jsobj_create_model(name, req);
   return_value_if_fail(jerry_value_is_object(jsobj), NULL);
@@ -148,14 +194,17 @@ view_model_t* view_model_jerryscript_create(const char* name, const char* code,
     view_model = view_model_array_jerryscript_create(jsobj);
     jsobj_set_prop_func(jsobj, "notifyPropsChanged", wrap_notify_props_changed);
     jsobj_set_prop_func(jsobj, "notifyItemsChanged", wrap_notify_items_changed);
+    jsobj_set_prop_func(jsobj, "notifyMethodsChanged", wrap_notify_methods_changed);
   } else {
     view_model = view_model_normal_jerryscript_create(jsobj);
     jsobj_set_prop_func(jsobj, "notifyPropsChanged", wrap_notify_props_changed);
+    jsobj_set_prop_func(jsobj, "notifyMethodsChanged", wrap_notify_methods_changed);
   }
 
   if (view_model != NULL) {
     object_set_name(OBJECT(view_model), name);
-    jsobj_set_prop_pointer(jsobj, STR_NATIVE_MODEL, OBJECT(view_model));
+    jsobj_set_prop_pointer(jsobj, JSOBJ_NATIVE_MODEL, OBJECT(view_model));
+    mvvm_jerryscript_check_heap(name);
   } else {
     jerry_release_value(jsobj);
     return NULL;
@@ -163,3 +212,23 @@ view_model_t* view_model_jerryscript_create(const char* name, const char* code,
 
   return VIEW_MODEL(view_model);
 }
+
+view_model_t* view_model_jerryscript_create(const char* name, const char* code, uint32_t code_size,
+                                            navigator_request_t* req) {
+  uint64_t start = navigator_trace_now();
+  return_value_if_fail(name != NULL && code != NULL && code_size > 0, NULL);
+  return_value_if_fail(view_model_jerryscript_load(name, code, code_size) == RET_OK, NULL);
+  navigator_trace_add(NAVIGATOR_TRACE_JS_LOAD, start);
+
+  return view_model_jerryscript_create_model(name, req);
+}
+
+view_model_t* view_model_jerryscript_create_from_snapshot(const char* name, const void* data,
+                                                          uint32_t size, navigator_request_t* req) {
+  uint64_t start = navigator_trace_now();
+  return_value_if_fail(name != NULL && data != NULL && size > 0, NULL);
+  return_value_if_fail(view_model_jerryscript_load_snapshot(name, data, size) == RET_OK, NULL);
+  navigator_trace_add(NAVIGATOR_TRACE_JS_LOAD, start);
+
+  return view_model_jerryscript_create_model(name, req);
+}
@@ -28,6 +28,9 @@
 
 BEGIN_C_DECLS
 
+/*预编译的JS代码(snapshot)作为data资源，名称为脚本名加上此扩展名*/
+#define VIEW_MODEL_JERRYSCRIPT_SNAPSHOT_EXT ".snapshot"
+
 /**
  * @method view_model_jerryscript_create
  * 通过一段JS代码创建一个view_model对象。
@@ -42,6 +45,44 @@ BEGIN_C_DECLS
 view_model_t* view_model_jerryscript_create(const char* name, const char* code, uint32_t code_size,
                                             navigator_request_t* req);
 
+/**
+ * @method view_model_jerryscript_create_from_snapshot
+ * 通过预编译的JS代码(snapshot)创建一个view_model对象。
+ * snapshot与引擎的版本或配置不匹配时返回NULL，调用者可以改用源码创建。
+ *
+ * @param {const char*} name 名称(通常是文件名)。
+ * @param {const void*} data snapshot数据。
+ * @param {uint32_t} size snapshot数据的长度。
+ * @param {navigator_request_t*} req 请求的参数(可选)。
+ *
+ * @return {view_model_t*} 返回view_model对象。
+ */
+view_model_t* view_model_jerryscript_create_from_snapshot(const char* name, const void* data,
+                                                          uint32_t size, navigator_request_t* req);
+
+/**
+ * @method view_model_jerryscript_load_snapshot
+ * 执行预编译的JS代码(snapshot)。
+ *
+ * @param {const char*} name 名称(通常是文件名)。
+ * @param {const void*} data snapshot数据。
+ * @param {uint32_t} size snapshot数据的长度。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_jerryscript_load_snapshot(const char* name, const void* data, uint32_t size);
+
+/**
+ * @method view_model_jerryscript_reload_methods
+ * 清除view_model缓存的命令函数。
+ * JS代码动态替换了模型的方法后调用(JS中也可以调用this.notifyMethodsChanged())。
+ *
+ * @param {view_model_t*} view_model 由view_model_jerryscript_create创建的view_model对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_jerryscript_reload_methods(view_model_t* view_model);
+
 END_C_DECLS
 
 #endif /*TK_VIEW_MODEL_JERRYSCRIPT_H*/
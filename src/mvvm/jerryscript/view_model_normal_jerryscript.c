@@ -28,6 +28,7 @@ static ret_t view_model_normal_jerryscript_on_destroy(object_t* obj) {
   view_model_normal_jerryscript_t* view_modeljs = VIEW_MODEL_NORMAL_JERRYSCRIPT(obj);
 
   str_reset(&(view_modeljs->temp));
+  jsobj_method_cache_deinit(&(view_modeljs->methods));
   view_model_deinit(VIEW_MODEL(obj));
   jerry_release_value(view_modeljs->jsobj);
 
@@ -51,11 +52,8 @@ static ret_t view_model_normal_jerryscript_get_prop(object_t* obj, const char* n
   return_value_if_fail(obj != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
   value_set_int(v, 0);
-  if (jsobj_has_prop(view_modeljs->jsobj, name)) {
-    return jsobj_get_prop(view_modeljs->jsobj, name, v, &(view_modeljs->temp));
-  }
 
-  return RET_NOT_FOUND;
+  return jsobj_get_prop(view_modeljs->jsobj, name, v, &(view_modeljs->temp));
 }
 
 static bool_t view_model_normal_jerryscript_can_exec(object_t* obj, const char* name,
@@ -63,14 +61,14 @@ static bool_t view_model_normal_jerryscript_can_exec(object_t* obj, const char*
   view_model_normal_jerryscript_t* view_modeljs = VIEW_MODEL_NORMAL_JERRYSCRIPT(obj);
   return_value_if_fail(obj != NULL && name != NULL, RET_BAD_PARAMS);
 
-  return jsobj_can_exec(view_modeljs->jsobj, name, args);
+  return jsobj_method_cache_can_exec(&(view_modeljs->methods), view_modeljs->jsobj, name, args);
 }
 
 static ret_t view_model_normal_jerryscript_exec(object_t* obj, const char* name, const char* args) {
   view_model_normal_jerryscript_t* view_modeljs = VIEW_MODEL_NORMAL_JERRYSCRIPT(obj);
   return_value_if_fail(obj != NULL && name != NULL, RET_BAD_PARAMS);
 
-  return jsobj_exec(view_modeljs->jsobj, name, args);
+  return jsobj_method_cache_exec(&(view_modeljs->methods), view_modeljs->jsobj, name, args);
 }
 
 static const object_vtable_t s_obj_view_model_normal_jerryscript_vtable = {
@@ -91,7 +89,8 @@ static ret_t view_model_jerryscript_on_will_mount(view_model_t* view_model,
   view_model_normal_jerryscript_t* view_modeljs = VIEW_MODEL_NORMAL_JERRYSCRIPT(view_model);
   jerry_value_t jsargs = jerry_value_from_navigator_request(req);
 
-  ret_t ret = jsobj_exec_ex(view_modeljs->jsobj, "onWillMount", jsargs);
+  ret_t ret = jsobj_method_cache_exec_ex(&(view_modeljs->methods), view_modeljs->jsobj,
+                                         "onWillMount", jsargs);
   jerry_release_value(jsargs);
 
   return ret;
@@ -100,19 +99,20 @@ static ret_t view_model_jerryscript_on_will_mount(view_model_t* view_model,
 static ret_t view_model_jerryscript_on_mount(view_model_t* view_model) {
   view_model_normal_jerryscript_t* view_modeljs = VIEW_MODEL_NORMAL_JERRYSCRIPT(view_model);
 
-  return jsobj_exec(view_modeljs->jsobj, "onMount", NULL);
+  return jsobj_method_cache_exec(&(view_modeljs->methods), view_modeljs->jsobj, "onMount", NULL);
 }
 
 static ret_t view_model_jerryscript_on_will_unmount(view_model_t* view_model) {
   view_model_normal_jerryscript_t* view_modeljs = VIEW_MODEL_NORMAL_JERRYSCRIPT(view_model);
 
-  return jsobj_exec(view_modeljs->jsobj, "onWillUnmount", NULL);
+  return jsobj_method_cache_exec(&(view_modeljs->methods), view_modeljs->jsobj, "onWillUnmount",
+                                 NULL);
 }
 
 static ret_t view_model_jerryscript_on_unmount(view_model_t* view_model) {
   view_model_normal_jerryscript_t* view_modeljs = VIEW_MODEL_NORMAL_JERRYSCRIPT(view_model);
 
-  return jsobj_exec(view_modeljs->jsobj, "onUnmount", NULL);
+  return jsobj_method_cache_exec(&(view_modeljs->methods), view_modeljs->jsobj, "onUnmount", NULL);
 }
 
 const static view_model_vtable_t s_view_model_jerryscript_vtable = {
@@ -128,8 +128,16 @@ view_model_t* view_model_normal_jerryscript_create(jerry_value_t jsobj) {
 
   view_modeljs->jsobj = jsobj;
   str_init(&(view_modeljs->temp), 0);
+  jsobj_method_cache_init(&(view_modeljs->methods));
   view_model_init(VIEW_MODEL(obj));
   VIEW_MODEL(view_modeljs)->vt = &s_view_model_jerryscript_vtable;
 
   return VIEW_MODEL(obj);
 }
+
+ret_t view_model_normal_jerryscript_reload_methods(view_model_t* view_model) {
+  view_model_normal_jerryscript_t* view_modeljs = VIEW_MODEL_NORMAL_JERRYSCRIPT(view_model);
+  return_value_if_fail(view_modeljs != NULL, RET_BAD_PARAMS);
+
+  return jsobj_method_cache_clear(&(view_modeljs->methods));
+}
@@ -24,6 +24,7 @@
 
 #include "tkc/str.h"
 #include "jerryscript.h"
+#include "mvvm/jerryscript/jsobj.h"
 #include "mvvm/base/view_model.h"
 
 BEGIN_C_DECLS
@@ -46,6 +47,9 @@ struct _model_jerryscript_normal_t {
 
   /*避免每次动态分配内存*/
   str_t temp;
+
+  /*缓存已解析的命令函数*/
+  jsobj_method_cache_t methods;
 };
 
 /**
@@ -58,6 +62,16 @@ struct _model_jerryscript_normal_t {
  */
 view_model_t* view_model_normal_jerryscript_create(jerry_value_t jsobj);
 
+/**
+ * @method view_model_normal_jerryscript_reload_methods
+ * JS对象的方法改变后，清除缓存的命令函数，下次执行时重新解析。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t view_model_normal_jerryscript_reload_methods(view_model_t* view_model);
+
 #define VIEW_MODEL_NORMAL_JERRYSCRIPT(view_model) ((view_model_normal_jerryscript_t*)(view_model))
 
 END_C_DECLS
@@ -34,10 +34,10 @@ ret_t mvvm_init(void) {
 }
 
 ret_t mvvm_deinit(void) {
+  mvvm_awtk_deinit();
 #ifdef WITH_JERRYSCRIPT
   mvvm_jerryscript_deinit();
 #endif /*WITH_JERRYSCRIPT*/
-  mvvm_awtk_deinit();
   mvvm_base_deinit();
 
   return RET_OK;
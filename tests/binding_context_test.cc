@@ -127,6 +127,116 @@ TEST(BindingContextAwtk, data_two_way) {
   test_view_model_deinit();
 }
 
+TEST(BindingContextAwtk, data_prop_id) {
+  value_t v;
+  widget_t* win = window_create(NULL, 0, 0, 400, 300);
+  widget_t* slider = slider_create(win, 0, 0, 128, 30);
+  test_view_model_init();
+
+  ASSERT_EQ(view_model_get_prop_id(s_temp_view_model, "i32"), TEST_OBJ_PROP_I32);
+  ASSERT_EQ(view_model_get_prop_id(s_temp_view_model, "not_exist"), VIEW_MODEL_PROP_ID_INVALID);
+  ASSERT_EQ(view_model_get_prop_id(s_persons_view_model, "a"), VIEW_MODEL_PROP_ID_INVALID);
+
+  value_set_int(&v, 12);
+  ASSERT_EQ(view_model_set_prop_by_id(s_temp_view_model, TEST_OBJ_PROP_I32, &v), RET_OK);
+  ASSERT_EQ(object_get_prop_int(OBJECT(s_temp_view_model), "i32", 0), 12);
+  ASSERT_EQ(view_model_get_prop_by_id(s_temp_view_model, TEST_OBJ_PROP_I32, &v), RET_OK);
+  ASSERT_EQ(value_int(&v), 12);
+
+  widget_set_prop_str(win, WIDGET_PROP_V_MODEL, STR_V_MODEL_TEMP);
+  widget_set_prop_str(slider, "v-data:value", "{i32}");
+  bind_for_window(win);
+
+  widget_set_value(slider, 99);
+  ASSERT_EQ(object_get_prop_int(OBJECT(s_temp_view_model), "i32", 0), 99);
+
+  value_set_int(&v, 66);
+  ASSERT_EQ(view_model_set_prop_by_id(s_temp_view_model, TEST_OBJ_PROP_I32, &v), RET_OK);
+  idle_dispatch();
+  ASSERT_EQ(widget_get_value(slider), 66);
+
+  widget_destroy(win);
+  test_view_model_deinit();
+}
+
+TEST(BindingContextAwtk, data_dirty_props) {
+  value_t v;
+  widget_t* win = window_create(NULL, 0, 0, 400, 300);
+  widget_t* i32_slider = slider_create(win, 0, 0, 128, 30);
+  widget_t* u32_slider = slider_create(win, 0, 70, 128, 30);
+  test_view_model_init();
+  test_obj_t* test_obj = ((test_obj_view_model_t*)(s_temp_view_model))->test_obj;
+
+  widget_set_prop_str(win, WIDGET_PROP_V_MODEL, STR_V_MODEL_TEMP);
+  widget_set_prop_str(i32_slider, "v-data:value", "{i32}");
+  widget_set_prop_str(u32_slider, "v-data:value", "{u32}");
+  bind_for_window(win);
+  ASSERT_EQ(view_model_notify_dirty_props(s_temp_view_model), RET_NOT_FOUND);
+
+  /*直接修改模型，不会触发任何通知*/
+  test_obj->u32 = 50;
+
+  value_set_int(&v, 66);
+  ASSERT_EQ(view_model_set_prop_by_id(s_temp_view_model, TEST_OBJ_PROP_I32, &v), RET_OK);
+  idle_dispatch();
+  ASSERT_EQ(widget_get_value(i32_slider), 66);
+  ASSERT_EQ(widget_get_value(u32_slider), 0);
+
+  /*值没有变化，不产生脏标记*/
+  ASSERT_EQ(view_model_set_prop_by_id(s_temp_view_model, TEST_OBJ_PROP_I32, &v), RET_OK);
+  ASSERT_EQ(view_model_notify_dirty_props(s_temp_view_model), RET_NOT_FOUND);
+
+  object_notify_changed(OBJECT(s_temp_view_model));
+  idle_dispatch();
+  ASSERT_EQ(widget_get_value(u32_slider), 50);
+
+  widget_destroy(win);
+  test_view_model_deinit();
+}
+
+TEST(BindingContextAwtk, data_dirty_props_derived) {
+  value_t v;
+  widget_t* win = window_create(NULL, 0, 0, 400, 300);
+  widget_t* total_slider = slider_create(win, 0, 0, 128, 30);
+  widget_t* count_slider = slider_create(win, 0, 70, 128, 30);
+  test_view_model_init();
+
+  widget_set_prop_str(win, WIDGET_PROP_V_MODEL, STR_V_MODEL_TEMP);
+  widget_set_prop_str(total_slider, "v-data:value", "{total}");
+  widget_set_prop_str(count_slider, "v-data:value", "{save_count}");
+  bind_for_window(win);
+
+  /*total由getter根据i32和u32计算得到，设置这两个属性之后也要刷新*/
+  value_set_int(&v, 30);
+  ASSERT_EQ(view_model_set_prop_by_id(s_temp_view_model, TEST_OBJ_PROP_I32, &v), RET_OK);
+  idle_dispatch();
+  ASSERT_EQ(widget_get_value(total_slider), 30);
+
+  value_set_int(&v, 20);
+  ASSERT_EQ(view_model_set_prop_by_id(s_temp_view_model, TEST_OBJ_PROP_U32, &v), RET_OK);
+  idle_dispatch();
+  ASSERT_EQ(widget_get_value(total_slider), 50);
+
+  /*按名称设置时全部刷新，不残留脏标记*/
+  ASSERT_EQ(object_set_prop_int(OBJECT(s_temp_view_model), "i32", 40), RET_OK);
+  ASSERT_EQ(view_model_notify_dirty_props(s_temp_view_model), RET_NOT_FOUND);
+  idle_dispatch();
+  ASSERT_EQ(widget_get_value(total_slider), 60);
+
+  /*命令直接修改模型的字段，全部刷新*/
+  ASSERT_EQ(view_model_exec(s_temp_view_model, "save", NULL), RET_OBJECT_CHANGED);
+  idle_dispatch();
+  ASSERT_EQ(widget_get_value(count_slider), 1);
+
+  value_set_int(&v, 10);
+  ASSERT_EQ(view_model_set_prop_by_id(s_temp_view_model, TEST_OBJ_PROP_U32, &v), RET_OK);
+  idle_dispatch();
+  ASSERT_EQ(widget_get_value(total_slider), 50);
+
+  widget_destroy(win);
+  test_view_model_deinit();
+}
+
 TEST(BindingContextAwtk, multi_view_model) {
   widget_t* win = window_create(NULL, 0, 0, 400, 300);
   widget_t* temp_slider = slider_create(win, 0, 0, 128, 30);
@@ -109,6 +109,17 @@ TEST(CommandBindingParser, update_model_false) {
   object_unref(OBJECT(rule));
 }
 
+TEST(CommandBindingParser, prefetch) {
+  binding_rule_t* rule =
+      binding_rule_parse("v-on:click", "{navigate, Args=home, Prefetch}", TRUE);
+  command_binding_t* cmd = (command_binding_t*)rule;
+
+  ASSERT_EQ(cmd->prefetch, TRUE);
+  ASSERT_EQ(string(cmd->args), string("home"));
+
+  object_unref(OBJECT(rule));
+}
+
 TEST(CommandBindingParser, key_filter) {
   binding_rule_t* rule =
       binding_rule_parse("v-on:keydown:ctrl_a", "{Save, UpdateModel=False}", TRUE);
@@ -1,4 +1,6 @@
-﻿#include "mvvm/jerryscript/jsobj.h"
+﻿#include "tkc/utils.h"
+#include "tkc/object_default.h"
+#include "mvvm/jerryscript/jsobj.h"
 #include "gtest/gtest.h"
 
 #include <string>
@@ -79,3 +81,151 @@ TEST(JsValue, request) {
   jerry_release_value(value);
   object_unref(OBJECT(req));
 }
+
+TEST(JsObj, get_prop_not_found) {
+  value_t v;
+  str_t str;
+  jerry_value_t obj = jerry_create_object();
+
+  str_init(&str, 0);
+  ASSERT_EQ(jsobj_set_prop_int(obj, "a", 1), RET_OK);
+  ASSERT_EQ(jsobj_get_prop(obj, "a", &v, &str), RET_OK);
+  ASSERT_EQ(value_int(&v), 1);
+  ASSERT_EQ(jsobj_get_prop(obj, "b", &v, &str), RET_NOT_FOUND);
+
+  str_reset(&str);
+  jerry_release_value(obj);
+}
+
+TEST(JsObj, prop_name_cache) {
+  value_t v;
+  uint32_t i = 0;
+  char name[TK_NAME_LEN + 1];
+  jerry_value_t obj = jerry_create_object();
+
+  for (i = 0; i < 1000; i++) {
+    tk_snprintf(name, sizeof(name), "prop%u", i);
+    ASSERT_EQ(jsobj_set_prop_int(obj, name, i), RET_OK);
+  }
+
+  for (i = 0; i < 1000; i++) {
+    tk_snprintf(name, sizeof(name), "prop%u", i);
+    ASSERT_EQ(jsobj_get_prop(obj, name, &v, NULL), RET_OK);
+    ASSERT_EQ(value_int(&v), (int32_t)i);
+    ASSERT_EQ(jsobj_has_prop(obj, name), TRUE);
+  }
+
+  ASSERT_EQ(jsobj_set_prop_int(obj, "a_very_long_property_name_that_exceeds_name_len", 2), RET_OK);
+  ASSERT_EQ(jsobj_get_prop(obj, "a_very_long_property_name_that_exceeds_name_len", &v, NULL),
+            RET_OK);
+  ASSERT_EQ(value_int(&v), 2);
+
+  /*空的名字不缓存，每次创建的JS字符串用完即释放*/
+  for (i = 0; i < 3; i++) {
+    ASSERT_EQ(jsobj_set_prop_int(obj, "", i), RET_OK);
+    ASSERT_EQ(jsobj_get_prop(obj, "", &v, NULL), RET_OK);
+    ASSERT_EQ(value_int(&v), (int32_t)i);
+  }
+
+  jerry_release_value(obj);
+}
+
+TEST(JsObj, from_object) {
+  value_t v;
+  str_t str;
+  object_t* obj = object_default_create();
+  object_set_prop_int(obj, "a", 1);
+  object_set_prop_str(obj, "name", "awtk");
+
+  str_init(&str, 0);
+  jerry_value_t jsobj = jerry_value_from_object(obj);
+  ASSERT_EQ(jsobj_get_prop(jsobj, "a", &v, &str), RET_OK);
+  ASSERT_EQ(value_int(&v), 1);
+  ASSERT_EQ(jsobj_get_prop(jsobj, "name", &v, &str), RET_OK);
+  ASSERT_STREQ(value_str(&v), "awtk");
+
+  object_set_prop_int(obj, "a", 2);
+  ASSERT_EQ(jsobj_get_prop(jsobj, "a", &v, &str), RET_OK);
+  ASSERT_EQ(value_int(&v), 2);
+
+  ASSERT_EQ(jsobj_set_prop_int(jsobj, "a", 3), RET_OK);
+  ASSERT_EQ(object_get_prop_int(obj, "a", 0), 3);
+
+  object_t* obj1 = jerry_value_to_object(jsobj);
+  ASSERT_EQ(obj1, obj);
+  object_unref(obj1);
+
+  str_reset(&str);
+  object_unref(obj);
+  jerry_release_value(jsobj);
+}
+
+static ret_t on_count_prop(void* ctx, const void* data) {
+  int32_t* n = (int32_t*)ctx;
+  *n = *n + 1;
+
+  return RET_OK;
+}
+
+TEST(JsObj, to_object) {
+  int32_t n = 0;
+  jerry_value_t jsobj = jerry_create_object();
+  ASSERT_EQ(jsobj_set_prop_int(jsobj, "a", 1), RET_OK);
+  ASSERT_EQ(jsobj_set_prop_str(jsobj, "name", "awtk"), RET_OK);
+
+  object_t* obj = jerry_value_to_object(jsobj);
+  ASSERT_EQ(object_get_prop_int(obj, "a", 0), 1);
+  ASSERT_STREQ(object_get_prop_str(obj, "name"), "awtk");
+
+  ASSERT_EQ(jsobj_set_prop_int(jsobj, "a", 2), RET_OK);
+  ASSERT_EQ(object_get_prop_int(obj, "a", 0), 2);
+
+  ASSERT_EQ(object_set_prop_int(obj, "b", 3), RET_OK);
+  ASSERT_EQ(jsobj_has_prop(jsobj, "b"), TRUE);
+
+  ASSERT_EQ(object_foreach_prop(obj, on_count_prop, &n), RET_OK);
+  ASSERT_EQ(n, 3);
+
+  jerry_value_t jsobj1 = jerry_value_from_object(obj);
+  ASSERT_EQ(jsobj1, jsobj);
+  jerry_release_value(jsobj1);
+
+  jerry_release_value(jsobj);
+  ASSERT_EQ(object_get_prop_int(obj, "a", 0), 2);
+  object_unref(obj);
+}
+
+static ret_t on_profile(void* ctx, const void* data) {
+  string& str = *(string*)ctx;
+  const jsobj_profile_t* profile = (const jsobj_profile_t*)data;
+
+  str += string(profile->scope) + "." + profile->func + ";";
+
+  return RET_OK;
+}
+
+TEST(JsObj, profiler) {
+  string str;
+  int owner1 = 0;
+  int owner2 = 0;
+
+  ASSERT_EQ(jsobj_profiler_reset(), RET_OK);
+  ASSERT_EQ(jsobj_profiler_record(&owner1, "temperature", "apply", 10), RET_OK);
+  ASSERT_EQ(jsobj_profiler_record(&owner1, "temperature", "canApply", 1), RET_OK);
+  ASSERT_EQ(jsobj_profiler_record(NULL, "fahrenheit", "toView", 5), RET_OK);
+  ASSERT_EQ(jsobj_profiler_record(&owner1, "temperature", "canApply", 20), RET_OK);
+
+  ASSERT_EQ(jsobj_profiler_foreach(on_profile, &str), RET_OK);
+  ASSERT_EQ(str, "temperature.canApply;temperature.apply;fahrenheit.toView;");
+
+  /*同名的另一个模型实例单独统计*/
+  ASSERT_EQ(jsobj_profiler_record(&owner2, "temperature", "apply", 2), RET_OK);
+  str = "";
+  ASSERT_EQ(jsobj_profiler_foreach(on_profile, &str), RET_OK);
+  ASSERT_EQ(str, "temperature.canApply;temperature.apply;fahrenheit.toView;temperature.apply;");
+
+  ASSERT_EQ(jsobj_profiler_reset(), RET_OK);
+  str = "";
+  ASSERT_EQ(jsobj_profiler_foreach(on_profile, &str), RET_OK);
+  ASSERT_EQ(str, "");
+}
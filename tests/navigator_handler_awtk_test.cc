@@ -0,0 +1,81 @@
+﻿#include "mvvm/base/navigator_handler.h"
+#include "mvvm/awtk/navigator_handler_awtk.h"
+#include "widgets/window.h"
+#include "widgets/slider.h"
+#include "base/window_manager.h"
+#include "gtest/gtest.h"
+
+static ret_t on_count_event(void* ctx, event_t* e) {
+  uint32_t* count = (uint32_t*)ctx;
+
+  *count = *count + 1;
+
+  return RET_OK;
+}
+
+static ret_t close_window(navigator_handler_t* handler, widget_t* win) {
+  ret_t ret = RET_OK;
+  navigator_request_t* req = navigator_request_create(win->name, NULL);
+
+  object_set_prop_pointer(OBJECT(req), NAVIGATOR_ARG_VIEW, win);
+  ret = navigator_handler_on_close(handler, req);
+  object_unref(OBJECT(req));
+
+  return ret;
+}
+
+static ret_t open_window(navigator_handler_t* handler, const char* target) {
+  ret_t ret = RET_OK;
+  navigator_request_t* req = navigator_request_create(target, NULL);
+
+  ret = navigator_handler_on_request(handler, req);
+  object_unref(OBJECT(req));
+
+  return ret;
+}
+
+TEST(NavigatorHandlerAwtk, cache_disabled) {
+  widget_t* win = window_create(NULL, 0, 0, 400, 300);
+  navigator_handler_t* handler = navigator_handler_awtk_create();
+
+  widget_set_name(win, "cached_win");
+  ASSERT_EQ(close_window(handler, win), RET_NOT_IMPL);
+  ASSERT_EQ(win->visible, TRUE);
+
+  widget_destroy(win);
+  object_unref(OBJECT(handler));
+}
+
+TEST(NavigatorHandlerAwtk, close_reopen) {
+  uint32_t to_foreground = 0;
+  widget_t* below = window_create(NULL, 0, 0, 400, 300);
+  widget_t* win = window_create(NULL, 0, 0, 400, 300);
+  widget_t* slider = slider_create(win, 0, 0, 128, 30);
+  navigator_handler_t* handler = navigator_handler_awtk_create();
+
+  widget_set_name(win, "cached_win");
+  widget_set_value(slider, 42);
+  widget_on(below, EVT_WINDOW_TO_FOREGROUND, on_count_event, &to_foreground);
+  ASSERT_EQ(navigator_handler_awtk_set_cache_budget(handler, 100 * 1024), RET_OK);
+
+  /*关闭时只是隐藏，下面的窗口切换到前台*/
+  ASSERT_EQ(close_window(handler, win), RET_OK);
+  ASSERT_EQ(win->visible, FALSE);
+  ASSERT_EQ(win->parent, window_manager());
+  ASSERT_EQ(to_foreground, 1u);
+
+  /*再次打开时恢复原来的窗口和状态*/
+  ASSERT_EQ(open_window(handler, "cached_win"), RET_OK);
+  ASSERT_EQ(win->visible, TRUE);
+  ASSERT_EQ(window_manager_get_top_window(window_manager()), win);
+  ASSERT_EQ(widget_get_value(slider), 42);
+
+  /*窗口管理器销毁缓存的窗口时，缓存中也移除*/
+  ASSERT_EQ(close_window(handler, win), RET_OK);
+  widget_destroy(win);
+  ASSERT_EQ(NAVIGATOR_HANDLER_AWTK(handler)->cached.size, 0u);
+  ASSERT_EQ(NAVIGATOR_HANDLER_AWTK(handler)->cache_size, 0u);
+
+  widget_destroy(below);
+  object_unref(OBJECT(handler));
+}
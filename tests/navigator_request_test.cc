@@ -32,3 +32,18 @@ TEST(NavigatorRequest, on_result) {
 
   object_unref(OBJECT(req));
 }
+
+TEST(NavigatorRequest, is_plain) {
+  navigator_request_t* req = navigator_request_create("home", NULL);
+
+  ASSERT_EQ(navigator_request_is_plain(req), TRUE);
+  ASSERT_EQ(object_set_prop_pointer(OBJECT(req), NAVIGATOR_ARG_VIEW, req), RET_OK);
+  ASSERT_EQ(navigator_request_is_plain(req), TRUE);
+  ASSERT_EQ(object_set_prop_int(OBJECT(req), "id", 1), RET_OK);
+  ASSERT_EQ(navigator_request_is_plain(req), FALSE);
+  object_unref(OBJECT(req));
+
+  req = navigator_request_create("home", on_result);
+  ASSERT_EQ(navigator_request_is_plain(req), FALSE);
+  object_unref(OBJECT(req));
+}
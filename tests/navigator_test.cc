@@ -70,6 +70,42 @@ TEST(Navigator, default_handler) {
 }
 
 static string s_log;
+static ret_t prefetch_on_request(navigator_handler_t* handler, navigator_request_t* req) {
+  s_log = string("open:") + string(req->target);
+
+  return RET_OK;
+}
+
+static ret_t prefetch_on_prefetch(navigator_handler_t* handler, navigator_request_t* req) {
+  s_log = string("prefetch:") + string(req->target) +
+          string(object_get_prop_str(OBJECT(req), NAVIGATOR_ARG_VMODEL));
+
+  return RET_OK;
+}
+
+TEST(Navigator, prefetch) {
+  navigator_t* old = navigator();
+  navigator_t* nav = navigator_create();
+  navigator_handler_t* handler = navigator_handler_create(prefetch_on_request);
+  navigator_request_t* req = navigator_request_create("home", NULL);
+  navigator_set(nav);
+
+  navigator_register_handler(nav, NAVIGATOR_DEFAULT_HANDLER, handler);
+  ASSERT_EQ(navigator_prefetch("home"), RET_NOT_IMPL);
+
+  handler->on_prefetch = prefetch_on_prefetch;
+  object_set_prop_str(OBJECT(req), NAVIGATOR_ARG_VMODEL, ":home.js");
+  ASSERT_EQ(navigator_prefetch_ex(req), RET_OK);
+  ASSERT_EQ(s_log, string("prefetch:home:home.js"));
+
+  ASSERT_EQ(navigator_to("home"), RET_OK);
+  ASSERT_EQ(s_log, string("open:home"));
+
+  object_unref(OBJECT(req));
+  object_unref(OBJECT(nav));
+  navigator_set(old);
+}
+
 static ret_t toast_on_request(navigator_handler_t* handler, navigator_request_t* req) {
   s_log = string("toast:") + string(object_get_prop_str(OBJECT(req), NAVIGATOR_ARG_CONTENT));
 
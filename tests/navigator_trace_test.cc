@@ -0,0 +1,146 @@
+#include "tkc/fs.h"
+#include "tkc/mem.h"
+#include "gtest/gtest.h"
+#include "mvvm/base/navigator.h"
+#include "mvvm/base/navigator_trace.h"
+
+#include <string>
+
+using std::string;
+
+TEST(NavigatorTrace, disabled) {
+  ASSERT_EQ(navigator_trace_begin("home"), 0u);
+  ASSERT_EQ(navigator_trace_is_active(), FALSE);
+  ASSERT_EQ(navigator_trace_now(), 0u);
+  ASSERT_EQ(navigator_trace_add(NAVIGATOR_TRACE_BIND, 0), RET_OK);
+  ASSERT_EQ(navigator_trace_end(), RET_OK);
+  ASSERT_EQ(navigator_trace_get_last() == NULL, true);
+}
+
+TEST(NavigatorTrace, basic) {
+  uint64_t start = 0;
+  const navigator_trace_t* trace = NULL;
+
+  navigator_trace_enable(TRUE);
+  start = navigator_trace_begin("home");
+  ASSERT_NE(start, 0u);
+
+  /*嵌套的请求并入外层的记录*/
+  navigator_trace_add(NAVIGATOR_TRACE_WINDOW_OPEN, navigator_trace_begin("detail"));
+  navigator_trace_end();
+  ASSERT_EQ(navigator_trace_is_active(), TRUE);
+
+  navigator_trace_accumulate(NAVIGATOR_TRACE_RULE_PARSE, navigator_trace_now());
+  navigator_trace_accumulate(NAVIGATOR_TRACE_RULE_PARSE, navigator_trace_now());
+  navigator_trace_add(NAVIGATOR_TRACE_HANDLE_REQUEST, start);
+  navigator_trace_end();
+  ASSERT_EQ(navigator_trace_is_active(), FALSE);
+
+  trace = navigator_trace_get_last();
+  ASSERT_EQ(string(trace->target), string("home"));
+  ASSERT_EQ(trace->points_nr, 3u);
+  ASSERT_EQ(string(trace->points[0].name), string(NAVIGATOR_TRACE_WINDOW_OPEN));
+  ASSERT_EQ(string(trace->points[1].name), string(NAVIGATOR_TRACE_RULE_PARSE));
+  ASSERT_EQ(trace->points[1].count, 2u);
+  ASSERT_EQ(trace->points[2].start, start);
+  ASSERT_GE(trace->duration, trace->points[2].duration);
+
+  navigator_trace_deinit();
+}
+
+TEST(NavigatorTrace, defer_end) {
+  int win1 = 0;
+  int win2 = 0;
+
+  navigator_trace_enable(TRUE);
+  navigator_trace_begin("home");
+  navigator_trace_defer_end(&win1);
+  navigator_trace_end();
+  ASSERT_EQ(navigator_trace_is_active(), TRUE);
+
+  navigator_trace_end_deferred(&win2);
+  ASSERT_EQ(navigator_trace_is_active(), TRUE);
+  navigator_trace_end_deferred(&win1);
+  ASSERT_EQ(navigator_trace_is_active(), FALSE);
+  ASSERT_EQ(string(navigator_trace_get_last()->points[0].name),
+            string(NAVIGATOR_TRACE_FIRST_PAINT));
+
+  /*窗口没有绘制就开始了新的导航，之前的记录到此为止*/
+  navigator_trace_begin("detail");
+  navigator_trace_defer_end(&win1);
+  navigator_trace_end();
+  navigator_trace_begin("list");
+  ASSERT_EQ(string(navigator_trace_get_last()->target), string("detail"));
+  navigator_trace_end();
+  ASSERT_EQ(string(navigator_trace_get_last()->target), string("list"));
+
+  navigator_trace_deinit();
+}
+
+TEST(NavigatorTrace, cancel_deferred) {
+  int win1 = 0;
+
+  navigator_trace_enable(TRUE);
+  navigator_trace_begin("home");
+  navigator_trace_defer_end(&win1);
+  navigator_trace_end();
+  ASSERT_EQ(navigator_trace_is_active(), TRUE);
+
+  /*窗口没有绘制就销毁了*/
+  navigator_trace_cancel_deferred(&win1);
+  ASSERT_EQ(navigator_trace_is_active(), FALSE);
+  ASSERT_EQ(string(navigator_trace_get_last()->target), string("home"));
+  ASSERT_EQ(navigator_trace_get_last()->points_nr, 0u);
+
+  /*之后的绘制不再结束其它记录*/
+  navigator_trace_begin("detail");
+  navigator_trace_end_deferred(&win1);
+  navigator_trace_cancel_deferred(&win1);
+  ASSERT_EQ(navigator_trace_is_active(), TRUE);
+  navigator_trace_end();
+
+  navigator_trace_deinit();
+}
+
+static ret_t trace_on_request(navigator_handler_t* handler, navigator_request_t* req) {
+  return RET_OK;
+}
+
+TEST(NavigatorTrace, skip_dialogs) {
+  navigator_t* nav = navigator_create();
+  navigator_request_t* req = navigator_request_create("home", NULL);
+  navigator_request_t* toast = navigator_request_create(NAVIGATOR_REQ_TOAST, NULL);
+
+  navigator_register_handler(nav, NAVIGATOR_DEFAULT_HANDLER,
+                             navigator_handler_create(trace_on_request));
+  navigator_trace_enable(TRUE);
+
+  ASSERT_EQ(navigator_handle_request(nav, req), RET_OK);
+  ASSERT_EQ(string(navigator_trace_get_last()->target), string("home"));
+
+  ASSERT_EQ(navigator_handle_request(nav, toast), RET_OK);
+  ASSERT_EQ(navigator_trace_is_active(), FALSE);
+  ASSERT_EQ(string(navigator_trace_get_last()->target), string("home"));
+
+  navigator_trace_deinit();
+  object_unref(OBJECT(req));
+  object_unref(OBJECT(toast));
+  object_unref(OBJECT(nav));
+}
+
+TEST(NavigatorTrace, escape) {
+  uint32_t size = 0;
+  char* data = NULL;
+  const char* filename = "navigator_trace.json";
+
+  ASSERT_EQ(navigator_trace_set_file(filename), RET_OK);
+  navigator_trace_begin("a\"b\\c");
+  navigator_trace_end();
+  navigator_trace_deinit();
+
+  data = (char*)file_read(filename, &size);
+  ASSERT_EQ(data != NULL, true);
+  ASSERT_EQ(string(data).find("\"name\":\"a\\\"b\\\\c\"") != string::npos, true);
+  TKMEM_FREE(data);
+  file_remove(filename);
+}
@@ -0,0 +1,70 @@
+#include "mvvm/base/numeric_series.h"
+#include "gtest/gtest.h"
+
+TEST(NumericSeries, push) {
+  float_t values[] = {1, 2, 3};
+  numeric_series_t* series = numeric_series_create(2);
+
+  ASSERT_EQ(numeric_series_is_dirty(series), FALSE);
+  ASSERT_EQ(numeric_series_push(series, 0), RET_OK);
+  ASSERT_EQ(numeric_series_push_n(series, values, 3), RET_OK);
+  ASSERT_EQ(series->size, 4u);
+  ASSERT_EQ(series->capacity >= 4u, true);
+  ASSERT_EQ(numeric_series_get(series, 3, -1), 3);
+  ASSERT_EQ(numeric_series_get(series, 4, -1), -1);
+
+  ASSERT_EQ(numeric_series_is_dirty(series), TRUE);
+  ASSERT_EQ(series->dirty_start, 0u);
+  ASSERT_EQ(series->dirty_end, 4u);
+
+  ASSERT_EQ(numeric_series_clear_dirty(series), RET_OK);
+  ASSERT_EQ(numeric_series_is_dirty(series), FALSE);
+
+  ASSERT_EQ(numeric_series_push(series, 4), RET_OK);
+  ASSERT_EQ(series->dirty_start, 4u);
+  ASSERT_EQ(series->dirty_end, 5u);
+
+  object_unref(OBJECT(series));
+}
+
+TEST(NumericSeries, set) {
+  float_t values[] = {1, 2, 3};
+  numeric_series_t* series = numeric_series_create(0);
+
+  ASSERT_EQ(numeric_series_push_n(series, values, 3), RET_OK);
+  ASSERT_EQ(numeric_series_clear_dirty(series), RET_OK);
+
+  ASSERT_EQ(numeric_series_set(series, 1, 20), RET_OK);
+  ASSERT_EQ(numeric_series_set(series, 3, 20), RET_BAD_PARAMS);
+  ASSERT_EQ(series->dirty_start, 1u);
+  ASSERT_EQ(series->dirty_end, 2u);
+
+  ASSERT_EQ(numeric_series_set_n(series, 2, values, 3), RET_OK);
+  ASSERT_EQ(series->size, 5u);
+  ASSERT_EQ(series->dirty_start, 1u);
+  ASSERT_EQ(series->dirty_end, 5u);
+  ASSERT_EQ(numeric_series_get(series, 1, 0), 20);
+  ASSERT_EQ(numeric_series_get(series, 4, 0), 3);
+
+  ASSERT_EQ(numeric_series_clear_dirty(series), RET_OK);
+  ASSERT_EQ(numeric_series_clear(series), RET_OK);
+  ASSERT_EQ(series->size, 0u);
+  ASSERT_EQ(series->dirty_start, 0u);
+  ASSERT_EQ(series->dirty_end, 5u);
+
+  object_unref(OBJECT(series));
+}
+
+TEST(NumericSeries, props) {
+  numeric_series_t* series = numeric_series_create(10);
+  object_t* obj = OBJECT(series);
+
+  ASSERT_EQ(numeric_series_cast(obj), series);
+  ASSERT_EQ(numeric_series_push(series, 1), RET_OK);
+  ASSERT_EQ(object_get_prop_int(obj, NUMERIC_SERIES_PROP_SIZE, 0), 1);
+  ASSERT_EQ(object_get_prop_int(obj, NUMERIC_SERIES_PROP_CAPACITY, 0), 10);
+  ASSERT_EQ(object_get_prop_int(obj, NUMERIC_SERIES_PROP_DIRTY_START, -1), 0);
+  ASSERT_EQ(object_get_prop_int(obj, NUMERIC_SERIES_PROP_DIRTY_END, -1), 1);
+
+  object_unref(obj);
+}
@@ -0,0 +1,99 @@
+#include "tkc/utils.h"
+#include "mvvm/base/registry.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using std::string;
+
+static uint32_t s_destroyed = 0;
+static ret_t on_destroy(void* data) {
+  s_destroyed++;
+
+  return RET_OK;
+}
+
+TEST(Registry, basic) {
+  registry_t registry;
+  int a = 0;
+  int b = 0;
+
+  s_destroyed = 0;
+  registry_init(&registry, on_destroy);
+  ASSERT_EQ(registry_get(&registry, "a") == NULL, true);
+  ASSERT_EQ(registry_set(&registry, "a", &a), RET_OK);
+  ASSERT_EQ(registry_set(&registry, "b", &b), RET_OK);
+  ASSERT_EQ(registry.size, 2u);
+
+  ASSERT_EQ(registry_get(&registry, "a") == &a, true);
+  ASSERT_EQ(registry_has(&registry, "b"), TRUE);
+  ASSERT_EQ(registry_has(&registry, "c"), FALSE);
+  ASSERT_EQ(registry.lookups, 4u);
+  ASSERT_EQ(registry.misses, 2u);
+
+  /*替换时销毁原来的数据*/
+  ASSERT_EQ(registry_set(&registry, "a", &b), RET_OK);
+  ASSERT_EQ(registry_get(&registry, "a") == &b, true);
+  ASSERT_EQ(s_destroyed, 1u);
+
+  ASSERT_EQ(registry_remove(&registry, "a"), RET_OK);
+  ASSERT_EQ(registry_remove(&registry, "a"), RET_NOT_FOUND);
+  ASSERT_EQ(s_destroyed, 2u);
+  ASSERT_EQ(registry.size, 1u);
+
+  registry_deinit(&registry);
+  ASSERT_EQ(s_destroyed, 3u);
+}
+
+TEST(Registry, grow) {
+  uint32_t i = 0;
+  char name[32];
+  registry_t registry;
+  static uint32_t values[1000];
+
+  registry_init(&registry, NULL);
+  for (i = 0; i < 1000; i++) {
+    tk_snprintf(name, sizeof(name), "creator%u", i);
+    ASSERT_EQ(registry_set(&registry, name, values + i), RET_OK);
+  }
+
+  for (i = 0; i < 1000; i += 2) {
+    tk_snprintf(name, sizeof(name), "creator%u", i);
+    ASSERT_EQ(registry_remove(&registry, name), RET_OK);
+  }
+
+  ASSERT_EQ(registry.size, 500u);
+  for (i = 0; i < 1000; i++) {
+    tk_snprintf(name, sizeof(name), "creator%u", i);
+    ASSERT_EQ(registry_get(&registry, name) == (i % 2 ? values + i : NULL), true);
+  }
+
+  registry_deinit(&registry);
+}
+
+TEST(Registry, intern) {
+  int a = 0;
+  registry_t r1;
+  registry_t r2;
+  uint32_t interned = registry_interned_size();
+  const char* name = registry_intern("temperature");
+
+  ASSERT_EQ(string(name), string("temperature"));
+  ASSERT_EQ(registry_intern("temperature") == name, true);
+
+  /*不同的注册表共享同一个名字*/
+  registry_init(&r1, NULL);
+  registry_init(&r2, NULL);
+  registry_set(&r1, "temperature", &a);
+  registry_set(&r2, "temperature", &a);
+  registry_set(&r2, "humidity", &a);
+  ASSERT_EQ(registry_interned_size(), interned + 2);
+
+  registry_deinit(&r1);
+  registry_deinit(&r2);
+  ASSERT_EQ(registry_interned_size(), interned + 1);
+
+  ASSERT_EQ(registry_unintern(name), RET_OK);
+  ASSERT_EQ(registry_unintern(name), RET_OK);
+  ASSERT_EQ(registry_interned_size(), interned);
+}
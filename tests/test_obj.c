@@ -34,6 +34,14 @@ static ret_t test_obj_set_data(test_obj_t* test_obj, const value_t* v) {
   return RET_OK;
 }
 
+static int32_t test_obj_get_total(test_obj_t* test_obj) {
+  return test_obj->i32 + (int32_t)(test_obj->u32);
+}
+
+static ret_t test_obj_set_total(test_obj_t* test_obj, const value_t* v) {
+  return RET_OK;
+}
+
 static bool_t test_obj_can_exec_save(test_obj_t* test_obj, const char* args) {
   return TRUE;
 }
@@ -57,86 +65,349 @@ static ret_t test_obj_bar(test_obj_t* test_obj, const char* args) {
 
 /***************test_obj_view_model***************/
 
-static ret_t test_obj_view_model_set_prop(object_t* obj, const char* name, const value_t* v) {
-  test_obj_view_model_t* vm = (test_obj_view_model_t*)(obj);
+static int32_t test_obj_view_model_get_prop_id(view_model_t* view_model, const char* name) {
+  return_value_if_fail(name != NULL, VIEW_MODEL_PROP_ID_INVALID);
+
+  switch (name[0]) {
+    case 'i': {
+      if (tk_str_eq("i8", name)) {
+        return TEST_OBJ_PROP_I8;
+      } else if (tk_str_eq("i16", name)) {
+        return TEST_OBJ_PROP_I16;
+      } else if (tk_str_eq("i32", name)) {
+        return TEST_OBJ_PROP_I32;
+      } else if (tk_str_eq("i64", name)) {
+        return TEST_OBJ_PROP_I64;
+      }
+      break;
+    }
+    case 'u': {
+      if (tk_str_eq("u8", name)) {
+        return TEST_OBJ_PROP_U8;
+      } else if (tk_str_eq("u16", name)) {
+        return TEST_OBJ_PROP_U16;
+      } else if (tk_str_eq("u32", name)) {
+        return TEST_OBJ_PROP_U32;
+      } else if (tk_str_eq("u64", name)) {
+        return TEST_OBJ_PROP_U64;
+      }
+      break;
+    }
+    case 'b': {
+      if (tk_str_eq("b", name)) {
+        return TEST_OBJ_PROP_B;
+      }
+      break;
+    }
+    case 'f': {
+      if (tk_str_eq("f32", name)) {
+        return TEST_OBJ_PROP_F32;
+      } else if (tk_str_eq("f64", name)) {
+        return TEST_OBJ_PROP_F64;
+      } else if (tk_str_eq("f", name)) {
+        return TEST_OBJ_PROP_F;
+      }
+      break;
+    }
+    case 's': {
+      if (tk_str_eq("save_count", name)) {
+        return TEST_OBJ_PROP_SAVE_COUNT;
+      }
+      break;
+    }
+    case 'd': {
+      if (tk_str_eq("data", name)) {
+        return TEST_OBJ_PROP_DATA;
+      }
+      break;
+    }
+    case 't': {
+      if (tk_str_eq("total", name)) {
+        return TEST_OBJ_PROP_TOTAL;
+      }
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+
+  return VIEW_MODEL_PROP_ID_INVALID;
+}
+
+static ret_t test_obj_view_model_get_prop_by_id(view_model_t* view_model, int32_t id, value_t* v) {
+  test_obj_view_model_t* vm = (test_obj_view_model_t*)(view_model);
   test_obj_t* test_obj = vm->test_obj;
 
-  if (tk_str_eq("i8", name)) {
-    test_obj->i8 = value_int8(v);
-  } else if (tk_str_eq("i16", name)) {
-    test_obj->i16 = value_int16(v);
-  } else if (tk_str_eq("i32", name)) {
-    test_obj->i32 = value_int32(v);
-  } else if (tk_str_eq("i64", name)) {
-    test_obj->i64 = value_int64(v);
-  } else if (tk_str_eq("u8", name)) {
-    test_obj->u8 = value_uint8(v);
-  } else if (tk_str_eq("u16", name)) {
-    test_obj->u16 = value_uint16(v);
-  } else if (tk_str_eq("u32", name)) {
-    test_obj->u32 = value_uint32(v);
-  } else if (tk_str_eq("u64", name)) {
-    test_obj->u64 = value_uint64(v);
-  } else if (tk_str_eq("b", name)) {
-    test_obj->b = value_bool(v);
-  } else if (tk_str_eq("f32", name)) {
-    test_obj->f32 = value_float(v);
-  } else if (tk_str_eq("f64", name)) {
-    test_obj->f64 = value_double(v);
-  } else if (tk_str_eq("save_count", name)) {
-    test_obj->save_count = value_int32(v);
-  } else if (tk_str_eq("data", name)) {
-    test_obj_set_data(test_obj, v);
-  } else if (tk_str_eq("f", name)) {
-    test_obj->f = value_float(v);
-  } else {
+  switch (id) {
+    case TEST_OBJ_PROP_I8: {
+      value_set_int8(v, test_obj->i8);
+      return RET_OK;
+    }
+    case TEST_OBJ_PROP_I16: {
+      value_set_int16(v, test_obj->i16);
+      return RET_OK;
+    }
+    case TEST_OBJ_PROP_I32: {
+      value_set_int32(v, test_obj->i32);
+      return RET_OK;
+    }
+    case TEST_OBJ_PROP_I64: {
+      value_set_int64(v, test_obj->i64);
+      return RET_OK;
+    }
+    case TEST_OBJ_PROP_U8: {
+      value_set_uint8(v, test_obj->u8);
+      return RET_OK;
+    }
+    case TEST_OBJ_PROP_U16: {
+      value_set_uint16(v, test_obj->u16);
+      return RET_OK;
+    }
+    case TEST_OBJ_PROP_U32: {
+      value_set_uint32(v, test_obj->u32);
+      return RET_OK;
+    }
+    case TEST_OBJ_PROP_U64: {
+      value_set_uint64(v, test_obj->u64);
+      return RET_OK;
+    }
+    case TEST_OBJ_PROP_B: {
+      value_set_bool(v, test_obj->b);
+      return RET_OK;
+    }
+    case TEST_OBJ_PROP_F32: {
+      value_set_float(v, test_obj->f32);
+      return RET_OK;
+    }
+    case TEST_OBJ_PROP_F64: {
+      value_set_double(v, test_obj->f64);
+      return RET_OK;
+    }
+    case TEST_OBJ_PROP_SAVE_COUNT: {
+      value_set_int32(v, test_obj->save_count);
+      return RET_OK;
+    }
+    case TEST_OBJ_PROP_DATA: {
+      value_set_str(v, test_obj_get_data(test_obj));
+      return RET_OK;
+    }
+    case TEST_OBJ_PROP_F: {
+      value_set_float(v, test_obj->f);
+      return RET_OK;
+    }
+    case TEST_OBJ_PROP_TOTAL: {
+      value_set_int32(v, test_obj_get_total(test_obj));
+      return RET_OK;
+    }
+    default: {
+      break;
+    }
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static ret_t test_obj_view_model_get_prop(object_t* obj, const char* name, value_t* v) {
+  int32_t id = test_obj_view_model_get_prop_id(VIEW_MODEL(obj), name);
+
+  if (id == VIEW_MODEL_PROP_ID_INVALID) {
     log_debug("not found %s\n", name);
     return RET_NOT_FOUND;
   }
 
+  return test_obj_view_model_get_prop_by_id(VIEW_MODEL(obj), id, v);
+}
+
+static const uint32_t* test_obj_view_model_get_dirty_props(view_model_t* view_model,
+                                                           uint32_t* size) {
+  test_obj_view_model_t* vm = (test_obj_view_model_t*)(view_model);
+
+  *size = sizeof(vm->dirty) / sizeof(vm->dirty[0]);
+
+  return vm->dirty;
+}
+
+static ret_t test_obj_view_model_clear_dirty_props(view_model_t* view_model) {
+  test_obj_view_model_t* vm = (test_obj_view_model_t*)(view_model);
+
+  memset(vm->dirty, 0x00, sizeof(vm->dirty));
+
   return RET_OK;
 }
 
-static ret_t test_obj_view_model_get_prop(object_t* obj, const char* name, value_t* v) {
-  test_obj_view_model_t* vm = (test_obj_view_model_t*)(obj);
+static ret_t test_obj_view_model_mark_dirty(test_obj_view_model_t* vm, int32_t id) {
+  switch (id) {
+    case TEST_OBJ_PROP_DATA:
+    case TEST_OBJ_PROP_TOTAL: {
+      memset(vm->dirty, 0xff, sizeof(vm->dirty));
+      return RET_OK;
+    }
+    default: {
+      break;
+    }
+  }
+
+  vm->dirty[id / 32] |= 1u << (id % 32);
+  vm->dirty[TEST_OBJ_PROP_DATA / 32] |= 1u << (TEST_OBJ_PROP_DATA % 32);
+  vm->dirty[TEST_OBJ_PROP_TOTAL / 32] |= 1u << (TEST_OBJ_PROP_TOTAL % 32);
+
+  return RET_OK;
+}
+
+static ret_t test_obj_view_model_set_prop_by_id(view_model_t* view_model, int32_t id,
+                                                const value_t* v) {
+  test_obj_view_model_t* vm = (test_obj_view_model_t*)(view_model);
   test_obj_t* test_obj = vm->test_obj;
+  value_t old;
 
-  if (tk_str_eq("i8", name)) {
-    value_set_int8(v, test_obj->i8);
-  } else if (tk_str_eq("i16", name)) {
-    value_set_int16(v, test_obj->i16);
-  } else if (tk_str_eq("i32", name)) {
-    value_set_int32(v, test_obj->i32);
-  } else if (tk_str_eq("i64", name)) {
-    value_set_int64(v, test_obj->i64);
-  } else if (tk_str_eq("u8", name)) {
-    value_set_uint8(v, test_obj->u8);
-  } else if (tk_str_eq("u16", name)) {
-    value_set_uint16(v, test_obj->u16);
-  } else if (tk_str_eq("u32", name)) {
-    value_set_uint32(v, test_obj->u32);
-  } else if (tk_str_eq("u64", name)) {
-    value_set_uint64(v, test_obj->u64);
-  } else if (tk_str_eq("b", name)) {
-    value_set_bool(v, test_obj->b);
-  } else if (tk_str_eq("f32", name)) {
-    value_set_float(v, test_obj->f32);
-  } else if (tk_str_eq("f64", name)) {
-    value_set_double(v, test_obj->f64);
-  } else if (tk_str_eq("save_count", name)) {
-    value_set_int32(v, test_obj->save_count);
-  } else if (tk_str_eq("data", name)) {
-    value_set_str(v, test_obj_get_data(test_obj));
-  } else if (tk_str_eq("f", name)) {
-    value_set_float(v, test_obj->f);
-  } else {
+  if (test_obj_view_model_get_prop_by_id(view_model, id, &old) == RET_OK && value_equal(&old, v)) {
+    return RET_OK;
+  }
+
+  switch (id) {
+    case TEST_OBJ_PROP_I8: {
+      test_obj->i8 = value_int8(v);
+      break;
+    }
+    case TEST_OBJ_PROP_I16: {
+      test_obj->i16 = value_int16(v);
+      break;
+    }
+    case TEST_OBJ_PROP_I32: {
+      test_obj->i32 = value_int32(v);
+      break;
+    }
+    case TEST_OBJ_PROP_I64: {
+      test_obj->i64 = value_int64(v);
+      break;
+    }
+    case TEST_OBJ_PROP_U8: {
+      test_obj->u8 = value_uint8(v);
+      break;
+    }
+    case TEST_OBJ_PROP_U16: {
+      test_obj->u16 = value_uint16(v);
+      break;
+    }
+    case TEST_OBJ_PROP_U32: {
+      test_obj->u32 = value_uint32(v);
+      break;
+    }
+    case TEST_OBJ_PROP_U64: {
+      test_obj->u64 = value_uint64(v);
+      break;
+    }
+    case TEST_OBJ_PROP_B: {
+      test_obj->b = value_bool(v);
+      break;
+    }
+    case TEST_OBJ_PROP_F32: {
+      test_obj->f32 = value_float(v);
+      break;
+    }
+    case TEST_OBJ_PROP_F64: {
+      test_obj->f64 = value_double(v);
+      break;
+    }
+    case TEST_OBJ_PROP_SAVE_COUNT: {
+      test_obj->save_count = value_int32(v);
+      break;
+    }
+    case TEST_OBJ_PROP_DATA: {
+      test_obj_set_data(test_obj, v);
+      break;
+    }
+    case TEST_OBJ_PROP_F: {
+      test_obj->f = value_float(v);
+      break;
+    }
+    case TEST_OBJ_PROP_TOTAL: {
+      test_obj_set_total(test_obj, v);
+      break;
+    }
+    default: {
+      return RET_NOT_FOUND;
+    }
+  }
+
+  return test_obj_view_model_mark_dirty(vm, id);
+}
+
+static ret_t test_obj_view_model_set_prop(object_t* obj, const char* name, const value_t* v) {
+  ret_t ret = RET_OK;
+  int32_t id = test_obj_view_model_get_prop_id(VIEW_MODEL(obj), name);
+
+  if (id == VIEW_MODEL_PROP_ID_INVALID) {
     log_debug("not found %s\n", name);
     return RET_NOT_FOUND;
   }
 
+  ret = test_obj_view_model_set_prop_by_id(VIEW_MODEL(obj), id, v);
+  /*随后object_set_prop触发EVT_PROP_CHANGED，绑定上下文全部刷新，不需要再发布脏属性*/
+  test_obj_view_model_clear_dirty_props(VIEW_MODEL(obj));
+
+  return ret;
+}
+
+static const view_model_snapshot_field_t s_test_obj_snapshot_fields[] = {
+    {0x00435aebu, TEST_OBJ_PROP_F64},
+    {0x05f374b1u, TEST_OBJ_PROP_U32},
+    {0x06903044u, TEST_OBJ_PROP_SAVE_COUNT},
+    {0x0b42b2f8u, TEST_OBJ_PROP_U8},
+    {0x56a2c0dbu, TEST_OBJ_PROP_I16},
+    {0x79ee1b1fu, TEST_OBJ_PROP_U16},
+    {0x79fae712u, TEST_OBJ_PROP_U64},
+    {0x84375ec4u, TEST_OBJ_PROP_F32},
+    {0x9338fbb4u, TEST_OBJ_PROP_I8},
+    {0xc69b2266u, TEST_OBJ_PROP_I64},
+    {0xcaa7f4a5u, TEST_OBJ_PROP_I32},
+    {0xd872e2a5u, TEST_OBJ_PROP_DATA},
+    {0xe30c2799u, TEST_OBJ_PROP_F},
+    {0xe70c2de5u, TEST_OBJ_PROP_B}
+};
+
+static ret_t test_obj_view_model_save_snapshot(view_model_t* view_model,
+                                                view_model_snapshot_t* snapshot) {
+  value_t v;
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(s_test_obj_snapshot_fields); i++) {
+    const view_model_snapshot_field_t* iter = s_test_obj_snapshot_fields + i;
+
+    if (test_obj_view_model_get_prop_by_id(view_model, iter->prop_id, &v) == RET_OK) {
+      return_value_if_fail(view_model_snapshot_write(snapshot, iter->field_id, &v) == RET_OK,
+                           RET_OOM);
+    }
+  }
+
   return RET_OK;
 }
 
+static ret_t test_obj_view_model_load_snapshot(view_model_t* view_model,
+                                                view_model_snapshot_t* snapshot) {
+  value_t v;
+  int32_t id = 0;
+  ret_t ret = RET_OK;
+  uint32_t field_id = 0;
+
+  /*先检查整个快照，数据损坏时不修改模型*/
+  ret = view_model_snapshot_validate(snapshot);
+  if (ret != RET_OK) {
+    return ret;
+  }
+
+  while ((ret = view_model_snapshot_read(snapshot, &field_id, &v)) == RET_OK) {
+    id = view_model_snapshot_find_field(s_test_obj_snapshot_fields,
+                                        ARRAY_SIZE(s_test_obj_snapshot_fields), field_id);
+    if (id != VIEW_MODEL_PROP_ID_INVALID) {
+      test_obj_view_model_set_prop_by_id(view_model, id, &v);
+    }
+  }
+
+  return ret == RET_EOS ? RET_OK : ret;
+}
+
 static bool_t test_obj_view_model_can_exec(object_t* obj, const char* name, const char* args) {
   test_obj_view_model_t* vm = (test_obj_view_model_t*)(obj);
   test_obj_t* test_obj = vm->test_obj;
@@ -177,6 +448,15 @@ static ret_t test_obj_view_model_on_destroy(object_t* obj) {
   return view_model_deinit(VIEW_MODEL(obj));
 }
 
+static const view_model_vtable_t s_test_obj_view_model_vm_vtable = {
+    .get_prop_id = test_obj_view_model_get_prop_id,
+    .get_prop_by_id = test_obj_view_model_get_prop_by_id,
+    .set_prop_by_id = test_obj_view_model_set_prop_by_id,
+    .get_dirty_props = test_obj_view_model_get_dirty_props,
+    .clear_dirty_props = test_obj_view_model_clear_dirty_props,
+    .save_snapshot = test_obj_view_model_save_snapshot,
+    .load_snapshot = test_obj_view_model_load_snapshot};
+
 static const object_vtable_t s_test_obj_view_model_vtable = {
     .type = "test_obj",
     .desc = "test_obj",
@@ -193,6 +473,7 @@ view_model_t* test_obj_view_model_create(navigator_request_t* req) {
   test_obj_view_model_t* test_obj_view_model = (test_obj_view_model_t*)(vm);
 
   return_value_if_fail(vm != NULL, NULL);
+  vm->vt = &s_test_obj_view_model_vm_vtable;
 
   test_obj_view_model->test_obj = test_obj_create();
   ENSURE(test_obj_view_model->test_obj != NULL);
@@ -29,6 +29,90 @@ typedef struct _test_obj_t {
   float_t f;
 } test_obj_t;
 
+/**
+ * @enum test_obj_prop_id_t
+ * @prefix TEST_OBJ_PROP_
+ * test_obj的属性ID。
+ */
+typedef enum _test_obj_prop_id_t {
+  /**
+   * @const TEST_OBJ_PROP_I8
+   * i8属性的ID。
+   */
+  TEST_OBJ_PROP_I8 = 0,
+  /**
+   * @const TEST_OBJ_PROP_I16
+   * i16属性的ID。
+   */
+  TEST_OBJ_PROP_I16,
+  /**
+   * @const TEST_OBJ_PROP_I32
+   * i32属性的ID。
+   */
+  TEST_OBJ_PROP_I32,
+  /**
+   * @const TEST_OBJ_PROP_I64
+   * i64属性的ID。
+   */
+  TEST_OBJ_PROP_I64,
+  /**
+   * @const TEST_OBJ_PROP_U8
+   * u8属性的ID。
+   */
+  TEST_OBJ_PROP_U8,
+  /**
+   * @const TEST_OBJ_PROP_U16
+   * u16属性的ID。
+   */
+  TEST_OBJ_PROP_U16,
+  /**
+   * @const TEST_OBJ_PROP_U32
+   * u32属性的ID。
+   */
+  TEST_OBJ_PROP_U32,
+  /**
+   * @const TEST_OBJ_PROP_U64
+   * u64属性的ID。
+   */
+  TEST_OBJ_PROP_U64,
+  /**
+   * @const TEST_OBJ_PROP_B
+   * b属性的ID。
+   */
+  TEST_OBJ_PROP_B,
+  /**
+   * @const TEST_OBJ_PROP_F32
+   * f32属性的ID。
+   */
+  TEST_OBJ_PROP_F32,
+  /**
+   * @const TEST_OBJ_PROP_F64
+   * f64属性的ID。
+   */
+  TEST_OBJ_PROP_F64,
+  /**
+   * @const TEST_OBJ_PROP_SAVE_COUNT
+   * save_count属性的ID。
+   */
+  TEST_OBJ_PROP_SAVE_COUNT,
+  /**
+   * @const TEST_OBJ_PROP_DATA
+   * data属性的ID。
+   */
+  TEST_OBJ_PROP_DATA,
+  /**
+   * @const TEST_OBJ_PROP_F
+   * f属性的ID。
+   */
+  TEST_OBJ_PROP_F,
+  /**
+   * @const TEST_OBJ_PROP_TOTAL
+   * total属性的ID。
+   */
+  TEST_OBJ_PROP_TOTAL,
+  TEST_OBJ_PROP_NR
+} test_obj_prop_id_t;
+
 /**
  * @class test_obj_view_model_t
  *
@@ -40,6 +124,9 @@ typedef struct _test_obj_view_model_t {
 
   /*model object*/
   test_obj_t* test_obj;
+
+  /*private*/
+  uint32_t dirty[(TEST_OBJ_PROP_NR + 31) / 32];
 } test_obj_view_model_t;
 
 /**
@@ -0,0 +1,586 @@
+﻿#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "mvvm/base/utils.h"
+#include "test_rows.h"
+
+/***************test_row***************/;
+
+test_row_t* test_row_create(void) {
+  test_row_t* test_row = TKMEM_ZALLOC(test_row_t);
+  return_value_if_fail(test_row != NULL, NULL);
+
+  str_init(&(test_row->name), 10);
+
+  return test_row;
+}
+
+int test_row_cmp(test_row_t* a, test_row_t* b) {
+  return_value_if_fail(a != NULL && b != NULL, -1);
+  return (int)(a->stock) - (int)(b->stock);
+}
+
+static bool_t test_row_can_exec_sale(test_row_t* test_row, const char* args) {
+  return test_row->stock > 0;
+}
+
+static ret_t test_row_sale(test_row_t* test_row, const char* args) {
+  test_row->stock--;
+  return RET_OBJECT_CHANGED;
+}
+
+/***************test_rows_view_model***************/
+
+static ret_t test_rows_view_model_load_row(test_rows_view_model_t* test_rows, uint32_t index,
+                                           test_row_t* test_row) {
+  return_value_if_fail(index < test_rows->size, RET_BAD_PARAMS);
+
+  memset(test_row, 0x00, sizeof(*test_row));
+  test_row->name = test_rows->columns.name[index];
+  test_row->stock = test_rows->columns.stock[index];
+
+  return RET_OK;
+}
+
+static ret_t test_rows_view_model_store_row(test_rows_view_model_t* test_rows, uint32_t index,
+                                            const test_row_t* test_row) {
+  return_value_if_fail(index < test_rows->capacity, RET_BAD_PARAMS);
+
+  test_rows->columns.name[index] = test_row->name;
+  test_rows->columns.stock[index] = test_row->stock;
+
+  return RET_OK;
+}
+
+static ret_t test_rows_view_model_deinit_rows(test_rows_view_model_t* test_rows, uint32_t start,
+                                              uint32_t nr) {
+  uint32_t i = 0;
+  test_row_t row;
+  test_row_t* test_row = &row;
+
+  for (i = start; i < start + nr; i++) {
+    test_rows_view_model_load_row(test_rows, i, test_row);
+    str_reset(&(test_row->name));
+  }
+
+  return RET_OK;
+}
+
+static ret_t test_rows_view_model_extend(test_rows_view_model_t* test_rows, uint32_t nr) {
+  void* p = NULL;
+  uint32_t capacity = 0;
+
+  if (test_rows->size + nr <= test_rows->capacity) {
+    return RET_OK;
+  }
+
+  capacity = test_rows->capacity + (test_rows->capacity >> 1) + nr;
+
+  p = TKMEM_REALLOC(test_rows->ids, capacity * sizeof(uint32_t));
+  return_value_if_fail(p != NULL, RET_OOM);
+  test_rows->ids = (uint32_t*)p;
+
+  p = TKMEM_REALLOC(test_rows->columns.name, capacity * sizeof(str_t));
+  return_value_if_fail(p != NULL, RET_OOM);
+  test_rows->columns.name = (str_t*)p;
+
+  p = TKMEM_REALLOC(test_rows->columns.stock, capacity * sizeof(uint32_t));
+  return_value_if_fail(p != NULL, RET_OOM);
+  test_rows->columns.stock = (uint32_t*)p;
+
+  test_rows->capacity = capacity;
+
+  return RET_OK;
+}
+
+static ret_t test_rows_view_model_free_columns(test_rows_view_model_t* test_rows) {
+  TKMEM_FREE(test_rows->ids);
+  TKMEM_FREE(test_rows->columns.name);
+  TKMEM_FREE(test_rows->columns.stock);
+
+  test_rows->capacity = 0;
+
+  return RET_OK;
+}
+
+ret_t test_rows_view_model_append(view_model_t* view_model, const test_row_t* rows, uint32_t nr) {
+  uint32_t i = 0;
+  test_rows_view_model_t* test_rows = (test_rows_view_model_t*)(view_model);
+  return_value_if_fail(test_rows != NULL && (rows != NULL || nr == 0), RET_BAD_PARAMS);
+  return_value_if_fail(test_rows_view_model_extend(test_rows, nr) == RET_OK, RET_OOM);
+
+  for (i = 0; i < nr; i++) {
+    test_rows->ids[test_rows->size] = ++test_rows->next_id;
+    test_rows_view_model_store_row(test_rows, test_rows->size, rows + i);
+    test_rows->size++;
+  }
+
+  return RET_OK;
+}
+
+ret_t test_rows_view_model_remove_range(view_model_t* view_model, uint32_t index, uint32_t nr) {
+  uint32_t rest = 0;
+  test_rows_view_model_t* test_rows = (test_rows_view_model_t*)(view_model);
+  return_value_if_fail(test_rows != NULL && index <= test_rows->size, RET_BAD_PARAMS);
+  return_value_if_fail(nr <= test_rows->size - index, RET_BAD_PARAMS);
+
+  if (nr == 0) {
+    return RET_OK;
+  }
+
+  test_rows_view_model_deinit_rows(test_rows, index, nr);
+
+  rest = test_rows->size - index - nr;
+  memmove(test_rows->ids + index, test_rows->ids + index + nr, rest * sizeof(uint32_t));
+  memmove(test_rows->columns.name + index, test_rows->columns.name + index + nr,
+          rest * sizeof(str_t));
+  memmove(test_rows->columns.stock + index, test_rows->columns.stock + index + nr,
+          rest * sizeof(uint32_t));
+  test_rows->size -= nr;
+
+  return RET_OK;
+}
+
+uint32_t test_rows_view_model_get_id(view_model_t* view_model, uint32_t index) {
+  test_rows_view_model_t* test_rows = (test_rows_view_model_t*)(view_model);
+  return_value_if_fail(test_rows != NULL && index < test_rows->size, 0);
+
+  return test_rows->ids[index];
+}
+
+int32_t test_rows_view_model_index_of(view_model_t* view_model, uint32_t id) {
+  int32_t low = 0;
+  int32_t high = 0;
+  test_rows_view_model_t* test_rows = (test_rows_view_model_t*)(view_model);
+  return_value_if_fail(test_rows != NULL, -1);
+
+  /*ID按添加顺序递增，删除时保持顺序，可以二分查找*/
+  high = (int32_t)(test_rows->size) - 1;
+  while (low <= high) {
+    int32_t mid = low + ((high - low) >> 1);
+    uint32_t iter = test_rows->ids[mid];
+
+    if (iter == id) {
+      return mid;
+    } else if (iter < id) {
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+
+  return -1;
+}
+
+ret_t test_rows_view_model_remove(view_model_t* view_model, uint32_t index) {
+  test_rows_view_model_t* test_rows = (test_rows_view_model_t*)(view_model);
+  return_value_if_fail(test_rows != NULL && index < test_rows->size, RET_BAD_PARAMS);
+
+  return test_rows_view_model_remove_range(view_model, index, 1);
+}
+
+static ret_t test_rows_view_model_append_empty(view_model_t* view_model) {
+  test_row_t row;
+
+  /*空行的字段全为0(str_t为空串)，不需要分配内存*/
+  memset(&row, 0x00, sizeof(row));
+
+  return test_rows_view_model_append(view_model, &row, 1);
+}
+
+static ret_t test_rows_view_model_destroy_row(test_row_t* test_row) {
+  return_value_if_fail(test_row != NULL, RET_BAD_PARAMS);
+
+  str_reset(&(test_row->name));
+  TKMEM_FREE(test_row);
+
+  return RET_OK;
+}
+
+ret_t test_rows_view_model_add(view_model_t* view_model, test_row_t* test_row) {
+  ret_t ret = RET_OK;
+  return_value_if_fail(view_model != NULL && test_row != NULL, RET_BAD_PARAMS);
+
+  /*字段已经转移到列中，只释放对象本身*/
+  ret = test_rows_view_model_append(view_model, test_row, 1);
+  if (ret == RET_OK) {
+    TKMEM_FREE(test_row);
+  }
+
+  return ret;
+}
+
+uint32_t test_rows_view_model_size(view_model_t* view_model) {
+  test_rows_view_model_t* test_rows = (test_rows_view_model_t*)(view_model);
+  return_value_if_fail(test_rows != NULL, 0);
+
+  return test_rows->size;
+}
+
+ret_t test_rows_view_model_clear(view_model_t* view_model) {
+  test_rows_view_model_t* test_rows = (test_rows_view_model_t*)(view_model);
+  return_value_if_fail(test_rows != NULL, RET_BAD_PARAMS);
+
+  test_rows_view_model_deinit_rows(test_rows, 0, test_rows->size);
+  test_rows->size = 0;
+
+  return RET_OK;
+}
+
+static int32_t test_rows_view_model_get_prop_id(view_model_t* view_model, const char* name) {
+  return_value_if_fail(name != NULL, VIEW_MODEL_PROP_ID_INVALID);
+
+  if (tk_str_start_with(name, "item.")) {
+    name += 5;
+  }
+
+  switch (name[0]) {
+    case 'n': {
+      if (tk_str_eq("name", name)) {
+        return TEST_ROW_PROP_NAME;
+      }
+      break;
+    }
+    case 's': {
+      if (tk_str_eq("stock", name)) {
+        return TEST_ROW_PROP_STOCK;
+      } else if (tk_str_eq("style", name)) {
+        return TEST_ROW_PROP_STYLE;
+      }
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+
+  return VIEW_MODEL_PROP_ID_INVALID;
+}
+
+static ret_t test_rows_view_model_get_item_prop(view_model_t* vm, uint32_t index, int32_t id,
+                                                value_t* v) {
+  test_rows_view_model_t* test_rows = (test_rows_view_model_t*)(vm);
+  return_value_if_fail(index < test_rows->size, RET_BAD_PARAMS);
+
+  switch (id) {
+    case TEST_ROW_PROP_NAME: {
+      value_set_str(v, test_rows->columns.name[index].str);
+      return RET_OK;
+    }
+    case TEST_ROW_PROP_STOCK: {
+      value_set_uint32(v, test_rows->columns.stock[index]);
+      return RET_OK;
+    }
+    case TEST_ROW_PROP_STYLE: {
+      value_set_str(v, index % 2 ? "odd" : "even");
+      return RET_OK;
+    }
+    default: {
+      break;
+    }
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static ret_t test_rows_view_model_get_prop_by_id(view_model_t* vm, int32_t id, value_t* v) {
+  return test_rows_view_model_get_item_prop(vm, VIEW_MODEL_ARRAY(vm)->cursor, id, v);
+}
+
+static ret_t test_rows_view_model_get_prop(object_t* obj, const char* name, value_t* v) {
+  int32_t id = 0;
+  uint32_t index = 0;
+  view_model_t* vm = VIEW_MODEL(obj);
+
+  if (tk_str_eq(VIEW_MODEL_PROP_ITEMS, name)) {
+    value_set_int(v, test_rows_view_model_size(VIEW_MODEL(obj)));
+
+    return RET_OK;
+  } else if (tk_str_eq(VIEW_MODEL_PROP_CURSOR, name)) {
+    value_set_int(v, VIEW_MODEL_ARRAY(obj)->cursor);
+
+    return RET_OK;
+  }
+
+  name = destruct_array_prop_name(name, &index);
+  return_value_if_fail(name != NULL, RET_BAD_PARAMS);
+
+  id = test_rows_view_model_get_prop_id(vm, name);
+  if (id == VIEW_MODEL_PROP_ID_INVALID) {
+    log_debug("not found %s\n", name);
+    return RET_NOT_FOUND;
+  }
+
+  return test_rows_view_model_get_item_prop(vm, index, id, v);
+}
+
+static const uint32_t* test_rows_view_model_get_dirty_props(view_model_t* view_model,
+                                                            uint32_t* size) {
+  test_rows_view_model_t* vm = (test_rows_view_model_t*)(view_model);
+
+  *size = sizeof(vm->dirty) / sizeof(vm->dirty[0]);
+
+  return vm->dirty;
+}
+
+static ret_t test_rows_view_model_clear_dirty_props(view_model_t* view_model) {
+  test_rows_view_model_t* vm = (test_rows_view_model_t*)(view_model);
+
+  memset(vm->dirty, 0x00, sizeof(vm->dirty));
+
+  return RET_OK;
+}
+
+static ret_t test_rows_view_model_mark_dirty(test_rows_view_model_t* vm, int32_t id) {
+  vm->dirty[id / 32] |= 1u << (id % 32);
+
+  return RET_OK;
+}
+
+static ret_t test_rows_view_model_set_item_prop(view_model_t* vm, uint32_t index, int32_t id,
+                                                const value_t* v) {
+  value_t old;
+  test_rows_view_model_t* test_rows = (test_rows_view_model_t*)(vm);
+  return_value_if_fail(index < test_rows->size, RET_BAD_PARAMS);
+
+  if (test_rows_view_model_get_item_prop(vm, index, id, &old) == RET_OK && value_equal(&old, v)) {
+    return RET_OK;
+  }
+
+  switch (id) {
+    case TEST_ROW_PROP_NAME: {
+      str_from_value(&(test_rows->columns.name[index]), v);
+      break;
+    }
+    case TEST_ROW_PROP_STOCK: {
+      test_rows->columns.stock[index] = value_uint32(v);
+      break;
+    }
+    default: {
+      return RET_NOT_FOUND;
+    }
+  }
+
+  return test_rows_view_model_mark_dirty(test_rows, id);
+}
+
+static ret_t test_rows_view_model_set_prop_by_id(view_model_t* vm, int32_t id, const value_t* v) {
+  return test_rows_view_model_set_item_prop(vm, VIEW_MODEL_ARRAY(vm)->cursor, id, v);
+}
+
+static ret_t test_rows_view_model_set_prop(object_t* obj, const char* name, const value_t* v) {
+  int32_t id = 0;
+  uint32_t index = 0;
+  ret_t ret = RET_OK;
+  view_model_t* vm = VIEW_MODEL(obj);
+
+  if (tk_str_eq(VIEW_MODEL_PROP_CURSOR, name)) {
+    view_model_array_set_cursor(vm, value_int(v));
+
+    return RET_OK;
+  }
+
+  name = destruct_array_prop_name(name, &index);
+  return_value_if_fail(name != NULL, RET_BAD_PARAMS);
+
+  id = test_rows_view_model_get_prop_id(vm, name);
+  if (id == VIEW_MODEL_PROP_ID_INVALID) {
+    log_debug("not found %s\n", name);
+    return RET_NOT_FOUND;
+  }
+
+  ret = test_rows_view_model_set_item_prop(vm, index, id, v);
+  /*随后object_set_prop触发EVT_PROP_CHANGED，绑定上下文全部刷新，不需要再发布脏属性*/
+  test_rows_view_model_clear_dirty_props(vm);
+
+  return ret;
+}
+
+static const view_model_snapshot_field_t s_test_row_snapshot_fields[] = {
+    {0x8d39bde6u, TEST_ROW_PROP_NAME},
+    {0xc20c8395u, TEST_ROW_PROP_STOCK}};
+
+static ret_t test_rows_view_model_save_snapshot(view_model_t* vm, view_model_snapshot_t* snapshot) {
+  value_t v;
+  uint32_t i = 0;
+  uint32_t index = 0;
+  uint32_t size = test_rows_view_model_size(vm);
+
+  for (index = 0; index < size; index++) {
+    value_set_uint32(&v, index);
+    return_value_if_fail(
+        view_model_snapshot_write(snapshot, VIEW_MODEL_SNAPSHOT_FIELD_ITEM, &v) == RET_OK, RET_OOM);
+
+    for (i = 0; i < ARRAY_SIZE(s_test_row_snapshot_fields); i++) {
+      const view_model_snapshot_field_t* iter = s_test_row_snapshot_fields + i;
+
+      if (test_rows_view_model_get_item_prop(vm, index, iter->prop_id, &v) == RET_OK) {
+        return_value_if_fail(view_model_snapshot_write(snapshot, iter->field_id, &v) == RET_OK,
+                             RET_OOM);
+      }
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t test_rows_view_model_load_snapshot(view_model_t* vm, view_model_snapshot_t* snapshot) {
+  value_t v;
+  int32_t id = 0;
+  int32_t index = -1;
+  ret_t ret = RET_OK;
+  uint32_t field_id = 0;
+
+  /*先检查整个快照，数据损坏时不修改模型*/
+  ret = view_model_snapshot_validate(snapshot);
+  if (ret != RET_OK) {
+    return ret;
+  }
+
+  test_rows_view_model_clear(vm);
+  while ((ret = view_model_snapshot_read(snapshot, &field_id, &v)) == RET_OK) {
+    if (field_id == VIEW_MODEL_SNAPSHOT_FIELD_ITEM) {
+      return_value_if_fail(test_rows_view_model_append_empty(vm) == RET_OK, RET_OOM);
+      index = test_rows_view_model_size(vm) - 1;
+    } else if (index >= 0) {
+      id = view_model_snapshot_find_field(s_test_row_snapshot_fields,
+                                          ARRAY_SIZE(s_test_row_snapshot_fields), field_id);
+      if (id != VIEW_MODEL_PROP_ID_INVALID) {
+        test_rows_view_model_set_item_prop(vm, index, id, &v);
+      }
+    }
+  }
+
+  return ret == RET_EOS ? RET_OK : ret;
+}
+
+static bool_t test_rows_view_model_can_exec(object_t* obj, const char* name, const char* args) {
+  test_row_t row;
+  test_row_t* test_row = &row;
+  uint32_t index = tk_atoi(args);
+  view_model_t* vm = VIEW_MODEL(obj);
+  test_rows_view_model_t* test_rows = (test_rows_view_model_t*)(obj);
+
+  if (tk_str_ieq(name, "add")) {
+    return TRUE;
+  } else if (tk_str_ieq(name, "clear")) {
+    return test_rows_view_model_size(vm) > 0;
+  }
+
+  return_value_if_fail(test_rows_view_model_load_row(test_rows, index, test_row) == RET_OK, FALSE);
+
+  if (tk_str_ieq(name, "remove")) {
+    return index < test_rows_view_model_size(vm);
+  }
+
+  switch (name[0]) {
+    case 's': {
+      if (tk_str_eq("sale", name)) {
+        return test_row_can_exec_sale(test_row, args);
+      }
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+
+  return FALSE;
+}
+
+static ret_t test_rows_view_model_exec_row(test_row_t* test_row, const char* name,
+                                           const char* args) {
+  switch (name[0]) {
+    case 's': {
+      if (tk_str_eq("sale", name)) {
+        return test_row_sale(test_row, args);
+      }
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+
+  log_debug("not found %s\n", name);
+  return RET_NOT_FOUND;
+}
+
+static ret_t test_rows_view_model_exec(object_t* obj, const char* name, const char* args) {
+  ret_t ret = RET_OK;
+  test_row_t row;
+  test_row_t* test_row = &row;
+  uint32_t index = tk_atoi(args);
+  view_model_t* vm = VIEW_MODEL(obj);
+  test_rows_view_model_t* test_rows = (test_rows_view_model_t*)(obj);
+
+  if (tk_str_ieq(name, "add")) {
+    test_row_t* item = test_row_create();
+    return_value_if_fail(item != NULL, RET_OOM);
+
+    /*添加失败时对象仍然属于调用者*/
+    if (test_rows_view_model_add(vm, item) != RET_OK) {
+      test_rows_view_model_destroy_row(item);
+      return RET_OOM;
+    }
+
+    return RET_ITEMS_CHANGED;
+  } else if (tk_str_ieq(name, "clear")) {
+    ENSURE(test_rows_view_model_clear(vm) == RET_OK);
+    return RET_ITEMS_CHANGED;
+  }
+
+  return_value_if_fail(test_rows_view_model_load_row(test_rows, index, test_row) == RET_OK,
+                       RET_BAD_PARAMS);
+
+  if (tk_str_ieq(name, "remove")) {
+    ENSURE(test_rows_view_model_remove(vm, index) == RET_OK);
+    return RET_ITEMS_CHANGED;
+  }
+
+  ret = test_rows_view_model_exec_row(test_row, name, args);
+  test_rows_view_model_store_row(test_rows, index, test_row);
+
+  return ret;
+}
+
+static ret_t test_rows_view_model_on_destroy(object_t* obj) {
+  test_rows_view_model_t* vm = (test_rows_view_model_t*)(obj);
+  return_value_if_fail(vm != NULL, RET_BAD_PARAMS);
+
+  test_rows_view_model_clear(VIEW_MODEL(obj));
+  test_rows_view_model_free_columns(vm);
+
+  return view_model_array_deinit(VIEW_MODEL(obj));
+}
+
+static const view_model_vtable_t s_test_rows_view_model_vm_vtable = {
+  .get_prop_id = test_rows_view_model_get_prop_id,
+  .get_prop_by_id = test_rows_view_model_get_prop_by_id,
+  .set_prop_by_id = test_rows_view_model_set_prop_by_id,
+  .get_dirty_props = test_rows_view_model_get_dirty_props,
+  .clear_dirty_props = test_rows_view_model_clear_dirty_props,
+  .save_snapshot = test_rows_view_model_save_snapshot,
+  .load_snapshot = test_rows_view_model_load_snapshot
+};
+
+static const object_vtable_t s_test_rows_view_model_vtable = {
+  .type = "test_row",
+  .desc = "columnar collection for tests",
+  .is_collection = TRUE,
+  .size = sizeof(test_rows_view_model_t),
+  .exec = test_rows_view_model_exec,
+  .can_exec = test_rows_view_model_can_exec,
+  .get_prop = test_rows_view_model_get_prop,
+  .set_prop = test_rows_view_model_set_prop,
+  .on_destroy = test_rows_view_model_on_destroy
+};
+
+view_model_t* test_rows_view_model_create(navigator_request_t* req) {
+  object_t* obj = object_create(&s_test_rows_view_model_vtable);
+  view_model_t* vm = view_model_array_init(VIEW_MODEL(obj));
+
+  return_value_if_fail(vm != NULL, NULL);
+  vm->vt = &s_test_rows_view_model_vm_vtable;
+
+  return vm;
+}
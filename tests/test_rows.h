@@ -0,0 +1,136 @@
+﻿
+#ifndef TK_TEST_ROW_H
+#define TK_TEST_ROW_H
+
+#include "tkc/str.h"
+#include "mvvm/base/view_model_array.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class test_row_t
+ *
+ * columnar collection for tests
+ *
+ */
+typedef struct _test_row_t {
+  str_t name;
+  uint32_t stock;
+} test_row_t;
+
+/**
+ * @enum test_row_prop_id_t
+ * @prefix TEST_ROW_PROP_
+ * test_row的属性ID。
+ */
+typedef enum _test_row_prop_id_t {
+  /**
+   * @const TEST_ROW_PROP_NAME
+   * name属性的ID。
+   */
+  TEST_ROW_PROP_NAME = 0,
+  /**
+   * @const TEST_ROW_PROP_STOCK
+   * stock属性的ID。
+   */
+  TEST_ROW_PROP_STOCK,
+  /**
+   * @const TEST_ROW_PROP_STYLE
+   * style属性的ID。
+   */
+  TEST_ROW_PROP_STYLE,
+  TEST_ROW_PROP_NR
+} test_row_prop_id_t;
+
+/**
+ * @class test_rows_view_model_t
+ *
+ * view model of test_row
+ *
+ */
+typedef struct _test_rows_view_model_t {
+  view_model_array_t view_model_array;
+
+  /*model object*/
+  uint32_t size;
+  uint32_t capacity;
+  uint32_t next_id;
+  uint32_t* ids;
+  struct {
+    str_t* name;
+    uint32_t* stock;
+  } columns;
+
+  /*private*/
+  uint32_t dirty[(TEST_ROW_PROP_NR + 31) / 32];
+} test_rows_view_model_t;
+
+/**
+ * @method test_rows_view_model_create
+ * 创建test_row view model对象。
+ *
+ * @annotation ["constructor"]
+ * @param {navigator_request_t*} req 请求参数。
+ *
+ * @return {view_model_t} 返回view_model_t对象。
+ */
+view_model_t* test_rows_view_model_create(navigator_request_t* req);
+
+/**
+ * @method test_rows_view_model_append
+ * 批量追加记录。记录中的字段(如str_t)直接转移给集合，调用者只需要释放rows本身。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {const test_row_t*} rows 记录数组。
+ * @param {uint32_t} nr 记录的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t test_rows_view_model_append(view_model_t* view_model, const test_row_t* rows, uint32_t nr);
+
+/**
+ * @method test_rows_view_model_remove_range
+ * 删除从index开始的nr条记录。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} index 第一条记录的序数。
+ * @param {uint32_t} nr 记录的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t test_rows_view_model_remove_range(view_model_t* view_model, uint32_t index, uint32_t nr);
+
+/**
+ * @method test_rows_view_model_get_id
+ * 获取记录的ID。ID在添加时分配，删除其它记录后保持不变。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} index 记录的序数。
+ *
+ * @return {uint32_t} 返回记录的ID，失败返回0。
+ */
+uint32_t test_rows_view_model_get_id(view_model_t* view_model, uint32_t index);
+
+/**
+ * @method test_rows_view_model_index_of
+ * 根据记录的ID查找记录的序数。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} id 记录的ID。
+ *
+ * @return {int32_t} 返回记录的序数，找不到返回-1。
+ */
+int32_t test_rows_view_model_index_of(view_model_t* view_model, uint32_t id);
+
+/*public for test*/
+
+test_row_t* test_row_create(void);
+
+ret_t test_rows_view_model_clear(view_model_t* view_model);
+uint32_t test_rows_view_model_size(view_model_t* view_model);
+ret_t test_rows_view_model_remove(view_model_t* view_model, uint32_t index);
+ret_t test_rows_view_model_add(view_model_t* view_model, test_row_t* test_row);
+
+END_C_DECLS
+
+#endif /*TK_TEST_ROW_H*/
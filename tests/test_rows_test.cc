@@ -0,0 +1,153 @@
+﻿#include "tkc/utils.h"
+#include "mvvm/base/view_model_snapshot.h"
+#include "gtest/gtest.h"
+#include "test_rows.h"
+
+static ret_t test_rows_append_n(view_model_t* vm, uint32_t start, uint32_t nr) {
+  uint32_t i = 0;
+  test_row_t rows[8];
+  char name[32];
+
+  for (i = 0; i < nr; i++) {
+    memset(rows + i, 0x00, sizeof(rows[i]));
+    tk_snprintf(name, sizeof(name), "row%u", start + i);
+    str_set(&(rows[i].name), name);
+    rows[i].stock = start + i;
+  }
+
+  return test_rows_view_model_append(vm, rows, nr);
+}
+
+static const char* test_rows_get_name(view_model_t* vm, uint32_t index) {
+  char name[32];
+  tk_snprintf(name, sizeof(name), "[%u].name", index);
+
+  return object_get_prop_str(OBJECT(vm), name);
+}
+
+TEST(TestRows, append) {
+  view_model_t* vm = test_rows_view_model_create(NULL);
+
+  ASSERT_EQ(test_rows_append_n(vm, 0, 8), RET_OK);
+  ASSERT_EQ(test_rows_append_n(vm, 8, 8), RET_OK);
+  ASSERT_EQ(test_rows_view_model_size(vm), 16u);
+  ASSERT_EQ(object_get_prop_int(OBJECT(vm), VIEW_MODEL_PROP_ITEMS, 0), 16);
+
+  ASSERT_STREQ(test_rows_get_name(vm, 0), "row0");
+  ASSERT_STREQ(test_rows_get_name(vm, 15), "row15");
+  ASSERT_EQ(object_get_prop_int(OBJECT(vm), "[9].stock", 0), 9);
+
+  ASSERT_EQ(test_rows_view_model_get_id(vm, 0), 1u);
+  ASSERT_EQ(test_rows_view_model_get_id(vm, 15), 16u);
+  ASSERT_EQ(test_rows_view_model_get_id(vm, 16), 0u);
+
+  object_unref(OBJECT(vm));
+}
+
+TEST(TestRows, remove_range) {
+  view_model_t* vm = test_rows_view_model_create(NULL);
+
+  ASSERT_EQ(test_rows_append_n(vm, 0, 8), RET_OK);
+
+  ASSERT_EQ(test_rows_view_model_remove_range(vm, 2, 3), RET_OK);
+  ASSERT_EQ(test_rows_view_model_size(vm), 5u);
+  ASSERT_STREQ(test_rows_get_name(vm, 1), "row1");
+  ASSERT_STREQ(test_rows_get_name(vm, 2), "row5");
+  ASSERT_STREQ(test_rows_get_name(vm, 4), "row7");
+
+  ASSERT_EQ(test_rows_view_model_remove_range(vm, 5, 0), RET_OK);
+  ASSERT_NE(test_rows_view_model_remove_range(vm, 4, 2), RET_OK);
+  ASSERT_NE(test_rows_view_model_remove_range(vm, 6, 0), RET_OK);
+  ASSERT_EQ(test_rows_view_model_size(vm), 5u);
+
+  ASSERT_EQ(test_rows_view_model_remove(vm, 0), RET_OK);
+  ASSERT_STREQ(test_rows_get_name(vm, 0), "row1");
+
+  ASSERT_EQ(test_rows_view_model_remove_range(vm, 0, 4), RET_OK);
+  ASSERT_EQ(test_rows_view_model_size(vm), 0u);
+
+  object_unref(OBJECT(vm));
+}
+
+TEST(TestRows, index_of) {
+  uint32_t i = 0;
+  view_model_t* vm = test_rows_view_model_create(NULL);
+
+  ASSERT_EQ(test_rows_view_model_index_of(vm, 1), -1);
+
+  for (i = 0; i < 4; i++) {
+    ASSERT_EQ(test_rows_append_n(vm, i * 8, 8), RET_OK);
+  }
+
+  for (i = 0; i < 32; i++) {
+    ASSERT_EQ(test_rows_view_model_index_of(vm, test_rows_view_model_get_id(vm, i)), (int32_t)i);
+  }
+
+  /*删除后ID保持不变，序数随之前移*/
+  ASSERT_EQ(test_rows_view_model_remove_range(vm, 3, 10), RET_OK);
+  ASSERT_EQ(test_rows_view_model_index_of(vm, 3), 2);
+  ASSERT_EQ(test_rows_view_model_index_of(vm, 4), -1);
+  ASSERT_EQ(test_rows_view_model_index_of(vm, 13), -1);
+  ASSERT_EQ(test_rows_view_model_index_of(vm, 14), 3);
+  ASSERT_EQ(test_rows_view_model_index_of(vm, 32), 21);
+  ASSERT_EQ(test_rows_view_model_index_of(vm, 33), -1);
+
+  for (i = 0; i < test_rows_view_model_size(vm); i++) {
+    ASSERT_EQ(test_rows_view_model_index_of(vm, test_rows_view_model_get_id(vm, i)), (int32_t)i);
+  }
+
+  /*新记录的ID继续递增*/
+  ASSERT_EQ(test_rows_append_n(vm, 32, 1), RET_OK);
+  ASSERT_EQ(test_rows_view_model_get_id(vm, 22), 33u);
+  ASSERT_EQ(test_rows_view_model_index_of(vm, 33), 22);
+
+  object_unref(OBJECT(vm));
+}
+
+TEST(TestRows, exec) {
+  view_model_t* vm = test_rows_view_model_create(NULL);
+
+  ASSERT_EQ(object_can_exec(OBJECT(vm), "add", NULL), TRUE);
+  ASSERT_EQ(object_exec(OBJECT(vm), "add", NULL), RET_ITEMS_CHANGED);
+  ASSERT_EQ(object_exec(OBJECT(vm), "add", NULL), RET_ITEMS_CHANGED);
+  ASSERT_EQ(test_rows_view_model_size(vm), 2u);
+  ASSERT_STREQ(test_rows_get_name(vm, 1), "");
+
+  ASSERT_EQ(object_set_prop_int(OBJECT(vm), "[1].stock", 1), RET_OK);
+  ASSERT_EQ(object_can_exec(OBJECT(vm), "sale", "0"), FALSE);
+  ASSERT_EQ(object_can_exec(OBJECT(vm), "sale", "1"), TRUE);
+  ASSERT_EQ(object_exec(OBJECT(vm), "sale", "1"), RET_OBJECT_CHANGED);
+  ASSERT_EQ(object_get_prop_int(OBJECT(vm), "[1].stock", -1), 0);
+
+  ASSERT_EQ(object_exec(OBJECT(vm), "remove", "0"), RET_ITEMS_CHANGED);
+  ASSERT_EQ(test_rows_view_model_size(vm), 1u);
+  ASSERT_EQ(object_exec(OBJECT(vm), "clear", NULL), RET_ITEMS_CHANGED);
+  ASSERT_EQ(test_rows_view_model_size(vm), 0u);
+
+  object_unref(OBJECT(vm));
+}
+
+TEST(TestRows, snapshot) {
+  uint32_t size = 0;
+  const void* data = NULL;
+  view_model_snapshot_t ws;
+  view_model_t* vm = test_rows_view_model_create(NULL);
+  view_model_t* vm2 = test_rows_view_model_create(NULL);
+
+  ASSERT_EQ(test_rows_append_n(vm, 0, 5), RET_OK);
+  ASSERT_EQ(test_rows_append_n(vm2, 100, 2), RET_OK);
+
+  ASSERT_EQ(view_model_snapshot_init(&ws) != NULL, true);
+  ASSERT_EQ(view_model_save_snapshot(vm, &ws), RET_OK);
+  data = view_model_snapshot_get_data(&ws, &size);
+
+  ASSERT_EQ(view_model_load_snapshot_from_data(vm2, data, size), RET_OK);
+  ASSERT_EQ(test_rows_view_model_size(vm2), 5u);
+  ASSERT_STREQ(test_rows_get_name(vm2, 0), "row0");
+  ASSERT_STREQ(test_rows_get_name(vm2, 4), "row4");
+  ASSERT_EQ(object_get_prop_int(OBJECT(vm2), "[3].stock", 0), 3);
+
+  view_model_snapshot_deinit(&ws);
+  object_unref(OBJECT(vm));
+  object_unref(OBJECT(vm2));
+}
@@ -0,0 +1,210 @@
+#include "tkc/utils.h"
+#include "tkc/expr_eval.h"
+#include "mvvm/base/typed_expr.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using std::string;
+
+static uint32_t s_reads = 0;
+
+static ret_t get_variable(void* ctx, const char* name, value_t* v) {
+  s_reads++;
+
+  if (tk_str_eq(name, "a")) {
+    value_set_int(v, 3);
+  } else if (tk_str_eq(name, "price")) {
+    value_set_double(v, 2.5);
+  } else if (tk_str_eq(name, "name")) {
+    value_set_str(v, "awtk");
+  } else if (tk_str_eq(name, "big")) {
+    value_set_int64(v, 9007199254740993ll);
+  } else if (tk_str_eq(name, "ubig")) {
+    value_set_uint64(v, 18446744073709551615ull);
+  } else if (tk_str_eq(name, "flag")) {
+    value_set_bool(v, TRUE);
+  } else if (tk_str_eq(name, "[1].name")) {
+    value_set_str(v, "second");
+  } else {
+    return RET_NOT_FOUND;
+  }
+
+  return RET_OK;
+}
+
+static ret_t eval(const char* expr, value_t* v) {
+  static str_t buff;
+
+  if (buff.str == NULL) {
+    str_init(&buff, 0);
+  }
+
+  return typed_expr_eval(expr, get_variable, NULL, &buff, v);
+}
+
+static string eval_str(const char* expr) {
+  value_t v;
+
+  if (eval(expr, &v) != RET_OK) {
+    return "error";
+  }
+
+  return v.type == VALUE_TYPE_STRING ? value_str(&v) : "not string";
+}
+
+TEST(TypedExpr, integer) {
+  value_t v;
+
+  ASSERT_EQ(eval("1 + 2 * 3", &v), RET_OK);
+  ASSERT_EQ(v.type, VALUE_TYPE_INT64);
+  ASSERT_EQ(value_int64(&v), 7);
+
+  ASSERT_EQ(eval("(1 + 2) * -$a", &v), RET_OK);
+  ASSERT_EQ(value_int64(&v), -9);
+
+  ASSERT_EQ(eval("8 / 2", &v), RET_OK);
+  ASSERT_EQ(v.type, VALUE_TYPE_INT64);
+  ASSERT_EQ(value_int64(&v), 4);
+
+  /*除不尽时和eval_execute一样为浮点数*/
+  ASSERT_EQ(eval("7 / 2", &v), RET_OK);
+  ASSERT_EQ(v.type, VALUE_TYPE_DOUBLE);
+  ASSERT_EQ(value_double(&v), 3.5);
+
+  ASSERT_EQ(eval("7 % 3 + 0xff", &v), RET_OK);
+  ASSERT_EQ(value_int64(&v), 256);
+
+  ASSERT_EQ(eval("(6 & 3) + (6 | 3) * 10 + (6 ^ 3) * 100 + ~0", &v), RET_OK);
+  ASSERT_EQ(value_int64(&v), 2 + 70 + 500 - 1);
+
+  ASSERT_EQ(eval("$price * 2", &v), RET_OK);
+  ASSERT_EQ(v.type, VALUE_TYPE_DOUBLE);
+  ASSERT_EQ(value_double(&v), 5.0);
+}
+
+TEST(TypedExpr, int64) {
+  value_t v;
+
+  /*double只有53位有效数字*/
+  ASSERT_EQ(eval("$big + 2", &v), RET_OK);
+  ASSERT_EQ(v.type, VALUE_TYPE_INT64);
+  ASSERT_EQ(value_int64(&v), 9007199254740995ll);
+
+  ASSERT_EQ(eval("$ubig - 1", &v), RET_OK);
+  ASSERT_EQ(v.type, VALUE_TYPE_UINT64);
+  ASSERT_EQ(value_uint64(&v), 18446744073709551614ull);
+
+  ASSERT_EQ(eval("$ubig > $big", &v), RET_OK);
+  ASSERT_EQ(value_bool(&v), TRUE);
+  ASSERT_EQ(eval("-1 < $ubig", &v), RET_OK);
+  ASSERT_EQ(value_bool(&v), TRUE);
+
+  /*溢出时为浮点数*/
+  ASSERT_EQ(eval("9223372036854775807 + 1", &v), RET_OK);
+  ASSERT_EQ(v.type, VALUE_TYPE_DOUBLE);
+}
+
+TEST(TypedExpr, compare) {
+  value_t v;
+
+  ASSERT_EQ(eval("$a > 1", &v), RET_OK);
+  ASSERT_EQ(v.type, VALUE_TYPE_BOOL);
+  ASSERT_EQ(value_bool(&v), TRUE);
+
+  ASSERT_EQ(eval("$a <= 2 || $a != 3", &v), RET_OK);
+  ASSERT_EQ(value_bool(&v), FALSE);
+
+  ASSERT_EQ(eval("$name == \"awtk\" && 'abc' < 'abd' && !($a >= 4)", &v), RET_OK);
+  ASSERT_EQ(value_bool(&v), TRUE);
+
+  ASSERT_EQ(eval("$flag == true", &v), RET_OK);
+  ASSERT_EQ(value_bool(&v), TRUE);
+
+  ASSERT_EQ(eval("'10' == 10.0", &v), RET_OK);
+  ASSERT_EQ(value_bool(&v), TRUE);
+}
+
+TEST(TypedExpr, short_circuit) {
+  value_t v;
+
+  /*不需要计算的分支不读取变量(不存在的变量也不报错)，也不做除法*/
+  s_reads = 0;
+  ASSERT_EQ(eval("$a > 100 && $none > 1 / 0", &v), RET_OK);
+  ASSERT_EQ(value_bool(&v), FALSE);
+  ASSERT_EQ(s_reads, 1u);
+
+  ASSERT_EQ(eval("$a > 0 || $none", &v), RET_OK);
+  ASSERT_EQ(value_bool(&v), TRUE);
+
+  ASSERT_EQ(eval_str("$a > 1 ? 'high' : $none"), string("high"));
+  ASSERT_EQ(eval_str("$a > 5 ? $none : $a > 2 ? 'middle' : 'low'"), string("middle"));
+}
+
+TEST(TypedExpr, string) {
+  value_t v;
+
+  ASSERT_EQ(eval_str("'Hello, ' + $name"), string("Hello, awtk"));
+  ASSERT_EQ(eval_str("$name + 1 + $price"), string("awtk12.5"));
+  ASSERT_EQ(eval_str("'it\\'s'"), string("it's"));
+  ASSERT_EQ(eval_str("$[1].name"), string("second"));
+
+  /*结果在缓冲区中，不需要释放*/
+  ASSERT_EQ(eval("$flag ? 'yes' : 'no'", &v), RET_OK);
+  ASSERT_EQ(string(value_str(&v)), string("yes"));
+  ASSERT_EQ(v.free_handle, FALSE);
+}
+
+TEST(TypedExpr, error) {
+  value_t v;
+
+  ASSERT_NE(eval("1 +", &v), RET_OK);
+  ASSERT_NE(eval("(1 + 2", &v), RET_OK);
+  ASSERT_NE(eval("1 2", &v), RET_OK);
+  ASSERT_NE(eval("$a / 0", &v), RET_OK);
+  ASSERT_NE(eval("$none + 1", &v), RET_OK);
+  ASSERT_NE(eval("'abc", &v), RET_OK);
+  ASSERT_NE(eval("a + 1", &v), RET_OK);
+}
+
+static EvalResult legacy_get_variable(const char* name, void* user_data, ExprValue* output) {
+  value_t v;
+
+  if (get_variable(user_data, name, &v) != RET_OK) {
+    return eval_default_hooks()->get_variable(name, user_data, output);
+  }
+
+  if (v.type == VALUE_TYPE_STRING) {
+    expr_value_set_string(output, value_str(&v), strlen(value_str(&v)));
+  } else {
+    expr_value_set_number(output, value_double(&v));
+  }
+
+  return EVAL_RESULT_OK;
+}
+
+/*和eval_execute的结果相同*/
+TEST(TypedExpr, same_as_legacy) {
+  uint32_t k = 0;
+  EvalHooks hooks;
+  const char* exprs[] = {"$a * 2 + 1", "($a > 1) ? \"high\" : \"low\"", "$price * $a - 0.5",
+                         "\"name: \" + $name"};
+
+  hooks.get_func = eval_default_hooks()->get_func;
+  hooks.get_variable = legacy_get_variable;
+
+  for (k = 0; k < ARRAY_SIZE(exprs); k++) {
+    value_t v;
+    ExprValue result;
+
+    ASSERT_EQ(eval(exprs[k], &v), RET_OK);
+    ASSERT_EQ(eval_execute(exprs[k], &hooks, NULL, &result), EVAL_RESULT_OK);
+
+    if (result.type == EXPR_VALUE_TYPE_STRING) {
+      ASSERT_EQ(string(value_str(&v)), string(result.v.str.str));
+    } else {
+      ASSERT_EQ(value_double(&v), result.v.val);
+    }
+    expr_value_clear(&result);
+  }
+}
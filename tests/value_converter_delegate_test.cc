@@ -64,3 +64,42 @@ TEST(ValueConverterDelegate, factory) {
 
   object_unref(OBJECT(c));
 }
+
+static ret_t to_str_positive(const value_t* from, value_t* to) {
+  return_value_if_fail(value_int(from) >= 0, RET_FAIL);
+
+  return to_str(from, to);
+}
+
+TEST(ValueConverterDelegate, batch) {
+  uint32_t i = 0;
+  value_t from[3];
+  value_t to[3];
+  value_t back[3];
+  value_converter_t* c = value_converter_delegate_create(to_int, to_str);
+
+  for (i = 0; i < 3; i++) {
+    value_set_int(from + i, 100 + i);
+  }
+
+  ASSERT_EQ(value_converter_to_view_batch(c, from, to, 3), RET_OK);
+  ASSERT_EQ(string(value_str(to)), string("100"));
+  ASSERT_EQ(string(value_str(to + 2)), string("102"));
+
+  ASSERT_EQ(value_converter_to_model_batch(c, to, back, 3), RET_OK);
+  ASSERT_EQ(value_int(back + 1), 101);
+
+  for (i = 0; i < 3; i++) {
+    value_reset(to + i);
+  }
+  object_unref(OBJECT(c));
+
+  /*任何一项失败时，已经转换的结果被释放*/
+  c = value_converter_delegate_create(to_int, to_str_positive);
+  value_set_int(from + 2, -1);
+  ASSERT_NE(value_converter_to_view_batch(c, from, to, 3), RET_OK);
+  ASSERT_EQ(to[0].type, VALUE_TYPE_INVALID);
+  ASSERT_EQ(to[1].type, VALUE_TYPE_INVALID);
+
+  object_unref(OBJECT(c));
+}
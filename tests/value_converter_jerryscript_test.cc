@@ -1,4 +1,5 @@
-﻿#include "mvvm/jerryscript/view_model_jerryscript.h"
+﻿#include "mvvm/jerryscript/mvvm_jerryscript.h"
+#include "mvvm/jerryscript/view_model_jerryscript.h"
 #include "mvvm/jerryscript/value_converter_jerryscript.h"
 #include "gtest/gtest.h"
 
@@ -31,6 +32,38 @@ TEST(ValueConverterJerryScript, basic) {
   object_unref(OBJECT(view_model));
 }
 
+TEST(ValueConverterJerryScript, reload) {
+  const char* code =
+      "var ValueConverters = {}; \
+        ValueConverters.jsdummy = {\
+          toView:function(v) {return v+1;}, \
+          toModel:function(v) {return v-1} \
+        }";
+  const char* code1 =
+      "ValueConverters.jsdummy = {\
+          toView:function(v) {return v+2;}, \
+          toModel:function(v) {return v-2} \
+        }";
+  value_t from;
+  value_t to;
+  view_model_t* view_model = view_model_jerryscript_create("test", code, strlen(code), NULL);
+
+  value_set_int(&from, 100);
+  value_converter_t* c = value_converter_create("jsdummy");
+  ASSERT_NE(c, VALUE_CONVERTER(NULL));
+  ASSERT_EQ(value_converter_to_view(c, &from, &to), RET_OK);
+  ASSERT_EQ(value_int(&to), 101);
+
+  ASSERT_EQ(jerryscript_run("test1", code1, strlen(code1)), RET_OK);
+  ASSERT_EQ(value_converter_to_view(c, &from, &to), RET_OK);
+  ASSERT_EQ(value_int(&to), 102);
+  ASSERT_EQ(value_converter_to_model(c, &from, &to), RET_OK);
+  ASSERT_EQ(value_int(&to), 98);
+
+  object_unref(OBJECT(c));
+  object_unref(OBJECT(view_model));
+}
+
 TEST(ValueConverterJerryScript, not_exist) {
   const char* code = "var ValueConverters = {};";
 
@@ -41,3 +74,36 @@ TEST(ValueConverterJerryScript, not_exist) {
 
   object_unref(OBJECT(view_model));
 }
+
+TEST(ValueConverterJerryScript, batch_map) {
+  const char* code =
+      "var ValueConverters = {}; \
+        ValueConverters.jsbatch = {\
+          k:10, \
+          toView:function(v, i) {return i === undefined ? v + this.k : -1;}, \
+          toModel:function(v, i) {return i === undefined ? v - this.k : -1;} \
+        }";
+  uint32_t i = 0;
+  value_t from[3];
+  value_t to[3];
+  value_t back[3];
+  view_model_t* view_model = view_model_jerryscript_create("test", code, strlen(code), NULL);
+  value_converter_t* c = value_converter_create("jsbatch");
+  ASSERT_NE(c, VALUE_CONVERTER(NULL));
+
+  for (i = 0; i < 3; i++) {
+    value_set_int(from + i, i);
+  }
+
+  ASSERT_EQ(value_converter_to_view_batch(c, from, to, 3), RET_OK);
+  ASSERT_EQ(value_converter_to_model_batch(c, to, back, 3), RET_OK);
+  for (i = 0; i < 3; i++) {
+    ASSERT_EQ(value_int(to + i), (int32_t)i + 10);
+    ASSERT_EQ(value_int(back + i), (int32_t)i);
+    value_reset(to + i);
+    value_reset(back + i);
+  }
+
+  object_unref(OBJECT(c));
+  object_unref(OBJECT(view_model));
+}
@@ -0,0 +1,161 @@
+#include "tkc/utils.h"
+#include "mvvm/base/value_converter_native.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using std::string;
+
+static string to_view_str(value_converter_t* c, const value_t* from) {
+  value_t v;
+  string str;
+
+  if (value_converter_to_view(c, from, &v) != RET_OK) {
+    return "error";
+  }
+
+  str = value_str(&v);
+  value_reset(&v);
+
+  return str;
+}
+
+static string int_to_view(value_converter_t* c, int32_t value) {
+  value_t v;
+
+  return to_view_str(c, value_set_int(&v, value));
+}
+
+static ret_t str_to_model(value_converter_t* c, const char* str, value_t* to) {
+  value_t v;
+
+  return value_converter_to_model(c, value_set_str(&v, str), to);
+}
+
+TEST(ValueConverterNative, scale) {
+  value_t v;
+  value_t to;
+  value_converter_t* c = value_converter_native_create("scale:0.1:1");
+
+  ASSERT_NE(c, VALUE_CONVERTER(NULL));
+  ASSERT_EQ(int_to_view(c, 253), string("25.3"));
+  ASSERT_EQ(int_to_view(c, -5), string("-0.5"));
+
+  /*定点数转换回模型时不因为舍入误差而少1*/
+  ASSERT_EQ(str_to_model(c, "25.3", &to), RET_OK);
+  ASSERT_EQ(to.type, VALUE_TYPE_INT32);
+  ASSERT_EQ(value_int(&to), 253);
+  object_unref(OBJECT(c));
+
+  c = value_converter_native_create("scale:0.5");
+  ASSERT_EQ(value_converter_to_view(c, value_set_int(&v, 3), &to), RET_OK);
+  ASSERT_EQ(value_double(&to), 1.5);
+  object_unref(OBJECT(c));
+
+  ASSERT_EQ(value_converter_native_create("scale"), VALUE_CONVERTER(NULL));
+  ASSERT_EQ(value_converter_native_create("scale:"), VALUE_CONVERTER(NULL));
+  ASSERT_EQ(value_converter_native_create("scale:0"), VALUE_CONVERTER(NULL));
+  ASSERT_EQ(value_converter_native_create("scale:abc"), VALUE_CONVERTER(NULL));
+  ASSERT_EQ(value_converter_native_create("scale:0.1:x"), VALUE_CONVERTER(NULL));
+  ASSERT_EQ(value_converter_native_create("scaled:0.1"), VALUE_CONVERTER(NULL));
+}
+
+TEST(ValueConverterNative, linear) {
+  value_t to;
+  value_converter_t* c = value_converter_native_create("linear:1.8:32:1");
+
+  ASSERT_NE(c, VALUE_CONVERTER(NULL));
+  ASSERT_EQ(int_to_view(c, 100), string("212.0"));
+  ASSERT_EQ(int_to_view(c, -40), string("-40.0"));
+  ASSERT_EQ(str_to_model(c, "98.6", &to), RET_OK);
+  ASSERT_EQ(value_int(&to), 37);
+  ASSERT_EQ(str_to_model(c, "100", &to), RET_OK);
+  ASSERT_EQ(to.type, VALUE_TYPE_DOUBLE);
+  object_unref(OBJECT(c));
+
+  ASSERT_EQ(value_converter_native_create("linear:1.8"), VALUE_CONVERTER(NULL));
+}
+
+TEST(ValueConverterNative, enum) {
+  value_t to;
+  value_converter_t* c = value_converter_native_create("enum:off:on:auto");
+
+  ASSERT_NE(c, VALUE_CONVERTER(NULL));
+  ASSERT_EQ(int_to_view(c, 0), string("off"));
+  ASSERT_EQ(int_to_view(c, 2), string("auto"));
+  ASSERT_EQ(int_to_view(c, 3), string("error"));
+  ASSERT_EQ(int_to_view(c, -1), string("error"));
+
+  ASSERT_EQ(str_to_model(c, "on", &to), RET_OK);
+  ASSERT_EQ(value_int(&to), 1);
+  ASSERT_EQ(str_to_model(c, "none", &to), RET_NOT_FOUND);
+  object_unref(OBJECT(c));
+
+  ASSERT_EQ(value_converter_native_create("enum"), VALUE_CONVERTER(NULL));
+}
+
+TEST(ValueConverterNative, thousands) {
+  value_t v;
+  value_t to;
+  value_converter_t* c = value_converter_native_create("thousands:");
+
+  ASSERT_NE(c, VALUE_CONVERTER(NULL));
+  ASSERT_EQ(int_to_view(c, 0), string("0"));
+  ASSERT_EQ(int_to_view(c, 999), string("999"));
+  ASSERT_EQ(int_to_view(c, 1000), string("1,000"));
+  ASSERT_EQ(int_to_view(c, -1234567), string("-1,234,567"));
+  ASSERT_EQ(str_to_model(c, "1,234,567", &to), RET_OK);
+  ASSERT_EQ(value_int64(&to), 1234567);
+  ASSERT_EQ(str_to_model(c, "1,2x", &to), RET_BAD_PARAMS);
+  object_unref(OBJECT(c));
+
+  c = value_converter_native_create("thousands:2");
+  ASSERT_EQ(to_view_str(c, value_set_double(&v, 12345.678)), string("12,345.68"));
+  ASSERT_EQ(to_view_str(c, value_set_double(&v, -0.001)), string("0.00"));
+  ASSERT_EQ(str_to_model(c, "12,345.5", &to), RET_OK);
+  ASSERT_EQ(value_double(&to), 12345.5);
+  object_unref(OBJECT(c));
+}
+
+TEST(ValueConverterNative, datetime) {
+  value_t v;
+  value_t to;
+  value_converter_t* c = value_converter_native_create("datetime:");
+
+  ASSERT_NE(c, VALUE_CONVERTER(NULL));
+  ASSERT_EQ(int_to_view(c, 0), string("1970-01-01 00:00:00"));
+  ASSERT_EQ(int_to_view(c, 951782400), string("2000-02-29 00:00:00"));
+  ASSERT_EQ(to_view_str(c, value_set_int64(&v, 1561036245)), string("2019-06-20 13:10:45"));
+  ASSERT_EQ(int_to_view(c, -1), string("1969-12-31 23:59:59"));
+
+  ASSERT_EQ(str_to_model(c, "2019-06-20 13:10:45", &to), RET_OK);
+  ASSERT_EQ(value_int64(&to), 1561036245);
+  ASSERT_EQ(str_to_model(c, "2019-13-20 13:10:45", &to), RET_BAD_PARAMS);
+  ASSERT_EQ(str_to_model(c, "2019-06-20", &to), RET_BAD_PARAMS);
+  object_unref(OBJECT(c));
+
+  c = value_converter_native_create("datetime:hh:mm");
+  ASSERT_EQ(int_to_view(c, 1561036245), string("13:10"));
+  ASSERT_EQ(str_to_model(c, "1:05", &to), RET_OK);
+  ASSERT_EQ(value_int64(&to), 3900);
+  object_unref(OBJECT(c));
+}
+
+TEST(ValueConverterNative, factory) {
+  value_converter_t* c = value_converter_create("scale:0.01:2");
+
+  ASSERT_NE(c, VALUE_CONVERTER(NULL));
+  ASSERT_EQ(int_to_view(c, 12345), string("123.45"));
+  ASSERT_EQ(value_converter_create("scale:0.01:2"), c);
+  object_unref(OBJECT(c));
+  object_unref(OBJECT(c));
+}
+
+TEST(ValueConverterNative, bare_names) {
+  /*不带参数的名称留给其它转换器(如JS中定义的datetime)*/
+  ASSERT_EQ(value_converter_native_create("datetime"), VALUE_CONVERTER(NULL));
+  ASSERT_EQ(value_converter_native_create("thousands"), VALUE_CONVERTER(NULL));
+  ASSERT_EQ(value_converter_native_create("enum"), VALUE_CONVERTER(NULL));
+  ASSERT_EQ(value_converter_native_create("temperature"), VALUE_CONVERTER(NULL));
+  ASSERT_EQ(value_converter_native_create("unknown:1"), VALUE_CONVERTER(NULL));
+}
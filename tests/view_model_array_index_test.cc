@@ -0,0 +1,167 @@
+#include "tkc/utils.h"
+#include "mvvm/base/view_model_dummy.h"
+#include "mvvm/base/view_model_array_dummy.h"
+#include "mvvm/base/view_model_array_view.h"
+#include "mvvm/base/view_model_array_index.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using std::string;
+
+static string result_of(view_model_array_index_t* index) {
+  uint32_t i = 0;
+  string str;
+  char row[32];
+
+  for (i = 0; i < index->result_nr; i++) {
+    tk_snprintf(row, sizeof(row), "%u;", index->result[i]);
+    str += row;
+  }
+
+  return str;
+}
+
+static string search(view_model_array_index_t* index, const char* query, bool_t substring) {
+  if (view_model_array_index_search(index, query, substring) != RET_OK) {
+    return "error";
+  }
+
+  return result_of(index);
+}
+
+static ret_t parts_add(view_model_t* parts, uint32_t row, const char* name) {
+  view_model_t* part = view_model_dummy_create(NULL);
+
+  object_set_prop_str(OBJECT(part), "name", name);
+  view_model_array_dummy_add(parts, part);
+  object_unref(OBJECT(part));
+
+  return view_model_array_notify_item_inserted(parts, row);
+}
+
+static string names_of(view_model_t* view) {
+  int32_t i = 0;
+  string str;
+  char name[32];
+
+  for (i = 0; i < view_model_array_view_size(view); i++) {
+    tk_snprintf(name, sizeof(name), "[%d].name", i);
+    str += object_get_prop_str(OBJECT(view), name);
+    str += ";";
+  }
+
+  return str;
+}
+
+TEST(ViewModelArrayIndex, prefix) {
+  view_model_array_index_t* index = view_model_array_index_create(FALSE);
+
+  ASSERT_EQ(view_model_array_index_insert(index, 0, "Bolt M3"), RET_OK);
+  ASSERT_EQ(view_model_array_index_insert(index, 1, "bearing"), RET_OK);
+  ASSERT_EQ(view_model_array_index_insert(index, 2, "Nut M3"), RET_OK);
+  ASSERT_EQ(view_model_array_index_insert(index, 1, "Bolt M4"), RET_OK);
+  ASSERT_EQ(view_model_array_index_insert(index, 5, "x"), RET_BAD_PARAMS);
+  ASSERT_EQ(index->rows, 4u);
+
+  ASSERT_EQ(search(index, "bolt", FALSE), string("0;1;"));
+  ASSERT_EQ(search(index, "B", FALSE), string("0;1;2;"));
+  ASSERT_EQ(search(index, "", FALSE), string("0;1;2;3;"));
+  ASSERT_EQ(search(index, "m3", FALSE), string(""));
+  /*没有启用trigram时，子串搜索逐行比较*/
+  ASSERT_EQ(search(index, "m3", TRUE), string("0;3;"));
+
+  ASSERT_EQ(view_model_array_index_remove(index, 0), RET_OK);
+  ASSERT_EQ(search(index, "bolt", FALSE), string("0;"));
+  ASSERT_EQ(view_model_array_index_update(index, 2, "Bolt M5"), RET_OK);
+  ASSERT_EQ(search(index, "bolt", FALSE), string("0;2;"));
+  ASSERT_EQ(search(index, "nut", FALSE), string(""));
+
+  ASSERT_EQ(view_model_array_index_clear(index), RET_OK);
+  ASSERT_EQ(search(index, "", FALSE), string(""));
+
+  object_unref(OBJECT(index));
+}
+
+TEST(ViewModelArrayIndex, substring) {
+  view_model_array_index_t* index = view_model_array_index_create(TRUE);
+
+  ASSERT_EQ(view_model_array_index_insert(index, 0, "PN-1001-GEAR"), RET_OK);
+  ASSERT_EQ(view_model_array_index_insert(index, 1, "PN-1002-SHAFT"), RET_OK);
+  ASSERT_EQ(view_model_array_index_insert(index, 2, "PN-2001-gearbox"), RET_OK);
+  ASSERT_EQ(view_model_array_index_insert(index, 3, "aaaa"), RET_OK);
+
+  ASSERT_EQ(search(index, "gear", TRUE), string("0;2;"));
+  ASSERT_EQ(search(index, "001", TRUE), string("0;2;"));
+  ASSERT_EQ(search(index, "aaa", TRUE), string("3;"));
+  ASSERT_EQ(search(index, "haft", TRUE), string("1;"));
+  ASSERT_EQ(search(index, "gearz", TRUE), string(""));
+  ASSERT_EQ(search(index, "pn-1", FALSE), string("0;1;"));
+
+  ASSERT_EQ(view_model_array_index_remove(index, 0), RET_OK);
+  ASSERT_EQ(search(index, "gear", TRUE), string("1;"));
+  ASSERT_EQ(view_model_array_index_update(index, 0, "PN-1002-GEAR"), RET_OK);
+  ASSERT_EQ(search(index, "gear", TRUE), string("0;1;"));
+  ASSERT_EQ(search(index, "shaft", TRUE), string(""));
+
+  object_unref(OBJECT(index));
+}
+
+TEST(ViewModelArrayIndex, attach) {
+  view_model_t* parts = view_model_array_dummy_create(NULL);
+  view_model_array_index_t* index = view_model_array_index_create(TRUE);
+
+  parts_add(parts, 0, "gear");
+  parts_add(parts, 1, "shaft");
+  ASSERT_EQ(view_model_array_index_attach(index, parts, "name"), RET_OK);
+  ASSERT_EQ(index->rows, 2u);
+
+  parts_add(parts, 2, "gearbox");
+  ASSERT_EQ(search(index, "gear", FALSE), string("0;2;"));
+
+  object_set_prop_str(OBJECT(view_model_array_dummy_get(parts, 1)), "name", "bevel gear");
+  view_model_array_notify_item_changed(parts, 1);
+  ASSERT_EQ(search(index, "gear", TRUE), string("0;1;2;"));
+
+  view_model_array_dummy_remove(parts, 0);
+  view_model_array_notify_item_removed(parts, 0);
+  ASSERT_EQ(search(index, "gear", FALSE), string("1;"));
+
+  view_model_array_dummy_clear(parts);
+  view_model_array_notify_items_changed(parts);
+  ASSERT_EQ(index->rows, 0u);
+
+  object_unref(OBJECT(index));
+  object_unref(OBJECT(parts));
+}
+
+TEST(ViewModelArrayIndex, filter_view) {
+  view_model_t* parts = view_model_array_dummy_create(NULL);
+  view_model_array_index_t* index = view_model_array_index_create(TRUE);
+  view_model_t* view = view_model_array_view_create(parts);
+
+  parts_add(parts, 0, "gear");
+  parts_add(parts, 1, "shaft");
+  parts_add(parts, 2, "gearbox");
+  parts_add(parts, 3, "bevel gear");
+  ASSERT_EQ(view_model_array_index_attach(index, parts, "name"), RET_OK);
+
+  ASSERT_EQ(view_model_array_index_filter_view(index, view, "g", FALSE), RET_OK);
+  ASSERT_EQ(names_of(view), string("gear;gearbox;"));
+  ASSERT_EQ(view_model_array_index_filter_view(index, view, "gearb", FALSE), RET_OK);
+  ASSERT_EQ(names_of(view), string("gearbox;"));
+  ASSERT_EQ(view_model_array_index_filter_view(index, view, "gear", TRUE), RET_OK);
+  ASSERT_EQ(names_of(view), string("gear;gearbox;bevel gear;"));
+
+  /*新增的项按当前的搜索条件过滤*/
+  parts_add(parts, 4, "spur gear");
+  parts_add(parts, 5, "bolt");
+  ASSERT_EQ(names_of(view), string("gear;gearbox;bevel gear;spur gear;"));
+
+  ASSERT_EQ(view_model_array_index_filter_view(index, view, "", TRUE), RET_OK);
+  ASSERT_EQ(view_model_array_view_size(view), 6);
+
+  object_unref(OBJECT(view));
+  object_unref(OBJECT(index));
+  object_unref(OBJECT(parts));
+}
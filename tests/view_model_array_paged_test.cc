@@ -0,0 +1,267 @@
+﻿#include "tkc/utils.h"
+#include "mvvm/base/view_model_array_paged.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using std::string;
+
+typedef struct _rows_source_t {
+  int32_t items;
+  uint32_t fetches;
+  bool_t async;
+  int32_t pending_start;
+  uint32_t pending_nr;
+  uint32_t pending[16];
+  uint32_t pending_size;
+} rows_source_t;
+
+static int32_t rows_count(void* ctx) {
+  rows_source_t* rows = (rows_source_t*)ctx;
+
+  return rows->items;
+}
+
+static ret_t rows_fill(view_model_t* view_model, uint32_t start, uint32_t nr) {
+  uint32_t i = 0;
+  value_t values[2 * 16];
+  char names[16][TK_NAME_LEN + 1];
+
+  for (i = 0; i < nr; i++) {
+    tk_snprintf(names[i], TK_NAME_LEN, "row%u", start + i);
+    value_set_str(values + 2 * i, names[i]);
+    value_set_int(values + 2 * i + 1, start + i);
+  }
+
+  return view_model_array_paged_fill(view_model, start, nr, values);
+}
+
+static ret_t rows_fetch(void* ctx, view_model_t* view_model, uint32_t start, uint32_t nr) {
+  rows_source_t* rows = (rows_source_t*)ctx;
+
+  rows->fetches++;
+  if (rows->async) {
+    rows->pending_start = start;
+    rows->pending_nr = nr;
+    if (rows->pending_size < ARRAY_SIZE(rows->pending)) {
+      rows->pending[rows->pending_size++] = start;
+    }
+
+    return RET_OK;
+  }
+
+  return rows_fill(view_model, start, nr);
+}
+
+static view_model_t* rows_create(rows_source_t* rows, uint32_t cache_pages) {
+  view_model_array_paged_source_t source;
+  const char* fields[] = {"name", "value"};
+
+  memset(&source, 0x00, sizeof(source));
+  source.count = rows_count;
+  source.fetch = rows_fetch;
+  source.ctx = rows;
+
+  return view_model_array_paged_create(&source, fields, 2, 10, cache_pages);
+}
+
+static string name_of(view_model_t* view_model, uint32_t index) {
+  char name[32];
+
+  tk_snprintf(name, sizeof(name), "[%u].name", index);
+
+  return object_get_prop_str(OBJECT(view_model), name);
+}
+
+static ret_t on_props_changed(void* ctx, event_t* e) {
+  uint32_t* count = (uint32_t*)ctx;
+
+  *count = *count + 1;
+
+  return RET_OK;
+}
+
+/*模拟绑定的整体刷新：读取所有行*/
+static uint32_t rows_update_all(view_model_t* view_model) {
+  uint32_t i = 0;
+  uint32_t loaded = 0;
+  uint32_t items = object_get_prop_int(OBJECT(view_model), VIEW_MODEL_PROP_ITEMS, 0);
+
+  view_model_begin_update(view_model);
+  for (i = 0; i < items; i++) {
+    if (!name_of(view_model, i).empty()) {
+      loaded++;
+    }
+  }
+  view_model_end_update(view_model);
+
+  return loaded;
+}
+
+/*模拟绑定的单行刷新：读取变化的行*/
+static ret_t on_item_changed(void* ctx, event_t* e) {
+  uint32_t* count = (uint32_t*)ctx;
+  view_model_item_event_t* evt = (view_model_item_event_t*)e;
+  view_model_t* view_model = VIEW_MODEL(e->target);
+
+  view_model_begin_update(view_model);
+  if (!name_of(view_model, evt->index).empty()) {
+    *count = *count + 1;
+  }
+  view_model_end_update(view_model);
+
+  return RET_OK;
+}
+
+TEST(ViewModelArrayPaged, basic) {
+  value_t v;
+  rows_source_t rows;
+  view_model_t* view_model = NULL;
+
+  memset(&rows, 0x00, sizeof(rows));
+  rows.items = 100;
+  view_model = rows_create(&rows, 3);
+
+  ASSERT_EQ(object_get_prop_int(OBJECT(view_model), VIEW_MODEL_PROP_ITEMS, 0), 100);
+  ASSERT_EQ(rows.fetches, 0u);
+
+  ASSERT_EQ(name_of(view_model, 0), string("row0"));
+  ASSERT_EQ(rows.fetches, 2u);
+  ASSERT_EQ(view_model_array_paged_is_loaded(view_model, 15), TRUE);
+  ASSERT_EQ(view_model_array_paged_is_loaded(view_model, 25), FALSE);
+
+  ASSERT_EQ(name_of(view_model, 15), string("row15"));
+  ASSERT_EQ(object_get_prop_int(OBJECT(view_model), "[25].value", 0), 25);
+  ASSERT_EQ(rows.fetches, 4u);
+
+  /*只缓存3页，最久没有使用的第0页被淘汰*/
+  ASSERT_EQ(view_model_array_paged_is_loaded(view_model, 5), FALSE);
+
+  /*向前滚动时预读前面的页*/
+  ASSERT_EQ(name_of(view_model, 95), string("row95"));
+  ASSERT_EQ(name_of(view_model, 85), string("row85"));
+  ASSERT_EQ(view_model_array_paged_is_loaded(view_model, 75), TRUE);
+
+  ASSERT_NE(object_get_prop(OBJECT(view_model), "[100].name", &v), RET_OK);
+  ASSERT_EQ(object_get_prop(OBJECT(view_model), "[1].none", &v), RET_NOT_FOUND);
+
+  object_unref(OBJECT(view_model));
+}
+
+TEST(ViewModelArrayPaged, async) {
+  rows_source_t rows;
+  uint32_t props_changed = 0;
+  uint32_t items_changed = 0;
+  view_model_t* view_model = NULL;
+
+  memset(&rows, 0x00, sizeof(rows));
+  rows.items = 100;
+  rows.async = TRUE;
+  view_model = rows_create(&rows, 3);
+  view_model_array_paged_set_read_ahead(view_model, 0);
+  emitter_on(EMITTER(view_model), EVT_PROPS_CHANGED, on_props_changed, &props_changed);
+  emitter_on(EMITTER(view_model), EVT_VIEW_MODEL_ITEM_CHANGED, on_item_changed, &items_changed);
+
+  ASSERT_EQ(name_of(view_model, 45), string(""));
+  ASSERT_EQ(object_get_prop_bool(OBJECT(view_model), "[45].loading", FALSE), TRUE);
+  ASSERT_EQ(rows.pending_start, 40);
+  ASSERT_EQ(rows.fetches, 1u);
+
+  /*正在加载的页不会重复请求*/
+  ASSERT_EQ(name_of(view_model, 46), string(""));
+  ASSERT_EQ(rows.fetches, 1u);
+
+  /*只通知提交的行*/
+  ASSERT_EQ(rows_fill(view_model, rows.pending_start, rows.pending_nr), RET_OK);
+  ASSERT_EQ(props_changed, 0u);
+  ASSERT_EQ(items_changed, 10u);
+  ASSERT_EQ(rows.fetches, 1u);
+  ASSERT_EQ(name_of(view_model, 45), string("row45"));
+  ASSERT_EQ(object_get_prop_bool(OBJECT(view_model), "[45].loading", TRUE), FALSE);
+
+  rows.items = 5;
+  ASSERT_EQ(view_model_array_paged_reload(view_model), RET_OK);
+  ASSERT_EQ(object_get_prop_int(OBJECT(view_model), VIEW_MODEL_PROP_ITEMS, 0), 5);
+  ASSERT_EQ(rows_fill(view_model, 0, 5), RET_NOT_FOUND);
+
+  object_unref(OBJECT(view_model));
+}
+
+TEST(ViewModelArrayPaged, more_rows_than_cache) {
+  uint32_t i = 0;
+  rows_source_t rows;
+  uint32_t items_changed = 0;
+  view_model_t* view_model = NULL;
+
+  memset(&rows, 0x00, sizeof(rows));
+  rows.items = 100;
+  rows.async = TRUE;
+  view_model = rows_create(&rows, 3);
+  emitter_on(EMITTER(view_model), EVT_VIEW_MODEL_ITEM_CHANGED, on_item_changed, &items_changed);
+
+  /*一次刷新最多加载缓存能容纳的页，不会淘汰本次刷新已经访问的页*/
+  ASSERT_EQ(rows_update_all(view_model), 0u);
+  ASSERT_EQ(rows.fetches, 3u);
+  ASSERT_EQ(rows.pending_size, 3u);
+
+  /*提交数据只刷新这些行，不会引起新的请求*/
+  for (i = 0; i < rows.pending_size; i++) {
+    ASSERT_EQ(rows_fill(view_model, rows.pending[i], 10), RET_OK);
+  }
+  ASSERT_EQ(items_changed, 30u);
+  ASSERT_EQ(rows.fetches, 3u);
+
+  /*再次刷新读取的都是缓存*/
+  ASSERT_EQ(rows_update_all(view_model), 30u);
+  ASSERT_EQ(rows.fetches, 3u);
+
+  /*滚动之后只加载可见区间*/
+  rows.pending_size = 0;
+  ASSERT_EQ(view_model_array_paged_set_visible(view_model, 50, 20), RET_OK);
+  rows_update_all(view_model);
+  ASSERT_EQ(rows.fetches, 5u);
+  ASSERT_EQ(rows.pending_size, 2u);
+  ASSERT_EQ(rows.pending[0], 50u);
+  ASSERT_EQ(rows.pending[1], 60u);
+
+  for (i = 0; i < rows.pending_size; i++) {
+    ASSERT_EQ(rows_fill(view_model, rows.pending[i], 10), RET_OK);
+  }
+  ASSERT_EQ(rows_update_all(view_model), 30u);
+  ASSERT_EQ(view_model_array_paged_is_loaded(view_model, 5), FALSE);
+  ASSERT_EQ(view_model_array_paged_is_loaded(view_model, 25), TRUE);
+  ASSERT_EQ(view_model_array_paged_is_loaded(view_model, 55), TRUE);
+  ASSERT_EQ(view_model_array_paged_is_loaded(view_model, 65), TRUE);
+  ASSERT_EQ(rows.fetches, 5u);
+
+  object_unref(OBJECT(view_model));
+}
+
+TEST(ViewModelArrayPaged, loading_timeout) {
+  rows_source_t rows;
+  view_model_t* view_model = NULL;
+
+  memset(&rows, 0x00, sizeof(rows));
+  rows.items = 100;
+  rows.async = TRUE;
+  view_model = rows_create(&rows, 3);
+  view_model_array_paged_set_read_ahead(view_model, 0);
+
+  ASSERT_EQ(name_of(view_model, 5), string(""));
+  ASSERT_EQ(name_of(view_model, 6), string(""));
+  ASSERT_EQ(rows.fetches, 1u);
+
+  /*超时之后再次访问时重新请求*/
+  ASSERT_EQ(view_model_array_paged_set_loading_timeout(view_model, 0), RET_OK);
+  ASSERT_EQ(name_of(view_model, 5), string(""));
+  ASSERT_EQ(rows.fetches, 2u);
+
+  /*超时的页可以被淘汰*/
+  ASSERT_EQ(name_of(view_model, 15), string(""));
+  ASSERT_EQ(name_of(view_model, 25), string(""));
+  ASSERT_EQ(name_of(view_model, 35), string(""));
+  ASSERT_EQ(rows.fetches, 5u);
+  ASSERT_EQ(rows_fill(view_model, 0, 10), RET_NOT_FOUND);
+
+  object_unref(OBJECT(view_model));
+}
@@ -0,0 +1,216 @@
+﻿#include "tkc/utils.h"
+#include "mvvm/base/view_model_dummy.h"
+#include "mvvm/base/view_model_array_dummy.h"
+#include "mvvm/base/view_model_array_view.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using std::string;
+
+static view_model_t* person_create(const char* name, int32_t age) {
+  view_model_t* person = view_model_dummy_create(NULL);
+
+  object_set_prop_str(OBJECT(person), "name", name);
+  object_set_prop_int(OBJECT(person), "age", age);
+
+  return person;
+}
+
+static ret_t persons_add(view_model_t* persons, const char* name, int32_t age) {
+  view_model_t* person = person_create(name, age);
+
+  view_model_array_dummy_add(persons, person);
+  object_unref(OBJECT(person));
+
+  return view_model_array_notify_item_inserted(
+      persons, view_model_array_dummy_size(persons) - 1);
+}
+
+static string names_of(view_model_t* view) {
+  int32_t i = 0;
+  string str;
+  char name[32];
+
+  for (i = 0; i < view_model_array_view_size(view); i++) {
+    tk_snprintf(name, sizeof(name), "[%d].name", i);
+    str += object_get_prop_str(OBJECT(view), name);
+    str += ";";
+  }
+
+  return str;
+}
+
+static bool_t age_gt(void* ctx, view_model_t* source, uint32_t index) {
+  view_model_t* person = view_model_array_dummy_get(source, index);
+
+  return object_get_prop_int(OBJECT(person), "age", 0) > *(int32_t*)ctx;
+}
+
+static ret_t on_item_event(void* ctx, event_t* e) {
+  string& log = *(string*)ctx;
+  char buff[32];
+
+  if (e->type == EVT_ITEMS_CHANGED) {
+    log += "reset;";
+  } else {
+    const char* type = e->type == EVT_VIEW_MODEL_ITEM_INSERTED
+                           ? "insert"
+                           : (e->type == EVT_VIEW_MODEL_ITEM_REMOVED ? "remove" : "change");
+
+    tk_snprintf(buff, sizeof(buff), "%s:%d;", type, ((view_model_item_event_t*)e)->index);
+    log += buff;
+  }
+
+  return RET_OK;
+}
+
+TEST(ViewModelArrayView, sort) {
+  view_model_t* persons = view_model_array_dummy_create(NULL);
+  view_model_t* view = view_model_array_view_create(persons);
+
+  persons_add(persons, "c", 30);
+  persons_add(persons, "a", 10);
+  persons_add(persons, "b", 20);
+  ASSERT_EQ(object_get_prop_int(OBJECT(view), VIEW_MODEL_PROP_ITEMS, 0), 3);
+  ASSERT_EQ(names_of(view), string("c;a;b;"));
+
+  ASSERT_EQ(view_model_array_view_set_sort_prop(view, "name", TRUE), RET_OK);
+  ASSERT_EQ(names_of(view), string("a;b;c;"));
+  ASSERT_EQ(view_model_array_view_get_source_index(view, 0), 1);
+
+  ASSERT_EQ(view_model_array_view_set_sort_prop(view, "age", FALSE), RET_OK);
+  ASSERT_EQ(names_of(view), string("c;b;a;"));
+
+  persons_add(persons, "d", 25);
+  ASSERT_EQ(names_of(view), string("c;d;b;a;"));
+
+  ASSERT_EQ(view_model_array_view_set_sort_prop(view, NULL, TRUE), RET_OK);
+  ASSERT_EQ(names_of(view), string("c;a;b;d;"));
+
+  object_unref(OBJECT(view));
+  object_unref(OBJECT(persons));
+}
+
+TEST(ViewModelArrayView, filter) {
+  int32_t age = 15;
+  view_model_t* persons = view_model_array_dummy_create(NULL);
+  view_model_t* view = view_model_array_view_create(persons);
+
+  persons_add(persons, "c", 30);
+  persons_add(persons, "a", 10);
+  persons_add(persons, "b", 20);
+  view_model_array_view_set_sort_prop(view, "name", TRUE);
+
+  ASSERT_EQ(view_model_array_view_set_filter(view, age_gt, &age, FALSE), RET_OK);
+  ASSERT_EQ(names_of(view), string("b;c;"));
+
+  /*条件更严格时只检查当前可见的项*/
+  age = 25;
+  ASSERT_EQ(view_model_array_view_set_filter(view, age_gt, &age, TRUE), RET_OK);
+  ASSERT_EQ(names_of(view), string("c;"));
+
+  age = 5;
+  ASSERT_EQ(view_model_array_view_set_filter(view, age_gt, &age, FALSE), RET_OK);
+  ASSERT_EQ(names_of(view), string("a;b;c;"));
+
+  ASSERT_EQ(view_model_array_view_set_filter(view, NULL, NULL, FALSE), RET_OK);
+  ASSERT_EQ(view_model_array_view_size(view), 3);
+
+  object_unref(OBJECT(view));
+  object_unref(OBJECT(persons));
+}
+
+TEST(ViewModelArrayView, events) {
+  string log;
+  int32_t age = 15;
+  value_t v;
+  view_model_t* persons = view_model_array_dummy_create(NULL);
+  view_model_t* view = view_model_array_view_create(persons);
+
+  persons_add(persons, "c", 30);
+  persons_add(persons, "a", 10);
+  persons_add(persons, "b", 20);
+  view_model_array_view_set_sort_prop(view, "age", TRUE);
+  view_model_array_view_set_filter(view, age_gt, &age, FALSE);
+  ASSERT_EQ(names_of(view), string("b;c;"));
+
+  emitter_on(EMITTER(view), EVT_ITEMS_CHANGED, on_item_event, &log);
+  emitter_on(EMITTER(view), EVT_VIEW_MODEL_ITEM_INSERTED, on_item_event, &log);
+  emitter_on(EMITTER(view), EVT_VIEW_MODEL_ITEM_REMOVED, on_item_event, &log);
+  emitter_on(EMITTER(view), EVT_VIEW_MODEL_ITEM_CHANGED, on_item_event, &log);
+
+  persons_add(persons, "d", 25);
+  ASSERT_EQ(log, string("insert:1;"));
+  ASSERT_EQ(names_of(view), string("b;d;c;"));
+
+  log = "";
+  persons_add(persons, "e", 1);
+  ASSERT_EQ(log, string(""));
+
+  log = "";
+  ASSERT_EQ(view_model_set_prop(view, "[0].age", value_set_int(&v, 21)), RET_OK);
+  ASSERT_EQ(log, string("change:0;"));
+
+  log = "";
+  ASSERT_EQ(view_model_set_prop(view, "[0].age", value_set_int(&v, 40)), RET_OK);
+  ASSERT_EQ(log, string("remove:0;insert:2;"));
+  ASSERT_EQ(names_of(view), string("d;c;b;"));
+
+  log = "";
+  view_model_array_dummy_remove(persons, 0);
+  view_model_array_notify_item_removed(persons, 0);
+  ASSERT_EQ(log, string("remove:1;"));
+  ASSERT_EQ(names_of(view), string("d;b;"));
+  ASSERT_EQ(view_model_array_view_get_source_index(view, 0), 2);
+
+  log = "";
+  view_model_array_dummy_clear(persons);
+  view_model_array_notify_items_changed(persons);
+  ASSERT_EQ(log, string("reset;"));
+  ASSERT_EQ(view_model_array_view_size(view), 0);
+
+  object_unref(OBJECT(view));
+  object_unref(OBJECT(persons));
+}
+
+typedef struct _prop_event_log_t {
+  string log;
+  void* target;
+} prop_event_log_t;
+
+static ret_t on_prop_event(void* ctx, event_t* e) {
+  char buff[64];
+  prop_event_log_t* info = (prop_event_log_t*)ctx;
+  prop_change_event_t* evt = (prop_change_event_t*)e;
+
+  tk_snprintf(buff, sizeof(buff), "%s=%d;", evt->name, value_int(evt->value));
+  info->log += buff;
+  info->target = e->target;
+
+  return RET_OK;
+}
+
+TEST(ViewModelArrayView, forward_prop_changed) {
+  value_t v;
+  prop_change_event_t evt;
+  prop_event_log_t info;
+  view_model_t* persons = view_model_array_dummy_create(NULL);
+  view_model_t* view = view_model_array_view_create(persons);
+
+  persons_add(persons, "a", 10);
+  emitter_on(EMITTER(view), EVT_PROP_CHANGED, on_prop_event, &info);
+
+  memset(&evt, 0x00, sizeof(evt));
+  evt.e = event_init(EVT_PROP_CHANGED, persons);
+  evt.name = "[0].age";
+  evt.value = value_set_int(&v, 11);
+  emitter_dispatch(EMITTER(persons), (event_t*)&evt);
+
+  ASSERT_EQ(info.log, string("[0].age=11;"));
+  ASSERT_EQ(info.target, (void*)view);
+  ASSERT_EQ(evt.e.target, (void*)persons);
+
+  object_unref(OBJECT(view));
+  object_unref(OBJECT(persons));
+}
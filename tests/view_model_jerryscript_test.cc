@@ -1,4 +1,9 @@
-﻿#include "mvvm/jerryscript/view_model_jerryscript.h"
+﻿#include "mvvm/jerryscript/mvvm_jerryscript.h"
+#include "mvvm/jerryscript/view_model_jerryscript.h"
+#include "mvvm/jerryscript/view_model_array_jerryscript.h"
+#include "mvvm/base/numeric_series.h"
+#include "tkc/timer_manager.h"
+#include "base/timer.h"
 #include "gtest/gtest.h"
 
 #include <string>
@@ -42,6 +47,86 @@ TEST(ModelJerryScript, array) {
   object_unref(OBJECT(view_model));
 }
 
+TEST(ModelJerryScript, array_items_changed) {
+  const char* code =
+      "var test_array = [{'name':'a', 'stock':1}, {'name':'b', 'stock':2}];"
+      "test_array.add = function(args) {this.push({'name':'c', 'stock':3}); return 0;};"
+      "test_array.reset = function(args) {test_array[0] = {'name':'d', 'stock':4}; "
+      "this.notifyItemsChanged(); return 0;};";
+  view_model_t* view_model = view_model_jerryscript_create("test_array", code, strlen(code), NULL);
+  object_t* obj = OBJECT(view_model);
+  ASSERT_NE(obj, OBJECT(NULL));
+
+  ASSERT_EQ(object_get_prop_int(obj, VIEW_MODEL_PROP_ITEMS, 0), 2);
+  ASSERT_EQ(object_get_prop_int(obj, "[0].stock", 0), 1);
+
+  ASSERT_EQ(object_exec(obj, "add", NULL), RET_OK);
+  ASSERT_EQ(object_get_prop_int(obj, VIEW_MODEL_PROP_ITEMS, 0), 3);
+  ASSERT_EQ(object_get_prop_int(obj, "[2].stock", 0), 3);
+
+  ASSERT_EQ(object_exec(obj, "reset", NULL), RET_OK);
+  ASSERT_EQ(object_get_prop_int(obj, "[0].stock", 0), 4);
+  ASSERT_STREQ(object_get_prop_str(obj, "[0].name"), "d");
+
+  ASSERT_EQ(object_set_prop_int(obj, "[0].stock", 5), RET_OK);
+  ASSERT_EQ(object_get_prop_int(obj, "[0].stock", 0), 5);
+
+  object_unref(OBJECT(view_model));
+}
+
+TEST(ModelJerryScript, array_get_row_props) {
+  value_t values[3];
+  const char* names[] = {"name", "stock", "none"};
+  const char* code =
+      "var test_array = [{'name':'a', 'stock':1}, {'name':'b', 'stock':2}, {'name':'c', "
+      "'stock':3}];";
+  view_model_t* view_model = view_model_jerryscript_create("test_array", code, strlen(code), NULL);
+  ASSERT_NE(view_model, (view_model_t*)NULL);
+
+  ASSERT_EQ(view_model_array_jerryscript_get_row_props(view_model, 1, names, values, 3), RET_OK);
+  ASSERT_STREQ(value_str(values), "b");
+  ASSERT_EQ(value_int(values + 1), 2);
+  ASSERT_EQ(values[2].type, VALUE_TYPE_INVALID);
+  value_reset(values);
+  value_reset(values + 1);
+  value_reset(values + 2);
+
+  ASSERT_NE(view_model_array_jerryscript_get_row_props(view_model, 3, names, values, 3), RET_OK);
+
+  object_unref(OBJECT(view_model));
+}
+
+TEST(ModelJerryScript, array_update_pass) {
+  value_t values[2];
+  const char* names[] = {"name", "stock"};
+  const char* code =
+      "var test_array = [{'name':'a', 'stock':1}, {'name':'b', 'stock':2}];"
+      "test_array.replace = function(args) {this[0] = {'name':'c', 'stock':3}; return 0;};";
+  view_model_t* view_model = view_model_jerryscript_create("test_array", code, strlen(code), NULL);
+  object_t* obj = OBJECT(view_model);
+  ASSERT_NE(obj, OBJECT(NULL));
+
+  ASSERT_EQ(view_model_begin_update(view_model), RET_OK);
+  ASSERT_EQ(object_get_prop_int(obj, VIEW_MODEL_PROP_ITEMS, 0), 2);
+  ASSERT_EQ(view_model_get_row_props(view_model, 0, names, values, 2), RET_OK);
+  ASSERT_STREQ(value_str(values), "a");
+  ASSERT_EQ(value_int(values + 1), 1);
+  value_reset(values);
+  value_reset(values + 1);
+  ASSERT_EQ(object_get_prop_int(obj, "[0].stock", 0), 1);
+  ASSERT_EQ(view_model_end_update(view_model), RET_OK);
+
+  /*缓存只在刷新过程中有效，命令修改数组后不需要通知也能读到新的行*/
+  ASSERT_EQ(object_exec(obj, "replace", NULL), RET_OK);
+  ASSERT_EQ(object_get_prop_int(obj, "[0].stock", 0), 3);
+  ASSERT_EQ(view_model_get_row_props(view_model, 0, names, values, 2), RET_OK);
+  ASSERT_STREQ(value_str(values), "c");
+  value_reset(values);
+  value_reset(values + 1);
+
+  object_unref(OBJECT(view_model));
+}
+
 TEST(ModelJerryScript, get_prop_global) {
   const char* code = "var a=1; var b = true; var name ='awtk';";
   view_model_t* view_model = view_model_jerryscript_create("test", code, strlen(code), NULL);
@@ -175,6 +260,30 @@ TEST(ModelJerryScript, notifyPropsChanged) {
   object_unref(OBJECT(view_model));
 }
 
+TEST(ModelJerryScript, notifyMethodsChanged) {
+  const char* code =
+      "var test = {save: function(args) {return 1;}, "
+      "reload: function(args) {this.save = function(args) {return 2;}; "
+      "this.canSave = function(args) {return false;}; return 0;}, "
+      "patch: function(args) {this.reload(args); this.notifyMethodsChanged(); return 0;}}";
+  view_model_t* view_model = view_model_jerryscript_create("test", code, strlen(code), NULL);
+  object_t* obj = OBJECT(view_model);
+  ASSERT_NE(obj, OBJECT(NULL));
+
+  ASSERT_EQ(object_can_exec(obj, "save", NULL), TRUE);
+  ASSERT_EQ(object_exec(obj, "save", NULL), 1);
+
+  ASSERT_EQ(object_exec(obj, "reload", NULL), RET_OK);
+  ASSERT_EQ(object_can_exec(obj, "save", NULL), TRUE);
+  ASSERT_EQ(object_exec(obj, "save", NULL), 1);
+
+  ASSERT_EQ(object_exec(obj, "patch", NULL), RET_OK);
+  ASSERT_EQ(object_can_exec(obj, "save", NULL), FALSE);
+  ASSERT_EQ(object_exec(obj, "save", NULL), 2);
+
+  object_unref(OBJECT(view_model));
+}
+
 TEST(ModelJerryScript, onMount) {
   const char* code =
       "var test = {onMount: function(args) {print('onMount js'); test.count++; "
@@ -302,3 +411,181 @@ TEST(ModelJerryScript, invalid) {
   object_t* obj = OBJECT(view_model);
   ASSERT_EQ(obj, OBJECT(NULL));
 }
+
+TEST(ModelJerryScript, mem_stats) {
+  mvvm_jerryscript_mem_stats_t stats;
+  mvvm_jerryscript_mem_stats_t stats1;
+
+  mvvm_jerryscript_get_mem_stats(&stats);
+  ASSERT_EQ(mvvm_jerryscript_gc(), RET_OK);
+  mvvm_jerryscript_get_mem_stats(&stats1);
+  ASSERT_EQ(stats1.manual_gc_count, stats.manual_gc_count + 1);
+
+  if (mvvm_jerryscript_get_mem_stats(&stats) == RET_OK) {
+    ASSERT_EQ(stats.allocated <= stats.size, true);
+    ASSERT_EQ(stats.allocated <= stats.peak, true);
+
+    ASSERT_EQ(mvvm_jerryscript_set_heap_warn_threshold(1), RET_OK);
+    ASSERT_NE(mvvm_jerryscript_check_heap("test"), RET_OK);
+  }
+
+  ASSERT_EQ(mvvm_jerryscript_set_heap_warn_threshold(0), RET_OK);
+  ASSERT_EQ(mvvm_jerryscript_check_heap("test"), RET_OK);
+}
+
+TEST(ModelJerryScript, invalid_snapshot) {
+  uint32_t data[4] = {0x12345678, 0, 0, 0};
+
+  ASSERT_EQ(view_model_jerryscript_create_from_snapshot("test", data, sizeof(data), NULL),
+            VIEW_MODEL(NULL));
+}
+
+#ifdef WITH_JERRY_SNAPSHOT
+TEST(ModelJerryScript, snapshot) {
+  static uint32_t snapshot[1024];
+  const char* code = "var test = {a:1, name:'awtk'};";
+  jerry_value_t jsret = jerry_generate_snapshot((const jerry_char_t*)"test", 4,
+                                                (const jerry_char_t*)code, strlen(code), 0,
+                                                snapshot, sizeof(snapshot));
+  ASSERT_EQ(jerry_value_is_error(jsret), false);
+
+  uint32_t size = (uint32_t)jerry_get_number_value(jsret);
+  view_model_t* view_model =
+      view_model_jerryscript_create_from_snapshot("test", snapshot, size, NULL);
+  object_t* obj = OBJECT(view_model);
+  ASSERT_NE(obj, OBJECT(NULL));
+
+  ASSERT_EQ(object_get_prop_int(obj, "a", 0), 1);
+  ASSERT_EQ(string(object_get_prop_str(obj, "name")), string("awtk"));
+
+  jerry_release_value(jsret);
+  object_unref(obj);
+}
+#endif /*WITH_JERRY_SNAPSHOT*/
+
+TEST(ModelJerryScript, numeric_series) {
+  value_t v;
+  const char* code =
+      "var test = {samples:createNumericSeries(10), \
+         add:function(args) {this.samples.push([1, 2, 3]); this.samples.push(4); return RET_OK;}, \
+         change:function(args) {this.samples.set(1, 20); return RET_OK;}};";
+  view_model_t* view_model = view_model_jerryscript_create("test", code, strlen(code), NULL);
+  object_t* obj = OBJECT(view_model);
+  ASSERT_NE(obj, OBJECT(NULL));
+
+  ASSERT_EQ(object_get_prop(obj, "samples", &v), RET_OK);
+  ASSERT_EQ(v.type, VALUE_TYPE_OBJECT);
+  numeric_series_t* series = numeric_series_cast(value_object(&v));
+  ASSERT_NE(series, (numeric_series_t*)NULL);
+  ASSERT_EQ(series->size, 0u);
+
+  ASSERT_EQ(object_exec(obj, "add", NULL), RET_OK);
+  ASSERT_EQ(series->size, 4u);
+  ASSERT_EQ(series->data[3], 4);
+  ASSERT_EQ(series->dirty_end, 4u);
+
+  ASSERT_EQ(numeric_series_clear_dirty(series), RET_OK);
+  ASSERT_EQ(object_exec(obj, "change", NULL), RET_OK);
+  ASSERT_EQ(series->data[1], 20);
+  ASSERT_EQ(series->dirty_start, 1u);
+  ASSERT_EQ(series->dirty_end, 2u);
+
+  value_reset(&v);
+  object_unref(obj);
+}
+
+static int32_t js_eval_int(const char* code) {
+  jerry_value_t v = jerryscript_eval("test", code, strlen(code));
+  int32_t ret = (int32_t)jerry_get_number_value(v);
+
+  jerry_release_value(v);
+
+  return ret;
+}
+
+static uint64_t s_fake_time = 0;
+
+static uint64_t fake_time_now(void) {
+  return s_fake_time;
+}
+
+/*用假的时钟驱动全局的定时器，测试不依赖真实的时间*/
+static timer_manager_t* fake_timer_manager_begin(void) {
+  timer_manager_t* old = timer_manager();
+
+  s_fake_time = 1000;
+  timer_manager_set(timer_manager_create(fake_time_now));
+
+  return old;
+}
+
+static ret_t fake_timer_manager_end(timer_manager_t* old) {
+  timer_manager_destroy(timer_manager());
+
+  return timer_manager_set(old);
+}
+
+/*时钟前进一帧以上的时间，再分发定时器*/
+static ret_t dispatch_animation_frame(void) {
+  s_fake_time += 100;
+
+  return timer_dispatch();
+}
+
+TEST(JerryScriptAwtk, cancel_animation_frame_in_callback) {
+  const char* code =
+      "var frames = [];"
+      "var stamps = [];"
+      "var id2 = 0;"
+      "requestAnimationFrame(function(now) { frames.push(1); stamps.push(now); "
+      "cancelAnimationFrame(id2); });"
+      "id2 = requestAnimationFrame(function(now) { frames.push(2); });"
+      "requestAnimationFrame(function(now) { frames.push(3); stamps.push(now); });";
+  timer_manager_t* old = fake_timer_manager_begin();
+
+  ASSERT_EQ(jerryscript_run("test", code, strlen(code)), RET_OK);
+
+  /*还没有到一帧的时间*/
+  ASSERT_EQ(timer_dispatch(), RET_OK);
+  ASSERT_EQ(js_eval_int("frames.length"), 0);
+
+  ASSERT_EQ(dispatch_animation_frame(), RET_OK);
+
+  /*同一帧中还没有执行的回调可以取消*/
+  ASSERT_EQ(js_eval_int("frames.length"), 2);
+  ASSERT_EQ(js_eval_int("frames[0]"), 1);
+  ASSERT_EQ(js_eval_int("frames[1]"), 3);
+
+  /*同一帧的回调收到同样的时间*/
+  ASSERT_EQ(js_eval_int("stamps[0]"), (int32_t)s_fake_time);
+  ASSERT_EQ(js_eval_int("stamps[1]"), (int32_t)s_fake_time);
+
+  fake_timer_manager_end(old);
+}
+
+TEST(JerryScriptAwtk, cancel_animation_frame_not_found) {
+  const char* code =
+      "var fired = 0;"
+      "var self_cancel = 0;"
+      "var id = requestAnimationFrame(function(now) { fired++; "
+      "self_cancel = cancelAnimationFrame(id); });";
+  timer_manager_t* old = fake_timer_manager_begin();
+
+  ASSERT_EQ(jerryscript_run("test", code, strlen(code)), RET_OK);
+  ASSERT_EQ(js_eval_int("cancelAnimationFrame(123456)"), RET_NOT_FOUND);
+  ASSERT_EQ(dispatch_animation_frame(), RET_OK);
+
+  /*已经执行(包括正在执行)的回调不能再取消*/
+  ASSERT_EQ(js_eval_int("fired"), 1);
+  ASSERT_EQ(js_eval_int("self_cancel"), RET_NOT_FOUND);
+  ASSERT_EQ(js_eval_int("cancelAnimationFrame(id)"), RET_NOT_FOUND);
+
+  /*取消还没有执行的回调*/
+  ASSERT_EQ(js_eval_int("id = requestAnimationFrame(function(now) { fired++; }); "
+                        "cancelAnimationFrame(id)"),
+            RET_OK);
+  ASSERT_EQ(dispatch_animation_frame(), RET_OK);
+  ASSERT_EQ(js_eval_int("fired"), 1);
+
+  fake_timer_manager_end(old);
+}
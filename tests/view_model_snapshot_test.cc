@@ -0,0 +1,165 @@
+#include "tkc/fs.h"
+#include "mvvm/base/view_model_snapshot.h"
+#include "mvvm/base/view_model.h"
+#include "gtest/gtest.h"
+#include "test_obj.h"
+
+TEST(ViewModelSnapshot, basic) {
+  value_t v;
+  uint32_t size = 0;
+  uint32_t field_id = 0;
+  const void* data = NULL;
+  view_model_snapshot_t ws;
+  view_model_snapshot_t rs;
+
+  ASSERT_EQ(view_model_snapshot_init(&ws) != NULL, true);
+  ASSERT_EQ(view_model_snapshot_write(&ws, 1, value_set_int8(&v, -8)), RET_OK);
+  ASSERT_EQ(view_model_snapshot_write(&ws, 2, value_set_uint32(&v, 0xffffffff)), RET_OK);
+  ASSERT_EQ(view_model_snapshot_write(&ws, 3, value_set_double(&v, 1.5)), RET_OK);
+  ASSERT_EQ(view_model_snapshot_write(&ws, 4, value_set_str(&v, "hello")), RET_OK);
+  ASSERT_EQ(view_model_snapshot_write(&ws, 5, value_set_bool(&v, TRUE)), RET_OK);
+  ASSERT_EQ(view_model_snapshot_write(&ws, 6, value_set_pointer(&v, &v)), RET_NOT_IMPL);
+  ASSERT_EQ(ws.nr, 5u);
+
+  data = view_model_snapshot_get_data(&ws, &size);
+  ASSERT_EQ(view_model_snapshot_attach(&rs, data, size), RET_OK);
+  ASSERT_EQ(rs.nr, 5u);
+
+  ASSERT_EQ(view_model_snapshot_read(&rs, &field_id, &v), RET_OK);
+  ASSERT_EQ(field_id, 1u);
+  ASSERT_EQ(value_int(&v), -8);
+
+  ASSERT_EQ(view_model_snapshot_read(&rs, &field_id, &v), RET_OK);
+  ASSERT_EQ(field_id, 2u);
+  ASSERT_EQ(value_uint32(&v), 0xffffffffu);
+
+  ASSERT_EQ(view_model_snapshot_read(&rs, &field_id, &v), RET_OK);
+  ASSERT_EQ(field_id, 3u);
+  ASSERT_EQ(value_double(&v), 1.5);
+
+  ASSERT_EQ(view_model_snapshot_read(&rs, &field_id, &v), RET_OK);
+  ASSERT_EQ(field_id, 4u);
+  ASSERT_STREQ(value_str(&v), "hello");
+
+  ASSERT_EQ(view_model_snapshot_read(&rs, &field_id, &v), RET_OK);
+  ASSERT_EQ(field_id, 5u);
+  ASSERT_EQ(value_bool(&v), TRUE);
+
+  ASSERT_EQ(view_model_snapshot_read(&rs, &field_id, &v), RET_EOS);
+  ASSERT_EQ(view_model_snapshot_validate(&rs), RET_OK);
+  ASSERT_EQ(view_model_snapshot_attach(&rs, data, size - 1), RET_OK);
+  ASSERT_EQ(view_model_snapshot_validate(&rs), RET_BAD_PARAMS);
+  while (view_model_snapshot_read(&rs, &field_id, &v) == RET_OK) {
+  }
+  ASSERT_EQ(view_model_snapshot_read(&rs, &field_id, &v), RET_BAD_PARAMS);
+
+  view_model_snapshot_deinit(&rs);
+  view_model_snapshot_deinit(&ws);
+}
+
+TEST(ViewModelSnapshot, skip_unknown) {
+  value_t v;
+  uint32_t size = 0;
+  uint8_t* data = NULL;
+  uint32_t field_id = 0;
+  view_model_snapshot_t ws;
+  view_model_snapshot_t rs;
+
+  ASSERT_EQ(view_model_snapshot_init(&ws) != NULL, true);
+  ASSERT_EQ(view_model_snapshot_write(&ws, 1, value_set_str(&v, "abc")), RET_OK);
+  ASSERT_EQ(view_model_snapshot_write(&ws, 2, value_set_int(&v, 2)), RET_OK);
+
+  /*把第一个字段改成新版本才有的类型*/
+  data = (uint8_t*)view_model_snapshot_get_data(&ws, &size);
+  data[VIEW_MODEL_SNAPSHOT_HEADER_SIZE + 4] = 0xf0;
+
+  ASSERT_EQ(view_model_snapshot_attach(&rs, data, size), RET_OK);
+  ASSERT_EQ(view_model_snapshot_read(&rs, &field_id, &v), RET_OK);
+  ASSERT_EQ(field_id, 2u);
+  ASSERT_EQ(value_int(&v), 2);
+  ASSERT_EQ(view_model_snapshot_read(&rs, &field_id, &v), RET_EOS);
+
+  data[4] = VIEW_MODEL_SNAPSHOT_VERSION + 1;
+  ASSERT_EQ(view_model_snapshot_attach(&rs, data, size), RET_NOT_IMPL);
+  data[0] = 0;
+  ASSERT_EQ(view_model_snapshot_attach(&rs, data, size), RET_BAD_PARAMS);
+
+  view_model_snapshot_deinit(&ws);
+}
+
+TEST(ViewModelSnapshot, find_field) {
+  view_model_snapshot_field_t fields[] = {{10, 0}, {20, 1}, {30, 2}};
+
+  ASSERT_EQ(view_model_snapshot_find_field(fields, 3, 10), 0);
+  ASSERT_EQ(view_model_snapshot_find_field(fields, 3, 30), 2);
+  ASSERT_EQ(view_model_snapshot_find_field(fields, 3, 15), VIEW_MODEL_PROP_ID_INVALID);
+  ASSERT_EQ(view_model_snapshot_find_field(fields, 0, 10), VIEW_MODEL_PROP_ID_INVALID);
+
+  ASSERT_EQ(view_model_snapshot_field_id("value"), 0x425ed3cau);
+}
+
+TEST(ViewModelSnapshot, model) {
+  value_t v;
+  uint32_t size = 0;
+  const void* data = NULL;
+  view_model_snapshot_t ws;
+  view_model_t* vm = test_obj_view_model_create(NULL);
+  view_model_t* vm2 = test_obj_view_model_create(NULL);
+
+  object_set_prop_int(OBJECT(vm), "i32", 123);
+  object_set_prop_float(OBJECT(vm), "f64", 2.5);
+  object_set_prop_str(OBJECT(vm), "data", "abc");
+  object_set_prop_bool(OBJECT(vm), "b", TRUE);
+
+  ASSERT_EQ(view_model_snapshot_init(&ws) != NULL, true);
+  ASSERT_EQ(view_model_save_snapshot(vm, &ws), RET_OK);
+  data = view_model_snapshot_get_data(&ws, &size);
+
+  ASSERT_EQ(view_model_load_snapshot_from_data(vm2, data, size), RET_OK);
+  ASSERT_EQ(object_get_prop_int(OBJECT(vm2), "i32", 0), 123);
+  ASSERT_EQ(object_get_prop_float(OBJECT(vm2), "f64", 0), 2.5);
+  ASSERT_STREQ(object_get_prop_str(OBJECT(vm2), "data"), "abc");
+  ASSERT_EQ(object_get_prop_bool(OBJECT(vm2), "b", FALSE), TRUE);
+  ASSERT_EQ(view_model_notify_dirty_props(vm2), RET_NOT_FOUND);
+
+  ASSERT_EQ(view_model_save_snapshot_to_file(vm, "test_obj.snapshot"), RET_OK);
+  value_set_int(&v, 0);
+  ASSERT_EQ(view_model_set_prop_by_id(vm2, TEST_OBJ_PROP_I32, &v), RET_OK);
+  ASSERT_EQ(view_model_load_snapshot_from_file(vm2, "test_obj.snapshot"), RET_OK);
+  ASSERT_EQ(object_get_prop_int(OBJECT(vm2), "i32", 0), 123);
+  file_remove("test_obj.snapshot");
+
+  view_model_snapshot_deinit(&ws);
+  object_unref(OBJECT(vm));
+  object_unref(OBJECT(vm2));
+}
+
+TEST(ViewModelSnapshot, model_corrupted) {
+  uint32_t size = 0;
+  const void* data = NULL;
+  view_model_snapshot_t ws;
+  view_model_t* vm = test_obj_view_model_create(NULL);
+  view_model_t* vm2 = test_obj_view_model_create(NULL);
+
+  object_set_prop_int(OBJECT(vm), "i32", 123);
+  object_set_prop_str(OBJECT(vm), "data", "abc");
+  object_set_prop_int(OBJECT(vm2), "i32", 1);
+  object_set_prop_str(OBJECT(vm2), "data", "old");
+
+  ASSERT_EQ(view_model_snapshot_init(&ws) != NULL, true);
+  ASSERT_EQ(view_model_save_snapshot(vm, &ws), RET_OK);
+  data = view_model_snapshot_get_data(&ws, &size);
+
+  /*最后一个字段被截断，前面的字段也不能恢复*/
+  ASSERT_NE(view_model_load_snapshot_from_data(vm2, data, size - 1), RET_OK);
+  ASSERT_EQ(object_get_prop_int(OBJECT(vm2), "i32", 0), 1);
+  ASSERT_STREQ(object_get_prop_str(OBJECT(vm2), "data"), "old");
+
+  ASSERT_EQ(view_model_load_snapshot_from_data(vm2, data, size), RET_OK);
+  ASSERT_EQ(object_get_prop_int(OBJECT(vm2), "i32", 0), 123);
+  ASSERT_STREQ(object_get_prop_str(OBJECT(vm2), "data"), "abc");
+
+  view_model_snapshot_deinit(&ws);
+  object_unref(OBJECT(vm));
+  object_unref(OBJECT(vm2));
+}
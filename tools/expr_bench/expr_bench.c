@@ -0,0 +1,123 @@
+﻿/**
+ * File:   expr_bench.c
+ * Author: AWTK Develop Team
+ * Brief:  compare typed_expr_eval with eval_execute
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "tkc/platform.h"
+#include "tkc/time_now.h"
+#include "tkc/expr_eval.h"
+#include "mvvm/base/typed_expr.h"
+
+#define BENCH_TIMES 10000
+
+static ret_t get_variable(void* ctx, const char* name, value_t* v) {
+  if (tk_str_eq(name, "a")) {
+    value_set_int(v, 3);
+  } else if (tk_str_eq(name, "price")) {
+    value_set_double(v, 2.5);
+  } else if (tk_str_eq(name, "name")) {
+    value_set_str(v, "awtk");
+  } else {
+    return RET_NOT_FOUND;
+  }
+
+  return RET_OK;
+}
+
+static EvalResult legacy_get_variable(const char* name, void* user_data, ExprValue* output) {
+  value_t v;
+
+  if (get_variable(user_data, name, &v) != RET_OK) {
+    return eval_default_hooks()->get_variable(name, user_data, output);
+  }
+
+  if (v.type == VALUE_TYPE_STRING) {
+    expr_value_set_string(output, value_str(&v), strlen(value_str(&v)));
+  } else {
+    expr_value_set_number(output, value_double(&v));
+  }
+
+  return EVAL_RESULT_OK;
+}
+
+static uint64_t bench_typed(const char* expr, uint32_t times, str_t* buff) {
+  value_t v;
+  uint32_t i = 0;
+  uint64_t start = time_now_us();
+
+  for (i = 0; i < times; i++) {
+    if (typed_expr_eval(expr, get_variable, NULL, buff, &v) != RET_OK) {
+      log_warn("typed_expr error: %s\n", expr);
+      break;
+    }
+  }
+
+  return time_now_us() - start;
+}
+
+static uint64_t bench_legacy(const char* expr, uint32_t times) {
+  uint32_t i = 0;
+  EvalHooks hooks;
+  ExprValue result;
+  uint64_t start = time_now_us();
+
+  hooks.get_func = eval_default_hooks()->get_func;
+  hooks.get_variable = legacy_get_variable;
+
+  for (i = 0; i < times; i++) {
+    if (eval_execute(expr, &hooks, NULL, &result) != EVAL_RESULT_OK) {
+      log_warn("eval_execute error: %s\n", expr);
+      break;
+    }
+    expr_value_clear(&result);
+  }
+
+  return time_now_us() - start;
+}
+
+int main(int argc, char* argv[]) {
+  str_t buff;
+  uint32_t i = 0;
+  uint64_t typed_cost = 0;
+  uint64_t legacy_cost = 0;
+  uint32_t times = argc > 1 ? tk_atoi(argv[1]) : BENCH_TIMES;
+  const char* exprs[] = {"$a * 2 + 1", "($a > 1) ? \"high\" : \"low\"", "$price * $a - 0.5",
+                         "\"name: \" + $name"};
+
+  platform_prepare();
+  str_init(&buff, 0);
+
+  for (i = 0; i < ARRAY_SIZE(exprs); i++) {
+    uint64_t typed = bench_typed(exprs[i], times, &buff);
+    uint64_t legacy = bench_legacy(exprs[i], times);
+
+    printf("%-32s typed_expr: %8u us, eval_execute: %8u us\n", exprs[i], (uint32_t)typed,
+           (uint32_t)legacy);
+    typed_cost += typed;
+    legacy_cost += legacy;
+  }
+
+  printf("%-32s typed_expr: %8u us, eval_execute: %8u us (x %u)\n", "total", (uint32_t)typed_cost,
+         (uint32_t)legacy_cost, times);
+  str_reset(&buff);
+
+  return 0;
+}
@@ -1,4 +1,4 @@
-const fs = require('fs')
+﻿const fs = require('fs')
 const path = require('path')
 const utils = require('./utils')
 
@@ -7,6 +7,15 @@ class CodeGen {
     let clsName = json.name;
     let propsDecl = utils.genPropDecls(json);
     let clsNameUpper = clsName.toUpperCase();
+    let propIds = this.hasPropIds(json) ? utils.genPropIdEnum(json, utils.genGetPropsCases(json)) : '';
+    let dirtyDecl = '';
+
+    if (this.hasPropIds(json)) {
+      dirtyDecl = `
+  /*private*/
+  uint32_t dirty[(${clsNameUpper}_PROP_NR + 31) / 32];
+`;
+    }
 
     let result =
       `
@@ -27,6 +36,7 @@ typedef struct _${clsName}_t{
 ${propsDecl}
 } ${clsName}_t;
 
+${propIds}
 /**
  * @class ${clsName}_view_model_t
  *
@@ -38,7 +48,7 @@ typedef struct _${clsName}_view_model_t {
 
   /*model object*/
   ${clsName}_t* ${clsName};
-} ${clsName}_view_model_t;
+${dirtyDecl}} ${clsName}_view_model_t;
 
 /**
  * @method ${clsName}_view_model_create
@@ -54,26 +64,53 @@ view_model_t* ${clsName}_view_model_create(navigator_request_t* req);
 END_C_DECLS
 
 #endif /*TK_${clsNameUpper}_H*/
+`
+    return result;
+  }
+
+  hasPropIds(json) {
+    return json.props && utils.genGetPropsCases(json).length > 0;
+  }
+
+  genPropId(json) {
+    const clsName = json.name;
+    const cases = utils.genGetPropsCases(json);
+    const dispatch = utils.genNameDispatch(utils.genPropIdCases(json, cases));
+    const result =
+      `
+static int32_t ${clsName}_view_model_get_prop_id(view_model_t* view_model, const char* name) {
+  return_value_if_fail(name != NULL, VIEW_MODEL_PROP_ID_INVALID);
+
+${dispatch}
+  return VIEW_MODEL_PROP_ID_INVALID;
+}
+
 `
     return result;
   }
 
   genGetProps(json) {
     const clsName = json.name;
-    const dispatch = utils.genGetPropsDispatch(json);
+    const dispatch = utils.genIdDispatch(json, utils.genGetPropsCases(json));
     const result =
       `
-static ret_t ${clsName}_view_model_get_prop(object_t* obj, const char* name, value_t* v) {
-  ${clsName}_view_model_t* vm = (${clsName}_view_model_t*)(obj);
+static ret_t ${clsName}_view_model_get_prop_by_id(view_model_t* view_model, int32_t id, value_t* v) {
+  ${clsName}_view_model_t* vm = (${clsName}_view_model_t*)(view_model);
   ${clsName}_t* ${clsName} = vm->${clsName};
 
 ${dispatch}
-  } else {
+  return RET_NOT_FOUND;
+}
+
+static ret_t ${clsName}_view_model_get_prop(object_t* obj, const char* name, value_t* v) {
+  int32_t id = ${clsName}_view_model_get_prop_id(VIEW_MODEL(obj), name);
+
+  if (id == VIEW_MODEL_PROP_ID_INVALID) {
     log_debug("not found %s\\n", name);
     return RET_NOT_FOUND;
   }
-  
-  return RET_OK;
+
+  return ${clsName}_view_model_get_prop_by_id(VIEW_MODEL(obj), id, v);
 }
 
 `
@@ -82,40 +119,99 @@ ${dispatch}
 
   genSetProps(json) {
     const clsName = json.name;
-    const dispatch = utils.genSetPropsDispatch(json);
+    const dispatch = utils.genSetPropsByIdDispatch(json);
     const result =
-      `
-static ret_t ${clsName}_view_model_set_prop(object_t* obj, const char* name, const value_t* v) {
-  ${clsName}_view_model_t* vm = (${clsName}_view_model_t*)(obj);
+      `${utils.genDirtyPropsFuncs(`${clsName}_view_model_t`, `${clsName}_view_model`)}${utils.genMarkDirtyFunc(json, `${clsName}_view_model_t`, `${clsName}_view_model`)}
+static ret_t ${clsName}_view_model_set_prop_by_id(view_model_t* view_model, int32_t id, const value_t* v) {
+  value_t old;
+  ${clsName}_view_model_t* vm = (${clsName}_view_model_t*)(view_model);
   ${clsName}_t* ${clsName} = vm->${clsName};
 
+  if (${clsName}_view_model_get_prop_by_id(view_model, id, &old) == RET_OK && value_equal(&old, v)) {
+    return RET_OK;
+  }
+
 ${dispatch}
-  } else {
+  return ${clsName}_view_model_mark_dirty(vm, id);
+}
+
+static ret_t ${clsName}_view_model_set_prop(object_t* obj, const char* name, const value_t* v) {
+  ret_t ret = RET_OK;
+  int32_t id = ${clsName}_view_model_get_prop_id(VIEW_MODEL(obj), name);
+
+  if (id == VIEW_MODEL_PROP_ID_INVALID) {
     log_debug("not found %s\\n", name);
     return RET_NOT_FOUND;
   }
-  
+
+  ret = ${clsName}_view_model_set_prop_by_id(VIEW_MODEL(obj), id, v);
+  /*随后object_set_prop触发EVT_PROP_CHANGED，绑定上下文全部刷新，不需要再发布脏属性*/
+  ${clsName}_view_model_clear_dirty_props(VIEW_MODEL(obj));
+
+  return ret;
+}
+
+`
+    return result;
+  }
+
+  genSnapshot(json) {
+    const clsName = json.name;
+    const fields = `s_${clsName}_snapshot_fields`;
+    const table = utils.genSnapshotFields(json, fields);
+
+    if (!table) {
+      return '';
+    }
+
+    const result =
+      `${table}
+static ret_t ${clsName}_view_model_save_snapshot(view_model_t* view_model,
+                                                 view_model_snapshot_t* snapshot) {
+  value_t v;
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(${fields}); i++) {
+    const view_model_snapshot_field_t* iter = ${fields} + i;
+
+    if (${clsName}_view_model_get_prop_by_id(view_model, iter->prop_id, &v) == RET_OK) {
+      return_value_if_fail(view_model_snapshot_write(snapshot, iter->field_id, &v) == RET_OK, RET_OOM);
+    }
+  }
+
   return RET_OK;
 }
 
+static ret_t ${clsName}_view_model_load_snapshot(view_model_t* view_model,
+                                                 view_model_snapshot_t* snapshot) {
+  value_t v;
+  int32_t id = 0;
+  ret_t ret = RET_OK;
+  uint32_t field_id = 0;
+
+  /*先检查整个快照，数据损坏时不修改模型*/
+  ret = view_model_snapshot_validate(snapshot);
+  if (ret != RET_OK) {
+    return ret;
+  }
+
+  while ((ret = view_model_snapshot_read(snapshot, &field_id, &v)) == RET_OK) {
+    id = view_model_snapshot_find_field(${fields}, ARRAY_SIZE(${fields}), field_id);
+    if (id != VIEW_MODEL_PROP_ID_INVALID) {
+      ${clsName}_view_model_set_prop_by_id(view_model, id, &v);
+    }
+  }
+
+  return ret == RET_EOS ? RET_OK : ret;
+}
+
 `
     return result;
   }
 
   genExec(json) {
     const clsName = json.name;
-    const dispatch = json.cmds.map((cmd, index) => {
-      const cmdName = cmd.name;
-      let str = '  ';
-      if (index === 0) {
-        str += 'if (';
-      } else {
-        str += '} else if (';
-      }
-      str += `tk_str_eq("${cmdName}", name)) {\n`
-      str += `    return ${clsName}_${cmdName}(${clsName}, args);`;
-      return str;
-    }).join('\n');
+    const dispatch = utils.genExecDispatch(json);
 
     const result =
       `
@@ -124,10 +220,8 @@ static ret_t ${clsName}_view_model_exec(object_t* obj, const char* name, const c
   ${clsName}_t* ${clsName} = vm->${clsName};
 
 ${dispatch}
-  } else {
-    log_debug("not found %s\\n", name);
-    return RET_NOT_FOUND;
-  }
+  log_debug("not found %s\\n", name);
+  return RET_NOT_FOUND;
 }
 `
     return result;
@@ -135,23 +229,7 @@ ${dispatch}
 
   genCanExec(json) {
     const clsName = json.name;
-    const dispatch = json.cmds.map((cmd, index) => {
-      const cmdName = cmd.name;
-      let str = '  ';
-      if (index === 0) {
-        str += 'if (';
-      } else {
-        str += '} else if (';
-      }
-      str += `tk_str_eq("${cmdName}", name)) {\n`
-
-      if (!cmd.canExec || typeof cmd.canExec === 'string') {
-        str += `    return ${clsName}_can_exec_${cmdName}(${clsName}, args);`;
-      } else {
-        str += `    return TRUE;`;
-      }
-      return str;
-    }).join('\n');
+    const dispatch = utils.genCanExecDispatch(json);
 
     const result =
       `
@@ -160,9 +238,7 @@ static bool_t ${clsName}_view_model_can_exec(object_t* obj, const char* name, co
   ${clsName}_t* ${clsName} = vm->${clsName};
 
 ${dispatch}
-  } else {
-    return FALSE;
-  }
+  return FALSE;
 }
 `
     return result;
@@ -171,6 +247,25 @@ ${dispatch}
   genVTable(json) {
     const clsName = json.name;
     const clsDesc = json.desc || clsName;
+    let vmVTable = '';
+    let vmInit = '';
+
+    if (this.hasPropIds(json)) {
+      const snapshot = utils.getSnapshotProps(json).length ? `,
+  .save_snapshot = ${clsName}_view_model_save_snapshot,
+  .load_snapshot = ${clsName}_view_model_load_snapshot` : '';
+      vmVTable = `static const view_model_vtable_t s_${clsName}_view_model_vm_vtable = {
+  .get_prop_id = ${clsName}_view_model_get_prop_id,
+  .get_prop_by_id = ${clsName}_view_model_get_prop_by_id,
+  .set_prop_by_id = ${clsName}_view_model_set_prop_by_id,
+  .get_dirty_props = ${clsName}_view_model_get_dirty_props,
+  .clear_dirty_props = ${clsName}_view_model_clear_dirty_props${snapshot}
+};
+
+`;
+      vmInit = `  vm->vt = &s_${clsName}_view_model_vm_vtable;\n`;
+    }
+
     let result =
       `
 static ret_t ${clsName}_view_model_on_destroy(object_t* obj) {
@@ -182,7 +277,7 @@ static ret_t ${clsName}_view_model_on_destroy(object_t* obj) {
   return view_model_deinit(VIEW_MODEL(obj));
 }
 
-static const object_vtable_t s_${clsName}_view_model_vtable = {
+${vmVTable}static const object_vtable_t s_${clsName}_view_model_vtable = {
   .type = "${clsName}",
   .desc = "${clsDesc}",
   .size = sizeof(${clsName}_view_model_t),
@@ -199,7 +294,7 @@ view_model_t* ${clsName}_view_model_create(navigator_request_t* req) {
   ${clsName}_view_model_t* ${clsName}_view_model = (${clsName}_view_model_t*)(vm);
 
   return_value_if_fail(vm != NULL, NULL);
-
+${vmInit}
   ${clsName}_view_model->${clsName} = ${clsName}_create();
   ENSURE(${clsName}_view_model->${clsName} != NULL);
 
@@ -222,9 +317,11 @@ view_model_t* ${clsName}_view_model_create(navigator_request_t* req) {
     }
 
     result += `/***************${clsName}_view_model***************/\n`;
-    if (json.props && json.props.length) {
-      result += this.genSetProps(json);
+    if (this.hasPropIds(json)) {
+      result += this.genPropId(json);
       result += this.genGetProps(json);
+      result += this.genSetProps(json);
+      result += this.genSnapshot(json);
     } else {
       result +=
         `
@@ -277,9 +374,11 @@ static ret_t ${clsName}_view_model_exec(object_t* obj, const char* name, const c
   }
 }
 
-if (process.argv.length < 3) {
-  console.log(`Usage: node gen_vm.js idl.json`);
+const files = utils.parseArgs(process.argv.slice(2));
+
+if (files.length < 1) {
+  console.log(`Usage: node gen_vm.js [--dispatch=switch|chain] idl.json`);
   process.exit(0);
 }
 
-CodeGen.run(process.argv[2]);
+CodeGen.run(files[0]);
@@ -1,4 +1,4 @@
-const fs = require('fs')
+﻿const fs = require('fs')
 const path = require('path')
 const utils = require('./utils')
 
@@ -7,13 +7,14 @@ class CodeGen {
     let clsName = json.name;
     let propsDecl = utils.genPropDecls(json);
     let clsNameUpper = clsName.toUpperCase();
+    let propIds = utils.genPropIdEnum(json, this.genPropIdCases(json));
 
     let result =
       `
 #ifndef TK_${clsNameUpper}_H
 #define TK_${clsNameUpper}_H
 
-#include "tkc/darray.h"
+${this.genHeaderIncludes()}
 #include "mvvm/base/view_model_array.h"
 
 BEGIN_C_DECLS
@@ -28,6 +29,7 @@ typedef struct _${clsName}_t {
 ${propsDecl}
 } ${clsName}_t;
 
+${propIds}
 /**
  * @class ${clsName}s_view_model_t
  *
@@ -37,8 +39,10 @@ ${propsDecl}
 typedef struct _${clsName}s_view_model_t {
   view_model_array_t view_model_array;
 
-  /*model object*/
-  darray_t ${clsName}s;
+${this.genStorageDecl(json)}
+
+  /*private*/
+  uint32_t dirty[(${clsNameUpper}_PROP_NR + 31) / 32];
 } ${clsName}s_view_model_t;
 
 /**
@@ -52,7 +56,30 @@ typedef struct _${clsName}s_view_model_t {
  */
 view_model_t* ${clsName}s_view_model_create(navigator_request_t* req);
 
-/*public for test*/
+${this.genPublicDecls(json)}
+
+END_C_DECLS
+
+#endif /*TK_${clsNameUpper}_H*/
+`
+    return result;
+  }
+
+  genHeaderIncludes() {
+    return '#include "tkc/darray.h"';
+  }
+
+  genStorageDecl(json) {
+    const clsName = json.name;
+
+    return `  /*model object*/
+  darray_t ${clsName}s;`;
+  }
+
+  genPublicDecls(json) {
+    const clsName = json.name;
+
+    return `/*public for test*/
 
 ${clsName}_t* ${clsName}_create(void);
 
@@ -60,24 +87,64 @@ ret_t ${clsName}s_view_model_clear(view_model_t* view_model);
 uint32_t ${clsName}s_view_model_size(view_model_t* view_model);
 ret_t ${clsName}s_view_model_remove(view_model_t* view_model, uint32_t index);
 ret_t ${clsName}s_view_model_add(view_model_t* view_model, ${clsName}_t* ${clsName});
-${clsName}_t* ${clsName}s_view_model_get(view_model_t* view_model, uint32_t index);
+${clsName}_t* ${clsName}s_view_model_get(view_model_t* view_model, uint32_t index);`;
+  }
 
-END_C_DECLS
+  genPropIdCases(json) {
+    return utils.genGetPropsCases(json).concat([{
+      name: 'style',
+      body: ['value_set_str(v, index % 2 ? "odd" : "even");', 'return RET_OK;']
+    }]);
+  }
+
+  genPropId(json) {
+    const clsName = json.name;
+    const dispatch = utils.genNameDispatch(utils.genPropIdCases(json, this.genPropIdCases(json)));
+    const result =
+      `
+static int32_t ${clsName}s_view_model_get_prop_id(view_model_t* view_model, const char* name) {
+  return_value_if_fail(name != NULL, VIEW_MODEL_PROP_ID_INVALID);
+
+  if (tk_str_start_with(name, "item.")) {
+    name += 5;
+  }
+
+${dispatch}
+  return VIEW_MODEL_PROP_ID_INVALID;
+}
 
-#endif /*TK_${clsNameUpper}_H*/
 `
     return result;
   }
 
+  genGetItemProp(json) {
+    const clsName = json.name;
+    const dispatch = utils.genIdDispatch(json, this.genPropIdCases(json));
+
+    return `
+static ret_t ${clsName}s_view_model_get_item_prop(view_model_t* vm, uint32_t index, int32_t id,
+                                             value_t* v) {
+  ${clsName}_t* ${clsName} = ${clsName}s_view_model_get(vm, index);
+  return_value_if_fail(${clsName} != NULL, RET_BAD_PARAMS);
+
+${dispatch}
+  return RET_NOT_FOUND;
+}
+`;
+  }
+
   genGetProps(json) {
     const clsName = json.name;
-    const dispatch = utils.genGetPropsDispatch(json);
 
-    const result =
+    const result = this.genGetItemProp(json) +
       `
+static ret_t ${clsName}s_view_model_get_prop_by_id(view_model_t* vm, int32_t id, value_t* v) {
+  return ${clsName}s_view_model_get_item_prop(vm, VIEW_MODEL_ARRAY(vm)->cursor, id, v);
+}
+
 static ret_t ${clsName}s_view_model_get_prop(object_t* obj, const char* name, value_t* v) {
+  int32_t id = 0;
   uint32_t index = 0;
-  ${clsName}_t* ${clsName} = NULL;
   view_model_t* vm = VIEW_MODEL(obj);
 
   if (tk_str_eq(VIEW_MODEL_PROP_ITEMS, name)) {
@@ -92,33 +159,55 @@ static ret_t ${clsName}s_view_model_get_prop(object_t* obj, const char* name, va
 
   name = destruct_array_prop_name(name, &index);
   return_value_if_fail(name != NULL, RET_BAD_PARAMS);
-  ${clsName} = ${clsName}s_view_model_get(vm, index);
-  return_value_if_fail(${clsName} != NULL, RET_BAD_PARAMS);
 
-${dispatch}
-  } else if (tk_str_eq("style", name)) {
-    value_set_str(v, index % 2 ? "odd" : "even");
-  } else {
+  id = ${clsName}s_view_model_get_prop_id(vm, name);
+  if (id == VIEW_MODEL_PROP_ID_INVALID) {
     log_debug("not found %s\\n", name);
     return RET_NOT_FOUND;
   }
-  
-  return RET_OK;
+
+  return ${clsName}s_view_model_get_item_prop(vm, index, id, v);
 }
 
 `
     return result;
   }
 
+  genSetItemProp(json) {
+    const clsName = json.name;
+    const dispatch = utils.genSetPropsByIdDispatch(json);
+
+    return `
+static ret_t ${clsName}s_view_model_set_item_prop(view_model_t* vm, uint32_t index, int32_t id,
+                                             const value_t* v) {
+  value_t old;
+  ${clsName}s_view_model_t* ${clsName}_vm = (${clsName}s_view_model_t*)(vm);
+  ${clsName}_t* ${clsName} = ${clsName}s_view_model_get(vm, index);
+  return_value_if_fail(${clsName} != NULL, RET_BAD_PARAMS);
+
+  if (${clsName}s_view_model_get_item_prop(vm, index, id, &old) == RET_OK && value_equal(&old, v)) {
+    return RET_OK;
+  }
+
+${dispatch}
+  return ${clsName}s_view_model_mark_dirty(${clsName}_vm, id);
+}
+`;
+  }
+
   genSetProps(json) {
     const clsName = json.name;
-    const dispatch = utils.genSetPropsDispatch(json);
 
     const result =
-      `
+      `${utils.genDirtyPropsFuncs(`${clsName}s_view_model_t`, `${clsName}s_view_model`)}${utils.genMarkDirtyFunc(json, `${clsName}s_view_model_t`, `${clsName}s_view_model`)}${this.genSetItemProp(json)}
+static ret_t ${clsName}s_view_model_set_prop_by_id(view_model_t* vm, int32_t id, const value_t* v) {
+  return ${clsName}s_view_model_set_item_prop(vm, VIEW_MODEL_ARRAY(vm)->cursor, id, v);
+}
+
 static ret_t ${clsName}s_view_model_set_prop(object_t* obj, const char* name, const value_t* v) {
+  int32_t id = 0;
   uint32_t index = 0;
-  ${clsName}_t* ${clsName} = NULL;
+  ret_t ret = RET_OK;
   view_model_t* vm = VIEW_MODEL(obj);
 
   if (tk_str_eq(VIEW_MODEL_PROP_CURSOR, name)) {
@@ -129,31 +218,100 @@ static ret_t ${clsName}s_view_model_set_prop(object_t* obj, const char* name, co
 
   name = destruct_array_prop_name(name, &index);
   return_value_if_fail(name != NULL, RET_BAD_PARAMS);
-  ${clsName} = ${clsName}s_view_model_get(vm, index);
-  return_value_if_fail(${clsName} != NULL, RET_BAD_PARAMS);
 
-${dispatch}
-  } else {
+  id = ${clsName}s_view_model_get_prop_id(vm, name);
+  if (id == VIEW_MODEL_PROP_ID_INVALID) {
     log_debug("not found %s\\n", name);
     return RET_NOT_FOUND;
   }
-  
+
+  ret = ${clsName}s_view_model_set_item_prop(vm, index, id, v);
+  /*随后object_set_prop触发EVT_PROP_CHANGED，绑定上下文全部刷新，不需要再发布脏属性*/
+  ${clsName}s_view_model_clear_dirty_props(vm);
+
+  return ret;
+}
+
+`
+    return result;
+  }
+
+  genSnapshotNewRow(json) {
+    const clsName = json.name;
+
+    return `${clsName}s_view_model_add(vm, ${clsName}_create())`;
+  }
+
+  genSnapshot(json) {
+    const clsName = json.name;
+    const fields = `s_${clsName}_snapshot_fields`;
+    const table = utils.genSnapshotFields(json, fields);
+
+    if (!table) {
+      return '';
+    }
+
+    const result =
+      `${table}
+static ret_t ${clsName}s_view_model_save_snapshot(view_model_t* vm, view_model_snapshot_t* snapshot) {
+  value_t v;
+  uint32_t i = 0;
+  uint32_t index = 0;
+  uint32_t size = ${clsName}s_view_model_size(vm);
+
+  for (index = 0; index < size; index++) {
+    value_set_uint32(&v, index);
+    return_value_if_fail(view_model_snapshot_write(snapshot, VIEW_MODEL_SNAPSHOT_FIELD_ITEM, &v) == RET_OK,
+                         RET_OOM);
+
+    for (i = 0; i < ARRAY_SIZE(${fields}); i++) {
+      const view_model_snapshot_field_t* iter = ${fields} + i;
+
+      if (${clsName}s_view_model_get_item_prop(vm, index, iter->prop_id, &v) == RET_OK) {
+        return_value_if_fail(view_model_snapshot_write(snapshot, iter->field_id, &v) == RET_OK,
+                             RET_OOM);
+      }
+    }
+  }
+
   return RET_OK;
 }
 
+static ret_t ${clsName}s_view_model_load_snapshot(view_model_t* vm, view_model_snapshot_t* snapshot) {
+  value_t v;
+  int32_t id = 0;
+  int32_t index = -1;
+  ret_t ret = RET_OK;
+  uint32_t field_id = 0;
+
+  /*先检查整个快照，数据损坏时不修改模型*/
+  ret = view_model_snapshot_validate(snapshot);
+  if (ret != RET_OK) {
+    return ret;
+  }
+
+  ${clsName}s_view_model_clear(vm);
+  while ((ret = view_model_snapshot_read(snapshot, &field_id, &v)) == RET_OK) {
+    if (field_id == VIEW_MODEL_SNAPSHOT_FIELD_ITEM) {
+      return_value_if_fail(${this.genSnapshotNewRow(json)} == RET_OK, RET_OOM);
+      index = ${clsName}s_view_model_size(vm) - 1;
+    } else if (index >= 0) {
+      id = view_model_snapshot_find_field(${fields}, ARRAY_SIZE(${fields}), field_id);
+      if (id != VIEW_MODEL_PROP_ID_INVALID) {
+        ${clsName}s_view_model_set_item_prop(vm, index, id, &v);
+      }
+    }
+  }
+
+  return ret == RET_EOS ? RET_OK : ret;
+}
 `
     return result;
   }
 
   genExec(json) {
     const clsName = json.name;
-    const dispatch = json.cmds.map((cmd, index) => {
-      const cmdName = cmd.name;
-      let str = '  } else if (';
-      str += `tk_str_eq("${cmdName}", name)) {\n`
-      str += `    return ${clsName}_${cmdName}(${clsName}, args);`;
-      return str;
-    }).join('\n');
+    const dispatch = utils.genExecDispatch(json);
 
     const result =
       `
@@ -176,11 +334,11 @@ static ret_t ${clsName}s_view_model_exec(object_t* obj, const char* name, const
   if (tk_str_ieq(name, "remove")) {
     ENSURE(${clsName}s_view_model_remove(vm, index) == RET_OK);
     return RET_ITEMS_CHANGED;
-${dispatch}
-  } else {
-    log_debug("not found %s\\\n", name);
-    return RET_NOT_FOUND;
   }
+
+${dispatch}
+  log_debug("not found %s\\n", name);
+  return RET_NOT_FOUND;
 }
 `
     return result;
@@ -188,18 +346,7 @@ ${dispatch}
 
   genCanExec(json) {
     const clsName = json.name;
-    const dispatch = json.cmds.map((cmd, index) => {
-      const cmdName = cmd.name;
-      let str = '  } else if (';
-      str += `tk_str_eq("${cmdName}", name)) {\n`
-
-      if (!cmd.canExec || typeof cmd.canExec === 'string') {
-        str += `    return ${clsName}_can_exec_${cmdName}(${clsName}, args);`;
-      } else {
-        str += `    return TRUE;`;
-      }
-      return str;
-    }).join('\n');
+    const dispatch = utils.genCanExecDispatch(json);
 
     const result =
       `
@@ -219,10 +366,10 @@ static bool_t ${clsName}s_view_model_can_exec(object_t* obj, const char* name, c
 
   if (tk_str_ieq(name, "remove")) {
     return index < ${clsName}s_view_model_size(vm);
-${dispatch}
-  } else {
-    return FALSE;
   }
+
+${dispatch}
+  return FALSE;
 }
 `
     return result;
@@ -231,18 +378,27 @@ ${dispatch}
   genVTable(json) {
     const clsName = json.name;
     const clsDesc = json.desc || clsName;
+    const snapshot = utils.getSnapshotProps(json).length ? `,
+  .save_snapshot = ${clsName}s_view_model_save_snapshot,
+  .load_snapshot = ${clsName}s_view_model_load_snapshot` : '';
     let result =
       `
 static ret_t ${clsName}s_view_model_on_destroy(object_t* obj) {
   ${clsName}s_view_model_t* vm = (${clsName}s_view_model_t*)(obj);
   return_value_if_fail(vm != NULL, RET_BAD_PARAMS);
   
-  ${clsName}s_view_model_clear(VIEW_MODEL(obj));
-  darray_deinit(&(vm->${clsName}s));
-
+${this.genStorageDeinit(json)}
   return view_model_array_deinit(VIEW_MODEL(obj));
 }
 
+static const view_model_vtable_t s_${clsName}s_view_model_vm_vtable = {
+  .get_prop_id = ${clsName}s_view_model_get_prop_id,
+  .get_prop_by_id = ${clsName}s_view_model_get_prop_by_id,
+  .set_prop_by_id = ${clsName}s_view_model_set_prop_by_id,
+  .get_dirty_props = ${clsName}s_view_model_get_dirty_props,
+  .clear_dirty_props = ${clsName}s_view_model_clear_dirty_props${snapshot}
+};
+
 static const object_vtable_t s_${clsName}s_view_model_vtable = {
   .type = "${clsName}",
   .desc = "${clsDesc}",
@@ -258,32 +414,47 @@ static const object_vtable_t s_${clsName}s_view_model_vtable = {
 view_model_t* ${clsName}s_view_model_create(navigator_request_t* req) {
   object_t* obj = object_create(&s_${clsName}s_view_model_vtable);
   view_model_t* vm = view_model_array_init(VIEW_MODEL(obj));
-  ${clsName}s_view_model_t* ${clsName}_vm = (${clsName}s_view_model_t*)(vm);
-
+${this.genStorageVar(json)}
   return_value_if_fail(vm != NULL, NULL);
-
-  darray_init(&(${clsName}_vm->${clsName}s), 100, 
-    (tk_destroy_t)${clsName}_destroy, (tk_compare_t)${clsName}_cmp);
-
+  vm->vt = &s_${clsName}s_view_model_vm_vtable;
+${this.genStorageInit(json)}
   return vm;
 }
 `
     return result;
   }
 
-  genContent(json) {
+  genStorageVar(json) {
     const clsName = json.name;
-    let result = utils.genModelCommonFuncs(json);
 
-    if (json.props && json.props.length) {
-      result += utils.genPropFuncs(json);
-    }
+    return `  ${clsName}s_view_model_t* ${clsName}_vm = (${clsName}s_view_model_t*)(vm);\n`;
+  }
 
-    if (json.cmds && json.cmds.length) {
-      result += utils.genCmdFuncs(json);
-    }
+  genStorageInit(json) {
+    const clsName = json.name;
 
-    result += `
+    return `
+  darray_init(&(${clsName}_vm->${clsName}s), 100, 
+    (tk_destroy_t)${clsName}_destroy, (tk_compare_t)${clsName}_cmp);
+`;
+  }
+
+  genStorageDeinit(json) {
+    const clsName = json.name;
+
+    return `  ${clsName}s_view_model_clear(VIEW_MODEL(obj));
+  darray_deinit(&(vm->${clsName}s));
+`;
+  }
+
+  genModelFuncs(json) {
+    return utils.genModelCommonFuncs(json);
+  }
+
+  genStorage(json) {
+    const clsName = json.name;
+
+    return `
 /***************${clsName}s_view_model***************/
 
 ret_t ${clsName}s_view_model_remove(view_model_t* view_model, uint32_t index) {
@@ -323,8 +494,24 @@ ${clsName}_t* ${clsName}s_view_model_get(view_model_t* view_model, uint32_t inde
   return (${clsName}_t*)(${clsName}_vm->${clsName}s.elms[index]);
 }
 `
-    result += this.genSetProps(json);
+  }
+
+  genContent(json) {
+    let result = this.genModelFuncs(json);
+
+    if (json.props && json.props.length) {
+      result += utils.genPropFuncs(json);
+    }
+
+    if (json.cmds && json.cmds.length) {
+      result += utils.genCmdFuncs(json);
+    }
+
+    result += this.genStorage(json);
+    result += this.genPropId(json);
     result += this.genGetProps(json);
+    result += this.genSetProps(json);
+    result += this.genSnapshot(json);
 
     result += this.genCanExec(json);
     result += this.genExec(json);
@@ -343,14 +530,547 @@ ${clsName}_t* ${clsName}s_view_model_get(view_model_t* view_model, uint32_t inde
   }
 
   static run(filename) {
-    const gen = new CodeGen();
-    gen.genFile(filename);
+    const json = JSON.parse(fs.readFileSync(filename).toString());
+    const gen = (json.layout || utils.layout) === 'columnar' ? new ColumnarCodeGen() : new CodeGen();
+
+    gen.genJson(json);
+  }
+}
+
+/*
+ * 列式集合：每个属性一列连续的数组，另有一列稳定的行ID(按添加顺序递增)。
+ * 普通属性直接读写列；命令和带getter/setter的属性通过行的浅拷贝(load_row/store_row)访问。
+ */
+class ColumnarCodeGen extends CodeGen {
+  getColumns(json) {
+    return (json.props || []).filter(prop => !prop.fake);
+  }
+
+  getColumnType(prop) {
+    return prop.type === 'char*' ? 'str_t' : prop.type;
+  }
+
+  genHeaderIncludes() {
+    return '#include "tkc/str.h"';
+  }
+
+  genStorageDecl(json) {
+    const columns = this.getColumns(json).map(prop => {
+      return `    ${this.getColumnType(prop)}* ${prop.name};`;
+    }).join('\n');
+
+    let result = `  /*model object*/
+  uint32_t size;
+  uint32_t capacity;
+  uint32_t next_id;
+  uint32_t* ids;`;
+
+    if (columns) {
+      result += `
+  struct {
+${columns}
+  } columns;`;
+    }
+
+    return result;
+  }
+
+  genPublicDecls(json) {
+    const clsName = json.name;
+
+    return `/**
+ * @method ${clsName}s_view_model_append
+ * 批量追加记录。记录中的字段(如str_t)直接转移给集合，调用者只需要释放rows本身。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {const ${clsName}_t*} rows 记录数组。
+ * @param {uint32_t} nr 记录的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t ${clsName}s_view_model_append(view_model_t* view_model, const ${clsName}_t* rows, uint32_t nr);
+
+/**
+ * @method ${clsName}s_view_model_remove_range
+ * 删除从index开始的nr条记录。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} index 第一条记录的序数。
+ * @param {uint32_t} nr 记录的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t ${clsName}s_view_model_remove_range(view_model_t* view_model, uint32_t index, uint32_t nr);
+
+/**
+ * @method ${clsName}s_view_model_get_id
+ * 获取记录的ID。ID在添加时分配，删除其它记录后保持不变。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} index 记录的序数。
+ *
+ * @return {uint32_t} 返回记录的ID，失败返回0。
+ */
+uint32_t ${clsName}s_view_model_get_id(view_model_t* view_model, uint32_t index);
+
+/**
+ * @method ${clsName}s_view_model_index_of
+ * 根据记录的ID查找记录的序数。
+ *
+ * @param {view_model_t*} view_model view_model对象。
+ * @param {uint32_t} id 记录的ID。
+ *
+ * @return {int32_t} 返回记录的序数，找不到返回-1。
+ */
+int32_t ${clsName}s_view_model_index_of(view_model_t* view_model, uint32_t id);
+
+/*public for test*/
+
+${clsName}_t* ${clsName}_create(void);
+
+ret_t ${clsName}s_view_model_clear(view_model_t* view_model);
+uint32_t ${clsName}s_view_model_size(view_model_t* view_model);
+ret_t ${clsName}s_view_model_remove(view_model_t* view_model, uint32_t index);
+ret_t ${clsName}s_view_model_add(view_model_t* view_model, ${clsName}_t* ${clsName});`;
+  }
+
+  genModelFuncs(json) {
+    return utils.genModelCommonFuncs(json, true);
+  }
+
+  genColumnsRealloc(json) {
+    const clsName = json.name;
+
+    return this.getColumns(json).map(prop => {
+      const type = this.getColumnType(prop);
+      return `
+  p = TKMEM_REALLOC(${clsName}s->columns.${prop.name}, capacity * sizeof(${type}));
+  return_value_if_fail(p != NULL, RET_OOM);
+  ${clsName}s->columns.${prop.name} = (${type}*)p;
+`;
+    }).join('');
+  }
+
+  genColumnsMove(json) {
+    const clsName = json.name;
+
+    return this.getColumns(json).map(prop => {
+      const type = this.getColumnType(prop);
+      return `  memmove(${clsName}s->columns.${prop.name} + index, ${clsName}s->columns.${prop.name} + index + nr,
+          rest * sizeof(${type}));\n`;
+    }).join('');
+  }
+
+  genSnapshotNewRow(json) {
+    const clsName = json.name;
+
+    return `${clsName}s_view_model_append_empty(vm)`;
+  }
+
+  genStorage(json) {
+    const clsName = json.name;
+    const columns = this.getColumns(json);
+    const load = columns.map(prop => {
+      return `  ${clsName}->${prop.name} = ${clsName}s->columns.${prop.name}[index];\n`;
+    }).join('');
+    const store = columns.map(prop => {
+      return `  ${clsName}s->columns.${prop.name}[index] = ${clsName}->${prop.name};\n`;
+    }).join('');
+    const deinit = utils.genModelDeinit(json).split('\n').map(iter => {
+      return iter ? '  ' + iter : iter;
+    }).join('\n').replace(/\n+$/, '');
+    const destroy = utils.genModelDeinit(json).replace(/\n*$/, '\n').replace(/^\n$/, '');
+    const free = columns.map(prop => {
+      return `  TKMEM_FREE(${clsName}s->columns.${prop.name});\n`;
+    }).join('');
+
+    return `
+/***************${clsName}s_view_model***************/
+
+static ret_t ${clsName}s_view_model_load_row(${clsName}s_view_model_t* ${clsName}s, uint32_t index,
+                                         ${clsName}_t* ${clsName}) {
+  return_value_if_fail(index < ${clsName}s->size, RET_BAD_PARAMS);
+
+  memset(${clsName}, 0x00, sizeof(*${clsName}));
+${load}
+  return RET_OK;
+}
+
+static ret_t ${clsName}s_view_model_store_row(${clsName}s_view_model_t* ${clsName}s, uint32_t index,
+                                          const ${clsName}_t* ${clsName}) {
+  return_value_if_fail(index < ${clsName}s->capacity, RET_BAD_PARAMS);
+
+${store}
+  return RET_OK;
+}
+
+static ret_t ${clsName}s_view_model_deinit_rows(${clsName}s_view_model_t* ${clsName}s, uint32_t start,
+                                            uint32_t nr) {
+  uint32_t i = 0;
+  ${clsName}_t row;
+  ${clsName}_t* ${clsName} = &row;
+
+  for (i = start; i < start + nr; i++) {
+    ${clsName}s_view_model_load_row(${clsName}s, i, ${clsName});
+${deinit}
+  }
+
+  return RET_OK;
+}
+
+static ret_t ${clsName}s_view_model_extend(${clsName}s_view_model_t* ${clsName}s, uint32_t nr) {
+  void* p = NULL;
+  uint32_t capacity = 0;
+
+  if (${clsName}s->size + nr <= ${clsName}s->capacity) {
+    return RET_OK;
+  }
+
+  capacity = ${clsName}s->capacity + (${clsName}s->capacity >> 1) + nr;
+
+  p = TKMEM_REALLOC(${clsName}s->ids, capacity * sizeof(uint32_t));
+  return_value_if_fail(p != NULL, RET_OOM);
+  ${clsName}s->ids = (uint32_t*)p;
+${this.genColumnsRealloc(json)}
+  ${clsName}s->capacity = capacity;
+
+  return RET_OK;
+}
+
+static ret_t ${clsName}s_view_model_free_columns(${clsName}s_view_model_t* ${clsName}s) {
+  TKMEM_FREE(${clsName}s->ids);
+${free}
+  ${clsName}s->capacity = 0;
+
+  return RET_OK;
+}
+
+ret_t ${clsName}s_view_model_append(view_model_t* view_model, const ${clsName}_t* rows, uint32_t nr) {
+  uint32_t i = 0;
+  ${clsName}s_view_model_t* ${clsName}s = (${clsName}s_view_model_t*)(view_model);
+  return_value_if_fail(${clsName}s != NULL && (rows != NULL || nr == 0), RET_BAD_PARAMS);
+  return_value_if_fail(${clsName}s_view_model_extend(${clsName}s, nr) == RET_OK, RET_OOM);
+
+  for (i = 0; i < nr; i++) {
+    ${clsName}s->ids[${clsName}s->size] = ++${clsName}s->next_id;
+    ${clsName}s_view_model_store_row(${clsName}s, ${clsName}s->size, rows + i);
+    ${clsName}s->size++;
+  }
+
+  return RET_OK;
+}
+
+ret_t ${clsName}s_view_model_remove_range(view_model_t* view_model, uint32_t index, uint32_t nr) {
+  uint32_t rest = 0;
+  ${clsName}s_view_model_t* ${clsName}s = (${clsName}s_view_model_t*)(view_model);
+  return_value_if_fail(${clsName}s != NULL && index <= ${clsName}s->size, RET_BAD_PARAMS);
+  return_value_if_fail(nr <= ${clsName}s->size - index, RET_BAD_PARAMS);
+
+  if (nr == 0) {
+    return RET_OK;
+  }
+
+  ${clsName}s_view_model_deinit_rows(${clsName}s, index, nr);
+
+  rest = ${clsName}s->size - index - nr;
+  memmove(${clsName}s->ids + index, ${clsName}s->ids + index + nr, rest * sizeof(uint32_t));
+${this.genColumnsMove(json)}  ${clsName}s->size -= nr;
+
+  return RET_OK;
+}
+
+uint32_t ${clsName}s_view_model_get_id(view_model_t* view_model, uint32_t index) {
+  ${clsName}s_view_model_t* ${clsName}s = (${clsName}s_view_model_t*)(view_model);
+  return_value_if_fail(${clsName}s != NULL && index < ${clsName}s->size, 0);
+
+  return ${clsName}s->ids[index];
+}
+
+int32_t ${clsName}s_view_model_index_of(view_model_t* view_model, uint32_t id) {
+  int32_t low = 0;
+  int32_t high = 0;
+  ${clsName}s_view_model_t* ${clsName}s = (${clsName}s_view_model_t*)(view_model);
+  return_value_if_fail(${clsName}s != NULL, -1);
+
+  /*ID按添加顺序递增，删除时保持顺序，可以二分查找*/
+  high = (int32_t)(${clsName}s->size) - 1;
+  while (low <= high) {
+    int32_t mid = low + ((high - low) >> 1);
+    uint32_t iter = ${clsName}s->ids[mid];
+
+    if (iter == id) {
+      return mid;
+    } else if (iter < id) {
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+
+  return -1;
+}
+
+ret_t ${clsName}s_view_model_remove(view_model_t* view_model, uint32_t index) {
+  ${clsName}s_view_model_t* ${clsName}s = (${clsName}s_view_model_t*)(view_model);
+  return_value_if_fail(${clsName}s != NULL && index < ${clsName}s->size, RET_BAD_PARAMS);
+
+  return ${clsName}s_view_model_remove_range(view_model, index, 1);
+}
+
+static ret_t ${clsName}s_view_model_append_empty(view_model_t* view_model) {
+  ${clsName}_t row;
+
+  /*空行的字段全为0(str_t为空串)，不需要分配内存*/
+  memset(&row, 0x00, sizeof(row));
+
+  return ${clsName}s_view_model_append(view_model, &row, 1);
+}
+
+static ret_t ${clsName}s_view_model_destroy_row(${clsName}_t* ${clsName}) {
+  return_value_if_fail(${clsName} != NULL, RET_BAD_PARAMS);
+
+${destroy}  TKMEM_FREE(${clsName});
+
+  return RET_OK;
+}
+
+ret_t ${clsName}s_view_model_add(view_model_t* view_model, ${clsName}_t* ${clsName}) {
+  ret_t ret = RET_OK;
+  return_value_if_fail(view_model != NULL && ${clsName} != NULL, RET_BAD_PARAMS);
+
+  /*字段已经转移到列中，只释放对象本身*/
+  ret = ${clsName}s_view_model_append(view_model, ${clsName}, 1);
+  if (ret == RET_OK) {
+    TKMEM_FREE(${clsName});
+  }
+
+  return ret;
+}
+
+uint32_t ${clsName}s_view_model_size(view_model_t* view_model) {
+  ${clsName}s_view_model_t* ${clsName}s = (${clsName}s_view_model_t*)(view_model);
+  return_value_if_fail(${clsName}s != NULL, 0);
+
+  return ${clsName}s->size;
+}
+
+ret_t ${clsName}s_view_model_clear(view_model_t* view_model) {
+  ${clsName}s_view_model_t* ${clsName}s = (${clsName}s_view_model_t*)(view_model);
+  return_value_if_fail(${clsName}s != NULL, RET_BAD_PARAMS);
+
+  ${clsName}s_view_model_deinit_rows(${clsName}s, 0, ${clsName}s->size);
+  ${clsName}s->size = 0;
+
+  return RET_OK;
+}
+`;
   }
+
+  genGetPropsCases(json) {
+    const clsName = json.name;
+    const column = name => `columns.${name}[index]`;
+
+    return json.props.filter(prop => !prop.private).map(prop => {
+      const getter = prop.getter || prop.fake;
+      if (getter) {
+        return {
+          name: prop.name,
+          row: true,
+          body: [`${clsName}s_view_model_load_row(${clsName}s, index, ${clsName});`,
+            utils.genToValue(clsName, prop.type, prop.name, getter), 'return RET_OK;']
+        };
+      } else {
+        return {
+          name: prop.name,
+          body: [utils.genToValue(`${clsName}s`, prop.type, column(prop.name)), 'return RET_OK;']
+        };
+      }
+    }).concat([{
+      name: 'style',
+      body: ['value_set_str(v, index % 2 ? "odd" : "even");', 'return RET_OK;']
+    }]);
+  }
+
+  genSetPropsCases(json) {
+    const clsName = json.name;
+    const column = name => `columns.${name}[index]`;
+
+    return json.props.filter(prop => !prop.private).map(prop => {
+      if (prop.setter || prop.fake) {
+        return {
+          name: prop.name,
+          row: true,
+          body: [`${clsName}s_view_model_load_row(${clsName}s, index, ${clsName});`,
+            `${clsName}_set_${prop.name}(${clsName}, v);`,
+            `${clsName}s_view_model_store_row(${clsName}s, index, ${clsName});`, 'break;']
+        };
+      } else {
+        return {
+          name: prop.name,
+          body: [`${utils.genAssignValue(`${clsName}s`, prop.type, column(prop.name))};`, 'break;']
+        };
+      }
+    });
+  }
+
+  genRowDecl(json, cases) {
+    const clsName = json.name;
+
+    if (cases.some(iter => iter.row)) {
+      return `  ${clsName}_t row;
+  ${clsName}_t* ${clsName} = &row;
+`;
+    } else {
+      return '';
+    }
+  }
+
+  genGetItemProp(json) {
+    const clsName = json.name;
+    const cases = this.genGetPropsCases(json);
+    const dispatch = utils.genIdDispatch(json, cases);
+
+    return `
+static ret_t ${clsName}s_view_model_get_item_prop(view_model_t* vm, uint32_t index, int32_t id,
+                                             value_t* v) {
+${this.genRowDecl(json, cases)}  ${clsName}s_view_model_t* ${clsName}s = (${clsName}s_view_model_t*)(vm);
+  return_value_if_fail(index < ${clsName}s->size, RET_BAD_PARAMS);
+
+${dispatch}
+  return RET_NOT_FOUND;
 }
+`;
+  }
+
+  genSetItemProp(json) {
+    const clsName = json.name;
+    const cases = this.genSetPropsCases(json);
+    const dispatch = utils.genIdDispatch(json, cases, 'return RET_NOT_FOUND;');
+
+    return `
+static ret_t ${clsName}s_view_model_set_item_prop(view_model_t* vm, uint32_t index, int32_t id,
+                                             const value_t* v) {
+  value_t old;
+${this.genRowDecl(json, cases)}  ${clsName}s_view_model_t* ${clsName}s = (${clsName}s_view_model_t*)(vm);
+  return_value_if_fail(index < ${clsName}s->size, RET_BAD_PARAMS);
+
+  if (${clsName}s_view_model_get_item_prop(vm, index, id, &old) == RET_OK && value_equal(&old, v)) {
+    return RET_OK;
+  }
+
+${dispatch}
+  return ${clsName}s_view_model_mark_dirty(${clsName}s, id);
+}
+`;
+  }
+
+  genExec(json) {
+    const clsName = json.name;
+    const dispatch = utils.genExecDispatch(json);
+
+    const result =
+      `
+static ret_t ${clsName}s_view_model_exec_row(${clsName}_t* ${clsName}, const char* name, const char* args) {
+${dispatch}
+  log_debug("not found %s\\n", name);
+  return RET_NOT_FOUND;
+}
+
+static ret_t ${clsName}s_view_model_exec(object_t* obj, const char* name, const char* args) {
+  ret_t ret = RET_OK;
+  ${clsName}_t row;
+  ${clsName}_t* ${clsName} = &row;
+  uint32_t index = tk_atoi(args);
+  view_model_t* vm = VIEW_MODEL(obj);
+  ${clsName}s_view_model_t* ${clsName}s = (${clsName}s_view_model_t*)(obj);
+
+  if (tk_str_ieq(name, "add")) {
+    ${clsName}_t* item = ${clsName}_create();
+    return_value_if_fail(item != NULL, RET_OOM);
+
+    /*添加失败时对象仍然属于调用者*/
+    if (${clsName}s_view_model_add(vm, item) != RET_OK) {
+      ${clsName}s_view_model_destroy_row(item);
+      return RET_OOM;
+    }
+
+    return RET_ITEMS_CHANGED;
+  } else if (tk_str_ieq(name, "clear")) {
+    ENSURE(${clsName}s_view_model_clear(vm) == RET_OK);
+    return RET_ITEMS_CHANGED;
+  }
+
+  return_value_if_fail(${clsName}s_view_model_load_row(${clsName}s, index, ${clsName}) == RET_OK,
+                       RET_BAD_PARAMS);
+
+  if (tk_str_ieq(name, "remove")) {
+    ENSURE(${clsName}s_view_model_remove(vm, index) == RET_OK);
+    return RET_ITEMS_CHANGED;
+  }
+
+  ret = ${clsName}s_view_model_exec_row(${clsName}, name, args);
+  ${clsName}s_view_model_store_row(${clsName}s, index, ${clsName});
+
+  return ret;
+}
+`
+    return result;
+  }
+
+  genCanExec(json) {
+    const clsName = json.name;
+    const dispatch = utils.genCanExecDispatch(json);
+
+    const result =
+      `
+static bool_t ${clsName}s_view_model_can_exec(object_t* obj, const char* name, const char* args) {
+  ${clsName}_t row;
+  ${clsName}_t* ${clsName} = &row;
+  uint32_t index = tk_atoi(args);
+  view_model_t* vm = VIEW_MODEL(obj);
+  ${clsName}s_view_model_t* ${clsName}s = (${clsName}s_view_model_t*)(obj);
+
+  if (tk_str_ieq(name, "add")) {
+    return TRUE;
+  } else if (tk_str_ieq(name, "clear")) {
+    return ${clsName}s_view_model_size(vm) > 0;
+  }
+
+  return_value_if_fail(${clsName}s_view_model_load_row(${clsName}s, index, ${clsName}) == RET_OK, FALSE);
+
+  if (tk_str_ieq(name, "remove")) {
+    return index < ${clsName}s_view_model_size(vm);
+  }
+
+${dispatch}
+  return FALSE;
+}
+`
+    return result;
+  }
+
+  genStorageVar(json) {
+    return '';
+  }
+
+  genStorageInit(json) {
+    return '';
+  }
+
+  genStorageDeinit(json) {
+    const clsName = json.name;
+
+    return `  ${clsName}s_view_model_clear(VIEW_MODEL(obj));
+  ${clsName}s_view_model_free_columns(vm);
+`;
+  }
+}
+
+const files = utils.parseArgs(process.argv.slice(2));
 
-if (process.argv.length < 3) {
-  console.log(`Usage: node gen_vm.js idl.json`);
+if (files.length < 1) {
+  console.log(`Usage: node gen_vm_array.js [--dispatch=switch|chain] [--layout=row|columnar] idl.json`);
   process.exit(0);
 }
 
-CodeGen.run(process.argv[2]);
+CodeGen.run(files[0]);
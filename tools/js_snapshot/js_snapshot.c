@@ -0,0 +1,121 @@
+﻿/**
+ * File:   js_snapshot.c
+ * Author: AWTK Develop Team
+ * Brief:  compile js script to jerryscript snapshot
+ *
+ * Copyright (c) 2019 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 agent <agent@local> created
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "jerryscript.h"
+
+#define SNAPSHOT_BUFFER_SIZE (256 * 1024)
+
+static uint32_t s_snapshot[SNAPSHOT_BUFFER_SIZE / sizeof(uint32_t)];
+
+static char* read_file(const char* filename, size_t* size) {
+  long len = 0;
+  char* buff = NULL;
+  FILE* fp = fopen(filename, "rb");
+
+  if (fp == NULL) {
+    return NULL;
+  }
+
+  fseek(fp, 0, SEEK_END);
+  len = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+
+  buff = (char*)malloc(len + 1);
+  if (buff != NULL) {
+    *size = fread(buff, 1, len, fp);
+    buff[*size] = '\0';
+  }
+  fclose(fp);
+
+  return buff;
+}
+
+static int write_file(const char* filename, const void* data, size_t size) {
+  FILE* fp = fopen(filename, "wb");
+
+  if (fp == NULL) {
+    return -1;
+  }
+
+  if (fwrite(data, 1, size, fp) != size) {
+    fclose(fp);
+    return -1;
+  }
+  fclose(fp);
+
+  return 0;
+}
+
+static int gen_snapshot(const char* in_filename, const char* out_filename) {
+  int ret = -1;
+  size_t size = 0;
+  jerry_value_t jsret = 0;
+  char* code = read_file(in_filename, &size);
+
+  if (code == NULL) {
+    printf("read %s failed\n", in_filename);
+    return -1;
+  }
+
+  jsret = jerry_generate_snapshot((const jerry_char_t*)in_filename, strlen(in_filename),
+                                  (const jerry_char_t*)code, size, 0, s_snapshot,
+                                  sizeof(s_snapshot));
+
+  if (jerry_value_is_error(jsret)) {
+    printf("compile %s failed\n", in_filename);
+  } else {
+    size = (size_t)jerry_get_number_value(jsret);
+    ret = write_file(out_filename, s_snapshot, size);
+    if (ret != 0) {
+      printf("write %s failed\n", out_filename);
+    }
+  }
+
+  jerry_release_value(jsret);
+  free(code);
+
+  return ret;
+}
+
+int main(int argc, char* argv[]) {
+  int ret = 0;
+
+  if (argc != 3) {
+    printf("Usage: %s in_filename out_filename\n", argv[0]);
+    printf("  Ex: %s assets/raw/scripts/temperature.js assets/raw/data/temperature.snapshot\n",
+           argv[0]);
+    return 0;
+  }
+
+  jerry_init(JERRY_INIT_EMPTY);
+  if (!jerry_is_feature_enabled(JERRY_FEATURE_SNAPSHOT_SAVE)) {
+    printf("snapshot save is not enabled in jerryscript\n");
+    ret = -1;
+  } else {
+    ret = gen_snapshot(argv[1], argv[2]);
+  }
+  jerry_cleanup();
+
+  return ret == 0 ? 0 : 1;
+}
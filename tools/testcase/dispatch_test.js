@@ -0,0 +1,167 @@
+const fs = require('fs')
+const path = require('path')
+const utils = require('../utils')
+
+/*
+ * 对比switch和chain两种分发代码：
+ * 对每个testcase生成两种版本的分发函数，分支体替换为返回分支序号，
+ * 用已有名称和不存在的名称检查结果是否一致，并测量单次查找的耗时。
+ */
+class DispatchTest {
+  static toCases(cases) {
+    return cases.map((iter, index) => {
+      return {
+        name: iter.name,
+        body: [`return ${index + 1};`]
+      };
+    });
+  }
+
+  static genFunc(name, cases, mode) {
+    return `static int ${name}_${mode}(const char* name) {\n` +
+      utils.genNameDispatch(DispatchTest.toCases(cases), mode) +
+      `\n  return 0;\n}\n`;
+  }
+
+  static genNames(cases) {
+    const names = [];
+    cases.forEach(iter => {
+      const name = iter.name;
+      names.push(name);
+      names.push(name + 'x');
+      names.push(name.substr(0, name.length - 1));
+      names.push(name[0].toUpperCase() + name.substr(1));
+    });
+    names.push('');
+    names.push('not_exist');
+
+    return names.map(iter => `"${iter}"`).join(', ');
+  }
+
+  static genSynthetic(n) {
+    const props = [];
+    const words = ['value', 'name', 'color', 'size', 'text', 'state', 'min', 'max'];
+    for (let i = 0; i < n; i++) {
+      props.push({
+        name: `${words[i % words.length]}_${i}`,
+        type: 'int32_t'
+      });
+    }
+
+    return {
+      id: 'synthetic',
+      name: 'synthetic',
+      props: props,
+      cmds: []
+    };
+  }
+
+  static gen(jsons) {
+    let result = `#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define tk_str_eq(s1, s2) (strcmp(s1, s2) == 0)
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+typedef int (*dispatch_t)(const char* name);
+
+static int check(const char* desc, dispatch_t a, dispatch_t b, const char** names, int nr) {
+  int i = 0;
+  int ret = 0;
+
+  for (i = 0; i < nr; i++) {
+    if (a(names[i]) != b(names[i])) {
+      printf("%s: mismatch on \\"%s\\"\\n", desc, names[i]);
+      ret = 1;
+    }
+  }
+
+  return ret;
+}
+
+static void bench(const char* desc, dispatch_t a, dispatch_t b, const char** names, int nr) {
+  int i = 0;
+  int n = 0;
+  int times = 200000 / nr + 1;
+  volatile int sum = 0;
+  double t1 = 0;
+  double t2 = 0;
+  double start = now_ns();
+
+  for (n = 0; n < times; n++) {
+    for (i = 0; i < nr; i++) {
+      sum += a(names[i]);
+    }
+  }
+  t1 = (now_ns() - start) / (times * nr);
+
+  start = now_ns();
+  for (n = 0; n < times; n++) {
+    for (i = 0; i < nr; i++) {
+      sum += b(names[i]);
+    }
+  }
+  t2 = (now_ns() - start) / (times * nr);
+
+  printf("%-32s switch: %6.1fns chain: %6.1fns\\n", desc, t1, t2);
+}
+
+`;
+    let main = `int main(void) {\n  int ret = 0;\n`;
+
+    jsons.forEach(json => {
+      const kinds = [];
+      if (json.props && json.props.length) {
+        kinds.push(['get_prop', utils.genGetPropsCases(json)]);
+        kinds.push(['set_prop', utils.genSetPropsCases(json)]);
+      }
+      if (json.cmds && json.cmds.length) {
+        kinds.push(['exec', utils.genExecCases(json)]);
+        kinds.push(['can_exec', utils.genCanExecCases(json)]);
+      }
+
+      kinds.forEach(iter => {
+        const name = `${json.id}_${iter[0]}`;
+        const cases = iter[1];
+        if (!cases.length) {
+          return;
+        }
+
+        result += DispatchTest.genFunc(name, cases, 'switch');
+        result += DispatchTest.genFunc(name, cases, 'chain');
+        result += `static const char* ${name}_names[] = {${DispatchTest.genNames(cases)}};\n\n`;
+
+        main += `  ret |= check("${name}", ${name}_switch, ${name}_chain, ${name}_names,\n`;
+        main += `               sizeof(${name}_names) / sizeof(${name}_names[0]));\n`;
+        main += `  bench("${name}(${cases.length})", ${name}_switch, ${name}_chain, ${name}_names,\n`;
+        main += `        sizeof(${name}_names) / sizeof(${name}_names[0]));\n`;
+      });
+    });
+
+    main += `\n  printf("%s\\n", ret == 0 ? "dispatch test passed" : "dispatch test failed");\n\n`;
+    main += `  return ret;\n}\n`;
+
+    return result + main;
+  }
+
+  static run(dir, output) {
+    const jsons = fs.readdirSync(dir).filter(iter => iter.endsWith('.json')).map(iter => {
+      const json = JSON.parse(fs.readFileSync(path.join(dir, iter)).toString());
+      json.id = path.basename(iter, '.json');
+      return json;
+    });
+
+    jsons.push(DispatchTest.genSynthetic(64));
+    fs.writeFileSync(output, DispatchTest.gen(jsons));
+    console.log(`output to ${output}`);
+  }
+}
+
+DispatchTest.run(process.argv[2] || '.', process.argv[3] || 'dispatch_test.c');
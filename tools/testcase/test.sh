@@ -6,3 +6,18 @@ gcc -c -Wall -I../../src/ -I../../../awtk/src *.c
 
 rm -fv *.h *.c *.o
 
+for f in *.json;do node ../gen_vm.js --dispatch=chain $f;done
+
+gcc -c -Wall -I../../src/ -I../../../awtk/src *.c
+
+rm -fv *.h *.c *.o
+
+node ../gen_vm_array.js --layout=columnar book.json
+
+gcc -c -Wall -I../../src/ -I../../../awtk/src books.c
+
+rm -fv *.h *.c *.o
+
+node dispatch_test.js . dispatch_test.c && gcc -O2 -Wall -o dispatch_test dispatch_test.c && ./dispatch_test
+
+rm -fv dispatch_test dispatch_test.c
@@ -49,54 +49,319 @@ class Utils {
     return propsDecl;
   }
 
-  static genGetPropsDispatch(json) {
-    const clsName = json.name;
-    return json.props.map((prop, index) => {
-      let str = '  ';
-      const propName = prop.name;
+  /*
+   * 根据名称分发：cases为[{name, body}]，body为语句数组，需自行return。
+   * 'switch'模式按首字符跳转，只对首字符相同的名称做字符串比较；
+   * 'chain'模式生成逐个比较的tk_str_eq链，用于对比测试。
+   */
+  static genNameDispatch(cases, mode) {
+    mode = mode || Utils.dispatchMode;
+
+    if (cases.length === 0) {
+      return '';
+    }
 
-      if (prop.private) {
+    if (mode === 'chain') {
+      return cases.map((iter, index) => {
+        let str = (index === 0) ? '  if (' : '  } else if (';
+        str += `tk_str_eq("${iter.name}", name)) {\n`;
+        str += iter.body.map(line => `    ${line}`).join('\n');
         return str;
+      }).join('\n') + '\n  }\n';
+    }
+
+    const groups = new Map();
+    cases.forEach(iter => {
+      const c = iter.name[0];
+      if (!groups.has(c)) {
+        groups.set(c, []);
       }
+      groups.get(c).push(iter);
+    });
+
+    let str = '  switch (name[0]) {\n';
+    groups.forEach((items, c) => {
+      str += `    case '${c === "'" || c === '\\' ? '\\' + c : c}': {\n`;
+      str += items.map((iter, index) => {
+        let s = (index === 0) ? '      if (' : '      } else if (';
+        s += `tk_str_eq("${iter.name}", name)) {\n`;
+        s += iter.body.map(line => `        ${line}`).join('\n');
+        return s;
+      }).join('\n');
+      str += '\n      }\n      break;\n    }\n';
+    });
+    str += '    default: {\n      break;\n    }\n  }\n';
+
+    return str;
+  }
 
-      if (index === 0) {
-        str += 'if (';
+  static genGetPropsCases(json) {
+    const clsName = json.name;
+    return json.props.filter(prop => !prop.private).map(prop => {
+      const getter = prop.getter || prop.fake;
+      return {
+        name: prop.name,
+        body: [Utils.genToValue(clsName, prop.type, prop.name, getter), 'return RET_OK;']
+      };
+    });
+  }
+
+  static genSetPropsCases(json) {
+    const clsName = json.name;
+    return json.props.filter(prop => !prop.private).map(prop => {
+      let stm = '';
+      if (prop.setter || prop.fake) {
+        stm = `${clsName}_set_${prop.name}(${clsName}, v);`;
       } else {
-        str += '} else if (';
+        stm = `${Utils.genAssignValue(clsName, prop.type, prop.name)};`;
       }
+      return {
+        name: prop.name,
+        body: [stm, 'return RET_OK;']
+      };
+    });
+  }
 
-      str += `tk_str_eq("${propName}", name)) {\n`
-      if (prop.getter || prop.fake) {
-        str += '    ' + Utils.genToValue(clsName, prop.type, propName, true);
-      } else {
-        str += '    ' + Utils.genToValue(clsName, prop.type, propName, false);
+  static genExecCases(json) {
+    const clsName = json.name;
+    return json.cmds.map(cmd => {
+      return {
+        name: cmd.name,
+        body: [`return ${clsName}_${cmd.name}(${clsName}, args);`]
+      };
+    });
+  }
+
+  static genCanExecCases(json) {
+    const clsName = json.name;
+    return json.cmds.map(cmd => {
+      let stm = 'return TRUE;';
+      if (!cmd.canExec || typeof cmd.canExec === 'string') {
+        stm = `return ${clsName}_can_exec_${cmd.name}(${clsName}, args);`;
       }
-      return str;
+      return {
+        name: cmd.name,
+        body: [stm]
+      };
+    });
+  }
+
+  static genPropId(clsName, name) {
+    return `${clsName.toUpperCase()}_PROP_${name.toUpperCase()}`;
+  }
+
+  static genPropIdEnum(json, cases) {
+    const clsName = json.name;
+    const ids = cases.map((iter, index) => {
+      const id = Utils.genPropId(clsName, iter.name);
+      return `  /**
+   * @const ${id}
+   * ${iter.name}属性的ID。
+   */
+  ${id}${index === 0 ? ' = 0' : ''},`;
     }).join('\n');
+
+    return `
+/**
+ * @enum ${clsName}_prop_id_t
+ * @prefix ${clsName.toUpperCase()}_PROP_
+ * ${clsName}的属性ID。
+ */
+typedef enum _${clsName}_prop_id_t {
+${ids}
+  ${clsName.toUpperCase()}_PROP_NR
+} ${clsName}_prop_id_t;
+`;
   }
-  
-  static genSetPropsDispatch(json) {
+
+  static genPropIdCases(json, cases) {
     const clsName = json.name;
-    return json.props.map((prop, index) => {
-      let str = '  ';
-      const propName = prop.name;
-      if (prop.private) {
-        return str;
-      }
+    return cases.map(iter => {
+      return {
+        name: iter.name,
+        body: [`return ${Utils.genPropId(clsName, iter.name)};`]
+      };
+    });
+  }
 
-      if (index === 0) {
-        str += 'if (';
-      } else {
-        str += '} else if (';
+  static genIdDispatch(json, cases, defaultBody) {
+    const clsName = json.name;
+    if (cases.length === 0) {
+      return '';
+    }
+
+    let str = '  switch (id) {\n';
+    cases.forEach(iter => {
+      str += `    case ${Utils.genPropId(clsName, iter.name)}: {\n`;
+      str += iter.body.map(line => `      ${line}`).join('\n');
+      str += '\n    }\n';
+    });
+    str += `    default: {\n      ${defaultBody || 'break;'}\n    }\n  }\n`;
+
+    return str;
+  }
+
+  static genSetPropsByIdDispatch(json) {
+    const cases = Utils.genSetPropsCases(json).map(iter => {
+      return {
+        name: iter.name,
+        body: [iter.body[0], 'break;']
+      };
+    });
+
+    return Utils.genIdDispatch(json, cases, 'return RET_NOT_FOUND;');
+  }
+
+  /*
+   * 标记脏属性：自定义setter可能同时修改其它属性，设置这类属性时全部标记为脏；
+   * getter返回的值可能由其它属性计算得到，设置任何属性时都标记为脏。
+   */
+  static genMarkDirtyFunc(json, vmType, prefix) {
+    const clsName = json.name;
+    const props = json.props.filter(prop => !prop.private);
+    const setters = props.filter(prop => prop.setter || prop.fake);
+    const getters = props.filter(prop => prop.getter || prop.fake);
+    let str = `
+static ret_t ${prefix}_mark_dirty(${vmType}* vm, int32_t id) {
+`;
+
+    if (setters.length > 0) {
+      str += '  switch (id) {\n';
+      str += setters.map(prop => `    case ${Utils.genPropId(clsName, prop.name)}:`).join('\n');
+      str += ` {
+      memset(vm->dirty, 0xff, sizeof(vm->dirty));
+      return RET_OK;
+    }
+    default: {
+      break;
+    }
+  }
+
+`;
+    }
+
+    str += '  vm->dirty[id / 32] |= 1u << (id % 32);\n';
+    getters.forEach(prop => {
+      const id = Utils.genPropId(clsName, prop.name);
+      str += `  vm->dirty[${id} / 32] |= 1u << (${id} % 32);\n`;
+    });
+    str += `
+  return RET_OK;
+}
+`;
+
+    return str;
+  }
+
+  static genDirtyPropsFuncs(vmType, prefix) {
+    return `
+static const uint32_t* ${prefix}_get_dirty_props(view_model_t* view_model, uint32_t* size) {
+  ${vmType}* vm = (${vmType}*)(view_model);
+
+  *size = sizeof(vm->dirty) / sizeof(vm->dirty[0]);
+
+  return vm->dirty;
+}
+
+static ret_t ${prefix}_clear_dirty_props(view_model_t* view_model) {
+  ${vmType}* vm = (${vmType}*)(view_model);
+
+  memset(vm->dirty, 0x00, sizeof(vm->dirty));
+
+  return RET_OK;
+}
+`;
+  }
+
+  /*
+   * 快照的字段ID：属性名的FNV-1a哈希，与view_model_snapshot_field_id一致。
+   */
+  static genFieldId(name) {
+    let hash = 2166136261;
+    for (let i = 0; i < name.length; i++) {
+      hash ^= name.charCodeAt(i) & 0xff;
+      hash = Math.imul(hash, 16777619) >>> 0;
+    }
+
+    return hash >>> 0;
+  }
+
+  static getSnapshotProps(json) {
+    if (!json.props) {
+      return [];
+    }
+
+    return json.props.filter(prop => !prop.private && !prop.fake && prop.type !== 'void*');
+  }
+
+  /*
+   * 生成按字段ID排序的字段表，没有可以保存的属性时返回空字符串。
+   */
+  static genSnapshotFields(json, varName) {
+    const clsName = json.name;
+    const fields = Utils.getSnapshotProps(json).map(prop => {
+      return {
+        name: prop.name,
+        id: Utils.genFieldId(prop.name)
+      };
+    }).sort((a, b) => a.id - b.id);
+
+    if (fields.length === 0) {
+      return '';
+    }
+
+    fields.forEach((iter, index) => {
+      if (iter.id === 0 || (index > 0 && iter.id === fields[index - 1].id)) {
+        console.log(`snapshot field id of ${iter.name} is conflicted, please rename it`);
+        process.exit(0);
       }
-      str += `tk_str_eq("${propName}", name)) {\n`
-      if (prop.setter || prop.fake) {
-        str += `    ${clsName}_set_${propName}(${clsName}, v);`;
+    });
+
+    const items = fields.map(iter => {
+      const id = '0x' + ('0000000' + iter.id.toString(16)).substr(-8) + 'u';
+      return `  {${id}, ${Utils.genPropId(clsName, iter.name)}}`;
+    }).join(',\n');
+
+    return `
+static const view_model_snapshot_field_t ${varName}[] = {
+${items}
+};
+`;
+  }
+
+  static genGetPropsDispatch(json) {
+    return Utils.genNameDispatch(Utils.genGetPropsCases(json));
+  }
+
+  static genSetPropsDispatch(json) {
+    return Utils.genNameDispatch(Utils.genSetPropsCases(json));
+  }
+
+  static genExecDispatch(json) {
+    return Utils.genNameDispatch(Utils.genExecCases(json));
+  }
+
+  static genCanExecDispatch(json) {
+    return Utils.genNameDispatch(Utils.genCanExecCases(json));
+  }
+
+  /*
+   * 解析命令行参数：--dispatch=chain生成旧的tk_str_eq比较链，
+   * --layout=columnar生成按列存储的集合模型(仅gen_vm_array.js)。
+   */
+  static parseArgs(argv) {
+    const files = [];
+    argv.forEach(iter => {
+      if (iter.indexOf('--dispatch=') === 0) {
+        Utils.dispatchMode = iter.substr('--dispatch='.length);
+      } else if (iter.indexOf('--layout=') === 0) {
+        Utils.layout = iter.substr('--layout='.length);
       } else {
-        str += `    ${Utils.genAssignValue(clsName, prop.type, prop.name)};`;
+        files.push(iter);
       }
-      return str;
-    }).join('\n');
+    });
+
+    return files;
   }
 
   static genToValue(clsName, type, name, getter) {
@@ -179,20 +444,34 @@ class Utils {
     }
   }
   
-  static genModelCommonFuncs(json) {
+  static genModelDeinit(json) {
+    const clsName = json.name;
+
+    if (json.deinit) {
+      return json.deinit;
+    }
+
+    if (!json.props) {
+      return '';
+    }
+
+    return json.props.map(iter => {
+      if(!iter.fake && iter.type === 'char*') {
+        return `  str_reset(&(${clsName}->${iter.name}));\n`;
+      } else {
+        return '';
+      }
+    }).join('');
+  }
+
+  /*
+   * withoutDestroy为true时不生成xxx_destroy，列式集合不单独释放对象。
+   */
+  static genModelCommonFuncs(json, withoutDestroy) {
     const clsName = json.name;
 
     let defaultInit = '';
-    let defulatDeinit = '';
     if(json.props) {
-      defulatDeinit = json.props.map(iter => {
-        if(!iter.fake && iter.type === 'char*') {
-          return `  str_reset(&(${clsName}->${iter.name}));\n`;
-        } else {
-          return '';
-        }
-      }).join('');
-      
       defaultInit = json.props.map(iter => {
         if(iter.fake) {
           return '';
@@ -213,7 +492,7 @@ class Utils {
     }
 
     let init = json.init ? json.init : defaultInit;
-    let deinit = json.deinit ? json.deinit : defulatDeinit;
+    let deinit = Utils.genModelDeinit(json);
     let cmp = json.cmp ? json.cmp : "/*TODO: */\n  return 0;"
 
     let cmpFunc = '';
@@ -226,6 +505,22 @@ int ${clsName}_cmp(${clsName}_t* a, ${clsName}_t* b) {
 ${cmp}
 }
 
+`
+    }
+    let destroyFunc = '';
+    if(!withoutDestroy) {
+    destroyFunc =
+`
+static ret_t ${clsName}_destroy(${clsName}_t* ${clsName}) {
+  return_value_if_fail(${clsName} != NULL, RET_BAD_PARAMS);
+
+${deinit}
+
+  TKMEM_FREE(${clsName});
+
+  return RET_OK;
+}
+
 `
     }
     let result =
@@ -240,18 +535,7 @@ ${init}
 
   return ${clsName};
 } 
-${cmpFunc}
-static ret_t ${clsName}_destroy(${clsName}_t* ${clsName}) {
-  return_value_if_fail(${clsName} != NULL, RET_BAD_PARAMS);
-
-${deinit}
-
-  TKMEM_FREE(${clsName});
-
-  return RET_OK;
-}
-
-`
+${cmpFunc}${destroyFunc}`
     return result;
   }
   
@@ -345,4 +629,7 @@ static ret_t ${clsName}_set_${propName}(${clsName}_t* ${clsName}, const value_t*
 
 }
 
+Utils.dispatchMode = 'switch';
+Utils.layout = 'row';
+
 module.exports = Utils;